@@ -163,18 +163,35 @@ public class JNIImsMediaService {
      * @return 1 if it is success to send data, -1 when it fails
      */
     public static int sendData2Java(final int sessionId, final byte[] baData) {
+        if (baData == null) {
+            return -1;
+        }
+        return sendData2Java(sessionId, baData, baData.length);
+    }
+
+    /**
+     * Sends callback parcel message from libimsmediajni to java. The byte array is a buffer
+     * reused by the native thread for the following messages, so only the first size bytes are
+     * valid and the data should not be kept after this method returns.
+     *
+     * @param sessionId An unique key idenfier to find corresponding listener object to send message
+     * @param baData byte array form of data to send
+     * @param size the size of the data in the byte array
+     * @return 1 if it is success to send data, -1 when it fails
+     */
+    public static int sendData2Java(final int sessionId, final byte[] baData, final int size) {
         Log.d(TAG, "sendData2Java() - sessionId=" + sessionId);
         JNIImsMediaListener listener = getListener(sessionId);
         if (listener == null) {
             Log.e(TAG, "No listener :: sessionId=" + sessionId);
             return -1;
         }
-        if (baData == null) {
+        if (baData == null || size < 0 || size > baData.length) {
             return -1;
         }
         // retrieve parcel object from pool
         Parcel parcel = Parcel.obtain();
-        parcel.unmarshall(baData, 0, baData.length);
+        parcel.unmarshall(baData, 0, size);
         parcel.setDataPosition(0);
         listener.onMessage(parcel);
         parcel.recycle();
@@ -84,6 +84,15 @@ public:
         AUDIO_QUALITY_EVS_FB,
     };
 
+    enum
+    {
+        /** The index of the percentiles of the playout delay, jitter and inter-arrival time */
+        kPercentile50 = 0,
+        kPercentile95,
+        kPercentile99,
+        kPercentileMax,
+    };
+
     CallQuality& operator=(const CallQuality& quality);
     bool operator==(const CallQuality& quality) const;
     bool operator!=(const CallQuality& quality) const;
@@ -132,6 +141,12 @@ public:
     void setNumRtpSidPacketsReceived(const int32_t num);
     int32_t getNumRtpDuplicatePackets();
     void setNumRtpDuplicatePackets(const int32_t num);
+    int32_t getPlayoutDelayPercentileMillis(const int32_t percentile);
+    void setPlayoutDelayPercentileMillis(const int32_t percentile, const int32_t delay);
+    int32_t getRelativeJitterPercentileMillis(const int32_t percentile);
+    void setRelativeJitterPercentileMillis(const int32_t percentile, const int32_t jitter);
+    int32_t getInterArrivalTimePercentileMillis(const int32_t percentile);
+    void setInterArrivalTimePercentileMillis(const int32_t percentile, const int32_t time);
 
 private:
     /** The Downlink call quality level measured in 5 sec monitoring*/
@@ -180,6 +195,15 @@ private:
     int32_t mNumRtpSidPacketsReceived;
     /** The total number of RTP duplicate packets received by this device for an ongoing call. */
     int32_t mNumRtpDuplicatePackets;
+    /**
+     * The percentiles of the playout delay, the relative jitter and the inter-arrival time of the
+     * received RTP packets since the call session began in milliseconds, indexed by
+     * kPercentile50 to kPercentile99. They are native only and not written to the parcel as
+     * android.telephony.CallQuality does not have them.
+     */
+    int32_t mPlayoutDelayPercentiles[kPercentileMax];
+    int32_t mRelativeJitterPercentiles[kPercentileMax];
+    int32_t mInterArrivalTimePercentiles[kPercentileMax];
 };
 
 }  // namespace imsmedia
@@ -15,6 +15,7 @@
  */
 
 #include <CallQuality.h>
+#include <string.h>
 
 namespace android
 {
@@ -50,6 +51,9 @@ CallQuality::CallQuality()
     mMaxPlayoutDelayMillis = 0;
     mNumRtpSidPacketsReceived = 0;
     mNumRtpDuplicatePackets = 0;
+    memset(mPlayoutDelayPercentiles, 0, sizeof(mPlayoutDelayPercentiles));
+    memset(mRelativeJitterPercentiles, 0, sizeof(mRelativeJitterPercentiles));
+    memset(mInterArrivalTimePercentiles, 0, sizeof(mInterArrivalTimePercentiles));
 }
 
 CallQuality::CallQuality(const CallQuality& quality)
@@ -75,6 +79,12 @@ CallQuality::CallQuality(const CallQuality& quality)
     mMaxPlayoutDelayMillis = quality.mMaxPlayoutDelayMillis;
     mNumRtpSidPacketsReceived = quality.mNumRtpSidPacketsReceived;
     mNumRtpDuplicatePackets = quality.mNumRtpDuplicatePackets;
+    memcpy(mPlayoutDelayPercentiles, quality.mPlayoutDelayPercentiles,
+            sizeof(mPlayoutDelayPercentiles));
+    memcpy(mRelativeJitterPercentiles, quality.mRelativeJitterPercentiles,
+            sizeof(mRelativeJitterPercentiles));
+    memcpy(mInterArrivalTimePercentiles, quality.mInterArrivalTimePercentiles,
+            sizeof(mInterArrivalTimePercentiles));
 }
 
 CallQuality::~CallQuality() {}
@@ -104,6 +114,12 @@ CallQuality& CallQuality::operator=(const CallQuality& quality)
         mMaxPlayoutDelayMillis = quality.mMaxPlayoutDelayMillis;
         mNumRtpSidPacketsReceived = quality.mNumRtpSidPacketsReceived;
         mNumRtpDuplicatePackets = quality.mNumRtpDuplicatePackets;
+        memcpy(mPlayoutDelayPercentiles, quality.mPlayoutDelayPercentiles,
+                sizeof(mPlayoutDelayPercentiles));
+        memcpy(mRelativeJitterPercentiles, quality.mRelativeJitterPercentiles,
+                sizeof(mRelativeJitterPercentiles));
+        memcpy(mInterArrivalTimePercentiles, quality.mInterArrivalTimePercentiles,
+                sizeof(mInterArrivalTimePercentiles));
     }
     return *this;
 }
@@ -130,7 +146,13 @@ bool CallQuality::operator==(const CallQuality& quality) const
             mMinPlayoutDelayMillis == quality.mMinPlayoutDelayMillis &&
             mMaxPlayoutDelayMillis == quality.mMaxPlayoutDelayMillis &&
             mNumRtpSidPacketsReceived == quality.mNumRtpSidPacketsReceived &&
-            mNumRtpDuplicatePackets == quality.mNumRtpDuplicatePackets);
+            mNumRtpDuplicatePackets == quality.mNumRtpDuplicatePackets &&
+            memcmp(mPlayoutDelayPercentiles, quality.mPlayoutDelayPercentiles,
+                    sizeof(mPlayoutDelayPercentiles)) == 0 &&
+            memcmp(mRelativeJitterPercentiles, quality.mRelativeJitterPercentiles,
+                    sizeof(mRelativeJitterPercentiles)) == 0 &&
+            memcmp(mInterArrivalTimePercentiles, quality.mInterArrivalTimePercentiles,
+                    sizeof(mInterArrivalTimePercentiles)) == 0);
 }
 
 bool CallQuality::operator!=(const CallQuality& quality) const
@@ -155,7 +177,13 @@ bool CallQuality::operator!=(const CallQuality& quality) const
             mMinPlayoutDelayMillis != quality.mMinPlayoutDelayMillis ||
             mMaxPlayoutDelayMillis != quality.mMaxPlayoutDelayMillis ||
             mNumRtpSidPacketsReceived != quality.mNumRtpSidPacketsReceived ||
-            mNumRtpDuplicatePackets != quality.mNumRtpDuplicatePackets);
+            mNumRtpDuplicatePackets != quality.mNumRtpDuplicatePackets ||
+            memcmp(mPlayoutDelayPercentiles, quality.mPlayoutDelayPercentiles,
+                    sizeof(mPlayoutDelayPercentiles)) != 0 ||
+            memcmp(mRelativeJitterPercentiles, quality.mRelativeJitterPercentiles,
+                    sizeof(mRelativeJitterPercentiles)) != 0 ||
+            memcmp(mInterArrivalTimePercentiles, quality.mInterArrivalTimePercentiles,
+                    sizeof(mInterArrivalTimePercentiles)) != 0);
 }
 
 status_t CallQuality::writeToParcel(Parcel* out) const
@@ -643,6 +671,60 @@ void CallQuality::setNumRtpDuplicatePackets(const int num)
     mNumRtpDuplicatePackets = num;
 }
 
+int32_t CallQuality::getPlayoutDelayPercentileMillis(const int32_t percentile)
+{
+    if (percentile < 0 || percentile >= kPercentileMax)
+    {
+        return 0;
+    }
+
+    return mPlayoutDelayPercentiles[percentile];
+}
+
+void CallQuality::setPlayoutDelayPercentileMillis(const int32_t percentile, const int32_t delay)
+{
+    if (percentile >= 0 && percentile < kPercentileMax)
+    {
+        mPlayoutDelayPercentiles[percentile] = delay;
+    }
+}
+
+int32_t CallQuality::getRelativeJitterPercentileMillis(const int32_t percentile)
+{
+    if (percentile < 0 || percentile >= kPercentileMax)
+    {
+        return 0;
+    }
+
+    return mRelativeJitterPercentiles[percentile];
+}
+
+void CallQuality::setRelativeJitterPercentileMillis(const int32_t percentile, const int32_t jitter)
+{
+    if (percentile >= 0 && percentile < kPercentileMax)
+    {
+        mRelativeJitterPercentiles[percentile] = jitter;
+    }
+}
+
+int32_t CallQuality::getInterArrivalTimePercentileMillis(const int32_t percentile)
+{
+    if (percentile < 0 || percentile >= kPercentileMax)
+    {
+        return 0;
+    }
+
+    return mInterArrivalTimePercentiles[percentile];
+}
+
+void CallQuality::setInterArrivalTimePercentileMillis(const int32_t percentile, const int32_t time)
+{
+    if (percentile >= 0 && percentile < kPercentileMax)
+    {
+        mInterArrivalTimePercentiles[percentile] = time;
+    }
+}
+
 }  // namespace imsmedia
 
 }  // namespace telephony
@@ -20,6 +20,7 @@
 BaseJitterBuffer::BaseJitterBuffer()
 {
     mCallback = nullptr;
+    mMetrics = nullptr;
     mFirstFrameReceived = false;
     mSsrc = 0;
     mCodecType = 0;
@@ -39,6 +40,7 @@ BaseJitterBuffer::~BaseJitterBuffer()
 void BaseJitterBuffer::SetSessionCallback(BaseSessionCallback* callback)
 {
     mCallback = callback;
+    mMetrics = callback != nullptr ? callback->getMetrics() : nullptr;
 }
 
 void BaseJitterBuffer::SetCodecType(uint32_t type)
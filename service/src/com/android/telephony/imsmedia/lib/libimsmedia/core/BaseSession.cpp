@@ -19,11 +19,22 @@
 #include <ImsMediaEventHandler.h>
 #include <string.h>
 #include <ImsMediaNetworkUtil.h>
+#include <SessionLatencyStats.h>
 
-BaseSession::BaseSession() :
+std::atomic<bool> SessionLatencyStats::sEnabled(false);
+
+void SessionLatencyStats::SetEnabled(bool enabled)
+{
+    IMLOGD1("[SetEnabled] enabled[%d]", enabled);
+    sEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+BaseSession::BaseSession(ImsMediaType mediaType) :
         mRtpFd(-1),
         mRtcpFd(-1),
-        mState(kSessionStateClosed)
+        mState(kSessionStateClosed),
+        mMediaType(mediaType),
+        mMetrics(nullptr)
 {
 }
 
@@ -40,11 +51,28 @@ BaseSession::~BaseSession()
         IMLOGD0("[~BaseSession] close rtcp fd");
         ImsMediaNetworkUtil::closeSocket(mRtcpFd);
     }
+
+    if (mMetrics != nullptr)
+    {
+        ImsMediaMetricsRegistry::Release(mMetrics);
+    }
 }
 
 void BaseSession::setSessionId(int sessionId)
 {
     mSessionId = sessionId;
+
+    if (mMetrics != nullptr)
+    {
+        ImsMediaMetricsRegistry::Release(mMetrics);
+    }
+
+    mMetrics = ImsMediaMetricsRegistry::Acquire(sessionId, mMediaType);
+}
+
+int32_t BaseSession::getSessionId()
+{
+    return mSessionId;
 }
 
 void BaseSession::setLocalEndPoint(int rtpFd, int rtcpFd)
@@ -73,4 +101,31 @@ void BaseSession::setMediaQualityThreshold(const MediaQualityThreshold& threshol
 {
     IMLOGI0("[setMediaQualityThreshold]");
     mThreshold = threshold;
-}
\ No newline at end of file
+}
+
+SessionLatencyStats* BaseSession::getLatencyStats()
+{
+    return &mLatencyStats;
+}
+
+void BaseSession::getNodeLatency(
+        kBaseNodeId nodeId, kNodeLatencyType type, ImsMediaHistogramSnapshot& snapshot)
+{
+    mLatencyStats.GetNodeLatency(nodeId, type, snapshot);
+}
+
+void BaseSession::getPathLatency(kPathLatencyType type, ImsMediaHistogramSnapshot& snapshot)
+{
+    mLatencyStats.GetPathLatency(type, snapshot);
+}
+
+void BaseSession::resetLatencyStats()
+{
+    IMLOGI0("[resetLatencyStats]");
+    mLatencyStats.Reset();
+}
+
+ImsMediaMetrics* BaseSession::getMetrics()
+{
+    return mMetrics;
+}
@@ -302,37 +302,62 @@ bool IRtpSession::SendRtpPacket(uint32_t payloadType, uint8_t* data, uint32_t da
         uint32_t timestamp, bool mark, uint32_t timeDiff, RtpHeaderExtensionInfo* extensionInfo)
 {
     tRtpSvc_SendRtpPacketParam stRtpPacketParam;
-    memset(&stRtpPacketParam, 0, sizeof(tRtpSvc_SendRtpPacketParam));
     IMLOGD_PACKET5(IM_PACKET_LOG_RTP,
             "SendRtpPacket, payloadType[%u], size[%u], TS[%u], mark[%d], extension[%d]",
             payloadType, dataSize, timestamp, mark, extensionInfo != nullptr);
+    SetSendRtpPacketParam(stRtpPacketParam, payloadType, timestamp, timeDiff, extensionInfo);
     stRtpPacketParam.bMbit = mark ? eRTP_TRUE : eRTP_FALSE;
-    stRtpPacketParam.byPayLoadType = payloadType;
-    stRtpPacketParam.diffFromLastRtpTimestamp = timeDiff;
-    stRtpPacketParam.bXbit = extensionInfo != nullptr ? eRTP_TRUE : eRTP_FALSE;
+
+    mNumRtpDataToSend++;
+    IMS_RtpSvc_SendRtpPacket(
+            this, mRtpSessionId, reinterpret_cast<char*>(data), dataSize, &stRtpPacketParam);
+    return true;
+}
+
+bool IRtpSession::SendRtpPackets(uint32_t payloadType, tRTP_PAYLOAD_SLICE* slices,
+        uint32_t numSlices, uint32_t timestamp, RtpHeaderExtensionInfo* extensionInfo)
+{
+    if (slices == nullptr || numSlices == 0)
+    {
+        return false;
+    }
+
+    tRtpSvc_SendRtpPacketParam stRtpPacketParam;
+    IMLOGD_PACKET4(IM_PACKET_LOG_RTP,
+            "SendRtpPackets, payloadType[%u], slices[%u], TS[%u], extension[%d]", payloadType,
+            numSlices, timestamp, extensionInfo != nullptr);
+    SetSendRtpPacketParam(stRtpPacketParam, payloadType, timestamp, 0, extensionInfo);
+
+    mNumRtpDataToSend += numSlices;
+    IMS_RtpSvc_SendRtpPackets(this, mRtpSessionId, slices, numSlices, &stRtpPacketParam);
+    return true;
+}
+
+void IRtpSession::SetSendRtpPacketParam(tRtpSvc_SendRtpPacketParam& param, uint32_t payloadType,
+        uint32_t timestamp, uint32_t timeDiff, RtpHeaderExtensionInfo* extensionInfo)
+{
+    memset(&param, 0, sizeof(tRtpSvc_SendRtpPacketParam));
+    param.byPayLoadType = payloadType;
+    param.diffFromLastRtpTimestamp = timeDiff;
+    param.bXbit = extensionInfo != nullptr ? eRTP_TRUE : eRTP_FALSE;
 
     if (extensionInfo != nullptr)
     {
-        stRtpPacketParam.wDefinedByProfile = extensionInfo->definedByProfile;
-        stRtpPacketParam.wExtLen = extensionInfo->length;
-        stRtpPacketParam.pExtData = extensionInfo->extensionData;
-        stRtpPacketParam.nExtDataSize = extensionInfo->extensionDataSize;
+        param.wDefinedByProfile = extensionInfo->definedByProfile;
+        param.wExtLen = extensionInfo->length;
+        param.pExtData = extensionInfo->extensionData;
+        param.nExtDataSize = extensionInfo->extensionDataSize;
     }
 
     if (mPrevTimestamp == timestamp)
     {
-        stRtpPacketParam.bUseLastTimestamp = eRTP_TRUE;
+        param.bUseLastTimestamp = eRTP_TRUE;
     }
     else
     {
-        stRtpPacketParam.bUseLastTimestamp = eRTP_FALSE;
+        param.bUseLastTimestamp = eRTP_FALSE;
         mPrevTimestamp = timestamp;
     }
-
-    mNumRtpDataToSend++;
-    IMS_RtpSvc_SendRtpPacket(
-            this, mRtpSessionId, reinterpret_cast<char*>(data), dataSize, &stRtpPacketParam);
-    return true;
 }
 
 bool IRtpSession::ProcRtpPacket(uint8_t* pData, uint32_t nDataSize)
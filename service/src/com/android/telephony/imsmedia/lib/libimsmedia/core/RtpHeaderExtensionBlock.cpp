@@ -0,0 +1,304 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpHeaderExtensionBlock.h>
+#include <ImsMediaTrace.h>
+#include <string.h>
+
+using namespace android;
+
+// RFC 8285 4.2, the local identifier 15 is reserved to terminate the one-byte header parsing
+#define ONE_BYTE_HEADER_ID_MAX   14
+#define ONE_BYTE_HEADER_ID_STOP  15
+#define ONE_BYTE_HEADER_DATA_MAX 16
+// RFC 8285 4.3, the lower 4 bits of the profile are app bits
+#define TWO_BYTE_HEADER_PROFILE_MASK 0xFFF0
+
+RtpHeaderExtensionBlock::RtpHeaderExtensionBlock()
+{
+    Clear();
+}
+
+RtpHeaderExtensionBlock::~RtpHeaderExtensionBlock() {}
+
+void RtpHeaderExtensionBlock::Clear()
+{
+    mCount = 0;
+    mSize = 0;
+    mTwoByteHeader = false;
+    memset(mBuffer, 0, IMS_MEDIA_WORD_SIZE);
+}
+
+bool RtpHeaderExtensionBlock::Parse(uint16_t definedByProfile, const uint8_t* data, uint32_t size)
+{
+    Clear();
+
+    if (data == nullptr || size == 0 || size > RTP_HEADER_EXTENSION_MAX_BLOCK_SIZE)
+    {
+        return false;
+    }
+
+    if (definedByProfile == RtpHeaderExtensionInfo::kBitPatternForOneByteHeader)
+    {
+        mTwoByteHeader = false;
+    }
+    else if ((definedByProfile & TWO_BYTE_HEADER_PROFILE_MASK) ==
+            RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader)
+    {
+        mTwoByteHeader = true;
+    }
+    else
+    {
+        IMLOGD1("[Parse] not supported profile[%x]", definedByProfile);
+        return false;
+    }
+
+    memcpy(mBuffer, data, size);
+    mSize = size;
+
+    uint32_t offset = 0;
+
+    while (offset < size && mCount < RTP_HEADER_EXTENSION_MAX_ELEMENTS)
+    {
+        if (mBuffer[offset] == 0)  // padding
+        {
+            offset++;
+            continue;
+        }
+
+        uint8_t localIdentifier;
+        uint8_t dataSize;
+
+        if (mTwoByteHeader)
+        {
+            if (offset + 2 > size)
+            {
+                break;
+            }
+
+            localIdentifier = mBuffer[offset];
+            dataSize = mBuffer[offset + 1];
+            offset += 2;
+        }
+        else
+        {
+            localIdentifier = mBuffer[offset] >> 4;
+
+            if (localIdentifier == ONE_BYTE_HEADER_ID_STOP)
+            {
+                break;
+            }
+
+            dataSize = (mBuffer[offset] & 0x0F) + 1;
+            offset++;
+        }
+
+        if (offset + dataSize > size)
+        {
+            IMLOGE2("[Parse] invalid element size[%d], remaining[%d]", dataSize, size - offset);
+            break;
+        }
+
+        mElements[mCount].localIdentifier = localIdentifier;
+        mElements[mCount].dataSize = dataSize;
+        mElements[mCount].offset = offset;
+        mCount++;
+        offset += dataSize;
+    }
+
+    return mCount > 0;
+}
+
+bool RtpHeaderExtensionBlock::Add(uint8_t localIdentifier, const uint8_t* data, uint8_t dataSize)
+{
+    if (localIdentifier == 0 || mCount >= RTP_HEADER_EXTENSION_MAX_ELEMENTS ||
+            (data == nullptr && dataSize > 0))
+    {
+        return false;
+    }
+
+    if (!mTwoByteHeader &&
+            (localIdentifier > ONE_BYTE_HEADER_ID_MAX || dataSize == 0 ||
+                    dataSize > ONE_BYTE_HEADER_DATA_MAX))
+    {
+        if (!convertToTwoByteHeader())
+        {
+            return false;
+        }
+    }
+
+    uint32_t headerSize = mTwoByteHeader ? 2 : 1;
+
+    if (mSize + headerSize + dataSize > RTP_HEADER_EXTENSION_MAX_BLOCK_SIZE)
+    {
+        IMLOGE2("[Add] no room for the element, size[%d], dataSize[%d]", mSize, dataSize);
+        return false;
+    }
+
+    if (mTwoByteHeader)
+    {
+        mBuffer[mSize++] = localIdentifier;
+        mBuffer[mSize++] = dataSize;
+    }
+    else
+    {
+        mBuffer[mSize++] = (localIdentifier << 4) | (dataSize - 1);
+    }
+
+    if (dataSize > 0)
+    {
+        memcpy(mBuffer + mSize, data, dataSize);
+    }
+
+    mElements[mCount].localIdentifier = localIdentifier;
+    mElements[mCount].dataSize = dataSize;
+    mElements[mCount].offset = mSize;
+    mCount++;
+    mSize += dataSize;
+
+    // keep the padding to the word boundary zero
+    memset(mBuffer + mSize, 0, GetDataSize() - mSize);
+    return true;
+}
+
+bool RtpHeaderExtensionBlock::Add(std::list<RtpHeaderExtension>* listExtension)
+{
+    if (listExtension == nullptr)
+    {
+        return false;
+    }
+
+    for (auto& extension : *listExtension)
+    {
+        if (extension.getLocalIdentifier() > UINT8_MAX ||
+                extension.getExtensionDataSize() > UINT8_MAX ||
+                !Add(extension.getLocalIdentifier(), extension.getExtensionData(),
+                        extension.getExtensionDataSize()))
+        {
+            IMLOGE1("[Add] failed to add the extension id[%d]", extension.getLocalIdentifier());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+RtpHeaderExtensionElement RtpHeaderExtensionBlock::GetElement(uint32_t index) const
+{
+    RtpHeaderExtensionElement element = {0, 0, nullptr};
+
+    if (index < mCount)
+    {
+        element.localIdentifier = mElements[index].localIdentifier;
+        element.dataSize = mElements[index].dataSize;
+        element.data = mBuffer + mElements[index].offset;
+    }
+
+    return element;
+}
+
+bool RtpHeaderExtensionBlock::Find(
+        uint8_t localIdentifier, RtpHeaderExtensionElement& element) const
+{
+    for (uint32_t i = 0; i < mCount; i++)
+    {
+        if (mElements[i].localIdentifier == localIdentifier)
+        {
+            element = GetElement(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint16_t RtpHeaderExtensionBlock::GetDefinedByProfile() const
+{
+    return mTwoByteHeader ? RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader
+                          : RtpHeaderExtensionInfo::kBitPatternForOneByteHeader;
+}
+
+uint16_t RtpHeaderExtensionBlock::GetDataSize() const
+{
+    return (mSize + IMS_MEDIA_WORD_SIZE - 1) / IMS_MEDIA_WORD_SIZE * IMS_MEDIA_WORD_SIZE;
+}
+
+RtpHeaderExtensionInfo RtpHeaderExtensionBlock::GetInfo() const
+{
+    uint16_t size = GetDataSize();
+    return RtpHeaderExtensionInfo(GetDefinedByProfile(), size / IMS_MEDIA_WORD_SIZE,
+            reinterpret_cast<int8_t*>(const_cast<uint8_t*>(mBuffer)), size);
+}
+
+status_t RtpHeaderExtensionBlock::WriteToParcel(android::Parcel* parcel) const
+{
+    if (parcel == nullptr)
+    {
+        return BAD_VALUE;
+    }
+
+    status_t err = parcel->writeInt32(mCount);
+
+    for (uint32_t i = 0; i < mCount && err == NO_ERROR; i++)
+    {
+        err = parcel->writeInt32(mElements[i].localIdentifier);
+
+        if (err == NO_ERROR)
+        {
+            err = parcel->writeInt32(mElements[i].dataSize);
+        }
+
+        if (err == NO_ERROR)
+        {
+            void* dest = parcel->writeInplace(mElements[i].dataSize);
+
+            if (dest == nullptr)
+            {
+                return NO_MEMORY;
+            }
+
+            memcpy(dest, mBuffer + mElements[i].offset, mElements[i].dataSize);
+        }
+    }
+
+    return err;
+}
+
+bool RtpHeaderExtensionBlock::convertToTwoByteHeader()
+{
+    // the two-byte form needs one more byte per element
+    if (mSize + mCount > RTP_HEADER_EXTENSION_MAX_BLOCK_SIZE)
+    {
+        return false;
+    }
+
+    uint8_t buffer[RTP_HEADER_EXTENSION_MAX_BLOCK_SIZE];
+    uint32_t size = 0;
+
+    for (uint32_t i = 0; i < mCount; i++)
+    {
+        buffer[size++] = mElements[i].localIdentifier;
+        buffer[size++] = mElements[i].dataSize;
+        memcpy(buffer + size, mBuffer + mElements[i].offset, mElements[i].dataSize);
+        mElements[i].offset = size;
+        size += mElements[i].dataSize;
+    }
+
+    memcpy(mBuffer, buffer, size);
+    mSize = size;
+    mTwoByteHeader = true;
+    return true;
+}
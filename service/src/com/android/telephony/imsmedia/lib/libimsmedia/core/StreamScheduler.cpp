@@ -108,7 +108,9 @@ void StreamScheduler::RunRegisteredNode()
         {
             if (node->IsSourceNode())  // process the source node
             {
+                uint64_t startTime = node->GetLatencyStartTime();
                 node->ProcessData();
+                node->AddLatency(kNodeLatencyProcessData, startTime);
             }
             else if (node->GetDataCount() > 0)
             {
@@ -131,7 +133,10 @@ void StreamScheduler::RunRegisteredNode()
             break;
         }
 
-        (*maxNode)->ProcessData();  // process the non runtime node
+        BaseNode* nodeToRun = *maxNode;
+        uint64_t startTime = nodeToRun->GetLatencyStartTime();
+        nodeToRun->ProcessData();  // process the non runtime node
+        nodeToRun->AddLatency(kNodeLatencyProcessData, startTime);
 
         if (IsThreadStopped())
         {
@@ -19,6 +19,9 @@
 #include <ImsMediaDataQueue.h>
 #include <ImsMediaTimer.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
+#include <ImsMediaMetrics.h>
+#include <MediaQualityAnalyzer.h>
 #include <numeric>
 
 #define AUDIO_JITTER_BUFFER_MIN_SIZE    (3)
@@ -49,6 +52,7 @@ AudioJitterBuffer::AudioJitterBuffer()
     mJitterAnalyzer.SetMinMaxJitterBufferSize(mMinJitterBufferSize, mMaxJitterBufferSize);
     mListJitterBufferSize.clear();
     mEvsRedundantFrameOffset = -1;
+    mMediaQualityAnalyzer = nullptr;
     AudioJitterBuffer::Reset();
 }
 
@@ -57,6 +61,12 @@ AudioJitterBuffer::~AudioJitterBuffer()
     AudioJitterBuffer::ClearBuffer();
 }
 
+void AudioJitterBuffer::SetSessionCallback(BaseSessionCallback* callback)
+{
+    BaseJitterBuffer::SetSessionCallback(callback);
+    mMediaQualityAnalyzer = callback != nullptr ? callback->getMediaQualityAnalyzer() : nullptr;
+}
+
 void AudioJitterBuffer::Reset()
 {
     IMLOGD0("[Reset]");
@@ -173,27 +183,36 @@ void AudioJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
 
     int32_t jitter = mJitterAnalyzer.CalculateTransitTimeDifference(nTimestamp, arrivalTime);
 
-    RtpPacket* packet = new RtpPacket();
+    RtpPacket packet;
 
     switch (currEntry.eDataType)
     {
         case MEDIASUBTYPE_AUDIO_SID:
-            packet->rtpDataType = kRtpDataTypeSid;
+            packet.rtpDataType = kRtpDataTypeSid;
             break;
         default:
         case MEDIASUBTYPE_AUDIO_NODATA:
-            packet->rtpDataType = kRtpDataTypeNoData;
+            packet.rtpDataType = kRtpDataTypeNoData;
             break;
         case MEDIASUBTYPE_AUDIO_NORMAL:
-            packet->rtpDataType = kRtpDataTypeNormal;
+            packet.rtpDataType = kRtpDataTypeNormal;
             break;
     }
 
-    packet->ssrc = mSsrc;
-    packet->seqNum = nSeqNum;
-    packet->jitter = jitter;
-    packet->arrival = arrivalTime;
-    mCallback->SendEvent(kCollectPacketInfo, kStreamRtpRx, reinterpret_cast<uint64_t>(packet));
+    packet.ssrc = mSsrc;
+    packet.seqNum = nSeqNum;
+    packet.jitter = jitter;
+    packet.arrival = arrivalTime;
+
+    if (mMediaQualityAnalyzer != nullptr)
+    {
+        mMediaQualityAnalyzer->reportRxRtpPacket(packet);
+    }
+    else
+    {
+        RtpPacket* copied = new RtpPacket(packet);
+        mCallback->SendEvent(kCollectPacketInfo, kStreamRtpRx, reinterpret_cast<uint64_t>(copied));
+    }
 
     std::lock_guard<std::mutex> guard(mMutex);
 
@@ -202,6 +221,7 @@ void AudioJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
             "arrival[%d]",
             nSeqNum, bMark, nTimestamp, nBufferSize, jitter, mDataQueue.GetCount() + 1,
             mCurrPlayingTS - nTimestamp, arrivalTime);
+    IMTRACE_PACKET(kPacketTraceJitterAdd, mCallback, nSeqNum, nTimestamp, nBufferSize);
 
     if (mDataQueue.GetCount() == 0)
     {  // jitter buffer is empty
@@ -508,6 +528,8 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
                 "[Get] OK - dtx[%d], curTS[%u], seq[%u], TS[%u], size[%u], delay[%u], queue[%u]",
                 mDtxPlayed, mCurrPlayingTS, pEntry->nSeqNum, pEntry->nTimestamp,
                 pEntry->nBufferSize, currentTime - pEntry->arrivalTime, mDataQueue.GetCount());
+        IMTRACE_PACKET(kPacketTraceJitterGet, mCallback, pEntry->nSeqNum, pEntry->nTimestamp,
+                pEntry->nBufferSize);
 
         mCurrPlayingTS = pEntry->nTimestamp + FRAME_INTERVAL;
         mFirstFrameReceived = true;
@@ -554,6 +576,8 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
             IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
                     "[Get] preserved frame, dtx[%d], curTS[%u], current[%u]", mDtxPlayed,
                     mCurrPlayingTS, currentTime);
+            IMTRACE_PACKET(kPacketTraceJitterGet, mCallback, pEntry->nSeqNum, mCurrPlayingTS,
+                    pEntry->nBufferSize);
 
             mLastPlayedSeqNum = pEntry->nSeqNum;
             mCurrPlayingTS += FRAME_INTERVAL;
@@ -632,6 +656,17 @@ void AudioJitterBuffer::CountLostFrames(int32_t currentSeq, int32_t lastSeq)
         IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[CountLostFrames] lost seq[%u], num[%u]", lostSeq,
                 lostGap - 1);
 
+        if (mMetrics != nullptr)
+        {
+            mMetrics->AddCounter(kMetricLostPackets, lostGap - 1);
+        }
+
+        if (mMediaQualityAnalyzer != nullptr)
+        {
+            mMediaQualityAnalyzer->reportOptionalInfo(kReportPacketLossGap, lostSeq, lostGap - 1);
+            return;
+        }
+
         SessionCallbackParameter* param =
                 new SessionCallbackParameter(kReportPacketLossGap, lostSeq, lostGap - 1);
         mCallback->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
@@ -665,7 +700,30 @@ void AudioJitterBuffer::CollectRxRtpStatus(int32_t seq, kRtpPacketStatus status)
 {
     IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[CollectRxRtpStatus] seq[%d], status[%d]", seq, status);
 
-    if (mCallback != nullptr)
+    if (mMetrics != nullptr)
+    {
+        switch (status)
+        {
+            case kRtpStatusLate:
+                mMetrics->AddCounter(kMetricLatePackets);
+                break;
+            case kRtpStatusDiscarded:
+                mMetrics->AddCounter(kMetricDiscardedPackets);
+                break;
+            case kRtpStatusDuplicated:
+                mMetrics->AddCounter(kMetricDuplicatedPackets);
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (mMediaQualityAnalyzer != nullptr)
+    {
+        mMediaQualityAnalyzer->reportRxRtpStatus(
+                seq, status, ImsMediaTimer::GetTimeInMilliSeconds());
+    }
+    else if (mCallback != nullptr)
     {
         SessionCallbackParameter* param =
                 new SessionCallbackParameter(seq, status, ImsMediaTimer::GetTimeInMilliSeconds());
@@ -678,6 +736,11 @@ void AudioJitterBuffer::CollectJitterBufferStatus(int32_t currSize, int32_t maxS
     IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[CollectJitterBufferStatus] currSize[%d], maxSize[%d]",
             currSize, maxSize);
 
+    if (mMetrics != nullptr)
+    {
+        mMetrics->SetGauge(kMetricJitterBufferSize, currSize);
+    }
+
     if (mCallback != nullptr)
     {
         mCallback->SendEvent(kCollectJitterBufferSize, currSize, maxSize);
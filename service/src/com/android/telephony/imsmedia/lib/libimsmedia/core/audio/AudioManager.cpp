@@ -15,9 +15,12 @@
  */
 
 #include <AudioManager.h>
+#include <ImsMediaEventHandlerId.h>
 #include <ImsMediaTrace.h>
 #include <ImsMediaNetworkUtil.h>
 #include <MediaQualityStatus.h>
+#include <RtpHeaderExtensionBlock.h>
+#include <string.h>
 
 using namespace android;
 
@@ -25,8 +28,8 @@ AudioManager* AudioManager::sManager = nullptr;
 
 AudioManager::AudioManager()
 {
-    mRequestHandler.Init("AUDIO_REQUEST_EVENT");
-    mResponseHandler.Init("AUDIO_RESPONSE_EVENT");
+    mRequestHandler.Init(AUDIO_REQUEST_EVENT);
+    mResponseHandler.Init(AUDIO_RESPONSE_EVENT);
 }
 
 AudioManager::~AudioManager()
@@ -193,6 +196,20 @@ void AudioManager::sendDtmf(int sessionId, char dtmfDigit, int duration)
     }
 }
 
+void AudioManager::setPtime(int sessionId, uint32_t ptime)
+{
+    auto session = mSessions.find(sessionId);
+    IMLOGI2("[setPtime] sessionId[%d], ptime[%u]", sessionId, ptime);
+    if (session != mSessions.end())
+    {
+        (session->second)->setPtime(ptime);
+    }
+    else
+    {
+        IMLOGE1("[setPtime] no session id[%d]", sessionId);
+    }
+}
+
 void AudioManager::sendRtpHeaderExtension(
         int sessionId, std::list<RtpHeaderExtension>* listExtension)
 {
@@ -248,47 +265,56 @@ void AudioManager::sendMessage(const int sessionId, const android::Parcel& parce
         {
             int rtpFd = parcel.readInt32();
             int rtcpFd = parcel.readInt32();
-            AudioConfig* config = new AudioConfig();
-            err = config->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<AudioConfig>();
+            err = payload.Get<AudioConfig>()->readFromParcel(&parcel);
 
             if (err != NO_ERROR && err != -ENODATA)
             {
                 IMLOGE1("[sendMessage] error readFromParcel[%d]", err);
             }
 
-            EventParamOpenSession* param = new EventParamOpenSession(rtpFd, rtcpFd, config);
             ImsMediaEventHandler::SendEvent(
-                    "AUDIO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(param));
+                    kAudioRequestHandler, nMsg, std::move(payload), sessionId, rtpFd, rtcpFd);
         }
         break;
         case kAudioCloseSession:
-            ImsMediaEventHandler::SendEvent("AUDIO_REQUEST_EVENT", nMsg, sessionId);
+            ImsMediaEventHandler::SendEvent(kAudioRequestHandler, nMsg, sessionId);
             break;
         case kAudioModifySession:
         case kAudioAddConfig:
         case kAudioConfirmConfig:
         case kAudioDeleteConfig:
         {
-            AudioConfig* config = new AudioConfig();
-            err = config->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<AudioConfig>();
+            err = payload.Get<AudioConfig>()->readFromParcel(&parcel);
             if (err != NO_ERROR)
             {
                 IMLOGE1("[sendMessage] error readFromParcel[%d]", err);
             }
             ImsMediaEventHandler::SendEvent(
-                    "AUDIO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(config));
+                    kAudioRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         case kAudioSendDtmf:
         {
-            EventParamDtmf* param = new EventParamDtmf(parcel.readByte(), parcel.readInt32());
-            ImsMediaEventHandler::SendEvent(
-                    "AUDIO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(param));
+            char digit = parcel.readByte();
+            int32_t duration = parcel.readInt32();
+            ImsMediaEventHandler::SendEvent(kAudioRequestHandler, nMsg, sessionId, digit, duration);
+        }
+        break;
+        case kAudioSetPtime:
+        {
+            int32_t ptime = parcel.readInt32();
+            ImsMediaEventHandler::SendEvent(kAudioRequestHandler, nMsg, sessionId,
+                    ptime < 0 ? 0 : static_cast<uint32_t>(ptime));
         }
         break;
         case kAudioSendRtpHeaderExtension:
         {
-            std::list<RtpHeaderExtension>* listExtension = new std::list<RtpHeaderExtension>();
+            ImsMediaEventPayload payload =
+                    ImsMediaEventPayload::Create<std::list<RtpHeaderExtension>>();
+            std::list<RtpHeaderExtension>* listExtension =
+                    payload.Get<std::list<RtpHeaderExtension>>();
             int listSize = parcel.readInt32();
 
             for (int32_t i = 0; i < listSize; i++)
@@ -301,16 +327,16 @@ void AudioManager::sendMessage(const int sessionId, const android::Parcel& parce
                 }
             }
 
-            ImsMediaEventHandler::SendEvent("AUDIO_REQUEST_EVENT", nMsg, sessionId,
-                    reinterpret_cast<uint64_t>(listExtension));
+            ImsMediaEventHandler::SendEvent(
+                    kAudioRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         case kAudioSetMediaQualityThreshold:
         {
-            MediaQualityThreshold* threshold = new MediaQualityThreshold();
-            threshold->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<MediaQualityThreshold>();
+            payload.Get<MediaQualityThreshold>()->readFromParcel(&parcel);
             ImsMediaEventHandler::SendEvent(
-                    "AUDIO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(threshold));
+                    kAudioRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         default:
@@ -318,8 +344,8 @@ void AudioManager::sendMessage(const int sessionId, const android::Parcel& parce
     }
 }
 
-void AudioManager::RequestHandler::processEvent(
-        uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB)
+void AudioManager::RequestHandler::processEvent(uint32_t event, uint64_t sessionId,
+        uint64_t paramA, uint64_t paramB, ImsMediaEventPayload& payload)
 {
     IMLOGI4("[processEvent] event[%d], sessionId[%d], paramA[%d], paramB[%d]", event, sessionId,
             paramA, paramB);
@@ -335,35 +361,18 @@ void AudioManager::RequestHandler::processEvent(
     {
         case kAudioOpenSession:
         {
-            EventParamOpenSession* param = reinterpret_cast<EventParamOpenSession*>(paramA);
-            if (param != nullptr)
-            {
-                AudioConfig* pConfig = reinterpret_cast<AudioConfig*>(param->mConfig);
-                result = sManager->openSession(
-                        static_cast<int>(sessionId), param->rtpFd, param->rtcpFd, pConfig);
-
-                if (result == RESULT_SUCCESS)
-                {
-                    ImsMediaEventHandler::SendEvent(
-                            "AUDIO_RESPONSE_EVENT", kAudioOpenSessionSuccess, sessionId);
-                }
-                else
-                {
-                    ImsMediaEventHandler::SendEvent(
-                            "AUDIO_RESPONSE_EVENT", kAudioOpenSessionFailure, sessionId, result);
-                }
+            result = sManager->openSession(static_cast<int>(sessionId), static_cast<int>(paramA),
+                    static_cast<int>(paramB), payload.Get<AudioConfig>());
 
-                delete param;
-
-                if (pConfig != nullptr)
-                {
-                    delete pConfig;
-                }
+            if (result == RESULT_SUCCESS)
+            {
+                ImsMediaEventHandler::SendEvent(
+                        kAudioResponseHandler, kAudioOpenSessionSuccess, sessionId);
             }
             else
             {
-                ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioOpenSessionFailure,
-                        sessionId, RESULT_INVALID_PARAM);
+                ImsMediaEventHandler::SendEvent(
+                        kAudioResponseHandler, kAudioOpenSessionFailure, sessionId, result);
             }
         }
         break;
@@ -371,78 +380,81 @@ void AudioManager::RequestHandler::processEvent(
             if (sManager->closeSession(static_cast<int>(sessionId)) == RESULT_SUCCESS)
             {
                 ImsMediaEventHandler::SendEvent(
-                        "AUDIO_RESPONSE_EVENT", kAudioSessionClosed, sessionId, 0, 0);
+                        kAudioResponseHandler, kAudioSessionClosed, sessionId, 0, 0);
             }
             break;
         case kAudioModifySession:
         {
-            AudioConfig* config = reinterpret_cast<AudioConfig*>(paramA);
+            AudioConfig* config = payload.Get<AudioConfig>();
             result = sManager->modifySession(static_cast<int>(sessionId), config);
-            ImsMediaEventHandler::SendEvent(
-                    "AUDIO_RESPONSE_EVENT", kAudioModifySessionResponse, sessionId, result, paramA);
+            // the config is sent back with the response
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioModifySessionResponse,
+                    std::move(payload), sessionId, result);
         }
         break;
         case kAudioAddConfig:
         {
-            AudioConfig* config = reinterpret_cast<AudioConfig*>(paramA);
+            AudioConfig* config = payload.Get<AudioConfig>();
             result = sManager->addConfig(static_cast<int>(sessionId), config);
-            ImsMediaEventHandler::SendEvent(
-                    "AUDIO_RESPONSE_EVENT", kAudioAddConfigResponse, sessionId, result, paramA);
+            // the config is sent back with the response
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioAddConfigResponse,
+                    std::move(payload), sessionId, result);
         }
         break;
         case kAudioConfirmConfig:
         {
-            AudioConfig* config = reinterpret_cast<AudioConfig*>(paramA);
+            AudioConfig* config = payload.Get<AudioConfig>();
             result = sManager->confirmConfig(static_cast<int>(sessionId), config);
-            ImsMediaEventHandler::SendEvent(
-                    "AUDIO_RESPONSE_EVENT", kAudioConfirmConfigResponse, sessionId, result, paramA);
+            // the config is sent back with the response
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioConfirmConfigResponse,
+                    std::move(payload), sessionId, result);
         }
         break;
         case kAudioDeleteConfig:
         {
-            AudioConfig* config = reinterpret_cast<AudioConfig*>(paramA);
+            AudioConfig* config = payload.Get<AudioConfig>();
             if (config != nullptr)
             {
                 sManager->deleteConfig(static_cast<int>(sessionId), config);
-                delete config;
             }
         }
         break;
         case kAudioSendDtmf:
-        {
-            EventParamDtmf* param = reinterpret_cast<EventParamDtmf*>(paramA);
-            if (param != nullptr)
-            {
-                sManager->sendDtmf(static_cast<int>(sessionId), param->digit, param->duration);
-                delete param;
-            }
-        }
-        break;
+            sManager->sendDtmf(static_cast<int>(sessionId), static_cast<char>(paramA),
+                    static_cast<int>(paramB));
+            break;
+        case kAudioSetPtime:
+            sManager->setPtime(static_cast<int>(sessionId), static_cast<uint32_t>(paramA));
+            break;
         case kAudioSendRtpHeaderExtension:
         {
             std::list<RtpHeaderExtension>* listExtension =
-                    reinterpret_cast<std::list<RtpHeaderExtension>*>(paramA);
+                    payload.Get<std::list<RtpHeaderExtension>>();
 
             if (listExtension != nullptr)
             {
                 sManager->sendRtpHeaderExtension(static_cast<int>(sessionId), listExtension);
-                delete listExtension;
             }
         }
         break;
         case kAudioSetMediaQualityThreshold:
         {
-            MediaQualityThreshold* threshold = reinterpret_cast<MediaQualityThreshold*>(paramA);
+            MediaQualityThreshold* threshold = payload.Get<MediaQualityThreshold>();
             if (threshold != nullptr)
             {
                 sManager->setMediaQualityThreshold(static_cast<int>(sessionId), threshold);
-                delete threshold;
             }
         }
         break;
+        case kRequestSendRtcpXrReport:
+            // the graphs borrow the report block released with the payload
+            sManager->SendInternalEvent(event, static_cast<int>(sessionId),
+                    reinterpret_cast<uint64_t>(payload.Get<uint8_t>()), paramA);
+            break;
         case kRequestAudioCmr:
         case kRequestAudioCmrEvs:
-        case kRequestSendRtcpXrReport:
+        case kRequestAudioFractionLostUpdate:
+        case kRequestAudioRttdUpdate:
             sManager->SendInternalEvent(event, static_cast<int>(sessionId), paramA, paramB);
             break;
         default:
@@ -450,8 +462,8 @@ void AudioManager::RequestHandler::processEvent(
     }
 }
 
-void AudioManager::ResponseHandler::processEvent(
-        uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB)
+void AudioManager::ResponseHandler::processEvent(uint32_t event, uint64_t sessionId,
+        uint64_t paramA, uint64_t paramB, ImsMediaEventPayload& payload)
 {
     IMLOGI4("[processEvent] event[%d], sessionId[%d], paramA[%d], paramB[%d]", event, sessionId,
             paramA, paramB);
@@ -482,56 +494,45 @@ void AudioManager::ResponseHandler::processEvent(
         {
             parcel.writeInt32(event);
             parcel.writeInt32(paramA);  // result
-            AudioConfig* config = reinterpret_cast<AudioConfig*>(paramB);
+            AudioConfig* config = payload.Get<AudioConfig>();
             if (config != nullptr)
             {
                 config->writeToParcel(&parcel);
                 sManager->sendResponse(sessionId, parcel);
-                delete config;
             }
         }
         break;
         case kAudioFirstMediaPacketInd:
         {
             parcel.writeInt32(event);
-            AudioConfig* config = reinterpret_cast<AudioConfig*>(paramA);
+            AudioConfig* config = payload.Get<AudioConfig>();
             if (config != nullptr)
             {
                 config->writeToParcel(&parcel);
                 sManager->sendResponse(sessionId, parcel);
-                delete config;
             }
         }
         break;
         case kAudioRtpHeaderExtensionInd:
         {
             parcel.writeInt32(event);
-            std::list<RtpHeaderExtension>* listExtension =
-                    reinterpret_cast<std::list<RtpHeaderExtension>*>(paramA);
+            RtpHeaderExtensionBlock* block = payload.Get<RtpHeaderExtensionBlock>();
 
-            if (listExtension != nullptr)
+            if (block != nullptr)
             {
-                parcel.writeInt32(listExtension->size());
-
-                for (auto& extension : *listExtension)
-                {
-                    extension.writeToParcel(&parcel);
-                }
-
+                block->WriteToParcel(&parcel);
                 sManager->sendResponse(sessionId, parcel);
-                delete listExtension;
             }
         }
         break;
         case kAudioMediaQualityStatusInd:
         {
             parcel.writeInt32(event);
-            MediaQualityStatus* status = reinterpret_cast<MediaQualityStatus*>(paramA);
+            MediaQualityStatus* status = payload.Get<MediaQualityStatus>();
             if (status != nullptr)
             {
                 status->writeToParcel(&parcel);
                 sManager->sendResponse(sessionId, parcel);
-                delete status;
             }
         }
         break;
@@ -547,12 +548,11 @@ void AudioManager::ResponseHandler::processEvent(
         case kAudioCallQualityChangedInd:
         {
             parcel.writeInt32(event);
-            CallQuality* quality = reinterpret_cast<CallQuality*>(paramA);
+            CallQuality* quality = payload.Get<CallQuality>();
             if (quality != nullptr)
             {
                 quality->writeToParcel(&parcel);
                 sManager->sendResponse(sessionId, parcel);
-                delete quality;
             }
         }
         break;
@@ -561,6 +561,24 @@ void AudioManager::ResponseHandler::processEvent(
             parcel.writeInt32(static_cast<int>(sessionId));
             sManager->sendResponse(sessionId, parcel);
             break;
+        case kAudioCallQualitySketchInd:
+        {
+            uint8_t* block = payload.Get<uint8_t>();
+
+            if (block != nullptr && paramA != 0)
+            {
+                parcel.writeInt32(event);
+                parcel.writeInt32(static_cast<int>(paramA));
+                void* dest = parcel.writeInplace(paramA);
+
+                if (dest != nullptr)
+                {
+                    memcpy(dest, block, paramA);
+                    sManager->sendResponse(sessionId, parcel);
+                }
+            }
+        }
+        break;
         default:
             break;
     }
@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <AudioPtimeAdapter.h>
+#include <BaseNode.h>
+#include <ImsMediaTrace.h>
+#include <algorithm>
+
+// the duration of an AMR or EVS frame in milliseconds, the ptime is changed by a frame
+#define PTIME_FRAME_DURATION 20
+// the longest ptime the payload encoder bundles in a packet
+#define PTIME_MAX (MAX_FRAME_IN_PACKET * PTIME_FRAME_DURATION)
+// the fraction lost of about 5 percent, in the 8 bits fixed point of RFC 3550 6.4.1
+#define PTIME_LOSS_THRESHOLD 13
+// the round trip time in milliseconds
+#define PTIME_RTT_THRESHOLD 400
+// the number of the consecutive reports without the congestion to decrease the ptime
+#define PTIME_RECOVERY_REPORTS 3
+
+AudioPtimeAdapter::AudioPtimeAdapter()
+{
+    SetConfig(PTIME_FRAME_DURATION, PTIME_FRAME_DURATION);
+}
+
+AudioPtimeAdapter::~AudioPtimeAdapter() {}
+
+void AudioPtimeAdapter::SetConfig(uint32_t ptime, uint32_t maxPtime)
+{
+    mNegotiatedPtime = std::clamp(ptime / PTIME_FRAME_DURATION * PTIME_FRAME_DURATION,
+            static_cast<uint32_t>(PTIME_FRAME_DURATION), static_cast<uint32_t>(PTIME_MAX));
+    mMaxPtime = std::max(mNegotiatedPtime,
+            std::min(maxPtime / PTIME_FRAME_DURATION * PTIME_FRAME_DURATION,
+                    static_cast<uint32_t>(PTIME_MAX)));
+    mPtime = mNegotiatedPtime;
+    mRoundTripTime = 0;
+    mNumGoodReports = 0;
+    mAdaptive = true;
+}
+
+uint32_t AudioPtimeAdapter::SetPtime(uint32_t ptime)
+{
+    mNumGoodReports = 0;
+
+    if (ptime == 0)
+    {
+        mAdaptive = true;
+        mPtime = mNegotiatedPtime;
+    }
+    else
+    {
+        mAdaptive = false;
+        mPtime = std::clamp(
+                (ptime + PTIME_FRAME_DURATION / 2) / PTIME_FRAME_DURATION * PTIME_FRAME_DURATION,
+                static_cast<uint32_t>(PTIME_FRAME_DURATION), mMaxPtime);
+    }
+
+    IMLOGI3("[SetPtime] ptime[%d], adaptive[%d], request[%d]", mPtime, mAdaptive, ptime);
+    return mPtime;
+}
+
+void AudioPtimeAdapter::OnRoundTripTime(uint32_t roundTripTime)
+{
+    mRoundTripTime = roundTripTime;
+}
+
+uint32_t AudioPtimeAdapter::OnFractionLost(uint32_t fractionLost)
+{
+    if (!mAdaptive || mMaxPtime <= mNegotiatedPtime)
+    {
+        return mPtime;
+    }
+
+    uint32_t prevPtime = mPtime;
+
+    if (fractionLost >= PTIME_LOSS_THRESHOLD || mRoundTripTime >= PTIME_RTT_THRESHOLD)
+    {
+        mNumGoodReports = 0;
+        mPtime = std::min(mPtime + PTIME_FRAME_DURATION, mMaxPtime);
+    }
+    else if (mPtime > mNegotiatedPtime && ++mNumGoodReports >= PTIME_RECOVERY_REPORTS)
+    {
+        mNumGoodReports = 0;
+        mPtime -= PTIME_FRAME_DURATION;
+    }
+
+    if (mPtime != prevPtime)
+    {
+        IMLOGI4("[OnFractionLost] ptime[%d] -> [%d], fractionLost[%d], rtt[%d]", prevPtime,
+                mPtime, fractionLost, mRoundTripTime);
+    }
+
+    return mPtime;
+}
@@ -16,12 +16,15 @@
 
 #include <AudioSession.h>
 #include <ImsMediaTrace.h>
-#include <ImsMediaEventHandler.h>
+#include <ImsMediaEventHandlerId.h>
 #include <ImsMediaAudioUtil.h>
 #include <AudioConfig.h>
+#include <MediaQualityStatus.h>
+#include <RtpHeaderExtensionBlock.h>
 #include <string>
 
-AudioSession::AudioSession()
+AudioSession::AudioSession() :
+        BaseSession(IMS_MEDIA_AUDIO)
 {
     IMLOGD0("[AudioSession]");
     std::unique_ptr<MediaQualityAnalyzer> analyzer(new MediaQualityAnalyzer());
@@ -471,35 +474,53 @@ void AudioSession::onEvent(int32_t type, uint64_t param1, uint64_t param2)
         case kImsMediaEventNotifyError:
             break;
         case kImsMediaEventFirstPacketReceived:
-            ImsMediaEventHandler::SendEvent(
-                    "AUDIO_RESPONSE_EVENT", kAudioFirstMediaPacketInd, mSessionId, param1, param2);
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioFirstMediaPacketInd,
+                    ImsMediaEventPayload::Adopt(reinterpret_cast<AudioConfig*>(param1)),
+                    mSessionId);
             break;
         case kImsMediaEventHeaderExtensionReceived:
-            ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioRtpHeaderExtensionInd,
-                    mSessionId, param1, param2);
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioRtpHeaderExtensionInd,
+                    ImsMediaEventPayload::Adopt(reinterpret_cast<RtpHeaderExtensionBlock*>(param1)),
+                    mSessionId);
             break;
         case kImsMediaEventMediaQualityStatus:
-            ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioMediaQualityStatusInd,
-                    mSessionId, param1, param2);
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioMediaQualityStatusInd,
+                    ImsMediaEventPayload::Adopt(reinterpret_cast<MediaQualityStatus*>(param1)),
+                    mSessionId);
             break;
         case kAudioTriggerAnbrQueryInd:
             /** TODO: add implementation */
             break;
         case kAudioDtmfReceivedInd:
             ImsMediaEventHandler::SendEvent(
-                    "AUDIO_RESPONSE_EVENT", kAudioDtmfReceivedInd, mSessionId, param1, param2);
+                    kAudioResponseHandler, kAudioDtmfReceivedInd, mSessionId, param1, param2);
             break;
         case kAudioCallQualityChangedInd:
-            ImsMediaEventHandler::SendEvent(
-                    "AUDIO_RESPONSE_EVENT", kAudioCallQualityChangedInd, mSessionId, param1);
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioCallQualityChangedInd,
+                    ImsMediaEventPayload::Adopt(reinterpret_cast<CallQuality*>(param1)),
+                    mSessionId);
+            break;
+        case kImsMediaEventCallQualitySketch:
+            ImsMediaEventHandler::SendEvent(kAudioResponseHandler, kAudioCallQualitySketchInd,
+                    ImsMediaEventPayload::AdoptArray(reinterpret_cast<uint8_t*>(param1)),
+                    mSessionId, param2);
+            break;
+        case kRequestSendRtcpXrReport:
+            ImsMediaEventHandler::SendEvent(kAudioRequestHandler, type,
+                    ImsMediaEventPayload::AdoptArray(reinterpret_cast<uint8_t*>(param1)),
+                    mSessionId, param2);
             break;
         case kRequestAudioCmr:
         case kRequestAudioCmrEvs:
-        case kRequestSendRtcpXrReport:
+        case kRequestAudioFractionLostUpdate:
             ImsMediaEventHandler::SendEvent(
-                    "AUDIO_REQUEST_EVENT", type, mSessionId, param1, param2);
+                    kAudioRequestHandler, type, mSessionId, param1, param2);
             break;
         case kRequestRoundTripTimeDelayUpdate:
+            // the tx graphs adapt the ptime with the round trip time in the request handler
+            ImsMediaEventHandler::SendEvent(
+                    kAudioRequestHandler, kRequestAudioRttdUpdate, mSessionId, param1);
+            [[fallthrough]];
         case kRequestAudioPlayingStatus:
         case kCollectPacketInfo:
         case kCollectOptionalInfo:
@@ -566,6 +587,19 @@ void AudioSession::sendDtmf(char digit, int duration)
     }
 }
 
+void AudioSession::setPtime(const uint32_t ptime)
+{
+    IMLOGI1("[setPtime] ptime[%u]", ptime);
+
+    for (auto& graph : mListGraphRtpTx)
+    {
+        if (graph != nullptr && graph->getState() == kStreamStateRunning)
+        {
+            graph->setPtime(ptime);
+        }
+    }
+}
+
 bool AudioSession::IsGraphAlreadyExist(RtpConfig* config)
 {
     if (mListGraphRtpTx.size() != 0)
@@ -608,6 +642,11 @@ void AudioSession::sendRtpHeaderExtension(std::list<RtpHeaderExtension>* listExt
     }
 }
 
+MediaQualityAnalyzer* AudioSession::getMediaQualityAnalyzer()
+{
+    return mMediaQualityAnalyzer.get();
+}
+
 void AudioSession::SendInternalEvent(int32_t type, uint64_t param1, uint64_t param2)
 {
     switch (type)
@@ -642,6 +681,25 @@ void AudioSession::SendInternalEvent(int32_t type, uint64_t param1, uint64_t par
                 }
             }
             break;
+        case kRequestAudioFractionLostUpdate:
+        case kRequestAudioRttdUpdate:
+            for (auto& graph : mListGraphRtpTx)
+            {
+                if (graph == nullptr || graph->getState() != kStreamStateRunning)
+                {
+                    continue;
+                }
+
+                if (type == kRequestAudioFractionLostUpdate)
+                {
+                    graph->processFractionLost(static_cast<uint32_t>(param1));
+                }
+                else
+                {
+                    graph->processRoundTripTime(static_cast<uint32_t>(param1));
+                }
+            }
+            break;
         case kRequestSendRtcpXrReport:
             for (std::list<AudioStreamGraphRtcp*>::iterator iter = mListGraphRtcp.begin();
                     iter != mListGraphRtcp.end(); iter++)
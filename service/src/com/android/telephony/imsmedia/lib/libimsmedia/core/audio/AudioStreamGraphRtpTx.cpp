@@ -41,6 +41,8 @@ ImsMediaResult AudioStreamGraphRtpTx::create(RtpConfig* config)
     }
 
     mConfig = new AudioConfig(reinterpret_cast<AudioConfig*>(config));
+    AudioConfig* audioConfig = reinterpret_cast<AudioConfig*>(mConfig);
+    mPtimeAdapter.SetConfig(audioConfig->getPtimeMillis(), audioConfig->getMaxPtimeMillis());
 
     BaseNode* pNodeSource = new IAudioSourceNode(mCallback);
     pNodeSource->SetMediaType(IMS_MEDIA_AUDIO);
@@ -99,11 +101,16 @@ ImsMediaResult AudioStreamGraphRtpTx::update(RtpConfig* config)
         return RESULT_SUCCESS;
     }
 
-    if (mConfig != nullptr)
+    AudioConfig* prevConfig = reinterpret_cast<AudioConfig*>(mConfig);
+
+    // keep the adapted ptime unless the negotiated ptime is changed
+    if (prevConfig->getPtimeMillis() != pConfig->getPtimeMillis() ||
+            prevConfig->getMaxPtimeMillis() != pConfig->getMaxPtimeMillis())
     {
-        delete mConfig;
+        mPtimeAdapter.SetConfig(pConfig->getPtimeMillis(), pConfig->getMaxPtimeMillis());
     }
 
+    delete mConfig;
     mConfig = new AudioConfig(pConfig);
 
     if (mConfig->getMediaDirection() == RtpConfig::MEDIA_DIRECTION_NO_FLOW ||
@@ -128,6 +135,9 @@ ImsMediaResult AudioStreamGraphRtpTx::update(RtpConfig* config)
                 IMLOGE2("[update] error in update node[%s], ret[%d]", node->GetNodeName(), ret);
             }
         }
+
+        // the restarted payload encoder is back to the negotiated ptime
+        applyPtime(mPtimeAdapter.GetPtime());
         mScheduler->Start();
     }
     else if (mGraphState == kStreamStateCreated)
@@ -164,7 +174,15 @@ ImsMediaResult AudioStreamGraphRtpTx::start()
     if (mConfig->getMediaDirection() == RtpConfig::MEDIA_DIRECTION_SEND_ONLY ||
             mConfig->getMediaDirection() == RtpConfig::MEDIA_DIRECTION_SEND_RECEIVE)
     {
-        return BaseStreamGraph::start();
+        ImsMediaResult ret = BaseStreamGraph::start();
+
+        if (ret == RESULT_SUCCESS)
+        {
+            // resume with the adapted ptime after the tx is paused
+            applyPtime(mPtimeAdapter.GetPtime());
+        }
+
+        return ret;
     }
 
     // not started
@@ -253,4 +271,47 @@ void AudioStreamGraphRtpTx::sendRtpHeaderExtension(std::list<RtpHeaderExtension>
     {
         (reinterpret_cast<RtpEncoderNode*>(node))->SetRtpHeaderExtension(listExtension);
     }
-}
\ No newline at end of file
+}
+
+void AudioStreamGraphRtpTx::setPtime(const uint32_t ptime)
+{
+    applyPtime(mPtimeAdapter.SetPtime(ptime));
+}
+
+void AudioStreamGraphRtpTx::processFractionLost(const uint32_t fractionLost)
+{
+    uint32_t prevPtime = mPtimeAdapter.GetPtime();
+    uint32_t ptime = mPtimeAdapter.OnFractionLost(fractionLost);
+
+    if (ptime != prevPtime)
+    {
+        applyPtime(ptime);
+    }
+}
+
+void AudioStreamGraphRtpTx::processRoundTripTime(const uint32_t roundTripTime)
+{
+    mPtimeAdapter.OnRoundTripTime(roundTripTime);
+}
+
+uint32_t AudioStreamGraphRtpTx::getPtime()
+{
+    BaseNode* node = findNode(kNodeIdAudioPayloadEncoder);
+
+    if (node == nullptr)
+    {
+        return 0;
+    }
+
+    return (reinterpret_cast<AudioRtpPayloadEncoderNode*>(node))->GetPtime();
+}
+
+void AudioStreamGraphRtpTx::applyPtime(const uint32_t ptime)
+{
+    BaseNode* node = findNode(kNodeIdAudioPayloadEncoder);
+
+    if (node != nullptr)
+    {
+        (reinterpret_cast<AudioRtpPayloadEncoderNode*>(node))->SetPtime(ptime);
+    }
+}
@@ -163,24 +163,17 @@ void MediaQualityAnalyzer::stop()
         StopThread();
         mConditionExit.wait_timeout(STOP_TIMEOUT);
         notifyCallQuality();
+        notifyQualitySketches();
     }
 
     reset();
 }
 
-void MediaQualityAnalyzer::collectInfo(const int32_t streamType, RtpPacket* packet)
+void MediaQualityAnalyzer::collectInfo(const int32_t streamType, const RtpPacket* packet)
 {
-    if (streamType == kStreamRtpTx && packet != nullptr)
+    if (streamType == kStreamRtpTx)
     {
-        mListTxPacket.push_back(packet);
-
-        if (mListTxPacket.size() >= MAX_NUM_PACKET_STORED)
-        {
-            RtpPacket* pPacket = mListTxPacket.front();
-            mListTxPacket.pop_front();
-            delete pPacket;
-        }
-
+        mNumTxPacket++;
         mCallQuality.setNumRtpPacketsTransmitted(mCallQuality.getNumRtpPacketsTransmitted() + 1);
     }
     else if (streamType == kStreamRtpRx && packet != nullptr)
@@ -209,8 +202,17 @@ void MediaQualityAnalyzer::collectInfo(const int32_t streamType, RtpPacket* pack
         {
             mJitterRxPacket =
                     mJitterRxPacket + (double)(std::abs(packet->jitter) - mJitterRxPacket) * 0.0625;
+
+            if (packet->arrival >= mLastRxArrival)
+            {
+                mQualitySketches[kQualitySketchInterArrival].Add(
+                        packet->arrival - mLastRxArrival);
+            }
         }
 
+        mLastRxArrival = packet->arrival;
+        mQualitySketches[kQualitySketchJitter].Add(std::lround(mJitterRxPacket));
+
         mCallQualitySumRelativeJitter += mJitterRxPacket;
 
         if (mCallQuality.getMaxRelativeJitter() < mJitterRxPacket)
@@ -223,17 +225,10 @@ void MediaQualityAnalyzer::collectInfo(const int32_t streamType, RtpPacket* pack
 
         mSSRC = packet->ssrc;
         mNumRxPacket++;
-        mListRxPacket.push_back(packet);
-
-        if (mListRxPacket.size() >= MAX_NUM_PACKET_STORED)
-        {
-            RtpPacket* pPacket = mListRxPacket.front();
-            mListRxPacket.pop_front();
-            delete pPacket;
-        }
+        mRxPacketRecords.Add(*packet);
 
-        IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[collectInfo] seq[%d], jitter[%d], rx list size[%d]",
-                packet->seqNum, packet->jitter, mListRxPacket.size());
+        IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[collectInfo] seq[%d], jitter[%d], rx records[%d]",
+                packet->seqNum, packet->jitter, mRxPacketRecords.GetCount());
     }
     else if (streamType == kStreamRtcp)
     {
@@ -275,7 +270,7 @@ void MediaQualityAnalyzer::collectOptionalInfo(
         for (int32_t i = 0; i < value; i++)
         {
             // for rtcp xr
-            mRtcpXrEncoder->stackRxRtpStatus(kRtpStatusLost, 0);
+            mRtcpXrEncoder->stackRxRtpStatus(seq + i, kRtpStatusLost, 0);
 
             // for call quality report
             mCallQuality.setNumRtpPacketsNotReceived(
@@ -306,48 +301,37 @@ void MediaQualityAnalyzer::collectOptionalInfo(
 void MediaQualityAnalyzer::collectRxRtpStatus(
         const int32_t seq, const kRtpPacketStatus status, const uint32_t time)
 {
-    if (mListRxPacket.empty())
+    if (mRxPacketRecords.GetCount() == 0)
     {
         return;
     }
 
-    bool found = false;
+    RtpPacketRecord* record = mRxPacketRecords.UpdateStatus(seq, status);
 
-    for (std::list<RtpPacket*>::reverse_iterator rit = mListRxPacket.rbegin();
-            rit != mListRxPacket.rend(); ++rit)
+    if (record == nullptr)
     {
-        RtpPacket* packet = *rit;
+        IMLOGW1("[collectRxRtpStatus] no rtp packet found seq[%d]", seq);
+        return;
+    }
 
-        if (packet->seqNum == seq)
-        {
-            packet->status = status;
-            uint32_t delay = time - packet->arrival;
-            mRtcpXrEncoder->stackRxRtpStatus(packet->status, delay);
-            IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[collectRxRtpStatus] seq[%d], status[%d], delay[%u]",
-                    seq, packet->status, delay);
-
-            // set the max playout delay
-            if (delay > mCallQuality.getMaxPlayoutDelayMillis())
-            {
-                mCallQuality.setMaxPlayoutDelayMillis(delay);
-            }
+    uint32_t delay = time - record->arrival;
+    mRtcpXrEncoder->stackRxRtpStatus(seq, status, delay, record->jitter);
+    IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[collectRxRtpStatus] seq[%d], status[%d], delay[%u]", seq,
+            status, delay);
 
-            // set the min playout delay
-            if (delay < mCallQuality.getMinPlayoutDelayMillis() ||
-                    mCallQuality.getMinPlayoutDelayMillis() == 0)
-            {
-                mCallQuality.setMinPlayoutDelayMillis(delay);
-            }
+    mQualitySketches[kQualitySketchPlayoutDelay].Add(delay);
 
-            found = true;
-            break;
-        }
+    // set the max playout delay
+    if (delay > mCallQuality.getMaxPlayoutDelayMillis())
+    {
+        mCallQuality.setMaxPlayoutDelayMillis(delay);
     }
 
-    if (!found)
+    // set the min playout delay
+    if (delay < mCallQuality.getMinPlayoutDelayMillis() ||
+            mCallQuality.getMinPlayoutDelayMillis() == 0)
     {
-        IMLOGW1("[collectRxRtpStatus] no rtp packet found seq[%d]", seq);
-        return;
+        mCallQuality.setMinPlayoutDelayMillis(delay);
     }
 
     switch (status)
@@ -467,13 +451,8 @@ void MediaQualityAnalyzer::processMediaQuality()
     if (mPacketLossDuration != 0)
     {
         // counts received packets for the duration
-        int32_t numReceivedPacketsInDuration =
-                std::count_if(mListRxPacket.begin(), mListRxPacket.end(),
-                        [=](RtpPacket* packet)
-                        {
-                            return (ImsMediaTimer::GetTimeInMilliSeconds() - packet->arrival <=
-                                    mPacketLossDuration);
-                        });
+        int32_t numReceivedPacketsInDuration = mRxPacketRecords.CountReceivedInDuration(
+                ImsMediaTimer::GetTimeInMilliSeconds(), mPacketLossDuration);
 
         int32_t numLostPacketsInDuration = 0;
 
@@ -590,6 +569,7 @@ void MediaQualityAnalyzer::notifyCallQuality()
         mCallQuality.setCallDuration(ImsMediaTimer::GetTimeInMilliSeconds() - mTimeStarted);
 
         IMLOGD1("[notifyCallQuality] duration[%d]", mCallQuality.getCallDuration());
+        updateQualityPercentiles();
         CallQuality* callQuality = new CallQuality(mCallQuality);
         mCallback->SendEvent(kAudioCallQualityChangedInd, reinterpret_cast<uint64_t>(callQuality));
 
@@ -599,6 +579,38 @@ void MediaQualityAnalyzer::notifyCallQuality()
     }
 }
 
+void MediaQualityAnalyzer::notifyQualitySketches()
+{
+    if (mCallback == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(mEventMutex);
+
+    for (int32_t type = 0; type < kQualitySketchMax; type++)
+    {
+        if (mQualitySketches[type].GetCount() == 0)
+        {
+            continue;
+        }
+
+        uint8_t* block = new uint8_t[IM_SKETCH_MAX_SERIALIZED_SIZE + 1];
+        block[0] = static_cast<uint8_t>(type);
+        uint32_t size = mQualitySketches[type].Serialize(block + 1, IM_SKETCH_MAX_SERIALIZED_SIZE);
+
+        if (size == 0)
+        {
+            delete[] block;
+            continue;
+        }
+
+        IMLOGD2("[notifyQualitySketches] type[%d], size[%u]", type, size);
+        mCallback->SendEvent(
+                kImsMediaEventCallQualitySketch, reinterpret_cast<uint64_t>(block), size + 1);
+    }
+}
+
 void MediaQualityAnalyzer::notifyMediaQualityStatus()
 {
     IMLOGD0("[notifyMediaQualityStatus]");
@@ -609,23 +621,34 @@ void MediaQualityAnalyzer::notifyMediaQualityStatus()
 bool MediaQualityAnalyzer::getRtcpXrReportBlock(
         const uint32_t rtcpXrReport, uint8_t* data, uint32_t& size)
 {
-    IMLOGD1("[getRtcpXrReportBlock] rtcpXrReport[%d]", rtcpXrReport);
+    std::lock_guard<std::mutex> guard(mEventMutex);
+    return generateRtcpXrReportBlock(rtcpXrReport, data, size);
+}
+
+bool MediaQualityAnalyzer::generateRtcpXrReportBlock(
+        const uint32_t rtcpXrReport, uint8_t* data, uint32_t& size)
+{
+    IMLOGD1("[generateRtcpXrReportBlock] rtcpXrReport[%d]", rtcpXrReport);
 
     if (rtcpXrReport == 0)
     {
         return false;
     }
 
-    if (!mRtcpXrEncoder->createRtcpXrReport(
-                rtcpXrReport, &mListRxPacket, &mListLostPacket, mBeginSeq, mEndSeq, data, size))
+    if (!mRtcpXrEncoder->createRtcpXrReport(rtcpXrReport, data, size))
     {
-        IMLOGW0("[getRtcpXrReportBlock] fail to createRtcpXrReport");
+        IMLOGW0("[generateRtcpXrReportBlock] fail to createRtcpXrReport");
         return false;
     }
 
+    // keep the packets waiting for the status from the jitter buffer
+    if (mEndSeq != -1)
+    {
+        mRxPacketRecords.RemoveUntil(mEndSeq);
+    }
+
     mBeginSeq = mEndSeq + 1;
-    clearPacketList(mListRxPacket, mEndSeq);
-    clearPacketList(mListTxPacket, mEndSeq);
+    mNumTxPacket = 0;
     clearLostPacketList(mEndSeq);
     return true;
 }
@@ -635,14 +658,42 @@ CallQuality MediaQualityAnalyzer::getCallQuality()
     return mCallQuality;
 }
 
+bool MediaQualityAnalyzer::getQualitySketch(
+        const kQualitySketchType type, ImsMediaQuantileSketch& sketch)
+{
+    if (type < 0 || type >= kQualitySketchMax)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mEventMutex);
+    sketch = mQualitySketches[type];
+    return true;
+}
+
+void MediaQualityAnalyzer::updateQualityPercentiles()
+{
+    static const uint32_t kPercents[CallQuality::kPercentileMax] = {50, 95, 99};
+
+    for (int32_t i = 0; i < CallQuality::kPercentileMax; i++)
+    {
+        mCallQuality.setPlayoutDelayPercentileMillis(
+                i, mQualitySketches[kQualitySketchPlayoutDelay].GetPercentile(kPercents[i]));
+        mCallQuality.setRelativeJitterPercentileMillis(
+                i, mQualitySketches[kQualitySketchJitter].GetPercentile(kPercents[i]));
+        mCallQuality.setInterArrivalTimePercentileMillis(
+                i, mQualitySketches[kQualitySketchInterArrival].GetPercentile(kPercents[i]));
+    }
+}
+
 uint32_t MediaQualityAnalyzer::getRxPacketSize()
 {
-    return mListRxPacket.size();
+    return mRxPacketRecords.GetCount();
 }
 
 uint32_t MediaQualityAnalyzer::getTxPacketSize()
 {
-    return mListTxPacket.size();
+    return mNumTxPacket;
 }
 
 uint32_t MediaQualityAnalyzer::getLostPacketSize()
@@ -654,6 +705,32 @@ uint32_t MediaQualityAnalyzer::getLostPacketSize()
             });
 }
 
+void MediaQualityAnalyzer::reportRxRtpPacket(const RtpPacket& packet)
+{
+    std::lock_guard<std::mutex> guard(mEventMutex);
+    collectInfo(kStreamRtpRx, &packet);
+}
+
+void MediaQualityAnalyzer::reportTxRtpPacket()
+{
+    std::lock_guard<std::mutex> guard(mEventMutex);
+    collectInfo(kStreamRtpTx, nullptr);
+}
+
+void MediaQualityAnalyzer::reportRxRtpStatus(
+        const int32_t seq, const kRtpPacketStatus status, const uint32_t time)
+{
+    std::lock_guard<std::mutex> guard(mEventMutex);
+    collectRxRtpStatus(seq, status, time);
+}
+
+void MediaQualityAnalyzer::reportOptionalInfo(
+        const int32_t optionType, const int32_t seq, const int32_t value)
+{
+    std::lock_guard<std::mutex> guard(mEventMutex);
+    collectOptionalInfo(optionType, seq, value);
+}
+
 void MediaQualityAnalyzer::SendEvent(uint32_t event, uint64_t paramA, uint64_t paramB)
 {
     AddEvent(event, paramA, paramB);
@@ -679,9 +756,12 @@ void MediaQualityAnalyzer::processEvent(uint32_t event, uint64_t paramA, uint64_
             collectOptionalInfo(kAudioPlayingStatus, 0, paramA);
             break;
         case kCollectPacketInfo:
-            collectInfo(
-                    static_cast<ImsMediaStreamType>(paramA), reinterpret_cast<RtpPacket*>(paramB));
-            break;
+        {
+            RtpPacket* packet = reinterpret_cast<RtpPacket*>(paramB);
+            collectInfo(static_cast<ImsMediaStreamType>(paramA), packet);
+            delete packet;
+        }
+        break;
         case kCollectOptionalInfo:
             if (paramA != 0)
             {
@@ -709,7 +789,7 @@ void MediaQualityAnalyzer::processEvent(uint32_t event, uint64_t paramA, uint64_
             uint32_t size = 0;
             uint8_t* reportBlock = new uint8_t[MAX_BLOCK_LENGTH]{};
 
-            if (getRtcpXrReportBlock(static_cast<int32_t>(paramA), reportBlock, size))
+            if (generateRtcpXrReportBlock(static_cast<int32_t>(paramA), reportBlock, size))
             {
                 mCallback->SendEvent(
                         kRequestSendRtcpXrReport, reinterpret_cast<uint64_t>(reportBlock), size);
@@ -779,6 +859,7 @@ void* MediaQualityAnalyzer::run()
         // process every TIMER_INTERVAL
         if (currTimeInMsec - prevTimeInMsec >= TIMER_INTERVAL)
         {
+            std::lock_guard<std::mutex> guard(mEventMutex);
             processData(++timeCount);
             prevTimeInMsec = currTimeInMsec;
         }
@@ -791,6 +872,7 @@ void* MediaQualityAnalyzer::run()
 
 void MediaQualityAnalyzer::reset()
 {
+    std::lock_guard<std::mutex> guard(mEventMutex);
     mSSRC = DEFAULT_PARAM;
     mBeginSeq = -1;
     mEndSeq = -1;
@@ -803,8 +885,15 @@ void MediaQualityAnalyzer::reset()
     mMaxBufferSize = 0;
     mCallQualityNumRxPacket = 0;
     mCallQualityNumLostPacket = 0;
-    clearPacketList(mListRxPacket, DELETE_ALL);
-    clearPacketList(mListTxPacket, DELETE_ALL);
+
+    for (int32_t i = 0; i < kQualitySketchMax; i++)
+    {
+        mQualitySketches[i].Reset();
+    }
+
+    mLastRxArrival = 0;
+    mRxPacketRecords.Clear();
+    mNumTxPacket = 0;
     clearLostPacketList(DELETE_ALL);
     mNumRxPacket = 0;
     mNumLostPacket = 0;
@@ -822,28 +911,6 @@ void MediaQualityAnalyzer::reset()
     mJitterChecker.initialize(mRtpHysteresisTime);
 }
 
-void MediaQualityAnalyzer::clearPacketList(std::list<RtpPacket*>& list, const int32_t seq)
-{
-    if (list.empty())
-    {
-        return;
-    }
-
-    for (std::list<RtpPacket*>::iterator iter = list.begin(); iter != list.end();)
-    {
-        RtpPacket* packet = *iter;
-        // do not remove the packet seq is larger than target seq
-        if (packet->seqNum > seq)
-        {
-            iter++;
-            continue;
-        }
-
-        iter = list.erase(iter);
-        delete packet;
-    }
-}
-
 void MediaQualityAnalyzer::clearLostPacketList(const int32_t seq)
 {
     if (mListLostPacket.empty())
@@ -17,7 +17,6 @@
 #include <RtcpXrEncoder.h>
 #include <RtcpConfig.h>
 #include <ImsMediaTrace.h>
-#include <limits.h>
 #include <cmath>
 
 RtcpXrEncoder::RtcpXrEncoder()
@@ -40,6 +39,7 @@ RtcpXrEncoder::RtcpXrEncoder()
     mVoipC33 = 0;
     mVoipC31 = 0;
     mVoipC32 = 0;
+    resetStatistics();
 }
 
 RtcpXrEncoder::~RtcpXrEncoder() {}
@@ -61,11 +61,45 @@ void RtcpXrEncoder::setRoundTripDelay(const uint32_t delay)
     mRoundTripDelay = delay;
 }
 
-void RtcpXrEncoder::stackRxRtpStatus(const int32_t status, const uint32_t delay)
+void RtcpXrEncoder::stackRxRtpStatus(
+        const uint16_t seq, const int32_t status, const uint32_t delay, const int32_t jitter)
 {
     bool packetLost = false;
     bool packetDiscarded = false;
 
+    if (mBeginSeq == -1)
+    {
+        mBeginSeq = seq;
+        mEndSeq = seq;
+    }
+    else if (USHORT_SEQ_ROUND_COMPARE(seq, mEndSeq))
+    {
+        mEndSeq = seq;
+    }
+    else if (USHORT_SEQ_ROUND_COMPARE(mBeginSeq, seq))
+    {
+        mBeginSeq = seq;
+    }
+
+    if (status == kRtpStatusLost)
+    {
+        mNumLost++;
+    }
+    else
+    {
+        mNumReceived++;
+
+        // the jitter is sampled once per sequence number
+        if (status == kRtpStatusDuplicated)
+        {
+            mNumDuplicated++;
+        }
+        else
+        {
+            mJitterStats.add(jitter);
+        }
+    }
+
     if (status == kRtpStatusLost)
     {
         mVoipLossCount++;
@@ -136,9 +170,7 @@ void RtcpXrEncoder::setJitterBufferStatus(const uint32_t current, const uint32_t
     mJitterBufferAbsMax = max;
 }
 
-bool RtcpXrEncoder::createRtcpXrReport(const uint32_t rtcpXrReport, std::list<RtpPacket*>* packets,
-        std::list<LostPacket*>* lostPackets, uint16_t beginSeq, uint16_t endSeq, uint8_t* data,
-        uint32_t& size)
+bool RtcpXrEncoder::createRtcpXrReport(const uint32_t rtcpXrReport, uint8_t* data, uint32_t& size)
 {
     size = 0;
 
@@ -151,193 +183,97 @@ bool RtcpXrEncoder::createRtcpXrReport(const uint32_t rtcpXrReport, std::list<Rt
 
     if (rtcpXrReport & RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK)
     {
-        tLossReport* lossReport = createLossAnalysisReport(packets, lostPackets, beginSeq, endSeq);
-        tJitterReport* jitterReport = createJitterAnalysisReport(packets, beginSeq, endSeq);
-        tTTLReport* ttlReport = createTTLAnalysisReport(packets, beginSeq, endSeq);
-        tDuplicateReport* duplicateReport =
-                createDuplicateAnalysisReport(packets, beginSeq, endSeq);
-
-        encodeStatisticSummeryReport(lossReport, jitterReport, ttlReport, duplicateReport, buffer);
-
-        if (lossReport != nullptr)
-        {
-            delete lossReport;
-        }
-
-        if (jitterReport != nullptr)
-        {
-            delete jitterReport;
-        }
-
-        if (ttlReport != nullptr)
-        {
-            delete ttlReport;
-        }
-
-        if (duplicateReport != nullptr)
-        {
-            delete duplicateReport;
-        }
-
+        tLossReport lossReport;
+        tJitterReport jitterReport;
+        tTTLReport ttlReport;
+        tDuplicateReport duplicateReport;
+        uint16_t beginSeq = mBeginSeq == -1 ? 0 : mBeginSeq;
+        uint16_t endSeq = mEndSeq == -1 ? 0 : mEndSeq;
+
+        createLossAnalysisReport(beginSeq, endSeq, lossReport);
+        createJitterAnalysisReport(beginSeq, endSeq, jitterReport);
+        createTTLAnalysisReport(beginSeq, endSeq, ttlReport);
+        createDuplicateAnalysisReport(beginSeq, endSeq, duplicateReport);
+
+        encodeStatisticSummeryReport(
+                &lossReport, &jitterReport, &ttlReport, &duplicateReport, buffer);
         size += BLOCK_LENGTH_STATISTICS;
     }
 
     if (rtcpXrReport & RtcpConfig::FLAG_RTCPXR_VOIP_METRICS_REPORT_BLOCK)
     {
-        tVoIPMatricReport* voipReport = createVoIPMatricReport();
-        encodeVoipMetricReport(voipReport, buffer + size);
+        tVoIPMatricReport voipReport;
+        createVoIPMatricReport(voipReport);
+        encodeVoipMetricReport(&voipReport, buffer + size);
         size += BLOCK_LENGTH_STATISTICS;
-
-        if (voipReport != nullptr)
-        {
-            delete voipReport;
-        }
     }
 
+    resetStatistics();
+
     IMLOGD_PACKET2(IM_PACKET_LOG_RTCP, "[createRtcpXrReport] rtcpXrReport[%d], size[%d]",
             rtcpXrReport, size);
 
     return (size > 0);
 }
 
-tLossReport* RtcpXrEncoder::createLossAnalysisReport(std::list<RtpPacket*>* packets,
-        std::list<LostPacket*>* lostPackets, uint16_t beginSeq, uint16_t endSeq)
+void RtcpXrEncoder::createLossAnalysisReport(
+        uint16_t beginSeq, uint16_t endSeq, tLossReport& report)
 {
-    tLossReport* report = new tLossReport();
-    report->beginSeq = beginSeq;
-    report->endSeq = endSeq;
-    report->numLostPackets = 0;
-    report->numPacketsReceived = 0;
-
-    for (const auto& packet : *packets)
-    {
-        if (packet->seqNum >= beginSeq && packet->seqNum <= endSeq)
-        {
-            report->numPacketsReceived++;
-        }
-    }
-
-    for (const auto& packet : *lostPackets)
-    {
-        if (packet->seqNum >= beginSeq && packet->seqNum <= endSeq)
-        {
-            for (int32_t i = 0; i < packet->numLoss; i++)
-            {
-                if (packet->seqNum + i > endSeq)
-                {
-                    break;
-                }
-
-                report->numLostPackets++;
-            }
-        }
-    }
+    report.beginSeq = beginSeq;
+    report.endSeq = endSeq;
+    report.numLostPackets = mNumLost;
+    report.numPacketsReceived = mNumReceived;
 
     IMLOGD_PACKET4(IM_PACKET_LOG_RTCP,
             "[createLossAnalysisReport] begin[%d], end[%d], lost[%d], received[%d]", beginSeq,
-            endSeq, report->numLostPackets, report->numPacketsReceived);
-
-    return report;
+            endSeq, report.numLostPackets, report.numPacketsReceived);
 }
 
-tJitterReport* RtcpXrEncoder::createJitterAnalysisReport(
-        std::list<RtpPacket*>* packets, uint16_t beginSeq, uint16_t endSeq)
+void RtcpXrEncoder::createJitterAnalysisReport(
+        uint16_t beginSeq, uint16_t endSeq, tJitterReport& report)
 {
-    tJitterReport* report = new tJitterReport();
-    report->beginSeq = beginSeq;
-    report->endSeq = endSeq;
-
-    report->minJitter = INT_MAX;
-    report->maxJitter = INT_MIN;
-    int64_t sumJitter = 0;
-    int64_t sumJitterSqr = 0;
-    uint32_t count = 0;
-
-    for (const auto& packet : *packets)
-    {
-        if (packet->seqNum >= beginSeq && packet->seqNum <= endSeq)
-        {
-            // change units from ms to timestamp
-            int32_t jitter = packet->jitter * mSamplingRate;
-            // min
-            if (jitter < report->minJitter)
-            {
-                report->minJitter = jitter;
-            }
-
-            // max
-            if (jitter > report->maxJitter)
-            {
-                report->maxJitter = jitter;
-            }
-
-            sumJitter += jitter;
-            sumJitterSqr += jitter * jitter;
-            count++;
-        }
-    }
-
-    count == 0 ? report->meanJitter = 0 : report->meanJitter = (double)sumJitter / count;
+    report.beginSeq = beginSeq;
+    report.endSeq = endSeq;
 
-    report->devJitter = (int32_t)sqrt((double)(sumJitterSqr) / count -
-            (double)(sumJitter) / count * (double)(sumJitter) / count);
+    // change units from ms to timestamp
+    int32_t rate = mSamplingRate;
+    report.minJitter = mJitterStats.min * rate;
+    report.maxJitter = mJitterStats.max * rate;
+    report.meanJitter = mJitterStats.mean * rate;
+    report.devJitter = mJitterStats.getDeviation() * rate;
 
     IMLOGD6("[createJitterAnalysisReport] begin[%d], end[%d], min[%d], max[%d], mean[%d], dev[%d]",
-            beginSeq, endSeq, report->minJitter, report->maxJitter, report->meanJitter,
-            report->devJitter);
-
-    return report;
+            beginSeq, endSeq, report.minJitter, report.maxJitter, report.meanJitter,
+            report.devJitter);
 }
 
-tTTLReport* RtcpXrEncoder::createTTLAnalysisReport(
-        std::list<RtpPacket*>* packets, uint16_t beginSeq, uint16_t endSeq)
+void RtcpXrEncoder::createTTLAnalysisReport(uint16_t beginSeq, uint16_t endSeq, tTTLReport& report)
 {
-    (void)packets;
-    tTTLReport* report = new tTTLReport();
-    report->beginSeq = beginSeq;
-    report->endSeq = endSeq;
-
-    // TODO: add implementation
-    report->minTTL = 0;
-    report->meanTTL = 0;
-    report->maxTTL = 0;
-    report->devTTL = 0;
+    report.beginSeq = beginSeq;
+    report.endSeq = endSeq;
+    // the ttl or the hop limit of the received packets is not available from the socket
+    report.minTTL = 0;
+    report.meanTTL = 0;
+    report.maxTTL = 0;
+    report.devTTL = 0;
 
     IMLOGD6("[createTTLAnalysisReport] begin[%d], end[%d], min[%d], max[%d], mean[%d], dev[%d]",
-            beginSeq, endSeq, report->minTTL, report->maxTTL, report->meanTTL, report->devTTL);
-
-    return report;
+            beginSeq, endSeq, report.minTTL, report.maxTTL, report.meanTTL, report.devTTL);
 }
 
-tDuplicateReport* RtcpXrEncoder::createDuplicateAnalysisReport(
-        std::list<RtpPacket*>* packets, uint16_t beginSeq, uint16_t endSeq)
+void RtcpXrEncoder::createDuplicateAnalysisReport(
+        uint16_t beginSeq, uint16_t endSeq, tDuplicateReport& report)
 {
-    tDuplicateReport* report = new tDuplicateReport();
-    report->beginSeq = beginSeq;
-    report->endSeq = endSeq;
-    report->numDuplicatedPackets = 0;
-    report->numPacketsReceived = 0;
-
-    for (const auto& packet : *packets)
-    {
-        if (packet->seqNum >= beginSeq && packet->seqNum <= endSeq)
-        {
-            if (packet->status == kRtpStatusDuplicated)
-            {
-                report->numDuplicatedPackets++;
-            }
-
-            report->numPacketsReceived++;
-        }
-    }
+    report.beginSeq = beginSeq;
+    report.endSeq = endSeq;
+    report.numDuplicatedPackets = mNumDuplicated;
+    report.numPacketsReceived = mNumReceived;
 
     IMLOGD4("[createDuplicateAnalysisReport] begin[%d], end[%d], dup[%d], received[%d]", beginSeq,
-            endSeq, report->numDuplicatedPackets, report->numPacketsReceived);
-
-    return report;
+            endSeq, report.numDuplicatedPackets, report.numPacketsReceived);
 }
 
-tVoIPMatricReport* RtcpXrEncoder::createVoIPMatricReport()
+void RtcpXrEncoder::createVoIPMatricReport(tVoIPMatricReport& report)
 {
     double p32 = 0;
     double p23 = 0;
@@ -377,43 +313,41 @@ tVoIPMatricReport* RtcpXrEncoder::createVoIPMatricReport()
 
     IMLOGD3("[createVoIPMatricReport] cTotal[%d], P23[%lf], P32[%lf]", cTotal, p23, p32);
 
-    tVoIPMatricReport* report = new tVoIPMatricReport();
-    report->ssrc = mSsrc;
+    report.ssrc = mSsrc;
     /* calculate loss and discard rates */
-    report->lossRate = 255 * (double)mVoipLossCount / cTotal;
-    report->discardRate = 255 * (double)mVoipDiscardedCount / cTotal;
-    report->burstDensity = 255 * (double)p23 / (p23 + p32);
-    report->gapDensity = 255 * (double)mVoipC14 / (mVoipC11 + mVoipC14);
+    report.lossRate = 255 * (double)mVoipLossCount / cTotal;
+    report.discardRate = 255 * (double)mVoipDiscardedCount / cTotal;
+    report.burstDensity = 255 * (double)p23 / (p23 + p32);
+    report.gapDensity = 255 * (double)mVoipC14 / (mVoipC11 + mVoipC14);
     // Calculate burst and gap durations in ms
     uint32_t denum = 0;
     mVoipC13 == 0 ? denum = 1 : denum = mVoipC13;
-    report->gapDuration = (mVoipC11 + mVoipC14 + mVoipC13) * 20 / denum;
-    report->burstDuration = cTotal * 20 / denum - report->gapDuration;
+    report.gapDuration = (mVoipC11 + mVoipC14 + mVoipC13) * 20 / denum;
+    report.burstDuration = cTotal * 20 / denum - report.gapDuration;
     // get it from the rtp stack
-    report->roundTripDelay = mRoundTripDelay;
+    report.roundTripDelay = mRoundTripDelay;
     // not implemented yet
-    report->endSystemDelay = 0;
+    report.endSystemDelay = 0;
     // sound signal quality - not support
-    report->signalLevel = 0;
-    report->noiseLevel = 0;
-    report->rerl = 0;
-    report->gMin = G_MIN_THRESHOLD;
+    report.signalLevel = 0;
+    report.noiseLevel = 0;
+    report.rerl = 0;
+    report.gMin = G_MIN_THRESHOLD;
     // call quaility - not support
-    report->rFactor = 0;
-    report->extRFactor = 0;
-    report->rxConfig = 127;
-    report->jitterBufferNominal = mJitterBufferNominal;
-    report->jitterBufferMaximum = mJitterBufferMax;
-    report->jitterBufferAbsMaximum = mJitterBufferAbsMax;
+    report.rFactor = 0;
+    report.extRFactor = 0;
+    report.rxConfig = 127;
+    report.jitterBufferNominal = mJitterBufferNominal;
+    report.jitterBufferMaximum = mJitterBufferMax;
+    report.jitterBufferAbsMaximum = mJitterBufferAbsMax;
 
     IMLOGD6("[createVoIPMatricReport] lossRate[%d], discardRate[%d], burstDensity[%d], "
             "gapDensity[%d], gapDuration[%d], burstDuration[%d]",
-            report->lossRate, report->discardRate, report->burstDensity, report->gapDensity,
-            report->gapDuration, report->burstDuration);
+            report.lossRate, report.discardRate, report.burstDensity, report.gapDensity,
+            report.gapDuration, report.burstDuration);
     IMLOGD3("[createVoIPMatricReport] JBNominal[%d], JBMax[%d], JBAbsMaximum[%d]",
-            report->jitterBufferNominal, report->jitterBufferMaximum,
-            report->jitterBufferAbsMaximum);
-    return report;
+            report.jitterBufferNominal, report.jitterBufferMaximum,
+            report.jitterBufferAbsMaximum);
 }
 
 void RtcpXrEncoder::encodeStatisticSummeryReport(tLossReport* lossReport,
@@ -573,3 +507,13 @@ void RtcpXrEncoder::encodeVoipMetricReport(tVoIPMatricReport* report, uint8_t* d
     mBitWriter.Write(report->jitterBufferMaximum, 16);
     mBitWriter.Write(report->jitterBufferAbsMaximum, 16);
 }
+
+void RtcpXrEncoder::resetStatistics()
+{
+    mBeginSeq = -1;
+    mEndSeq = -1;
+    mNumReceived = 0;
+    mNumLost = 0;
+    mNumDuplicated = 0;
+    mJitterStats.reset();
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpPacketRecordRing.h>
+#include <ImsMediaTrace.h>
+#include <string.h>
+
+// the first extended sequence number starts from the second cycle to extend the older packets
+#define SEQ_CYCLE 0x10000
+
+RtpPacketRecordRing::RtpPacketRecordRing()
+{
+    Clear();
+}
+
+RtpPacketRecordRing::~RtpPacketRecordRing() {}
+
+void RtpPacketRecordRing::Clear()
+{
+    memset(mRecords, 0, sizeof(mRecords));
+    mHighestSeq = 0;
+    mSsrc = 0;
+    mCount = 0;
+    mStarted = false;
+}
+
+bool RtpPacketRecordRing::Add(const RtpPacket& packet)
+{
+    uint16_t seq = static_cast<uint16_t>(packet.seqNum);
+    uint32_t extendedSeq = extendSeq(seq);
+
+    if (mStarted)
+    {
+        if (extendedSeq > mHighestSeq && extendedSeq - mHighestSeq < RTP_PACKET_RECORD_RING_SIZE)
+        {
+            // empty the slots skipped to the new highest sequence number
+            for (uint32_t i = mHighestSeq + 1; i < extendedSeq; i++)
+            {
+                RtpPacketRecord& skipped = mRecords[i & RTP_PACKET_RECORD_RING_MASK];
+                mCount -= skipped.numArrival;
+                skipped.numArrival = 0;
+            }
+
+            mHighestSeq = extendedSeq;
+        }
+        else if (!isInRange(extendedSeq))
+        {
+            if (packet.ssrc == mSsrc && extendedSeq < mHighestSeq)
+            {
+                IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[Add] ignore old seq[%u], highest[%u]", seq,
+                        static_cast<uint16_t>(mHighestSeq));
+                return false;
+            }
+
+            IMLOGD2("[Add] restart from seq[%u], ssrc[%x]", seq, packet.ssrc);
+            Clear();
+        }
+    }
+
+    if (!mStarted)
+    {
+        extendedSeq = extendSeq(seq);
+        mHighestSeq = extendedSeq;
+        mStarted = true;
+    }
+
+    mSsrc = packet.ssrc;
+    RtpPacketRecord& record = mRecords[extendedSeq & RTP_PACKET_RECORD_RING_MASK];
+
+    if (record.numArrival > 0 && record.extendedSeq == extendedSeq)
+    {
+        record.numArrival++;
+        mCount++;
+        return true;
+    }
+
+    mCount -= record.numArrival;
+    record.extendedSeq = extendedSeq;
+    record.jitter = packet.jitter;
+    record.arrival = packet.arrival;
+    record.numArrival = 1;
+    record.numDuplicated = 0;
+    record.rtpDataType = packet.rtpDataType;
+    record.status = packet.status;
+    mCount++;
+    return true;
+}
+
+RtpPacketRecord* RtpPacketRecordRing::Find(const uint16_t seq)
+{
+    if (!mStarted)
+    {
+        return nullptr;
+    }
+
+    uint32_t extendedSeq = extendSeq(seq);
+
+    if (!isInRange(extendedSeq))
+    {
+        return nullptr;
+    }
+
+    RtpPacketRecord& record = mRecords[extendedSeq & RTP_PACKET_RECORD_RING_MASK];
+
+    if (record.numArrival == 0 || record.extendedSeq != extendedSeq)
+    {
+        return nullptr;
+    }
+
+    return &record;
+}
+
+RtpPacketRecord* RtpPacketRecordRing::UpdateStatus(
+        const uint16_t seq, const kRtpPacketStatus status)
+{
+    RtpPacketRecord* record = Find(seq);
+
+    if (record == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (status == kRtpStatusDuplicated)
+    {
+        record->numDuplicated++;
+    }
+    else
+    {
+        record->status = status;
+    }
+
+    return record;
+}
+
+void RtpPacketRecordRing::RemoveUntil(const uint16_t seq)
+{
+    if (!mStarted)
+    {
+        return;
+    }
+
+    uint32_t extendedSeq = extendSeq(seq);
+
+    for (auto& record : mRecords)
+    {
+        if (record.numArrival > 0 && record.extendedSeq <= extendedSeq)
+        {
+            mCount -= record.numArrival;
+            record.numArrival = 0;
+        }
+    }
+}
+
+uint32_t RtpPacketRecordRing::CountReceivedInDuration(
+        const uint32_t currentTime, const int32_t duration) const
+{
+    uint32_t count = 0;
+
+    for (const auto& record : mRecords)
+    {
+        if (record.numArrival > 0 &&
+                currentTime - static_cast<uint32_t>(record.arrival) <=
+                        static_cast<uint32_t>(duration))
+        {
+            count += record.numArrival;
+        }
+    }
+
+    return count;
+}
+
+uint32_t RtpPacketRecordRing::extendSeq(const uint16_t seq) const
+{
+    if (!mStarted)
+    {
+        return SEQ_CYCLE + seq;
+    }
+
+    return mHighestSeq + static_cast<int16_t>(seq - static_cast<uint16_t>(mHighestSeq));
+}
+
+bool RtpPacketRecordRing::isInRange(const uint32_t extendedSeq) const
+{
+    return extendedSeq <= mHighestSeq && mHighestSeq - extendedSeq < RTP_PACKET_RECORD_RING_SIZE;
+}
@@ -19,6 +19,7 @@
 #include <ImsMediaTrace.h>
 #include <AudioConfig.h>
 #include <EvsParams.h>
+#include <ImsMediaMetrics.h>
 
 AudioRtpPayloadEncoderNode::AudioRtpPayloadEncoderNode(BaseSessionCallback* callback) :
         BaseNode(callback)
@@ -30,6 +31,11 @@ AudioRtpPayloadEncoderNode::AudioRtpPayloadEncoderNode(BaseSessionCallback* call
     mFirstFrame = false;
     mTimestamp = 0;
     mMaxNumOfFrame = 0;
+    mNextNumOfFrame = 0;
+    mNegotiatedNumOfFrame = 0;
+    mNumFramesSent = 0;
+    mNumPacketsSent = 0;
+    mNumPacketsSaved = 0;
     mCurrNumOfFrame = 0;
     mCurrFramePos = 0;
     mTotalPayloadSize = 0;
@@ -64,10 +70,22 @@ ImsMediaResult AudioRtpPayloadEncoderNode::Start()
         return RESULT_INVALID_PARAM;
     }
 
+    mNextNumOfFrame = mMaxNumOfFrame;
+    mNegotiatedNumOfFrame = mMaxNumOfFrame;
+    mNumFramesSent = 0;
+    mNumPacketsSent = 0;
+    mNumPacketsSaved = 0;
     mCurrNumOfFrame = 0;
     mCurrFramePos = 0;
     mFirstFrame = true;
     mTotalPayloadSize = 0;
+
+    if (mMetrics != nullptr)
+    {
+        mMetrics->SetGauge(kMetricAudioPtime, mPtime);
+        mMetrics->SetGauge(kMetricAudioPacketRateSaved, 0);
+    }
+
     mNodeState = kNodeStateRunning;
     return RESULT_SUCCESS;
 }
@@ -92,6 +110,13 @@ void AudioRtpPayloadEncoderNode::OnDataFromFrontNode(ImsMediaSubType /*subtype*/
         uint32_t nDataSize, uint32_t nTimestamp, bool bMark, uint32_t nSeqNum,
         ImsMediaSubType nDataType, uint32_t arrivalTime)
 {
+    // the frames per packet is changed between the packets only as the header of a packet is
+    // laid out for the number of frames when its first frame is written
+    if (mCurrNumOfFrame == 0)
+    {
+        updateNumOfFrame();
+    }
+
     switch (mCodecType)
     {
         case kAudioCodecAmr:
@@ -262,6 +287,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadAmr(
         {
             SendDataToRearNode(
                     MEDIASUBTYPE_RTPPAYLOAD, mPayload, nTotalSize, mTimestamp, mFirstFrame, 0);
+            updatePacketMetrics();
         }
 
         mCurrNumOfFrame = 0;
@@ -336,6 +362,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
             {
                 SendDataToRearNode(
                         MEDIASUBTYPE_RTPPAYLOAD, mPayload, nTotalSize, mTimestamp, mFirstFrame, 0);
+                updatePacketMetrics();
             }
 
             mCurrNumOfFrame = 0;
@@ -423,6 +450,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
             {
                 SendDataToRearNode(
                         MEDIASUBTYPE_RTPPAYLOAD, mPayload, nTotalSize, mTimestamp, mFirstFrame, 0);
+                updatePacketMetrics();
             }
 
             mCurrNumOfFrame = 0;
@@ -520,6 +548,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
                 {
                     SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload,
                             CheckPaddingNecessity(nTotalSize), mTimestamp, mFirstFrame, 0);
+                    updatePacketMetrics();
                 }
 
                 mCurrNumOfFrame = 0;
@@ -601,6 +630,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
                 {
                     SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload,
                             CheckPaddingNecessity(nTotalSize), mTimestamp, mFirstFrame, 0);
+                    updatePacketMetrics();
                 }
 
                 mCurrNumOfFrame = 0;
@@ -624,6 +654,25 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
     return;
 }
 
+void AudioRtpPayloadEncoderNode::SetPtime(uint32_t ptime)
+{
+    uint32_t numOfFrame = ptime / 20;
+
+    if (numOfFrame == 0 || numOfFrame > MAX_FRAME_IN_PACKET)
+    {
+        IMLOGE1("[SetPtime] invalid ptime[%d]", ptime);
+        return;
+    }
+
+    IMLOGD1("[SetPtime] ptime[%d]", ptime);
+    mNextNumOfFrame = numOfFrame;
+}
+
+uint32_t AudioRtpPayloadEncoderNode::GetPtime()
+{
+    return mNextNumOfFrame * 20;
+}
+
 uint32_t AudioRtpPayloadEncoderNode::CheckPaddingNecessity(uint32_t nTotalSize)
 {
     kEvsCodecMode evsCodecMode;
@@ -641,3 +690,45 @@ uint32_t AudioRtpPayloadEncoderNode::CheckPaddingNecessity(uint32_t nTotalSize)
 
     return nSize;
 }
+
+void AudioRtpPayloadEncoderNode::updateNumOfFrame()
+{
+    uint32_t numOfFrame = mNextNumOfFrame;
+
+    if (numOfFrame == 0 || numOfFrame == mMaxNumOfFrame)
+    {
+        return;
+    }
+
+    IMLOGI2("[updateNumOfFrame] num of frames[%d] -> [%d]", mMaxNumOfFrame, numOfFrame);
+    mMaxNumOfFrame = numOfFrame;
+
+    if (mMetrics != nullptr)
+    {
+        int64_t ptime = numOfFrame * 20;
+        int64_t negotiatedPtime = mNegotiatedNumOfFrame * 20;
+        mMetrics->SetGauge(kMetricAudioPtime, ptime);
+        mMetrics->SetGauge(kMetricAudioPacketRateSaved, 1000 / negotiatedPtime - 1000 / ptime);
+    }
+}
+
+void AudioRtpPayloadEncoderNode::updatePacketMetrics()
+{
+    mNumFramesSent += mCurrNumOfFrame;
+    mNumPacketsSent++;
+
+    if (mMetrics == nullptr || mNegotiatedNumOfFrame == 0)
+    {
+        return;
+    }
+
+    // the number of the packets to send the same frames with the negotiated ptime
+    uint64_t numPacketsNegotiated = mNumFramesSent / mNegotiatedNumOfFrame;
+
+    if (numPacketsNegotiated > mNumPacketsSent + mNumPacketsSaved)
+    {
+        uint64_t saved = numPacketsNegotiated - mNumPacketsSent - mNumPacketsSaved;
+        mNumPacketsSaved += saved;
+        mMetrics->AddCounter(kMetricAudioPacketsSaved, saved);
+    }
+}
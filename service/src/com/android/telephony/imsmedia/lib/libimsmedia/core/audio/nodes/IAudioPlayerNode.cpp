@@ -18,6 +18,8 @@
 #include <ImsMediaAudioPlayer.h>
 #include <ImsMediaDefine.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
+#include <ImsMediaMetrics.h>
 #include <ImsMediaTimer.h>
 #include <ImsMediaAudioUtil.h>
 #include <AudioConfig.h>
@@ -341,6 +343,7 @@ void* IAudioPlayerNode::run()
         {
             IMLOGD_PACKET3(IM_PACKET_LOG_AUDIO, "[run] write buffer size[%u], TS[%u], datatype[%u]",
                     size, timestamp, datatype);
+            IMTRACE_PACKET(kPacketTraceAudioPlay, mCallback, seq, timestamp, size);
 #ifdef FILE_DUMP
             size > 0 ? std::fwrite(data, size, 1, file) : std::fwrite(&noDataHeader, 1, 1, file);
 #endif
@@ -367,7 +370,15 @@ void* IAudioPlayerNode::run()
                         frameType == SPEECH ? kAudioTypeVoice : kAudioTypeNoData, 0);
             }
 
-            if (mAudioPlayer->onDataFrame(data, size, frameType, false, 0))
+            bool played = mAudioPlayer->onDataFrame(data, size, frameType, false, 0);
+            AddPlayoutLatency();
+
+            if (mMetrics != nullptr)
+            {
+                mMetrics->AddCounter(kMetricFramesPlayed);
+            }
+
+            if (played)
             {
                 // send buffering complete message to client
                 if (!isFirstFrameReceived && mCallback != nullptr)
@@ -391,6 +402,7 @@ void* IAudioPlayerNode::run()
                     GetRedundantFrame(lostSeq, &data, &size, &hasNextFrame, &nextFrameByte))
             {
                 lastPlayedSeq++;
+                IMTRACE_PACKET(kPacketTraceAudioPlayLost, mCallback, lostSeq, 0, size);
                 mAudioPlayer->onDataFrame(data, size, LOST, hasNextFrame, nextFrameByte);
 
                 if (mCallback != nullptr)
@@ -401,6 +413,7 @@ void* IAudioPlayerNode::run()
             else
             {
                 IMLOGD_PACKET0(IM_PACKET_LOG_AUDIO, "[run] no data");
+                IMTRACE_PACKET(kPacketTraceAudioPlayNoData, mCallback, lostSeq, 0, 0);
                 mAudioPlayer->onDataFrame(nullptr, 0, NO_DATA, false, 0);
 
                 if (mCallback != nullptr)
@@ -409,6 +422,11 @@ void* IAudioPlayerNode::run()
                 }
             }
 
+            if (mMetrics != nullptr)
+            {
+                mMetrics->AddCounter(kMetricFramesConcealed);
+            }
+
 #ifdef FILE_DUMP
             std::fwrite(&noDataHeader, 1, 1, file);
 #endif
@@ -19,11 +19,24 @@
 #include <AudioConfig.h>
 #include <ImsMediaTrace.h>
 #include <string.h>
+#include <array>
 
 #define MAX_AMR_MODE 8
 #define MAX_EVS_MODE 20
 
-static const uint32_t gaAMRWBLen[32] = {
+#define AUDIO_FRAMES_PER_SECOND   50  // 20 ms frames
+#define AMR_NUM_SPEECH_MODES      8
+#define AMRWB_NUM_SPEECH_MODES    9
+#define EVS_PRIMARY_FIRST_FIXED   1  // the index of 7.2 kbps in gaEVSPrimaryBitLen
+#define EVS_NUM_FIXED_RATE_MODES  11
+#define EVS_AMRWBIO_CMR_BITS      3
+#define AUDIO_MODE_NOT_FOUND      0xFF
+#define AMR_MAX_FRAME_LEN         31
+#define AMRWB_MAX_FRAME_LEN       60
+#define EVS_PRIMARY_MAX_FRAME_LEN 320
+#define EVS_HEADER_FULL_MAX_LEN   321
+
+static constexpr uint32_t gaAMRWBLen[32] = {
         17,  // 6.6
         23,  // 8.85
         32,  // 12.65
@@ -37,7 +50,7 @@ static const uint32_t gaAMRWBLen[32] = {
         0,
 };
 
-static const uint32_t gaAMRWBbitLen[32] = {
+static constexpr uint32_t gaAMRWBbitLen[32] = {
         132,  // 6.6
         177,  // 8.85
         253,  // 12.65
@@ -51,7 +64,7 @@ static const uint32_t gaAMRWBbitLen[32] = {
         0,
 };
 
-static const uint32_t gaEVSPrimaryByteLen[32] = {
+static constexpr uint32_t gaEVSPrimaryByteLen[32] = {
         7,    // 2.8 special case
         18,   // 7.2
         20,   // 8.0
@@ -68,7 +81,7 @@ static const uint32_t gaEVSPrimaryByteLen[32] = {
         0,
 };
 
-static const uint32_t gaEVSPrimaryHeaderFullByteLen[32] = {
+static constexpr uint32_t gaEVSPrimaryHeaderFullByteLen[32] = {
         8,    // 2.8 special case
         19,   // 7.2
         21,   // 8.0
@@ -84,7 +97,7 @@ static const uint32_t gaEVSPrimaryHeaderFullByteLen[32] = {
         7,    // SID
 };
 
-static const uint32_t gaEVSPrimaryBitLen[32] = {
+static constexpr uint32_t gaEVSPrimaryBitLen[32] = {
         56,    // 2.8 Special case
         144,   // 7.2
         160,   // 8.0
@@ -101,7 +114,7 @@ static const uint32_t gaEVSPrimaryBitLen[32] = {
         0,
 };
 
-static const uint32_t gaEVSAMRWBIOLen[32] = {
+static constexpr uint32_t gaEVSAMRWBIOLen[32] = {
         17,  // 6.6
         23,  // 8.85
         32,  // 12.65
@@ -115,7 +128,7 @@ static const uint32_t gaEVSAMRWBIOLen[32] = {
         0,
 };
 
-static const uint32_t gaEVSAmrWbIoBitLen[32] = {
+static constexpr uint32_t gaEVSAmrWbIoBitLen[32] = {
         136,  // 6.6 AMR-WB IO
         184,  // 8.85 AMR-WB IO
         256,  // 12.65 AMR-WB IO
@@ -130,7 +143,7 @@ static const uint32_t gaEVSAmrWbIoBitLen[32] = {
            For such frames the Header-Full format with CMR byte shall be used*/
 };
 
-static const uint32_t gaAMRLen[16] = {
+static constexpr uint32_t gaAMRLen[16] = {
         12,  // 4.75
         13,  // 5.15
         15,  // 5.90
@@ -143,7 +156,7 @@ static const uint32_t gaAMRLen[16] = {
         0,
 };
 
-static const uint32_t gaAMRBitLen[16] = {
+static constexpr uint32_t gaAMRBitLen[16] = {
         95,   // 4.75
         103,  // 5.15
         118,  // 5.90
@@ -156,6 +169,145 @@ static const uint32_t gaAMRBitLen[16] = {
         0,
 };
 
+// the bitrates indexed by kImsAudioAmrMode, kImsAudioAmrWbMode and kImsAudioEvsMode
+static constexpr uint32_t gaAMRBitrate[] = {4750, 5150, 5900, 6700, 7400, 7950, 10200, 12200};
+static constexpr uint32_t gaAMRWBBitrate[] = {
+        6600, 8850, 12650, 14250, 15850, 18250, 19850, 23050, 23850};
+static constexpr int32_t gaEVSBitrate[] = {6600, 8850, 12650, 14250, 15850, 18250, 19850, 23050,
+        23850, 5900, 7200, 8000, 9600, 13200, 16400, 24400, 32000, 48000, 64000, 96000, 128000};
+
+// Compile time checks of the frame tables against the bit lengths of 3GPP TS 26.101 Table 1a,
+// TS 26.201 Table 1a and TS 26.445 Table A.1
+static constexpr bool checkAmrTables()
+{
+    for (uint32_t i = 0; i <= kImsAudioAmrModeSID; i++)
+    {
+        if (gaAMRLen[i] != (gaAMRBitLen[i] + 7) / 8)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < AMR_NUM_SPEECH_MODES; i++)
+    {
+        if (gaAMRBitrate[i] != gaAMRBitLen[i] * AUDIO_FRAMES_PER_SECOND)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static constexpr bool checkAmrWbTables()
+{
+    for (uint32_t i = 0; i <= kImsAudioAmrWbModeSID; i++)
+    {
+        if (gaAMRWBLen[i] != (gaAMRWBbitLen[i] + 7) / 8 || gaEVSAMRWBIOLen[i] != gaAMRWBLen[i])
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < AMRWB_NUM_SPEECH_MODES; i++)
+    {
+        // the compact AMR-WB IO frame has the 3 bits CMR and the padding to the byte boundary
+        if (gaAMRWBBitrate[i] != gaAMRWBbitLen[i] * AUDIO_FRAMES_PER_SECOND ||
+                gaEVSBitrate[i] != static_cast<int32_t>(gaAMRWBBitrate[i]) ||
+                gaEVSAmrWbIoBitLen[i] != (gaAMRWBbitLen[i] + EVS_AMRWBIO_CMR_BITS + 7) / 8 * 8)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < EVS_COMPACT_AMRWBIO_PAYLOAD_NUM; i++)
+    {
+        if (gaEVSAmrWbIoBitLen[i] != gaEVSAMRWBIOLen[i] * 8)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static constexpr bool checkEvsPrimaryTables()
+{
+    for (uint32_t i = 0; i < EVS_COMPACT_PRIMARY_PAYLOAD_NUM; i++)
+    {
+        // the header-full frame has a ToC byte in front of the compact frame
+        if (gaEVSPrimaryBitLen[i] != gaEVSPrimaryByteLen[i] * 8 ||
+                gaEVSPrimaryHeaderFullByteLen[i] != gaEVSPrimaryByteLen[i] + 1)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < EVS_NUM_FIXED_RATE_MODES; i++)
+    {
+        if (gaEVSBitrate[kImsAudioEvsPrimaryMode7200 + i] !=
+                static_cast<int32_t>(
+                        gaEVSPrimaryBitLen[EVS_PRIMARY_FIRST_FIXED + i] * AUDIO_FRAMES_PER_SECOND))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(checkAmrTables(), "AMR frame tables are not consistent");
+static_assert(checkAmrWbTables(), "AMR-WB frame tables are not consistent");
+static_assert(checkEvsPrimaryTables(), "EVS primary frame tables are not consistent");
+static_assert(sizeof(gaEVSBitrate) / sizeof(gaEVSBitrate[0]) == kImsAudioEvsPrimaryModeSID,
+        "EVS bitrate table does not cover all the modes");
+
+// Build the table of the mode indexed by the frame length, the first mode of the length wins
+template <size_t kMaxLength, size_t kNumLengths>
+static constexpr std::array<uint8_t, kMaxLength + 1> makeModeTable(
+        const uint32_t (&lengths)[kNumLengths], uint32_t numModes)
+{
+    std::array<uint8_t, kMaxLength + 1> table{};
+
+    for (auto& mode : table)
+    {
+        mode = AUDIO_MODE_NOT_FOUND;
+    }
+
+    for (uint32_t mode = numModes; mode-- > 0;)
+    {
+        table[lengths[mode]] = mode;
+    }
+
+    return table;
+}
+
+static constexpr auto gaAMRModeFromLen =
+        makeModeTable<AMR_MAX_FRAME_LEN>(gaAMRLen, kImsAudioAmrModeSID + 1);
+static constexpr auto gaAMRWBModeFromLen =
+        makeModeTable<AMRWB_MAX_FRAME_LEN>(gaAMRWBLen, kImsAudioAmrWbModeSID + 1);
+// the index of the primary lengths is the compact frame id as well
+static constexpr auto gaEVSPrimaryModeFromLen = makeModeTable<EVS_PRIMARY_MAX_FRAME_LEN>(
+        gaEVSPrimaryByteLen, EVS_COMPACT_PRIMARY_PAYLOAD_NUM);
+static constexpr auto gaEVSAMRWBIOModeFromLen =
+        makeModeTable<AMRWB_MAX_FRAME_LEN>(gaEVSAMRWBIOLen, EVS_COMPACT_AMRWBIO_PAYLOAD_NUM);
+static constexpr auto gaEVSHeaderFullModeFromLen = makeModeTable<EVS_HEADER_FULL_MAX_LEN>(
+        gaEVSPrimaryHeaderFullByteLen, EVS_COMPACT_PAYLOAD_MAX_NUM);
+
+static_assert(gaAMRModeFromLen[12] == kImsAudioAmrMode475 &&
+                gaAMRModeFromLen[31] == kImsAudioAmrMode1220,
+        "AMR mode table is not consistent");
+static_assert(gaEVSPrimaryModeFromLen[7] == 0 && gaEVSPrimaryModeFromLen[320] == 11 &&
+                gaEVSPrimaryModeFromLen[6] == 12,
+        "EVS primary mode table is not consistent");
+
+// Look up the mode table, AUDIO_MODE_NOT_FOUND when the length is out of the table
+template <size_t kSize>
+static inline uint32_t lookUpMode(const std::array<uint8_t, kSize>& table, uint32_t nLen)
+{
+    return nLen < kSize ? table[nLen] : AUDIO_MODE_NOT_FOUND;
+}
+
 int32_t ImsMediaAudioUtil::ConvertCodecType(int32_t type)
 {
     switch (type)
@@ -236,18 +388,13 @@ uint32_t ImsMediaAudioUtil::ConvertAmrModeToBitLen(uint32_t mode)
 
 uint32_t ImsMediaAudioUtil::ConvertLenToAmrMode(uint32_t nLen)
 {
-    uint32_t i;
     if (nLen == 0)
     {
         return 15;
     }
 
-    for (i = 0; i <= MAX_AMR_MODE; i++)
-    {
-        if (gaAMRLen[i] == nLen)
-            return i;
-    }
-    return 0;
+    uint32_t mode = lookUpMode(gaAMRModeFromLen, nLen);
+    return mode == AUDIO_MODE_NOT_FOUND ? 0 : mode;
 }
 
 uint32_t ImsMediaAudioUtil::ConvertAmrWbModeToLen(uint32_t mode)
@@ -270,55 +417,42 @@ uint32_t ImsMediaAudioUtil::ConvertAmrWbModeToBitLen(uint32_t mode)
 
 uint32_t ImsMediaAudioUtil::ConvertLenToAmrWbMode(uint32_t nLen)
 {
-    uint32_t i;
     if (nLen == 0)
         return kImsAudioAmrWbModeNoData;
-    for (i = 0; i <= kImsAudioAmrWbModeSID; i++)
-    {
-        if (gaAMRWBLen[i] == nLen)
-            return i;
-    }
-    return 0;
+
+    uint32_t mode = lookUpMode(gaAMRWBModeFromLen, nLen);
+    return mode == AUDIO_MODE_NOT_FOUND ? 0 : mode;
 }
 
 bool ImsMediaAudioUtil::CheckEVSPrimaryHeaderFullModeFromSize(uint32_t size)
 {
-    auto it = std::find(std::begin(gaEVSPrimaryHeaderFullByteLen),
-            std::end(gaEVSPrimaryHeaderFullByteLen), size);
-
     // Check if the Evs size is headerfull or not
-    if (it != std::end(gaEVSPrimaryHeaderFullByteLen))
-    {
-        return true;
-    }
-
-    return false;
+    return lookUpMode(gaEVSHeaderFullModeFromLen, size) != AUDIO_MODE_NOT_FOUND;
 }
+
 uint32_t ImsMediaAudioUtil::ConvertLenToEVSAudioMode(uint32_t nLen)
 {
-    uint32_t i = 0;
     if (nLen == 0)
         return kImsAudioEvsPrimaryModeNoData;
-    for (i = 0; i <= kImsAudioEvsPrimaryModeSID; i++)
+
+    uint32_t mode = lookUpMode(gaEVSPrimaryModeFromLen, nLen);
+
+    if (mode != AUDIO_MODE_NOT_FOUND)
     {
-        if (gaEVSPrimaryByteLen[i] == nLen)
-            return i;
+        return mode;
     }
+
     IMLOGD0("[ConvertLenToEVSAudioMode] No primery bit len found....");
     return 0;
 }
 
 uint32_t ImsMediaAudioUtil::ConvertLenToEVSAMRIOAudioMode(uint32_t nLen)
 {
-    uint32_t i = 0;
     if (nLen == 0)
         return kImsAudioEvsAmrWbIoModeNoData;
-    for (i = 0; i <= kImsAudioEvsAmrWbIoModeSID; i++)
-    {
-        if (gaEVSAMRWBIOLen[i] == nLen)
-            return i;
-    }
-    return 0;
+
+    uint32_t mode = lookUpMode(gaEVSAMRWBIOModeFromLen, nLen);
+    return mode == AUDIO_MODE_NOT_FOUND ? 0 : mode;
 }
 
 uint32_t ImsMediaAudioUtil::ConvertEVSAudioModeToBitLen(uint32_t mode)
@@ -341,198 +475,66 @@ uint32_t ImsMediaAudioUtil::ConvertEVSAMRIOAudioModeToBitLen(uint32_t mode)
 
 uint32_t ImsMediaAudioUtil::ConvertAmrModeToBitrate(uint32_t mode)
 {
-    switch ((kImsAudioAmrMode)mode)
-    {
-        case kImsAudioAmrMode475:
-            return 4750;
-        case kImsAudioAmrMode515:
-            return 5150;
-        case kImsAudioAmrMode590:
-            return 5900;
-        case kImsAudioAmrMode670:
-            return 6700;
-        case kImsAudioAmrMode740:
-            return 7400;
-        case kImsAudioAmrMode795:
-            return 7950;
-        case kImsAudioAmrMode1020:
-            return 10200;
-        default:
-        case kImsAudioAmrMode1220:
-            return 12200;
-    }
+    return mode < AMR_NUM_SPEECH_MODES ? gaAMRBitrate[mode] : gaAMRBitrate[kImsAudioAmrMode1220];
 }
 
 uint32_t ImsMediaAudioUtil::ConvertAmrWbModeToBitrate(uint32_t mode)
 {
-    switch ((kImsAudioAmrWbMode)mode)
-    {
-        case kImsAudioAmrWbMode660:
-            return 6600;
-        case kImsAudioAmrWbMode885:
-            return 8850;
-        case kImsAudioAmrWbMode1265:
-            return 12650;
-        case kImsAudioAmrWbMode1425:
-            return 14250;
-        case kImsAudioAmrWbMode1585:
-            return 15850;
-        case kImsAudioAmrWbMode1825:
-            return 18250;
-        case kImsAudioAmrWbMode1985:
-            return 19850;
-        case kImsAudioAmrWbMode2305:
-            return 23050;
-        default:
-        case kImsAudioAmrWbMode2385:
-            return 23850;
-    }
+    return mode < AMRWB_NUM_SPEECH_MODES ? gaAMRWBBitrate[mode]
+                                         : gaAMRWBBitrate[kImsAudioAmrWbMode2385];
 }
 
 uint32_t ImsMediaAudioUtil::GetMaximumAmrMode(int32_t bitmask)
 {
-    uint32_t maxMode = 0;
-
-    for (int32_t i = 0; i <= MAX_AMR_MODE; i++)
-    {
-        if (bitmask & (1 << i))
-        {
-            maxMode = i;
-        }
-    }
-
-    return maxMode;
+    uint32_t modes = bitmask & ((1u << (MAX_AMR_MODE + 1)) - 1);
+    return modes == 0 ? 0 : 31 - __builtin_clz(modes);
 }
 
 uint32_t ImsMediaAudioUtil::GetMaximumEvsMode(int32_t bitmask)
 {
-    uint32_t maxMode = 0;
-
-    for (int32_t i = 0; i <= MAX_EVS_MODE; i++)
-    {
-        if (bitmask & (1 << i))
-        {
-            maxMode = i;
-        }
-    }
-
-    return maxMode;
+    uint32_t modes = bitmask & ((1u << (MAX_EVS_MODE + 1)) - 1);
+    return modes == 0 ? 0 : 31 - __builtin_clz(modes);
 }
 
 int32_t ImsMediaAudioUtil::ConvertEVSModeToBitRate(const int32_t mode)
 {
-    switch ((kImsAudioEvsMode)mode)
+    if (mode < 0 || mode > kImsAudioEvsPrimaryMode128000)
     {
-        case kImsAudioEvsAmrWbIoMode660:
-            return 6600;
-        case kImsAudioEvsAmrWbIoMode885:
-            return 8850;
-        case kImsAudioEvsAmrWbIoMode1265:
-            return 12650;
-        case kImsAudioEvsAmrWbIoMode1425:
-            return 14250;
-        case kImsAudioEvsAmrWbIoMode1585:
-            return 15850;
-        case kImsAudioEvsAmrWbIoMode1825:
-            return 18250;
-        case kImsAudioEvsAmrWbIoMode1985:
-            return 19850;
-        case kImsAudioEvsAmrWbIoMode2305:
-            return 23050;
-        case kImsAudioEvsAmrWbIoMode2385:
-            return 23850;
-        case kImsAudioEvsPrimaryMode5900:
-            return 5900;
-        case kImsAudioEvsPrimaryMode7200:
-            return 7200;
-        case kImsAudioEvsPrimaryMode8000:
-            return 8000;
-        case kImsAudioEvsPrimaryMode9600:
-            return 9600;
-        case kImsAudioEvsPrimaryMode13200:
-            return 13200;
-        case kImsAudioEvsPrimaryMode16400:
-            return 16400;
-        case kImsAudioEvsPrimaryMode24400:
-            return 24400;
-        case kImsAudioEvsPrimaryMode32000:
-            return 32000;
-        case kImsAudioEvsPrimaryMode48000:
-            return 48000;
-        case kImsAudioEvsPrimaryMode64000:
-            return 64000;
-        case kImsAudioEvsPrimaryMode96000:
-            return 96000;
-        case kImsAudioEvsPrimaryMode128000:
-            return 128000;
-        default:
-            return 13200;
+        return gaEVSBitrate[kImsAudioEvsPrimaryMode13200];
     }
+
+    return gaEVSBitrate[mode];
 }
 
 kEvsCodecMode ImsMediaAudioUtil::CheckEVSCodecMode(const uint32_t nAudioFrameLength)
 {
-    switch (nAudioFrameLength)
-    {
-        // EVS AMR IO Mode Case
-        case 17:
-        case 23:
-        case 32:
-        case 36:
-        case 40:
-        case 46:
-        case 50:
-        case 58:
-        case 60:
-        case 5:
-            return kEvsCodecModeAmrIo;
-        // EVS Primary Mode Case
-        case 7:
-        case 18:
-        case 20:
-        case 24:
-        case 33:
-        case 41:
-        case 61:
-        case 80:
-        case 120:
-        case 160:
-        case 240:
-        case 320:
-        case 6:
-        default:
-            return kEvsCodecModePrimary;
-    }
+    // the AMR-WB IO lengths and the primary lengths do not overlap, the others are primary
+    return lookUpMode(gaEVSAMRWBIOModeFromLen, nAudioFrameLength) != AUDIO_MODE_NOT_FOUND
+            ? kEvsCodecModeAmrIo
+            : kEvsCodecModePrimary;
 }
 
 kRtpPyaloadHeaderMode ImsMediaAudioUtil::ConvertEVSPayloadMode(
         uint32_t nDataSize, kEvsCodecMode* pEVSCodecMode, uint32_t* pEVSCompactId)
 {
-    uint32_t i = 0;
-    uint32_t nDataBitSize = 0;
-    // nDataBitSize -= 2;
-    nDataBitSize = nDataSize * 8;  // change byte to bit size
-
     // compact format & primary mode
-    for (i = 0; i < EVS_COMPACT_PRIMARY_PAYLOAD_NUM; i++)
+    uint32_t id = lookUpMode(gaEVSPrimaryModeFromLen, nDataSize);
+
+    if (id != AUDIO_MODE_NOT_FOUND)
     {
-        if (gaEVSPrimaryBitLen[i] == nDataBitSize)
-        {
-            *pEVSCodecMode = kEvsCodecModePrimary;
-            *pEVSCompactId = i;
-            return kRtpPyaloadHeaderModeEvsCompact;
-        }
+        *pEVSCodecMode = kEvsCodecModePrimary;
+        *pEVSCompactId = id;
+        return kRtpPyaloadHeaderModeEvsCompact;
     }
 
     // compact format & amr-wb io mode
-    for (i = 0; i < EVS_COMPACT_AMRWBIO_PAYLOAD_NUM; i++)
+    id = lookUpMode(gaEVSAMRWBIOModeFromLen, nDataSize);
+
+    if (id != AUDIO_MODE_NOT_FOUND)
     {
-        if (gaEVSAmrWbIoBitLen[i] == nDataBitSize)
-        {
-            *pEVSCodecMode = kEvsCodecModeAmrIo;
-            *pEVSCompactId = i;
-            return kRtpPyaloadHeaderModeEvsCompact;
-        }
+        *pEVSCodecMode = kEvsCodecModeAmrIo;
+        *pEVSCompactId = id;
+        return kRtpPyaloadHeaderModeEvsCompact;
     }
 
     // TODO : need to check ID...
@@ -97,6 +97,7 @@ public:
 
 protected:
     BaseSessionCallback* mCallback;
+    ImsMediaMetrics* mMetrics;
     bool mFirstFrameReceived;
     uint32_t mSsrc;
     uint32_t mCodecType;
@@ -20,17 +20,22 @@
 #include <BaseSessionCallback.h>
 #include <RtpConfig.h>
 #include <MediaQualityThreshold.h>
+#include <SessionLatencyStats.h>
+#include <ImsMediaMetrics.h>
 #include <stdint.h>
 
 class BaseSession : public BaseSessionCallback
 {
 public:
-    BaseSession();
+    BaseSession(ImsMediaType mediaType);
     virtual ~BaseSession();
 
-    /** Set the session id */
+    /** Set the session id and register the metrics of the session */
     void setSessionId(const int32_t sessionId);
 
+    /** Get the session id */
+    virtual int32_t getSessionId();
+
     /** Set the local socket file descriptor for rtp and rtcp */
     void setLocalEndPoint(const int32_t rtpFd, const int32_t rtcpFd);
 
@@ -55,6 +60,33 @@ public:
      */
     void setMediaQualityThreshold(const MediaQualityThreshold& threshold);
 
+    /** Get the latency histograms of the session to be updated by the nodes */
+    virtual SessionLatencyStats* getLatencyStats();
+
+    /**
+     * @brief Get the snapshot of the processing time histogram of the node type in microseconds
+     *
+     * @param nodeId The node type to get
+     * @param type The processing stage of the node, check #kNodeLatencyType
+     * @param snapshot The snapshot to fill
+     */
+    void getNodeLatency(
+            kBaseNodeId nodeId, kNodeLatencyType type, ImsMediaHistogramSnapshot& snapshot);
+
+    /**
+     * @brief Get the snapshot of the latency histogram of the received packets in microseconds
+     *
+     * @param type The section of the receiving path, check #kPathLatencyType
+     * @param snapshot The snapshot to fill
+     */
+    void getPathLatency(kPathLatencyType type, ImsMediaHistogramSnapshot& snapshot);
+
+    /** Clear all the latency histograms of the session */
+    void resetLatencyStats();
+
+    /** Get the metrics of the session to be updated by the nodes */
+    virtual ImsMediaMetrics* getMetrics();
+
 protected:
     /**
      * @brief get the stream state
@@ -76,6 +108,9 @@ protected:
     int mRtcpFd;
     MediaQualityThreshold mThreshold;
     int mState;
+    SessionLatencyStats mLatencyStats;
+    ImsMediaType mMediaType;
+    ImsMediaMetrics* mMetrics;
 };
 
 #endif
\ No newline at end of file
@@ -19,6 +19,10 @@
 
 #include <ImsMediaDefine.h>
 
+class SessionLatencyStats;
+class ImsMediaMetrics;
+class MediaQualityAnalyzer;
+
 struct SessionCallbackParameter
 {
 public:
@@ -43,6 +47,29 @@ public:
         onEvent(type, param1, param2);
     }
 
+    /**
+     * @brief Get the id of the session, it is -1 when the callback is not a session
+     */
+    virtual int32_t getSessionId() { return -1; }
+
+    /**
+     * @brief Get the latency histograms of the session, it is nullptr when the callback is not a
+     * session
+     */
+    virtual SessionLatencyStats* getLatencyStats() { return nullptr; }
+
+    /**
+     * @brief Get the metrics of the stream registered in ImsMediaMetricsRegistry, it is nullptr
+     * when the callback is not a session or the session id is not set
+     */
+    virtual ImsMediaMetrics* getMetrics() { return nullptr; }
+
+    /**
+     * @brief Get the analyzer to collect the rtp packet statistics without the event dispatch, it
+     * is nullptr when the callback is not an audio session
+     */
+    virtual MediaQualityAnalyzer* getMediaQualityAnalyzer() { return nullptr; }
+
 protected:
     virtual void onEvent(int32_t type, uint64_t param1, uint64_t param2) = 0;
 };
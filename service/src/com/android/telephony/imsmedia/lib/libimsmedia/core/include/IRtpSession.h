@@ -105,6 +105,12 @@ public:
     void StopRtcp();
     bool SendRtpPacket(uint32_t payloadType, uint8_t* data, uint32_t dataSize, uint32_t timestamp,
             bool mark, uint32_t nTimeDiff, RtpHeaderExtensionInfo* extensionInfo = nullptr);
+    /**
+     * @brief Sends the payloads sharing one timestamp, such as the fragments of a video frame, in
+     * one call of the RtpStack. The extension is added to the slices with bExtension set.
+     */
+    bool SendRtpPackets(uint32_t payloadType, tRTP_PAYLOAD_SLICE* slices, uint32_t numSlices,
+            uint32_t timestamp, RtpHeaderExtensionInfo* extensionInfo = nullptr);
     bool ProcRtpPacket(uint8_t* pData, uint32_t nDataSize);
     bool ProcRtcpPacket(uint8_t* pData, uint32_t nDataSize);
     void OnTimer();
@@ -126,6 +132,9 @@ public:
     virtual void OnPeerRtcpComponents(void* nMsg);
 
 private:
+    void SetSendRtpPacketParam(tRtpSvc_SendRtpPacketParam& param, uint32_t payloadType,
+            uint32_t timestamp, uint32_t timeDiff, RtpHeaderExtensionInfo* extensionInfo);
+
     static std::list<IRtpSession*> mListRtpSession;
     ImsMediaType mMediaType;
     RTPSESSIONID mRtpSessionId;
@@ -53,6 +53,10 @@ enum kImsMediaEventType
     kImsMediaEventNotifyVideoDataUsage,
     kImsMediaEventNotifyRttReceived,
     kImsMediaEventNotifyVideoLowestBitrate,
+    // the quantile sketch of the call, param1 is the byte array of the kQualitySketchType in the
+    // first byte followed by the sketch written by ImsMediaQuantileSketch::Serialize and param2
+    // is the size of the array
+    kImsMediaEventCallQualitySketch,
 };
 
 // Internal Request Event
@@ -76,6 +80,8 @@ enum kImsMediaInternalRequestType
     kCollectJitterBufferSize,
     kGetRtcpXrReportBlock,
     kRequestSendRtcpXrReport,
+    // the fraction lost of the received rtcp report block in param1
+    kRequestAudioFractionLostUpdate,
 };
 
 enum kImsMediaErrorNotify
@@ -297,6 +303,8 @@ enum ImsMediaAudioMsgRequest
     kAudioSendDtmf,
     kAudioSendRtpHeaderExtension,
     kAudioSetMediaQualityThreshold,
+    // 110 and 111 are the dtmf commands handled in the framework session
+    kAudioSetPtime = 112,
 };
 
 enum ImsMediaAudioMsgResponse
@@ -313,6 +321,7 @@ enum ImsMediaAudioMsgResponse
     kAudioDtmfReceivedInd,
     kAudioCallQualityChangedInd,
     kAudioSessionClosed,
+    kAudioCallQualitySketchInd,
 };
 
 enum ImsMediaVideoMsgRequest
@@ -367,34 +376,6 @@ enum ImsMediaTextMsgResponse
 #define MAX_RTT_LEN                                (RTT_MAX_CHAR_PER_SEC * RTT_MAX_UNICODE_UTF8)
 #define PAYLOADENCODER_TEXT_MAX_REDUNDANT_INTERVAL (16383)
 
-struct EventParamOpenSession
-{
-public:
-    void* mConfig;
-    int rtpFd;
-    int rtcpFd;
-    EventParamOpenSession(
-            int rtp = UNDEFINED_SOCKET_FD, int rtcp = UNDEFINED_SOCKET_FD, void* config = nullptr) :
-            mConfig(config),
-            rtpFd(rtp),
-            rtcpFd(rtcp)
-    {
-    }
-};
-
-struct EventParamDtmf
-{
-public:
-    char digit;
-    int duration;
-
-    EventParamDtmf(char dig, int d)
-    {
-        digit = dig;
-        duration = d;
-    }
-};
-
 enum kAudioCodecType
 {
     kAudioCodecNone = 0,
@@ -558,6 +539,10 @@ public:
     uint32_t option;
 };
 
+/**
+ * @brief The view of the rtp header extension payload to pass to or from the RtpStack. It does not
+ * own the extension data, the data is valid only while the buffer it refers to is alive.
+ */
 struct RtpHeaderExtensionInfo
 {
 public:
@@ -575,59 +560,12 @@ public:
     uint16_t extensionDataSize;
 
     RtpHeaderExtensionInfo(
-            uint16_t profile = 0, uint16_t len = 0, int8_t* data = nullptr, uint16_t size = 0)
-    {
-        definedByProfile = profile;
-        length = len;
-        extensionData = nullptr;
-        extensionDataSize = 0;
-        setExtensionData(data, size);
-    }
-
-    RtpHeaderExtensionInfo(const RtpHeaderExtensionInfo& extension)
-    {
-        definedByProfile = extension.definedByProfile;
-        extensionData = nullptr;
-        length = extension.length;
-        setExtensionData(extension.extensionData, extension.extensionDataSize);
-    }
-
-    ~RtpHeaderExtensionInfo()
-    {
-        if (extensionData != nullptr)
-        {
-            delete[] extensionData;
-            extensionData = nullptr;
-        }
-    }
-
-    RtpHeaderExtensionInfo& operator=(const RtpHeaderExtensionInfo& extension)
+            uint16_t profile = 0, uint16_t len = 0, int8_t* data = nullptr, uint16_t size = 0) :
+            definedByProfile(profile),
+            length(len),
+            extensionData(data),
+            extensionDataSize(data != nullptr ? size : 0)
     {
-        if (this != &extension)
-        {
-            definedByProfile = extension.definedByProfile;
-            length = extension.length;
-            setExtensionData(extension.extensionData, extension.extensionDataSize);
-        }
-
-        return *this;
-    }
-
-    void setExtensionData(int8_t* data, uint16_t dataSize)
-    {
-        if (extensionData != nullptr)
-        {
-            delete[] extensionData;
-            extensionData = nullptr;
-            extensionDataSize = 0;
-        }
-
-        if (data != nullptr)
-        {
-            extensionDataSize = dataSize;
-            extensionData = new int8_t[extensionDataSize];
-            memcpy(extensionData, data, extensionDataSize);
-        }
     }
 };
 
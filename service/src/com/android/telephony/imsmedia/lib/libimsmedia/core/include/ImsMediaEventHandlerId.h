@@ -0,0 +1,39 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMS_MEDIA_EVENT_HANDLER_ID_H
+#define IMS_MEDIA_EVENT_HANDLER_ID_H
+
+#include <ImsMediaEventHandler.h>
+
+#define AUDIO_REQUEST_EVENT  "AUDIO_REQUEST_EVENT"
+#define AUDIO_RESPONSE_EVENT "AUDIO_RESPONSE_EVENT"
+#define VIDEO_REQUEST_EVENT  "VIDEO_REQUEST_EVENT"
+#define VIDEO_RESPONSE_EVENT "VIDEO_RESPONSE_EVENT"
+#define TEXT_REQUEST_EVENT   "TEXT_REQUEST_EVENT"
+#define TEXT_RESPONSE_EVENT  "TEXT_RESPONSE_EVENT"
+
+/** The ids of the request and response handlers of the managers, reserved for their names in
+ * the order so the senders use them without resolving the names */
+inline constexpr int32_t kAudioRequestHandler = 0;
+inline constexpr int32_t kAudioResponseHandler = 1;
+inline constexpr int32_t kVideoRequestHandler = 2;
+inline constexpr int32_t kVideoResponseHandler = 3;
+inline constexpr int32_t kTextRequestHandler = 4;
+inline constexpr int32_t kTextResponseHandler = 5;
+inline constexpr int32_t kReservedHandlerMax = 6;
+
+#endif
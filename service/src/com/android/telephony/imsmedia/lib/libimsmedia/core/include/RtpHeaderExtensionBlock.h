@@ -0,0 +1,138 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTP_HEADER_EXTENSION_BLOCK_H
+#define RTP_HEADER_EXTENSION_BLOCK_H
+
+#include <ImsMediaDefine.h>
+#include <RtpHeaderExtension.h>
+#include <stdint.h>
+#include <list>
+
+#define RTP_HEADER_EXTENSION_MAX_ELEMENTS   16
+#define RTP_HEADER_EXTENSION_MAX_BLOCK_SIZE 256
+
+/**
+ * @brief A view of a single RFC 8285 header extension element. The data points to the memory of
+ * the RtpHeaderExtensionBlock it was taken from and is valid only while the block is alive and
+ * unmodified.
+ */
+struct RtpHeaderExtensionElement
+{
+    uint8_t localIdentifier;
+    uint8_t dataSize;
+    const uint8_t* data;
+};
+
+/**
+ * @brief Fixed capacity container of the RFC 8285 one-byte and two-byte header extension
+ * elements. The serialized extension payload, including the word padding, is stored inline so the
+ * block can be parsed, built, copied and handed to the RtpStack without any heap allocation.
+ */
+class RtpHeaderExtensionBlock
+{
+public:
+    RtpHeaderExtensionBlock();
+    ~RtpHeaderExtensionBlock();
+
+    /**
+     * @brief Clear all the elements and the serialized payload
+     */
+    void Clear();
+
+    /**
+     * @brief Parse the extension payload of the received rtp packet. The payload is copied once to
+     * the inline buffer and the elements refer to it.
+     *
+     * @param definedByProfile The 16 bits profile field of the rtp header extension
+     * @param data The extension payload following the profile and length field
+     * @param size The size of the payload in byte
+     * @return true when at least one element is parsed, false when the profile is not RFC 8285 or
+     * the payload is malformed
+     */
+    bool Parse(uint16_t definedByProfile, const uint8_t* data, uint32_t size);
+
+    /**
+     * @brief Append an element to the block. The block switches to the two-byte header form when
+     * the local identifier is out of 1 - 14 or the data size is out of 1 - 16 bytes.
+     *
+     * @return false when the block does not have room for the element
+     */
+    bool Add(uint8_t localIdentifier, const uint8_t* data, uint8_t dataSize);
+
+    /**
+     * @brief Build the block from the list of RtpHeaderExtension received from the client
+     */
+    bool Add(std::list<RtpHeaderExtension>* listExtension);
+
+    uint32_t GetCount() const { return mCount; }
+    bool IsEmpty() const { return mCount == 0; }
+    bool IsTwoByteHeader() const { return mTwoByteHeader; }
+
+    /**
+     * @brief Get the element view of the given index, the index should be less than GetCount()
+     */
+    RtpHeaderExtensionElement GetElement(uint32_t index) const;
+
+    /**
+     * @brief Find the first element of the given local identifier
+     *
+     * @return true when the element is found and element is filled
+     */
+    bool Find(uint8_t localIdentifier, RtpHeaderExtensionElement& element) const;
+
+    /**
+     * @brief Get the profile field to set in the rtp header extension
+     */
+    uint16_t GetDefinedByProfile() const;
+
+    /**
+     * @brief Get the serialized payload size including the padding in byte
+     */
+    uint16_t GetDataSize() const;
+
+    const uint8_t* GetData() const { return mBuffer; }
+
+    /**
+     * @brief Get the view of the serialized payload to pass to the IRtpSession. The returned
+     * info refers to the inline buffer of this block.
+     */
+    RtpHeaderExtensionInfo GetInfo() const;
+
+    /**
+     * @brief Write the number of elements and each element in the parcel format of the
+     * RtpHeaderExtension without creating RtpHeaderExtension instances
+     */
+    status_t WriteToParcel(android::Parcel* parcel) const;
+
+private:
+    bool convertToTwoByteHeader();
+
+    struct ElementPosition
+    {
+        uint8_t localIdentifier;
+        uint8_t dataSize;
+        uint16_t offset;
+    };
+
+    uint8_t mBuffer[RTP_HEADER_EXTENSION_MAX_BLOCK_SIZE];
+    ElementPosition mElements[RTP_HEADER_EXTENSION_MAX_ELEMENTS];
+    uint32_t mCount;
+    uint32_t mSize;  // serialized size without the padding
+    bool mTwoByteHeader;
+};
+
+#endif
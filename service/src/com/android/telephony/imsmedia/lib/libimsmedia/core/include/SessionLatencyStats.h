@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SESSION_LATENCY_STATS_H
+#define SESSION_LATENCY_STATS_H
+
+#include <BaseNode.h>
+#include <ImsMediaHistogram.h>
+#include <atomic>
+
+enum kPathLatencyType
+{
+    // from the packet read in SocketReaderNode to the packet added to the jitter buffer
+    kPathLatencySocketToJitterBuffer,
+    // from the packet added to the jitter buffer to the packet removed from the jitter buffer
+    kPathLatencyJitterBufferDwell,
+    // from the frame removed from the jitter buffer to the frame delivered to the player
+    kPathLatencyJitterBufferToPlayer,
+    kPathLatencyMax,
+};
+
+/**
+ * @brief The latency histograms of a session in microseconds unit. The node latencies are counted
+ * per node type, so the nodes of the same type in the graphs of the session share the histogram.
+ * The latencies are only measured while the collection is enabled with SetEnabled.
+ */
+class SessionLatencyStats
+{
+public:
+    static inline bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Enable or disable the latency collection of all sessions. The histograms collected
+     * before are kept until Reset.
+     */
+    static void SetEnabled(bool enabled);
+
+    void AddNodeLatency(kBaseNodeId nodeId, kNodeLatencyType type, uint64_t latencyUs)
+    {
+        if (nodeId < kNodeIdMax && type < kNodeLatencyMax)
+        {
+            mNodeLatency[nodeId][type].Add(latencyUs);
+        }
+    }
+
+    void AddPathLatency(kPathLatencyType type, uint64_t latencyUs)
+    {
+        if (type < kPathLatencyMax)
+        {
+            mPathLatency[type].Add(latencyUs);
+        }
+    }
+
+    void GetNodeLatency(kBaseNodeId nodeId, kNodeLatencyType type,
+            ImsMediaHistogramSnapshot& snapshot) const
+    {
+        if (nodeId < kNodeIdMax && type < kNodeLatencyMax)
+        {
+            mNodeLatency[nodeId][type].GetSnapshot(snapshot);
+        }
+    }
+
+    void GetPathLatency(kPathLatencyType type, ImsMediaHistogramSnapshot& snapshot) const
+    {
+        if (type < kPathLatencyMax)
+        {
+            mPathLatency[type].GetSnapshot(snapshot);
+        }
+    }
+
+    void Reset()
+    {
+        for (auto& node : mNodeLatency)
+        {
+            for (auto& histogram : node)
+            {
+                histogram.Reset();
+            }
+        }
+
+        for (auto& histogram : mPathLatency)
+        {
+            histogram.Reset();
+        }
+    }
+
+private:
+    static std::atomic<bool> sEnabled;
+    ImsMediaHistogram mNodeLatency[kNodeIdMax][kNodeLatencyMax];
+    ImsMediaHistogram mPathLatency[kPathLatencyMax];
+};
+
+#endif
@@ -20,11 +20,14 @@
 #include <BaseJitterBuffer.h>
 #include <JitterNetworkAnalyser.h>
 
+class MediaQualityAnalyzer;
+
 class AudioJitterBuffer : public BaseJitterBuffer
 {
 public:
     AudioJitterBuffer();
     virtual ~AudioJitterBuffer();
+    virtual void SetSessionCallback(BaseSessionCallback* callback);
     virtual void Reset();
     virtual void ClearBuffer();
     virtual void SetJitterBufferSize(uint32_t nInit, uint32_t nMin, uint32_t nMax);
@@ -99,6 +102,8 @@ private:
     DataEntry* mPreservedDtx;
     int32_t mEvsRedundantFrameOffset;
     uint32_t mPrevGetTime;
+    /** The analyzer of the session to collect the packet statistics without the event dispatch */
+    MediaQualityAnalyzer* mMediaQualityAnalyzer;
 };
 
 #endif
\ No newline at end of file
@@ -38,8 +38,8 @@ public:
     class RequestHandler : public ImsMediaEventHandler
     {
     protected:
-        virtual void processEvent(
-                uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB);
+        virtual void processEvent(uint32_t event, uint64_t sessionId, uint64_t paramA,
+                uint64_t paramB, ImsMediaEventPayload& payload);
     };
 
     /**
@@ -48,8 +48,8 @@ public:
     class ResponseHandler : public ImsMediaEventHandler
     {
     protected:
-        virtual void processEvent(
-                uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB);
+        virtual void processEvent(uint32_t event, uint64_t sessionId, uint64_t paramA,
+                uint64_t paramB, ImsMediaEventPayload& payload);
     };
 
     static AudioManager* getInstance();
@@ -66,6 +66,7 @@ protected:
     virtual ImsMediaResult deleteConfig(int sessionId, AudioConfig* config);
     ImsMediaResult confirmConfig(int sessionId, AudioConfig* config);
     virtual void sendDtmf(int sessionId, char dtmfDigit, int duration);
+    virtual void setPtime(int sessionId, uint32_t ptime);
     virtual void sendRtpHeaderExtension(
             int sessionId, std::list<RtpHeaderExtension>* listExtension);
     virtual void setMediaQualityThreshold(int sessionId, MediaQualityThreshold* threshold);
@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_PTIME_ADAPTER_H
+#define AUDIO_PTIME_ADAPTER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Decides the ptime of the audio tx stream within the negotiated ptime and maxptime. The
+ * ptime is increased by a frame per packet when the rtcp report shows the congestion, the high
+ * fraction lost or the long round trip time, to lower the packet rate, and decreased back to the
+ * negotiated ptime when the network recovers. The ptime given by SetPtime() overrides the
+ * adaptation until it is resumed.
+ */
+class AudioPtimeAdapter
+{
+public:
+    AudioPtimeAdapter();
+    ~AudioPtimeAdapter();
+
+    /**
+     * @brief Set the negotiated ptime and maxptime and restart the adaptation from the ptime
+     *
+     * @param ptime The negotiated ptime in milliseconds
+     * @param maxPtime The negotiated maxptime in milliseconds, the ptime is not adapted when it
+     * is not larger than the ptime
+     */
+    void SetConfig(uint32_t ptime, uint32_t maxPtime);
+
+    /**
+     * @brief Fix the ptime to the given value rounded to the frame duration and limited to the
+     * maxptime, or resume the adaptation from the negotiated ptime
+     *
+     * @param ptime The ptime in milliseconds, 0 to resume the adaptation
+     * @return uint32_t The ptime to apply
+     */
+    uint32_t SetPtime(uint32_t ptime);
+
+    /**
+     * @brief Update the round trip time, it is checked with the next rtcp report
+     *
+     * @param roundTripTime The round trip time in milliseconds
+     */
+    void OnRoundTripTime(uint32_t roundTripTime);
+
+    /**
+     * @brief Check the received rtcp report and adapt the ptime
+     *
+     * @param fractionLost The 8 bits fraction lost of the report block of RFC 3550 6.4.1
+     * @return uint32_t The ptime to apply
+     */
+    uint32_t OnFractionLost(uint32_t fractionLost);
+
+    uint32_t GetPtime() const { return mPtime; }
+    bool IsAdaptive() const { return mAdaptive; }
+
+private:
+    uint32_t mNegotiatedPtime;
+    uint32_t mMaxPtime;
+    uint32_t mPtime;
+    uint32_t mRoundTripTime;
+    uint32_t mNumGoodReports;
+    bool mAdaptive;
+};
+
+#endif
@@ -80,6 +80,14 @@ public:
      */
     void sendDtmf(char digit, int duration);
 
+    /**
+     * @brief Change the ptime of the running tx streams within the negotiated maxptime without
+     * the renegotiation. The fixed ptime stops the adaptation to the rtcp reports.
+     *
+     * @param ptime The ptime in milliseconds, 0 to adapt the ptime to the rtcp reports again
+     */
+    void setPtime(const uint32_t ptime);
+
     /**
      * @brief Send internal event to process in the stream graph
      *
@@ -111,6 +119,9 @@ public:
      */
     void sendRtpHeaderExtension(std::list<RtpHeaderExtension>* listExtension);
 
+    /** Get the analyzer to be updated by the jitter buffer and the rtp encoder directly */
+    virtual MediaQualityAnalyzer* getMediaQualityAnalyzer();
+
 private:
     std::list<AudioStreamGraphRtpTx*> mListGraphRtpTx;
     std::list<AudioStreamGraphRtpRx*> mListGraphRtpRx;
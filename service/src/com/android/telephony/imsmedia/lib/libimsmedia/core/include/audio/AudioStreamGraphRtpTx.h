@@ -19,6 +19,7 @@
 
 #include <ImsMediaDefine.h>
 #include <AudioStreamGraph.h>
+#include <AudioPtimeAdapter.h>
 #include <RtpHeaderExtension.h>
 
 class AudioStreamGraphRtpTx : public AudioStreamGraph
@@ -66,8 +67,40 @@ public:
      */
     void sendRtpHeaderExtension(std::list<RtpHeaderExtension>* listExtension);
 
+    /**
+     * @brief Change the ptime of the stream within the negotiated maxptime without the
+     * renegotiation. The fixed ptime stops the adaptation to the rtcp reports.
+     *
+     * @param ptime The ptime in milliseconds, 0 to adapt the ptime to the rtcp reports again
+     */
+    void setPtime(const uint32_t ptime);
+
+    /**
+     * @brief Adapt the ptime to the fraction lost of the received rtcp report
+     *
+     * @param fractionLost The 8 bits fraction lost of the report block
+     */
+    void processFractionLost(const uint32_t fractionLost);
+
+    /**
+     * @brief Update the round trip time checked with the next rtcp report
+     *
+     * @param roundTripTime The round trip time in milliseconds
+     */
+    void processRoundTripTime(const uint32_t roundTripTime);
+
+    /**
+     * @brief Get the ptime the payload encoder bundles the frames with
+     *
+     * @return uint32_t The ptime in milliseconds, 0 when the graph is not created
+     */
+    uint32_t getPtime();
+
 private:
+    void applyPtime(const uint32_t ptime);
+
     std::list<BaseNode*> mListDtmfNodes;
+    AudioPtimeAdapter mPtimeAdapter;
 };
 
 #endif
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include <IImsMediaThread.h>
 #include <ImsMediaCondition.h>
 #include <RtcpXrEncoder.h>
+#include <RtpPacketRecordRing.h>
+#include <ImsMediaQuantileSketch.h>
 #include <BaseSessionCallback.h>
 #include <AudioConfig.h>
 #include <MediaQualityThreshold.h>
@@ -31,6 +33,17 @@
 #include <mutex>
 #include <algorithm>
 
+enum kQualitySketchType
+{
+    /** The playout delay of the rx rtp packets in milliseconds */
+    kQualitySketchPlayoutDelay = 0,
+    /** The relative jitter of the rx rtp packets in milliseconds */
+    kQualitySketchJitter,
+    /** The interval between the arrivals of the rx rtp packets in milliseconds */
+    kQualitySketchInterArrival,
+    kQualitySketchMax,
+};
+
 class HysteresisTimeChecker
 {
 public:
@@ -151,9 +164,10 @@ public:
      * @brief Collect information of sending or receiving the rtp or the rtcp packet datas.
      *
      * @param streamType The stream type. Tx, Rx, Rtcp.
-     * @param packet The packet data struct.
+     * @param packet The packet data struct, it is copied to the packet record ring of the rx rtp
+     * and the caller keeps the ownership.
      */
-    void collectInfo(const int32_t streamType, RtpPacket* packet);
+    void collectInfo(const int32_t streamType, const RtpPacket* packet);
 
     /**
      * @brief Collect optional information of sending or receiving the rtp or rtcp packet datas.
@@ -182,7 +196,9 @@ public:
     void collectJitterBufferSize(const int32_t currSize, const int32_t maxSize);
 
     /**
-     * @brief generate  Rtcp-Xr report blocks with given report block enabled in bitmask type
+     * @brief generate  Rtcp-Xr report blocks with given report block enabled in bitmask type. The
+     * report blocks are encoded from the statistics accumulated since the last report, so the
+     * caller can pass a buffer on its stack of MAX_BLOCK_LENGTH bytes.
      *
      * @param nReportBlocks The bitmask of report block to creates
      * @param data The byte array of total report blocks
@@ -197,6 +213,16 @@ public:
      */
     CallQuality getCallQuality();
 
+    /**
+     * @brief Copy the quantile sketch of the call. The sketches of the calls can be merged and
+     * serialized to aggregate them out of the device.
+     *
+     * @param type The type of the sketch, check kQualitySketchType
+     * @param sketch The sketch to copy to
+     * @return false when the type is not valid
+     */
+    bool getQualitySketch(const kQualitySketchType type, ImsMediaQuantileSketch& sketch);
+
     /**
      * @brief Get number of rx packets in the list
      */
@@ -212,6 +238,29 @@ public:
      */
     uint32_t getLostPacketSize();
 
+    /**
+     * @brief Collect the received rtp packet in the thread of the caller without the event
+     * dispatch. It is called by the jitter buffer for every received packet.
+     */
+    void reportRxRtpPacket(const RtpPacket& packet);
+
+    /**
+     * @brief Count the sent rtp packet in the thread of the caller without the event dispatch
+     */
+    void reportTxRtpPacket();
+
+    /**
+     * @brief Collect the rtp status determined from the jitter buffer in the thread of the caller
+     * without the event dispatch, check #collectRxRtpStatus
+     */
+    void reportRxRtpStatus(const int32_t seq, const kRtpPacketStatus status, const uint32_t time);
+
+    /**
+     * @brief Collect the optional information in the thread of the caller without the event
+     * dispatch, check #collectOptionalInfo
+     */
+    void reportOptionalInfo(const int32_t optionType, const int32_t seq, const int32_t value);
+
     /**
      * @brief Send message event to event handler
      *
@@ -230,24 +279,36 @@ protected:
     void processData(const int32_t timeCount);
     void processMediaQuality();
     void notifyCallQuality();
+    void updateQualityPercentiles();
+
+    /**
+     * @brief Send the serialized quantile sketches of the call to aggregate them out of the
+     * device, the empty sketches are not sent
+     */
+    void notifyQualitySketches();
     void notifyMediaQualityStatus();
     void AddEvent(uint32_t event, uint64_t paramA, uint64_t paramB);
     void processEvent(uint32_t event, uint64_t paramA, uint64_t paramB);
+
+    /**
+     * @brief Generate the Rtcp-Xr report blocks, the caller should hold the mEventMutex. Check
+     * #getRtcpXrReportBlock
+     */
+    bool generateRtcpXrReportBlock(const uint32_t nReportBlocks, uint8_t* data, uint32_t& size);
     virtual void* run();
     void reset();
-    void clearPacketList(std::list<RtpPacket*>& list, const int32_t seq);
     void clearLostPacketList(const int32_t seq);
     uint32_t getCallQuality(double lossRate);
     int32_t convertAudioCodecType(const int32_t codec, const int32_t bandwidth);
 
     BaseSessionCallback* mCallback;
     std::unique_ptr<RtcpXrEncoder> mRtcpXrEncoder;
-    /** The list of the packets received ordered by arrival time */
-    std::list<RtpPacket*> mListRxPacket;
+    /** The statistics of the packets received indexed by the sequence number */
+    RtpPacketRecordRing mRxPacketRecords;
     /** The list of the lost packets object */
     std::list<LostPacket*> mListLostPacket;
-    /** The list of the packets sent */
-    std::list<RtpPacket*> mListTxPacket;
+    /** The number of the packets sent since the last Rtcp-Xr report */
+    uint32_t mNumTxPacket;
     /** The time of call started in milliseconds unit*/
     int32_t mTimeStarted;
     /** The ssrc of the receiving Rtp stream to identify */
@@ -280,6 +341,10 @@ protected:
     uint32_t mCallQualityNumRxPacket;
     /** The number of lost rx packet for call quality calculation */
     uint32_t mCallQualityNumLostPacket;
+    /** The percentile sketches of the call for call quality, check kQualitySketchType */
+    ImsMediaQuantileSketch mQualitySketches[kQualitySketchMax];
+    /** The arrival time of the last rx rtp packet in milliseconds unit */
+    int32_t mLastRxArrival;
 
     // MediaQualityThreshold parameters
     std::vector<int32_t> mBaseRtpInactivityTimes;
@@ -314,6 +379,7 @@ protected:
     std::list<uint32_t> mListevent;
     std::list<uint64_t> mListParamA;
     std::list<uint64_t> mListParamB;
+    /** It guards the event list and the statistics updated by the report methods */
     std::mutex mEventMutex;
     ImsMediaCondition mConditionExit;
 };
@@ -19,7 +19,7 @@
 
 #include <ImsMediaDefine.h>
 #include <ImsMediaBitWriter.h>
-#include <list>
+#include <cmath>
 #include <vector>
 
 #define MAX_BLOCK_LENGTH          220
@@ -144,6 +144,51 @@ struct tVoIPMatricReport
     uint32_t jitterBufferAbsMaximum;
 };
 
+/**
+ * @brief Streaming minimum, maximum, mean and deviation of the values. The mean and the variance
+ * are updated with the Welford's method to keep them stable without storing the values.
+ */
+struct tRunningStats
+{
+    tRunningStats() { reset(); }
+
+    void reset()
+    {
+        count = 0;
+        min = 0;
+        max = 0;
+        mean = 0;
+        m2 = 0;
+    }
+
+    void add(const int32_t value)
+    {
+        if (count == 0 || value < min)
+        {
+            min = value;
+        }
+
+        if (count == 0 || value > max)
+        {
+            max = value;
+        }
+
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    double getDeviation() const { return count == 0 ? 0 : sqrt(m2 / count); }
+
+    uint32_t count;
+    int32_t min;
+    int32_t max;
+    double mean;
+    /** The sum of the squared differences from the mean */
+    double m2;
+};
+
 class RtcpXrEncoder
 {
 public:
@@ -166,13 +211,17 @@ public:
     void setRoundTripDelay(const uint32_t delay);
 
     /**
-     * @brief Stack receiving rtp status
+     * @brief Stack receiving rtp status. The statistics summary of the report interval is updated
+     * with the status and its sequence number range is extended to the given sequence number.
      *
+     * @param seq The rtp sequence number of the audio frame
      * @param status The status of the audio frame how it is processed in jitter buffer
      * @param delay The delay of the audio frame from stacked in jitter buffer to play to the audio
      * codec
+     * @param jitter The transit time difference of the received packet in milliseconds unit
      */
-    void stackRxRtpStatus(const int32_t status, const uint32_t delay);
+    void stackRxRtpStatus(const uint16_t seq, const int32_t status, const uint32_t delay,
+            const int32_t jitter = 0);
 
     /**
      * @brief Set the jitter buffer size
@@ -183,37 +232,29 @@ public:
     void setJitterBufferStatus(const uint32_t current, const uint32_t max);
 
     /**
-     * @brief Create a rtcp-xr report blocks
+     * @brief Create a rtcp-xr report blocks from the statistics stacked in the report interval and
+     * start the next interval. The statistics summary report block carries the lowest and the
+     * highest sequence number stacked in the interval.
      *
      * @param nRtcpXrReport The bitmask of the enabled report block types
-     * @param packets The list of the packets received to use in statistic summary report block
-     * @param lostPackets The list of the lost packet counted to use in statistic summary report
-     * block
-     * @param beginSeq The beginning of the rtp sequence number to generate statistics summery
-     * report block
-     * @param endSeq The end of the rtp sequence number to generate statistics summery report block
      * @param data The data buffer to store the report block
      * @param size The size of the data buffer to stored
      * @return true The report block generated without error
      * @return false The bitmask of the report block types are zero or data buffer is null
      */
-    bool createRtcpXrReport(const uint32_t nRtcpXrReport, std::list<RtpPacket*>* packets,
-            std::list<LostPacket*>* lostPackets, uint16_t beginSeq, uint16_t endSeq, uint8_t* data,
-            uint32_t& size);
+    bool createRtcpXrReport(const uint32_t nRtcpXrReport, uint8_t* data, uint32_t& size);
 
 private:
-    tLossReport* createLossAnalysisReport(std::list<RtpPacket*>* packets,
-            std::list<LostPacket*>* lostPackets, uint16_t beginSeq, uint16_t endSeq);
-    tJitterReport* createJitterAnalysisReport(
-            std::list<RtpPacket*>* packets, uint16_t beginSeq, uint16_t endSeq);
-    tTTLReport* createTTLAnalysisReport(
-            std::list<RtpPacket*>* packets, uint16_t beginSeq, uint16_t endSeq);
-    tDuplicateReport* createDuplicateAnalysisReport(
-            std::list<RtpPacket*>* packets, uint16_t beginSeq, uint16_t endSeq);
-    tVoIPMatricReport* createVoIPMatricReport();
+    void createLossAnalysisReport(uint16_t beginSeq, uint16_t endSeq, tLossReport& report);
+    void createJitterAnalysisReport(uint16_t beginSeq, uint16_t endSeq, tJitterReport& report);
+    void createTTLAnalysisReport(uint16_t beginSeq, uint16_t endSeq, tTTLReport& report);
+    void createDuplicateAnalysisReport(
+            uint16_t beginSeq, uint16_t endSeq, tDuplicateReport& report);
+    void createVoIPMatricReport(tVoIPMatricReport& report);
     void encodeStatisticSummeryReport(tLossReport* lossReport, tJitterReport* jitterReport,
             tTTLReport* ttlReport, tDuplicateReport* duplicateReport, uint8_t* data);
     void encodeVoipMetricReport(tVoIPMatricReport* report, uint8_t* data);
+    void resetStatistics();
 
     uint32_t mSsrc;
     uint32_t mSamplingRate;
@@ -226,6 +267,14 @@ private:
     uint32_t mJitterBufferMax;
     uint32_t mJitterBufferAbsMax;
 
+    // the statistics summary of the report interval, the sequence numbers are -1 before any status
+    int32_t mBeginSeq;
+    int32_t mEndSeq;
+    uint32_t mNumReceived;
+    uint32_t mNumLost;
+    uint32_t mNumDuplicated;
+    tRunningStats mJitterStats;
+
     /**
      * state 1 = received a packet during a gap
      * state 2 = received a packet during a burst
@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTP_PACKET_RECORD_RING_H
+#define RTP_PACKET_RECORD_RING_H
+
+#include <ImsMediaDefine.h>
+#include <stdint.h>
+
+// power of two to get the slot of the extended sequence number with the mask
+#define RTP_PACKET_RECORD_RING_SIZE 512
+#define RTP_PACKET_RECORD_RING_MASK (RTP_PACKET_RECORD_RING_SIZE - 1)
+
+/**
+ * @brief The statistics of the received rtp packet stored in the RtpPacketRecordRing
+ */
+struct RtpPacketRecord
+{
+    /** The sequence number extended with the number of the sequence number cycles */
+    uint32_t extendedSeq;
+    /** transit time difference */
+    int32_t jitter;
+    /** arrival time */
+    int32_t arrival;
+    /** The number of the packets received with the sequence number, 0 when the slot is empty */
+    uint16_t numArrival;
+    /** The number of the packets determined as duplicated by the jitter buffer */
+    uint16_t numDuplicated;
+    kRtpDataType rtpDataType;
+    kRtpPacketStatus status;
+};
+
+/**
+ * @brief Fixed capacity store of the received rtp packet statistics indexed by the extended
+ * sequence number. Adding a packet and updating the status of a packet are O(1) and do not
+ * allocate. The Rtcp-Xr statistics are accumulated by the RtcpXrEncoder as the status of each
+ * packet is reported, so the ring only keeps what is needed to match the status to the arrival.
+ * The ring is not thread safe, the owner should guard it.
+ */
+class RtpPacketRecordRing
+{
+public:
+    RtpPacketRecordRing();
+    ~RtpPacketRecordRing();
+
+    /**
+     * @brief Remove all the records and restart the sequence number extension
+     */
+    void Clear();
+
+    /**
+     * @brief Store the received packet. The packet received again with the same sequence number
+     * is counted in the record of the first packet. When the sequence number jumps out of the ring
+     * range, the ring restarts from the packet if the ssrc is changed or the packet is newer than
+     * the records, and the packet is ignored if it is older than the records.
+     *
+     * @return false when the packet is ignored
+     */
+    bool Add(const RtpPacket& packet);
+
+    /**
+     * @brief Find the record of the sequence number in the ring range
+     *
+     * @return The record in the ring, it is valid until the next Add or Remove. nullptr when it
+     * is not found
+     */
+    RtpPacketRecord* Find(const uint16_t seq);
+
+    /**
+     * @brief Set the status determined by the jitter buffer to the record of the sequence number.
+     * The duplicated status is counted in the record without changing the status of the packet
+     * received first.
+     *
+     * @return The record updated, nullptr when it is not found
+     */
+    RtpPacketRecord* UpdateStatus(const uint16_t seq, const kRtpPacketStatus status);
+
+    /**
+     * @brief Remove the records of the sequence number and the older ones
+     */
+    void RemoveUntil(const uint16_t seq);
+
+    /**
+     * @brief Get the number of the packets stored including the duplicated packets
+     */
+    uint32_t GetCount() const { return mCount; }
+
+    /**
+     * @brief Count the packets arrived within the duration from the current time
+     *
+     * @param currentTime The current time in milliseconds unit
+     * @param duration The duration in milliseconds unit
+     */
+    uint32_t CountReceivedInDuration(const uint32_t currentTime, const int32_t duration) const;
+
+private:
+    uint32_t extendSeq(const uint16_t seq) const;
+    bool isInRange(const uint32_t extendedSeq) const;
+
+    RtpPacketRecord mRecords[RTP_PACKET_RECORD_RING_SIZE];
+    /** The highest extended sequence number stored */
+    uint32_t mHighestSeq;
+    uint32_t mSsrc;
+    uint32_t mCount;
+    bool mStarted;
+};
+
+#endif
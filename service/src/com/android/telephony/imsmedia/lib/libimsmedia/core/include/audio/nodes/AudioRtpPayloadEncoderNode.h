@@ -19,6 +19,7 @@
 
 #include <BaseNode.h>
 #include <ImsMediaBitWriter.h>
+#include <atomic>
 
 class AudioRtpPayloadEncoderNode : public BaseNode
 {
@@ -37,10 +38,26 @@ public:
     virtual void SetConfig(void* config);
     virtual bool IsSameConfig(void* config);
 
+    /**
+     * @brief Change the number of the frames bundled in a packet without the renegotiation. The
+     * packet being bundled is completed with the current ptime and the new ptime is applied from
+     * the next packet. The EVS compact format carries a frame per packet and ignores the ptime.
+     *
+     * @param ptime The ptime in milliseconds, a multiple of the 20 ms frame duration
+     */
+    void SetPtime(uint32_t ptime);
+
+    /**
+     * @brief Get the ptime in milliseconds applied from the next packet
+     */
+    uint32_t GetPtime();
+
 private:
     void EncodePayloadAmr(uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp);
     void EncodePayloadEvs(uint8_t* pData, uint32_t nDataSize, uint32_t nTimeStamp);
     uint32_t CheckPaddingNecessity(uint32_t nTotalSize);
+    void updateNumOfFrame();
+    void updatePacketMetrics();
 
     int32_t mCodecType;
     bool mOctetAligned;
@@ -49,6 +66,12 @@ private:
     bool mFirstFrame;
     uint32_t mTimestamp;
     uint32_t mMaxNumOfFrame;
+    // the number of frames per packet requested by SetPtime() from the other thread
+    std::atomic<uint32_t> mNextNumOfFrame;
+    uint32_t mNegotiatedNumOfFrame;
+    uint64_t mNumFramesSent;
+    uint64_t mNumPacketsSent;
+    uint64_t mNumPacketsSaved;
     uint32_t mCurrNumOfFrame;
     uint32_t mCurrFramePos;
     uint32_t mTotalPayloadSize;
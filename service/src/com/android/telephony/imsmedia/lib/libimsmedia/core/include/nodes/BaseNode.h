@@ -61,6 +61,22 @@ enum kBaseNodeId
     kNodeIdTextRenderer,
     kNodeIdTextPayloadEncoder,
     kNodeIdTextPayloadDecoder,
+    // for network emulation
+    kNodeIdImpairment,
+    // for pacing
+    kNodeIdRtpPacer,
+    kNodeIdMax,
+};
+
+enum kNodeLatencyType
+{
+    // the time of BaseNode::ProcessData called by the StreamScheduler
+    kNodeLatencyProcessData,
+    // the time of BaseNode::OnDataFromFrontNode called by the front node
+    kNodeLatencyOnDataFromFrontNode,
+    // the time of BaseNode::SendDataToRearNode including all the rear nodes
+    kNodeLatencySendDataToRearNode,
+    kNodeLatencyMax,
 };
 
 /**
@@ -306,6 +322,23 @@ public:
             ImsMediaSubType nDataType = ImsMediaSubType::MEDIASUBTYPE_UNDEFINED,
             uint32_t arrivalTime = 0);
 
+    /**
+     * @brief Gets the start time to measure the latency of the node
+     *
+     * @return uint64_t The current time in microseconds, 0 when the node is not in a session or
+     * the latency collection is disabled
+     */
+    uint64_t GetLatencyStartTime();
+
+    /**
+     * @brief Adds the time elapsed from the start time to the latency histogram of the node type
+     * in the session
+     *
+     * @param type The processing stage measured
+     * @param startTime The time returned by GetLatencyStartTime
+     */
+    void AddLatency(kNodeLatencyType type, uint64_t startTime);
+
 protected:
     /**
      * @brief Disconnects the front node from this node.
@@ -323,6 +356,8 @@ protected:
 
     std::shared_ptr<StreamSchedulerCallback> mScheduler;
     BaseSessionCallback* mCallback;
+    SessionLatencyStats* mLatencyStats;
+    ImsMediaMetrics* mMetrics;
     kBaseNodeState mNodeState;
     ImsMediaDataQueue mDataQueue;
     std::list<BaseNode*> mListFrontNodes;
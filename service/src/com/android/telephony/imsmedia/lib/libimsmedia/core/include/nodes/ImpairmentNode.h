@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMPAIRMENT_NODE_H
+#define IMPAIRMENT_NODE_H
+
+#include <BaseNode.h>
+#include <list>
+#include <mutex>
+#include <random>
+#include <vector>
+
+// the trace entry to drop the packet instead of delaying it
+#define IMPAIRMENT_TRACE_DROP (-1)
+
+enum kImpairmentDelayDistribution
+{
+    // the fixed delay without the jitter
+    kImpairmentDelayConstant = 0,
+    // the delay uniformly distributed in delay +/- jitter
+    kImpairmentDelayUniform,
+    // the delay normally distributed with the mean of delay and the deviation of jitter
+    kImpairmentDelayNormal,
+};
+
+/**
+ * @brief The parameters of the network impairment. The loss follows the two state Gilbert-Elliott
+ * model, the packet is lost with lossRateGood in the good state and with lossRateBad in the bad
+ * state. All the rates are the probability in 0.0 - 1.0.
+ */
+struct ImpairmentParams
+{
+    ImpairmentParams() :
+            seed(0),
+            delayMs(0),
+            jitterMs(0),
+            distribution(kImpairmentDelayConstant),
+            goodToBadRate(0),
+            badToGoodRate(1),
+            lossRateGood(0),
+            lossRateBad(0),
+            reorderRate(0),
+            reorderDelayMs(0),
+            duplicateRate(0)
+    {
+    }
+
+    uint32_t seed;
+    uint32_t delayMs;
+    uint32_t jitterMs;
+    kImpairmentDelayDistribution distribution;
+    double goodToBadRate;
+    double badToGoodRate;
+    double lossRateGood;
+    double lossRateBad;
+    // the rate of the packets held reorderDelayMs more to be overtaken by the following packets
+    double reorderRate;
+    uint32_t reorderDelayMs;
+    double duplicateRate;
+};
+
+struct ImpairmentStats
+{
+    uint32_t received;
+    uint32_t dropped;
+    uint32_t duplicated;
+    uint32_t reordered;
+    uint32_t sent;
+};
+
+/**
+ * @brief The node to emulate the network impairment for the tests. It can be connected between
+ * the SocketReaderNode and the RtpDecoderNode or in front of the SocketWriterNode and passes the
+ * data to the rear node unchanged after the delay, loss, reordering and duplication configured.
+ * The random sequence is generated from the seed and is reproducible for the same seed. When the
+ * trace is set, each packet takes the next entry of the trace as its delay in order instead of the
+ * random model and the trace is repeated when it reaches the end.
+ */
+class ImpairmentNode : public BaseNode
+{
+public:
+    ImpairmentNode(BaseSessionCallback* callback = nullptr);
+    virtual ~ImpairmentNode();
+    virtual kBaseNodeId GetNodeId();
+    virtual ImsMediaResult Start();
+    virtual void Stop();
+    virtual bool IsRunTime();
+    virtual bool IsSourceNode();
+    virtual void ProcessData();
+    virtual uint32_t GetDataCount();
+    virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+            uint32_t timestamp, bool mark, uint32_t seq,
+            ImsMediaSubType dataType = ImsMediaSubType::MEDIASUBTYPE_UNDEFINED,
+            uint32_t arrivalTime = 0);
+
+    /**
+     * @brief Set the impairment parameters, the random generator and the loss state are reset
+     */
+    void SetParams(const ImpairmentParams& params);
+
+    /**
+     * @brief Set the schedule of the delay in milliseconds for each packet in order. The entry of
+     * IMPAIRMENT_TRACE_DROP drops the packet. The empty trace returns to the random model.
+     */
+    void SetTrace(const std::vector<int32_t>& trace);
+
+    /**
+     * @brief Load the trace from the text file which has one entry per line, the delay in
+     * milliseconds or "drop". The empty lines and the lines starting with '#' are ignored.
+     *
+     * @param path The path of the trace file
+     * @return true when the file is read and has at least one entry
+     */
+    bool LoadTrace(const char* path);
+
+    ImpairmentStats GetStats();
+
+protected:
+    /**
+     * @brief Get the current time in milliseconds to schedule the packets
+     */
+    virtual uint32_t GetCurrentTime();
+
+private:
+    struct ImpairedPacket
+    {
+        uint32_t releaseTime;
+        ImsMediaSubType subtype;
+        std::vector<uint8_t> data;
+        uint32_t timestamp;
+        bool mark;
+        uint32_t seq;
+        ImsMediaSubType dataType;
+        uint32_t arrivalTime;
+    };
+
+    bool IsLost();
+    int32_t GetRandomDelay();
+    void Schedule(ImpairedPacket&& packet);
+    void Reset();
+
+    std::mutex mMutex;
+    ImpairmentParams mParams;
+    std::vector<int32_t> mTrace;
+    uint32_t mTraceIndex;
+    std::mt19937 mRandom;
+    bool mBadState;
+    uint32_t mLastReleaseTime;
+    std::list<ImpairedPacket> mPendingPackets;
+    ImpairmentStats mStats;
+};
+
+#endif
@@ -19,6 +19,10 @@
 
 #include <BaseJitterBuffer.h>
 #include <BaseNode.h>
+#include <atomic>
+
+// the number of the sequence numbers to keep the time added to the jitter buffer, power of 2
+#define JITTER_BUFFER_LATENCY_SLOTS 1024
 
 class JitterBufferControlNode : public BaseNode
 {
@@ -46,8 +50,23 @@ private:
     JitterBufferControlNode& operator=(const JitterBufferControlNode& objRHS);
 
 protected:
+    /**
+     * @brief Adds the time from the last frame taken from the jitter buffer to now to the latency
+     * histogram of the session. It is called when the frame is delivered to the player.
+     */
+    void AddPlayoutLatency();
+
     BaseJitterBuffer* mJitterBuffer;
     ImsMediaType mMediaType;
+
+private:
+    /**
+     * The time in microseconds when the packet is added, indexed by the sequence number. The
+     * socket thread sets the slot and the player thread takes it, so the slot holds the valid flag
+     * and the sequence number with the time in the lower 32 bits to check and clear it atomically.
+     */
+    std::atomic<uint64_t> mAddTime[JITTER_BUFFER_LATENCY_SLOTS];
+    uint64_t mLastGetTime;
 };
 
 #endif
\ No newline at end of file
@@ -82,7 +82,7 @@ public:
     /**
      * @brief Send Rtcp-Xr payload to the RtpStack to add the rtp header to send it to the network
      *
-     * @param data The payload of the rtcp-xr report blocks
+     * @param data The payload of the rtcp-xr report blocks, it is owned by the caller
      * @param size The size of payload
      */
     bool SendRtcpXr(uint8_t* data, uint32_t size);
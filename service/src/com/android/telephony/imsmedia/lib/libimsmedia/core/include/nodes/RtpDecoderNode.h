@@ -19,7 +19,7 @@
 
 #include <BaseNode.h>
 #include <IRtpSession.h>
-#include <RtpHeaderExtension.h>
+#include <RtpHeaderExtensionBlock.h>
 
 /**
  * @brief This class is to depacketize the rtp packet and acquires sequence number, ssrc, timestamp,
@@ -65,8 +65,6 @@ public:
 
 private:
     void processDtmf(uint8_t* data);
-    std::list<RtpHeaderExtension>* DecodeRtpHeaderExtension(
-            const RtpHeaderExtensionInfo& extensionInfo);
 
     IRtpSession* mRtpSession;
     RtpAddress mLocalAddress;
@@ -85,6 +83,7 @@ private:
     uint32_t mArrivalTime;
     ImsMediaSubType mSubtype;
     bool mDtmfEndBit;
+    RtpHeaderExtensionBlock mExtensionBlock;
 #if defined(SIMULATION_LOSS) || defined(SIMULATION_DUPLICATE) || defined(SIMULATION_SSRC_CHANGE)
     uint32_t mPacketCounter;
 #endif
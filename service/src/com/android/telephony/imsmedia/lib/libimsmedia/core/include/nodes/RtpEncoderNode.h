@@ -20,7 +20,7 @@
 #include <BaseNode.h>
 #include <IRtpSession.h>
 #include <RtpContextParams.h>
-#include <RtpHeaderExtension.h>
+#include <RtpHeaderExtensionBlock.h>
 #include <mutex>
 
 class RtpEncoderNode : public BaseNode, public IRtpEncoderListener
@@ -77,10 +77,16 @@ public:
 
 private:
     bool ProcessAudioData(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize);
-    void ProcessVideoData(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
-            uint32_t timestamp, bool mark);
+    /**
+     * @brief Sends the video packets of a frame in the data queue at once
+     */
+    void ProcessVideoData();
     void ProcessTextData(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
             uint32_t timestamp, bool mark);
+    /**
+     * @brief Build the cvo extension, the caller should hold mMutex
+     */
+    bool BuildCvoExtension(const int64_t facing, const int64_t orientation);
 
     IRtpSession* mRtpSession;
     std::mutex mMutex;
@@ -99,7 +105,10 @@ private:
     int32_t mCvoValue;
     int8_t mRedundantPayload;
     int8_t mRedundantLevel;
-    std::list<RtpHeaderExtensionInfo> mListRtpExtension;
+    // extensions requested by the client, each one is sent once with the next audio packet
+    std::list<RtpHeaderExtensionBlock> mListRtpExtension;
+    // pre-serialized cvo extension sent with the IDR frames
+    RtpHeaderExtensionBlock mCvoExtension;
     RtpContextParams mRtpContextParams;
 };
 
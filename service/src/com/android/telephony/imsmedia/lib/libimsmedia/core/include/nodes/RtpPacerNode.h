@@ -0,0 +1,163 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTP_PACER_NODE_H
+#define RTP_PACER_NODE_H
+
+#include <BaseNode.h>
+#include <list>
+#include <mutex>
+#include <vector>
+
+// the pacing rate is the target bitrate multiplied by the factor to drain the queue fast enough
+#define RTP_PACER_DEFAULT_RATE_FACTOR 2.5
+// the bytes sent back-to-back after the idle time, about two full size packets
+#define RTP_PACER_DEFAULT_BURST_SIZE 3000
+// the max time in milliseconds a packet waits in the queue, the rate is raised to meet it
+#define RTP_PACER_DEFAULT_MAX_QUEUE_DELAY 500
+
+/**
+ * @brief The priority of the packets queued in the pacer, the lower value is sent first
+ */
+enum kRtpPacerPriority
+{
+    kRtpPacerPriorityAudio = 0,
+    kRtpPacerPriorityRtcp,
+    kRtpPacerPriorityRetransmission,
+    kRtpPacerPriorityVideo,
+    kRtpPacerPriorityMax,
+};
+
+struct RtpPacerStats
+{
+    uint32_t received[kRtpPacerPriorityMax];
+    uint32_t sent[kRtpPacerPriorityMax];
+    // the max time in microseconds the packet of each priority waited in the queue
+    uint32_t maxQueueDelay[kRtpPacerPriorityMax];
+};
+
+/**
+ * @brief The node to pace the packets to the SocketWriterNode with the token bucket. The bucket
+ * is filled at the pacing rate up to the burst size and a packet is sent when the bucket has the
+ * tokens for its size. A packet larger than the burst size is sent when the bucket is full and
+ * the bucket goes into debt. The packets are kept in a queue per kRtpPacerPriority and the queue
+ * of the higher priority is always drained first. The rate is raised above the pacing rate when
+ * the queued bytes can not be sent within the max queue delay at the pacing rate, and the packet
+ * waited longer than the max queue delay is sent without the tokens. The pacer passes the
+ * packets through without the delay when the pacing rate is 0.
+ */
+class RtpPacerNode : public BaseNode
+{
+public:
+    RtpPacerNode(BaseSessionCallback* callback = nullptr);
+    virtual ~RtpPacerNode();
+    virtual kBaseNodeId GetNodeId();
+    virtual ImsMediaResult Start();
+    virtual void Stop();
+    virtual bool IsRunTime();
+    virtual bool IsSourceNode();
+    virtual void SetConfig(void* config);
+    virtual bool IsSameConfig(void* config);
+    virtual ImsMediaResult UpdateConfig(void* config);
+    virtual void ProcessData();
+    virtual uint32_t GetDataCount();
+    virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+            uint32_t timestamp, bool mark, uint32_t seq,
+            ImsMediaSubType dataType = ImsMediaSubType::MEDIASUBTYPE_UNDEFINED,
+            uint32_t arrivalTime = 0);
+
+    /**
+     * @brief Queue the packet with the given priority. OnDataFromFrontNode queues the rtcp
+     * packets as kRtpPacerPriorityRtcp and the rtp packets by the media type of the node, the
+     * sender of the retransmitted packets calls it with kRtpPacerPriorityRetransmission.
+     */
+    void EnqueuePacket(kRtpPacerPriority priority, ImsMediaSubType subtype, uint8_t* data,
+            uint32_t size, uint32_t timestamp, bool mark, uint32_t seq,
+            ImsMediaSubType dataType = ImsMediaSubType::MEDIASUBTYPE_UNDEFINED);
+
+    /**
+     * @brief Set the target bitrate of the stream, the pacing rate is updated to the target
+     * bitrate multiplied by the rate factor
+     *
+     * @param bitrate The target bitrate in bps
+     */
+    void SetTargetBitrate(uint32_t bitrate);
+
+    /**
+     * @brief Set the factor to multiply the target bitrate to get the pacing rate
+     */
+    void SetRateFactor(double factor);
+
+    /**
+     * @brief Set the size of the token bucket in bytes
+     */
+    void SetBurstSize(uint32_t size);
+
+    /**
+     * @brief Set the max time a packet waits in the queue
+     *
+     * @param delay The delay in milliseconds, 0 not to limit the delay
+     */
+    void SetMaxQueueDelay(uint32_t delay);
+
+    /**
+     * @brief Get the pacing rate in bps, 0 when the pacing is disabled
+     */
+    uint32_t GetPacingRate();
+
+    RtpPacerStats GetStats();
+
+protected:
+    /**
+     * @brief Get the current time in microseconds to fill the token bucket
+     */
+    virtual uint64_t GetCurrentTime();
+
+private:
+    struct PacedPacket
+    {
+        uint64_t queuedTime;
+        ImsMediaSubType subtype;
+        std::vector<uint8_t> data;
+        uint32_t timestamp;
+        bool mark;
+        uint32_t seq;
+        ImsMediaSubType dataType;
+    };
+
+    void FillTokens(uint64_t currentTime);
+    uint32_t GetDrainRate(uint64_t currentTime);
+    void UpdatePacingRate();
+    void Reset();
+
+    std::mutex mMutex;
+    std::list<PacedPacket> mQueues[kRtpPacerPriorityMax];
+    uint32_t mQueuedCount;
+    uint32_t mQueuedBytes;
+    uint32_t mTargetBitrate;
+    double mRateFactor;
+    uint32_t mPacingRate;
+    uint32_t mBurstSize;
+    uint32_t mMaxQueueDelay;
+    // the dequeued packets are being sent, the new packet is queued not to overtake them
+    bool mDraining;
+    // the bytes allowed to send, negative after the packet larger than the burst size
+    double mTokens;
+    uint64_t mLastFillTime;
+    RtpPacerStats mStats;
+};
+
+#endif
@@ -64,6 +64,7 @@ public:
 protected:
     bool OpenSocket();
     void CloseSocket();
+    void UpdateMetrics(uint32_t size);
 
     int mLocalFd;
     kProtocolType mProtocolType;
@@ -74,6 +75,7 @@ protected:
     std::mutex mMutex;
     uint8_t mBuffer[DEFAULT_MTU];
     bool mReceiveTtl;
+    uint64_t mLastReceivedTime;
 };
 
 #endif
\ No newline at end of file
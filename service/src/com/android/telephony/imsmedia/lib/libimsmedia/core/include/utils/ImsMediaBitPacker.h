@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMS_MEDIA_BITPACKER_H
+#define IMS_MEDIA_BITPACKER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Copies the bit strings between the byte arrays at any bit position in the network bit
+ * order. The speech frames of the AMR and EVS bandwidth efficient payloads start at the bit
+ * positions following the CMR and ToC fields, e.g. the 10th bit of a single AMR frame payload.
+ * The bytes are funnel shifted 16 at a time with SSE2 or NEON, or 8 at a time in a 64 bit word,
+ * with a dedicated loop for each of the 7 unaligned bit offsets. All the paths give the identical
+ * output.
+ */
+class ImsMediaBitPacker
+{
+public:
+    /**
+     * @brief Enable or disable the SIMD path at runtime, the 64 bit scalar path is used when
+     * disabled or when the target has no SIMD path. It is for the tests and benchmarks to compare
+     * the paths.
+     */
+    static void SetSimdEnabled(bool enabled);
+
+    /**
+     * @brief Check whether the SIMD path is used
+     */
+    static bool IsSimdEnabled();
+
+    /**
+     * @brief Pack the bits of the source bytes to the destination from the given bit position.
+     * The bits of the first destination byte before the bit position are kept and the bits of the
+     * last destination byte after the packed bits are cleared.
+     *
+     * @param pbDst The destination buffer of at least (nDstBitPos + nBitSize + 7) / 8 bytes
+     * @param nDstBitPos The bit position to pack the first bit at
+     * @param pbSrc The source bytes, the bits are taken from the most significant bit of the
+     * first byte
+     * @param nBitSize The number of bits to pack
+     */
+    static void Pack(uint8_t* pbDst, uint32_t nDstBitPos, const uint8_t* pbSrc, uint32_t nBitSize);
+
+    /**
+     * @brief Unpack the bits of the source from the given bit position to the destination bytes.
+     * The bits are stored from the most significant bit of the first destination byte and the
+     * bits of the last destination byte after the unpacked bits are cleared. No byte of the
+     * source after the last unpacked bit is read.
+     *
+     * @param pbDst The destination buffer of at least (nBitSize + 7) / 8 bytes
+     * @param pbSrc The source buffer of at least (nSrcBitPos + nBitSize + 7) / 8 bytes
+     * @param nSrcBitPos The bit position of the first bit to unpack
+     * @param nBitSize The number of bits to unpack
+     */
+    static void Unpack(
+            uint8_t* pbDst, const uint8_t* pbSrc, uint32_t nSrcBitPos, uint32_t nBitSize);
+};
+
+#endif
@@ -19,22 +19,46 @@
 
 #include <stdint.h>
 
+/**
+ * @brief Reads the bit fields of a byte buffer in the network bit order. The bits are cached in a
+ * 64 bit accumulator which is refilled with up to 8 bytes at once.
+ */
 class ImsMediaBitReader
 {
 public:
     ImsMediaBitReader();
     ~ImsMediaBitReader();
     void SetBuffer(uint8_t* pbBuffer, uint32_t nBufferSize);
+
+    /**
+     * @brief Read the bit field of up to 24 bits
+     *
+     * @return The value of the field, 0 when the field is out of the buffer
+     */
     uint32_t Read(uint32_t nSize);
+
+    /**
+     * @brief Read the bits to the byte array, the last byte is filled from the most significant
+     * bit when nBitSize is not a multiple of 8. The bytes are copied in bulk both when the read
+     * position is byte aligned and when it is not.
+     */
     void ReadByteBuffer(uint8_t* pbDst, uint32_t nBitSize);
+
+    /**
+     * @brief Read the unsigned Exp-Golomb code of ue(v) of ITU-T H.264 9.1
+     */
     uint32_t ReadByUEMode();
 
 private:
+    bool refill(uint32_t nSize);
+    uint32_t readBits(uint32_t nSize);
+    void seekToBit(uint32_t nBitPos);
+
     uint8_t* mBuffer;
     uint32_t mMaxBufferSize;
-    uint32_t mBytePos;
-    uint32_t mBitPos;  // start bit position of valid data in mBitBuffer
-    uint32_t mBitBuffer;
+    uint32_t mBytePos;   // position of the next byte to load to mBitBuffer
+    uint32_t mBitCount;  // number of the valid bits from the most significant bit of mBitBuffer
+    uint64_t mBitBuffer;
     bool mBufferEOF;
 };
 
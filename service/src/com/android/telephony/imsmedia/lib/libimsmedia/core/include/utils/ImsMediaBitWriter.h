@@ -19,14 +19,34 @@
 
 #include <stdint.h>
 
+/**
+ * @brief Writes the bit fields to a byte buffer in the network bit order. The pending bits are kept
+ * in a 64 bit accumulator and the whole bytes are stored as soon as they are complete, so the
+ * writers sharing a buffer through Seek() and Flush() see the same bytes as with the byte-wise
+ * writes.
+ */
 class ImsMediaBitWriter
 {
 public:
     ImsMediaBitWriter();
     ~ImsMediaBitWriter();
     void SetBuffer(uint8_t* pbBuffer, uint32_t nBufferSize);
+
+    /**
+     * @brief Write the bit field of up to 24 bits
+     */
     bool Write(uint32_t nValue, uint32_t nSize);
+
+    /**
+     * @brief Write the bits of the byte array, the bits of the last byte are taken from the most
+     * significant bit when nBitSize is not a multiple of 8. The bytes are copied in bulk both when
+     * the write position is byte aligned and when it is not.
+     */
     bool WriteByteBuffer(uint8_t* pbSrc, uint32_t nBitSize);
+
+    /**
+     * @brief Write the 32 bits value in the network byte order
+     */
     bool WriteByteBuffer(uint32_t value);
     void Seek(uint32_t nSize);
     void AddPadding();
@@ -34,11 +54,13 @@ public:
     void Flush();
 
 private:
+    void writeBits(uint32_t nValue, uint32_t nSize);
+
     uint8_t* mBuffer;
     uint32_t mMaxBufferSize;
     uint32_t mBytePos;
-    uint32_t mBitPos;
-    uint32_t mBitBuffer;
+    uint32_t mBitPos;  // number of the pending bits from the most significant bit of mBitBuffer
+    uint64_t mBitBuffer;
     bool mBufferFull;
 };
 
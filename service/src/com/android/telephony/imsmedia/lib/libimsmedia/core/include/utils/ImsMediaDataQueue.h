@@ -34,6 +34,7 @@ public:
         nSeqNum = 0;
         bHeader = false;
         bValid = false;
+        bExternalBuffer = false;
         arrivalTime = 0;
         eDataType = MEDIASUBTYPE_UNDEFINED;
         subtype = MEDIASUBTYPE_UNDEFINED;
@@ -43,7 +44,11 @@ public:
     {
         pbBuffer = nullptr;
 
-        if (entry.nBufferSize > 0 && entry.pbBuffer != nullptr)
+        if (entry.bExternalBuffer)
+        {
+            pbBuffer = entry.pbBuffer;
+        }
+        else if (entry.nBufferSize > 0 && entry.pbBuffer != nullptr)
         {
             pbBuffer = new uint8_t[entry.nBufferSize];
             memcpy(pbBuffer, entry.pbBuffer, entry.nBufferSize);
@@ -55,6 +60,7 @@ public:
         nSeqNum = entry.nSeqNum;
         bHeader = entry.bHeader;
         bValid = entry.bValid;
+        bExternalBuffer = entry.bExternalBuffer;
         arrivalTime = entry.arrivalTime;
         eDataType = entry.eDataType;
         subtype = entry.subtype;
@@ -64,7 +70,7 @@ public:
 
     void deleteBuffer()
     {
-        if (pbBuffer != nullptr)
+        if (pbBuffer != nullptr && !bExternalBuffer)
         {
             delete[] pbBuffer;
         }
@@ -82,6 +88,8 @@ public:
     bool bHeader;
     /** The flag when the data is fully integrated from fragmented packet */
     bool bValid;
+    /** The flag when the data buffer is owned by the caller, it is not copied nor deleted */
+    bool bExternalBuffer;
     /** The arrival time of the packet */
     uint32_t arrivalTime;
     /** The additional data type for the video frames */
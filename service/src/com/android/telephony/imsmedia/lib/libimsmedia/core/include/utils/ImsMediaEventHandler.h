@@ -18,10 +18,18 @@
 #define IMS_MEDIA_EVENTHANDLER_H
 
 #include <stdint.h>
-#include <list>
+#include <atomic>
 #include <mutex>
 #include <IImsMediaThread.h>
 #include <ImsMediaCondition.h>
+#include <ImsMediaEventPayload.h>
+
+// the number of the event handler names registered in the process
+#define IM_EVENT_HANDLER_MAX 16
+// the number of the events queued in a handler, it should be a power of 2
+#define IM_EVENT_QUEUE_SIZE 256
+#define IM_EVENT_QUEUE_MASK (IM_EVENT_QUEUE_SIZE - 1)
+#define IM_EVENT_HANDLER_ID_INVALID (-1)
 
 /**
  * @class ImsMediaEventHandler
@@ -29,15 +37,34 @@
  * - Call SendEvent() method to send an evnet
  * - Child class should implement processEvent() method.
  * - processEvent() method will be called when an event is received.
+ * - The handler is found by the id resolved once from the name with GetHandlerId(), and the
+ *   events are queued in a bounded lock-free ring of the fixed size records, so sending an event
+ *   does not allocate or search the handlers.
+ * - The object of an event is sent as the ImsMediaEventPayload owned by the queue, it is released
+ *   after processEvent() unless the handler moves it out, and when the event is not queued.
  */
 class ImsMediaEventHandler : public IImsMediaThread
 {
 private:
-    std::list<uint32_t> mListevent;
-    std::list<uint64_t> mListParamA;
-    std::list<uint64_t> mListParamB;
-    std::list<uint64_t> mListParamC;
-    static std::list<ImsMediaEventHandler*> gListEventHandler;
+    struct EventRecord
+    {
+        /** The position of the ring the record is ready for, check #PushEvent */
+        std::atomic<uint32_t> sequence;
+        uint32_t event;
+        uint64_t paramA;
+        uint64_t paramB;
+        uint64_t paramC;
+        ImsMediaEventPayload payload;
+    };
+
+    EventRecord mRing[IM_EVENT_QUEUE_SIZE];
+    std::atomic<uint32_t> mEnqueuePos;
+    uint32_t mDequeuePos;
+    int32_t mId;
+    static std::atomic<ImsMediaEventHandler*> gHandlers[IM_EVENT_HANDLER_MAX];
+    /** The number of the senders using the handler of the id, Deinit waits for them */
+    static std::atomic<uint32_t> gSenders[IM_EVENT_HANDLER_MAX];
+    static char gHandlerNames[IM_EVENT_HANDLER_MAX][MAX_EVENTHANDLER_NAME];
     static std::mutex mMutex;
     ImsMediaCondition mCondition;
     ImsMediaCondition mConditionExit;
@@ -50,15 +77,64 @@ public:
     virtual ~ImsMediaEventHandler();
     void Init(const char* strName);
     void Deinit();
-    static void SendEvent(const char* strEventHandlerName, uint32_t event, uint64_t paramA,
+
+    /**
+     * @brief Get the id of the handler name. The id is registered for the name when a handler is
+     * initialized with it for the first time and kept for the process, so it can be cached by
+     * the sender. The names of the manager handlers have the ids reserved in
+     * ImsMediaEventHandlerId.h.
+     *
+     * @return int32_t The id of the name, IM_EVENT_HANDLER_ID_INVALID when no handler is
+     * initialized with the name
+     */
+    static int32_t GetHandlerId(const char* strEventHandlerName);
+
+    /**
+     * @brief Queue the event to the handler of the id without a lock
+     *
+     * @return false when the handler is not initialized or its queue is full
+     */
+    static bool SendEvent(int32_t handlerId, uint32_t event, uint64_t paramA,
             uint64_t paramB = 0, uint64_t paramC = 0);
+    static bool SendEvent(const char* strEventHandlerName, uint32_t event, uint64_t paramA,
+            uint64_t paramB = 0, uint64_t paramC = 0);
+
+    /**
+     * @brief Queue the event with the payload to the handler of the id. The payload is released
+     * when the event is not queued.
+     *
+     * @return false when the handler is not initialized or its queue is full
+     */
+    static bool SendEvent(int32_t handlerId, uint32_t event, ImsMediaEventPayload payload,
+            uint64_t paramA, uint64_t paramB = 0, uint64_t paramC = 0);
+    static bool SendEvent(const char* strEventHandlerName, uint32_t event,
+            ImsMediaEventPayload payload, uint64_t paramA, uint64_t paramB = 0,
+            uint64_t paramC = 0);
     char* getName();
 
 private:
-    void AddEvent(uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC);
-    virtual void processEvent(
-            uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC) = 0;
+    /**
+     * @brief Register the name for the id when the handler is initialized
+     *
+     * @return int32_t The id of the name, IM_EVENT_HANDLER_ID_INVALID when no more name can be
+     * registered
+     */
+    static int32_t RegisterHandlerId(const char* strEventHandlerName);
+    bool PushEvent(uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC,
+            ImsMediaEventPayload& payload);
+    bool PopEvent(uint32_t& event, uint64_t& paramA, uint64_t& paramB, uint64_t& paramC,
+            ImsMediaEventPayload& payload);
+    void ResetQueue();
+
+    /**
+     * @brief Process the event in the thread of the handler
+     *
+     * @param payload The payload of the event, it is released after the call unless the handler
+     * moves it out
+     */
+    virtual void processEvent(uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC,
+            ImsMediaEventPayload& payload) = 0;
     virtual void* run();  // thread method
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,261 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMS_MEDIA_EVENT_PAYLOAD_H
+#define IMS_MEDIA_EVENT_PAYLOAD_H
+
+#include <stdint.h>
+#include <atomic>
+#include <new>
+#include <utility>
+
+// the number of the payload slots pooled per payload type, up to 32 for the free mask
+#define IM_EVENT_PAYLOAD_POOL_SIZE 32
+
+/**
+ * @brief The fixed size storage of the event payloads of a type. The slots are taken and
+ * returned with the atomic free mask, so the payload is created without a lock and without the
+ * heap allocation while the pool has a free slot.
+ */
+template <typename T>
+class ImsMediaEventPayloadPool
+{
+public:
+    static ImsMediaEventPayloadPool& GetInstance()
+    {
+        static ImsMediaEventPayloadPool sPool;
+        return sPool;
+    }
+
+    /**
+     * @brief Construct the object in a free slot
+     *
+     * @return T* The object in the pool, nullptr when every slot is in use
+     */
+    template <typename... Args>
+    T* Acquire(Args&&... args)
+    {
+        uint32_t freeMask = mFreeMask.load(std::memory_order_relaxed);
+
+        while (freeMask != 0)
+        {
+            uint32_t bit = freeMask & (~freeMask + 1);
+
+            if (mFreeMask.compare_exchange_weak(
+                        freeMask, freeMask & ~bit, std::memory_order_acquire))
+            {
+                return new (mSlots[__builtin_ctz(bit)].storage) T(std::forward<Args>(args)...);
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Destroy the object and return its slot to the pool
+     *
+     * @return false when the object is not in the pool
+     */
+    bool Release(T* object)
+    {
+        Slot* slot = reinterpret_cast<Slot*>(object);
+
+        if (slot < mSlots || slot >= mSlots + IM_EVENT_PAYLOAD_POOL_SIZE)
+        {
+            return false;
+        }
+
+        object->~T();
+        mFreeMask.fetch_or(1u << (slot - mSlots), std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        alignas(T) uint8_t storage[sizeof(T)];
+    };
+
+    ImsMediaEventPayloadPool() :
+            mFreeMask(0xFFFFFFFFu >> (32 - IM_EVENT_PAYLOAD_POOL_SIZE))
+    {
+    }
+
+    Slot mSlots[IM_EVENT_PAYLOAD_POOL_SIZE];
+    std::atomic<uint32_t> mFreeMask;
+};
+
+/**
+ * @brief The typed payload of an event. It owns the object and releases it to where it came from
+ * when it is destroyed, so the payload of the event dropped in any path is not leaked. The
+ * payload is only moved, the handler moves it out of the event to forward the object.
+ */
+class ImsMediaEventPayload
+{
+public:
+    ImsMediaEventPayload() :
+            mObject(nullptr),
+            mType(nullptr),
+            mRelease(nullptr)
+    {
+    }
+
+    ImsMediaEventPayload(ImsMediaEventPayload&& other) noexcept :
+            mObject(other.mObject),
+            mType(other.mType),
+            mRelease(other.mRelease)
+    {
+        other.Detach();
+    }
+
+    ImsMediaEventPayload& operator=(ImsMediaEventPayload&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            mObject = other.mObject;
+            mType = other.mType;
+            mRelease = other.mRelease;
+            other.Detach();
+        }
+
+        return *this;
+    }
+
+    ImsMediaEventPayload(const ImsMediaEventPayload&) = delete;
+    ImsMediaEventPayload& operator=(const ImsMediaEventPayload&) = delete;
+
+    ~ImsMediaEventPayload() { Reset(); }
+
+    /**
+     * @brief Create the payload in the pool of the type, the heap is used when the pool is full
+     */
+    template <typename T, typename... Args>
+    static ImsMediaEventPayload Create(Args&&... args)
+    {
+        T* object = ImsMediaEventPayloadPool<T>::GetInstance().Acquire(std::forward<Args>(args)...);
+
+        if (object != nullptr)
+        {
+            return ImsMediaEventPayload(object, GetType<T>(), &ReleaseToPool<T>);
+        }
+
+        return ImsMediaEventPayload(
+                new T(std::forward<Args>(args)...), GetType<T>(), &ReleaseObject<T>);
+    }
+
+    /**
+     * @brief Take the ownership of the object allocated with new
+     */
+    template <typename T>
+    static ImsMediaEventPayload Adopt(T* object)
+    {
+        if (object == nullptr)
+        {
+            return ImsMediaEventPayload();
+        }
+
+        return ImsMediaEventPayload(object, GetType<T>(), &ReleaseObject<T>);
+    }
+
+    /**
+     * @brief Take the ownership of the array allocated with new[], it is read with Get<T>()
+     */
+    template <typename T>
+    static ImsMediaEventPayload AdoptArray(T* array)
+    {
+        if (array == nullptr)
+        {
+            return ImsMediaEventPayload();
+        }
+
+        return ImsMediaEventPayload(array, GetType<T>(), &ReleaseArray<T>);
+    }
+
+    /**
+     * @brief Get the object of the payload
+     *
+     * @return T* The object, nullptr when the payload is empty or of the other type
+     */
+    template <typename T>
+    T* Get() const
+    {
+        return mType == GetType<T>() ? static_cast<T*>(mObject) : nullptr;
+    }
+
+    bool IsEmpty() const { return mObject == nullptr; }
+
+    /**
+     * @brief Release the object and make the payload empty
+     */
+    void Reset()
+    {
+        if (mObject != nullptr && mRelease != nullptr)
+        {
+            mRelease(mObject);
+        }
+
+        Detach();
+    }
+
+private:
+    typedef void (*ReleaseFunc)(void*);
+
+    ImsMediaEventPayload(void* object, const void* type, ReleaseFunc release) :
+            mObject(object),
+            mType(type),
+            mRelease(release)
+    {
+    }
+
+    void Detach()
+    {
+        mObject = nullptr;
+        mType = nullptr;
+        mRelease = nullptr;
+    }
+
+    template <typename T>
+    static const void* GetType()
+    {
+        static const char sType = 0;
+        return &sType;
+    }
+
+    template <typename T>
+    static void ReleaseToPool(void* object)
+    {
+        ImsMediaEventPayloadPool<T>::GetInstance().Release(static_cast<T*>(object));
+    }
+
+    template <typename T>
+    static void ReleaseObject(void* object)
+    {
+        delete static_cast<T*>(object);
+    }
+
+    template <typename T>
+    static void ReleaseArray(void* array)
+    {
+        delete[] static_cast<T*>(array);
+    }
+
+    void* mObject;
+    const void* mType;
+    ReleaseFunc mRelease;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMS_MEDIA_HISTOGRAM_H
+#define IMS_MEDIA_HISTOGRAM_H
+
+#include <stdint.h>
+#include <atomic>
+
+// each power of 2 range is divided into 2^IM_HISTOGRAM_SUB_BUCKET_BITS linear buckets
+#define IM_HISTOGRAM_SUB_BUCKET_BITS 3
+#define IM_HISTOGRAM_SUB_BUCKETS     (1 << IM_HISTOGRAM_SUB_BUCKET_BITS)
+// the values from 2^IM_HISTOGRAM_MAX_ORDER are counted in the last bucket
+#define IM_HISTOGRAM_MAX_ORDER 24
+#define IM_HISTOGRAM_BUCKETS \
+    ((IM_HISTOGRAM_MAX_ORDER - IM_HISTOGRAM_SUB_BUCKET_BITS + 1) * IM_HISTOGRAM_SUB_BUCKETS)
+
+/**
+ * @brief The copy of the histogram taken at a time
+ */
+struct ImsMediaHistogramSnapshot
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint32_t buckets[IM_HISTOGRAM_BUCKETS];
+
+    /**
+     * @brief Get the average of the values, 0 when there is no value
+     */
+    uint64_t GetMean() const;
+
+    /**
+     * @brief Get the estimated value of the percentile. The value is the middle of the bucket
+     * which has the percentile, so the error is less than 1/16 of the value.
+     *
+     * @param percent The percentile from 0 to 100, 0 and 100 are the min and the max
+     */
+    uint64_t GetPercentile(uint32_t percent) const;
+};
+
+/**
+ * @brief Log-linear histogram of the non-negative integer values. The values less than
+ * IM_HISTOGRAM_SUB_BUCKETS are counted exactly and the other values are counted in the bucket of
+ * its power of 2 range and the top IM_HISTOGRAM_SUB_BUCKET_BITS bits below the leading bit.
+ * Add is a few relaxed atomic operations without a lock, so it can be called from any thread in
+ * the data path while the other thread takes the snapshot.
+ */
+class ImsMediaHistogram
+{
+public:
+    ImsMediaHistogram();
+    ~ImsMediaHistogram();
+
+    /**
+     * @brief Count the value in the histogram
+     */
+    void Add(uint64_t value);
+
+    /**
+     * @brief Clear all the counted values
+     */
+    void Reset();
+
+    /**
+     * @brief Copy the histogram. The buckets are read one by one while the values are added, so
+     * the count can differ from the sum of the buckets by the values added in the middle.
+     */
+    void GetSnapshot(ImsMediaHistogramSnapshot& snapshot) const;
+
+    /**
+     * @brief Get the bucket index of the value
+     */
+    static uint32_t GetBucketIndex(uint64_t value);
+
+    /**
+     * @brief Get the smallest value counted in the bucket
+     */
+    static uint64_t GetBucketLowerBound(uint32_t index);
+
+private:
+    ImsMediaHistogram(const ImsMediaHistogram&) = delete;
+    ImsMediaHistogram& operator=(const ImsMediaHistogram&) = delete;
+
+    std::atomic<uint64_t> mCount;
+    std::atomic<uint64_t> mSum;
+    std::atomic<uint64_t> mMin;
+    std::atomic<uint64_t> mMax;
+    std::atomic<uint32_t> mBuckets[IM_HISTOGRAM_BUCKETS];
+};
+
+#endif
@@ -17,11 +17,28 @@
 #ifndef IMS_MEDIA_IMAGE_ROTATE
 #define IMS_MEDIA_IMAGE_ROTATE
 
+#include <stdint.h>
 #include <string.h>
 
+/**
+ * @brief The rotation of the camera images. The planes are rotated in 8x8 tiles with the SSE2 or
+ * NEON transpose when the target supports it, and with the scalar tiles otherwise. All the paths
+ * give the identical output.
+ */
 class ImsMediaImageRotate
 {
 public:
+    /**
+     * @brief Enable or disable the SIMD tiles at runtime, the scalar tiles are used when disabled
+     * or when the target has no SIMD path. It is for the tests and benchmarks to compare the paths.
+     */
+    static void SetSimdEnabled(bool enabled);
+
+    /**
+     * @brief Check whether the SIMD tiles are used
+     */
+    static bool IsSimdEnabled();
+
     /**
      * @brief Rotates YUVImage_420_Planar Image by 90 degrees and flips.
      * Supports input row stride equal to width.
@@ -0,0 +1,179 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMS_MEDIA_METRICS_H
+#define IMS_MEDIA_METRICS_H
+
+#include <ImsMediaDefine.h>
+#include <ImsMediaHistogram.h>
+#include <stdint.h>
+#include <atomic>
+
+// the number of the streams registered at the same time
+#define IM_METRICS_MAX_STREAMS 16
+#define IM_CACHE_LINE_SIZE     64
+
+enum ImsMediaMetricCounter
+{
+    kMetricRtpPacketsSent,
+    kMetricRtpBytesSent,
+    kMetricRtcpPacketsSent,
+    kMetricRtpPacketsReceived,
+    kMetricRtpBytesReceived,
+    kMetricRtcpPacketsReceived,
+    // the received packets dropped by the full queue of SocketReaderNode
+    kMetricSocketQueueDropped,
+    kMetricLostPackets,
+    kMetricLatePackets,
+    kMetricDiscardedPackets,
+    kMetricDuplicatedPackets,
+    kMetricFramesPlayed,
+    // the lost and no data frames given to the player
+    kMetricFramesConcealed,
+    // the audio packets not sent by bundling more frames in a packet than the negotiated ptime
+    kMetricAudioPacketsSaved,
+    kMetricCounterMax,
+};
+
+enum ImsMediaMetricGauge
+{
+    // the number of the packets in the jitter buffer
+    kMetricJitterBufferCount,
+    // the size of the audio jitter buffer in frames
+    kMetricJitterBufferSize,
+    // the ptime of the audio tx stream in milliseconds
+    kMetricAudioPtime,
+    // the audio packets per second saved by the current ptime against the negotiated ptime
+    kMetricAudioPacketRateSaved,
+    // the bytes of the packets waiting in the queues of RtpPacerNode
+    kMetricPacerQueueBytes,
+    kMetricGaugeMax,
+};
+
+enum ImsMediaMetricHistogram
+{
+    // the interval of the received rtp packets in microseconds
+    kMetricRtpInterArrivalTime,
+    // the time the packets waited in the queues of RtpPacerNode in microseconds
+    kMetricPacerQueueDelay,
+    kMetricHistogramMax,
+};
+
+/**
+ * @brief The copy of the metrics of a stream taken at a time
+ */
+struct ImsMediaMetricsSnapshot
+{
+    int32_t sessionId;
+    ImsMediaType mediaType;
+    uint64_t counters[kMetricCounterMax];
+    int64_t gauges[kMetricGaugeMax];
+    ImsMediaHistogramSnapshot histograms[kMetricHistogramMax];
+};
+
+/**
+ * @brief The metrics of a stream. Each counter and gauge has its own cache line, so the nodes
+ * updating the different values from the different threads do not share the cache line. The
+ * values are relaxed atomics updated in place by the media path and read in place by the
+ * monitoring thread.
+ */
+class ImsMediaMetrics
+{
+public:
+    void AddCounter(ImsMediaMetricCounter counter, uint64_t value = 1)
+    {
+        mCounters[counter].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t GetCounter(ImsMediaMetricCounter counter) const
+    {
+        return mCounters[counter].value.load(std::memory_order_relaxed);
+    }
+
+    void SetGauge(ImsMediaMetricGauge gauge, int64_t value)
+    {
+        mGauges[gauge].value.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t GetGauge(ImsMediaMetricGauge gauge) const
+    {
+        return mGauges[gauge].value.load(std::memory_order_relaxed);
+    }
+
+    void AddHistogram(ImsMediaMetricHistogram histogram, uint64_t value)
+    {
+        mHistograms[histogram].Add(value);
+    }
+
+    void Reset();
+    void GetSnapshot(ImsMediaMetricsSnapshot& snapshot) const;
+
+private:
+    struct alignas(IM_CACHE_LINE_SIZE) PaddedCounter
+    {
+        std::atomic<uint64_t> value;
+    };
+
+    struct alignas(IM_CACHE_LINE_SIZE) PaddedGauge
+    {
+        std::atomic<int64_t> value;
+    };
+
+    PaddedCounter mCounters[kMetricCounterMax];
+    PaddedGauge mGauges[kMetricGaugeMax];
+    ImsMediaHistogram mHistograms[kMetricHistogramMax];
+};
+
+/**
+ * @brief The registry of the metrics keyed by the session id and the media type of the stream.
+ * The metrics are kept in IM_METRICS_MAX_STREAMS static slots which are never freed, so the
+ * monitoring thread can poll the snapshots at any time without a lock shared with the media path.
+ * A slot is reused after Release and the snapshot taken while the slot is reused is discarded.
+ */
+class ImsMediaMetricsRegistry
+{
+public:
+    /**
+     * @brief Get the metrics of the stream, the metrics are cleared when the stream is newly
+     * registered
+     *
+     * @return ImsMediaMetrics* The metrics to update, nullptr when all the slots are in use
+     */
+    static ImsMediaMetrics* Acquire(int32_t sessionId, ImsMediaType mediaType);
+
+    /**
+     * @brief Unregister the metrics, the metrics should not be updated after the call
+     */
+    static void Release(ImsMediaMetrics* metrics);
+
+    /**
+     * @brief Get the snapshot of the stream
+     *
+     * @return true when the stream is registered and the snapshot is filled
+     */
+    static bool GetSnapshot(
+            int32_t sessionId, ImsMediaType mediaType, ImsMediaMetricsSnapshot& snapshot);
+
+    /**
+     * @brief Get the snapshots of all the registered streams
+     *
+     * @param snapshots The array to fill
+     * @param maxSnapshots The size of the array
+     * @return uint32_t The number of the snapshots filled
+     */
+    static uint32_t GetSnapshots(ImsMediaMetricsSnapshot* snapshots, uint32_t maxSnapshots);
+};
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMS_MEDIA_NAL_UNIT_SPLITTER_H
+#define IMS_MEDIA_NAL_UNIT_SPLITTER_H
+
+#include <stdint.h>
+
+/**
+ * @brief The NAL unit found in the Annex B byte stream. The data points to the NAL unit header
+ * right after the start code in the buffer given to the splitter.
+ */
+struct ImsMediaNalUnit
+{
+    uint8_t* data;
+    uint32_t size;
+    // the size of the start code in front of the data, 3 or 4
+    uint32_t startCodeSize;
+};
+
+/**
+ * @brief Splits the AVC and HEVC access unit in the Annex B byte stream format to the NAL units.
+ * Both of the 3 bytes "00 00 01" and the 4 bytes "00 00 00 01" start codes are recognized. The
+ * search skips a word at a time while the word has no zero byte, and each byte of the buffer is
+ * scanned once while the NAL units are taken in order by Next().
+ */
+class ImsMediaNalUnitSplitter
+{
+public:
+    ImsMediaNalUnitSplitter(uint8_t* buffer, uint32_t size);
+    ~ImsMediaNalUnitSplitter();
+
+    /**
+     * @brief Get the next NAL unit of the buffer. The bytes before the first start code are
+     * skipped.
+     *
+     * @param unit The NAL unit to fill
+     * @return false when there is no more NAL unit
+     */
+    bool Next(ImsMediaNalUnit* unit);
+
+    /**
+     * @brief Split the buffer to the NAL units in one pass
+     *
+     * @param units The array to fill with the NAL units found in order
+     * @param maxUnits The capacity of the units array
+     * @return The number of the NAL units filled, the NAL units over the capacity are not counted
+     */
+    static uint32_t Split(
+            uint8_t* buffer, uint32_t size, ImsMediaNalUnit* units, uint32_t maxUnits);
+
+    /**
+     * @brief Find the first start code in the buffer
+     *
+     * @param startCodeSize The size of the start code found, 3 or 4. It is 4 when a zero byte
+     * precedes "00 00 01" in the buffer.
+     * @return The position of the start code, nullptr when the buffer has no start code
+     */
+    static uint8_t* FindStartCode(uint8_t* buffer, uint32_t size, uint32_t* startCodeSize);
+
+    /**
+     * @brief Get the size of the start code at the beginning of the buffer
+     *
+     * @return 3 or 4 when the buffer starts with the start code, 0 otherwise
+     */
+    static uint32_t GetStartCodeSize(const uint8_t* buffer, uint32_t size);
+
+private:
+    uint8_t* mEnd;
+    uint8_t* mNextStartCode;
+    uint32_t mNextStartCodeSize;
+};
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMS_MEDIA_PACKET_TRACER_H
+#define IMS_MEDIA_PACKET_TRACER_H
+
+#include <stdint.h>
+#include <atomic>
+
+#define IM_PACKET_TRACE_MAGIC   0x54504D49  // "IMPT"
+#define IM_PACKET_TRACE_VERSION 1
+#define IM_PACKET_TRACE_FILE    "/data/user_de/0/com.android.telephony.imsmedia/packet_trace.bin"
+// the number of records kept per thread, power of 2
+#define IM_PACKET_TRACE_RING_SIZE 4096
+
+enum ImsMediaPacketTraceEvent
+{
+    kPacketTraceNone = 0,
+    kPacketTraceSocketRead,
+    kPacketTraceSocketWrite,
+    kPacketTraceRtpEncode,
+    kPacketTraceRtpDecode,
+    kPacketTraceJitterAdd,
+    kPacketTraceJitterGet,
+    kPacketTraceAudioPlay,
+    kPacketTraceAudioPlayLost,
+    kPacketTraceAudioPlayNoData,
+    kPacketTraceMax,
+};
+
+/**
+ * @brief The fixed size binary record of a packet event. The layout is the dump file format, so
+ * the fields are only appended with a new IM_PACKET_TRACE_VERSION.
+ */
+struct ImsMediaPacketTraceRecord
+{
+    uint64_t timeNs;  // CLOCK_MONOTONIC in nanoseconds
+    int32_t sessionId;
+    uint32_t threadId;
+    uint32_t timestamp;
+    uint32_t size;
+    uint16_t seq;
+    uint16_t event;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ImsMediaPacketTraceRecord) == 32, "the record size is the file format");
+
+/**
+ * @brief The header of the dump file followed by numRecords records
+ */
+struct ImsMediaPacketTraceFileHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t numRecords;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Writes the packet events to per-thread lock-free ring buffers. A record is a copy of 32
+ * bytes without any formatting, so the trace can be enabled in a live call. Each ring keeps the
+ * latest IM_PACKET_TRACE_RING_SIZE - 1 records of the thread, the last slot is the one the writer
+ * reuses next. The rings are dumped to a binary file to be decoded offline with
+ * imsmedia_packet_trace_decoder.
+ */
+class ImsMediaPacketTracer
+{
+public:
+    static inline bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Enable or disable the trace. The records written before are kept until Reset.
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * @brief Write a record to the ring of the calling thread
+     */
+    static void Write(ImsMediaPacketTraceEvent event, int32_t sessionId, uint16_t seq,
+            uint32_t timestamp, uint32_t size);
+
+    /**
+     * @brief Write a record with the sequence number and the timestamp read from the rtp header
+     * of the given packet
+     */
+    static void WriteRtp(
+            ImsMediaPacketTraceEvent event, int32_t sessionId, const uint8_t* data, uint32_t size);
+
+    /**
+     * @brief Copy the records in all the rings to the given buffer. The records of a ring are in
+     * the written order, the rings are not merged.
+     *
+     * @param records The buffer to copy the records
+     * @param maxRecords The number of records the buffer can hold
+     * @return The number of records copied
+     */
+    static uint32_t Collect(ImsMediaPacketTraceRecord* records, uint32_t maxRecords);
+
+    /**
+     * @brief Write the file header and the records in all the rings to the given file
+     *
+     * @return The number of records written, -1 when the file can not be written
+     */
+    static int32_t Dump(const char* path);
+
+    /**
+     * @brief Discard the records in all the rings
+     */
+    static void Reset();
+
+    /**
+     * @brief Get the printable name of the event for the decoder
+     */
+    static const char* GetEventName(uint16_t event)
+    {
+        static const char* const kNames[kPacketTraceMax] = {"none", "socket_read",
+                "socket_write", "rtp_encode", "rtp_decode", "jitter_add", "jitter_get",
+                "audio_play", "audio_play_lost", "audio_play_nodata"};
+        return event < kPacketTraceMax ? kNames[event] : "unknown";
+    }
+
+private:
+    static std::atomic<bool> sEnabled;
+};
+
+/**
+ * The callback is the BaseSessionCallback of the node to get the session id of the record. The
+ * arguments are evaluated only when the trace is enabled.
+ */
+#define IMTRACE_PACKET(event, callback, seq, timestamp, size)                                \
+    do                                                                                       \
+    {                                                                                        \
+        if (ImsMediaPacketTracer::IsEnabled())                                               \
+        {                                                                                    \
+            ImsMediaPacketTracer::Write(event,                                               \
+                    (callback) != nullptr ? (callback)->getSessionId() : -1, seq, timestamp, \
+                    size);                                                                   \
+        }                                                                                    \
+    } while (0)
+
+#define IMTRACE_RTP_PACKET(event, callback, data, size)                                          \
+    do                                                                                           \
+    {                                                                                            \
+        if (ImsMediaPacketTracer::IsEnabled())                                                   \
+        {                                                                                        \
+            ImsMediaPacketTracer::WriteRtp(                                                      \
+                    event, (callback) != nullptr ? (callback)->getSessionId() : -1, data, size); \
+        }                                                                                        \
+    } while (0)
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef IMS_MEDIA_QUANTILE_SKETCH_H
+#define IMS_MEDIA_QUANTILE_SKETCH_H
+
+#include <stdint.h>
+
+// the estimated quantile is within 2% of the actual value
+#define IM_SKETCH_RELATIVE_ACCURACY 0.02
+// the values covered by the bins are 1 to about 27000, the larger values are in the last bin
+#define IM_SKETCH_MAX_BINS          256
+// the version of the serialized form, the reader rejects the other versions
+#define IM_SKETCH_VERSION           1
+// the version, the zero count, min, max, the number of bins and the bins in LEB128
+#define IM_SKETCH_MAX_SERIALIZED_SIZE (1 + 5 * 4 + IM_SKETCH_MAX_BINS * (2 + 5))
+
+/**
+ * @brief Mergeable quantile sketch of the non-negative integer values in the manner of DDSketch.
+ * The value v from 1 is counted in the bin ceil(log(v) / log(gamma)) where
+ * gamma = (1 + IM_SKETCH_RELATIVE_ACCURACY) / (1 - IM_SKETCH_RELATIVE_ACCURACY) and the value 0
+ * has its own bin, so the sketch has a fixed size regardless of the number of the values. Two
+ * sketches are merged by adding the bins and the serialized form only has the non-empty bins to
+ * aggregate the sketches of many calls. The sketch is not thread safe, the owner should guard it.
+ */
+class ImsMediaQuantileSketch
+{
+public:
+    ImsMediaQuantileSketch();
+    ~ImsMediaQuantileSketch();
+
+    /**
+     * @brief Count the value in the sketch
+     */
+    void Add(uint32_t value);
+
+    /**
+     * @brief Add all the values counted in the other sketch
+     */
+    void Merge(const ImsMediaQuantileSketch& sketch);
+
+    /**
+     * @brief Clear all the counted values
+     */
+    void Reset();
+
+    uint64_t GetCount() const { return mCount; }
+    uint32_t GetMin() const { return mCount == 0 ? 0 : mMin; }
+    uint32_t GetMax() const { return mMax; }
+
+    /**
+     * @brief Get the estimated value of the percentile, 0 when there is no value
+     *
+     * @param percent The percentile from 0 to 100, 0 and 100 are the min and the max
+     */
+    uint32_t GetPercentile(uint32_t percent) const;
+
+    /**
+     * @brief Write the sketch in the compact byte format to exchange the sketch out of the
+     * process
+     *
+     * @param buffer The buffer to write, IM_SKETCH_MAX_SERIALIZED_SIZE bytes is always enough
+     * @param size The size of the buffer
+     * @return uint32_t The number of the bytes written, 0 when the buffer is too small
+     */
+    uint32_t Serialize(uint8_t* buffer, uint32_t size) const;
+
+    /**
+     * @brief Replace the sketch with the one written by Serialize
+     *
+     * @return false when the data is of the other version, truncated or has a bin out of the
+     * range, the sketch is cleared in that case
+     */
+    bool Deserialize(const uint8_t* buffer, uint32_t size);
+
+    /**
+     * @brief Get the bin index of the value 1 and larger
+     */
+    static uint32_t GetBinIndex(uint32_t value);
+
+private:
+    uint64_t mCount;
+    uint32_t mZeroCount;
+    uint32_t mMin;
+    uint32_t mMax;
+    uint32_t mBins[IM_SKETCH_MAX_BINS];
+};
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIDEO_FRAME_BUFFER_POOL_H_INCLUDED
+#define VIDEO_FRAME_BUFFER_POOL_H_INCLUDED
+
+#include <ImsMediaDataQueue.h>
+#include <stdint.h>
+
+#define VIDEO_FRAME_BUFFER_POOL_SIZE 8
+
+/**
+ * @brief The pool of the contiguous buffers to assemble the received video frames in place. The
+ * packets of a rtp timestamp are copied back to back to the buffer reserved for the timestamp, so
+ * the frame can be read in one piece when the packets are received in order.
+ */
+class VideoFrameBufferPool
+{
+public:
+    VideoFrameBufferPool();
+    ~VideoFrameBufferPool();
+
+    /**
+     * @brief Set the capacity of each frame buffer from the negotiated resolution. The buffers
+     * allocated before are released.
+     */
+    void SetResolution(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Release all the frame buffers from the timestamps they are reserved for
+     */
+    void Reset();
+
+    /**
+     * @brief Copy the data to the end of the frame buffer of the timestamp. A new frame buffer is
+     * reserved when the timestamp does not have one yet, reusing the one which is not referred by
+     * any entry of the queue and not held.
+     *
+     * @param timestamp The rtp timestamp of the data
+     * @param data The data to copy
+     * @param size The size of the data
+     * @param queue The queue of the entries referring to the frame buffers
+     * @return The address of the data copied, nullptr when there is no room for the data
+     */
+    uint8_t* Write(
+            uint32_t timestamp, const uint8_t* data, uint32_t size, ImsMediaDataQueue* queue);
+
+    /**
+     * @brief Hold the frame buffer of the data not to be reused while it is read after the entries
+     * are deleted. The frame buffers of the last two frames held are kept.
+     */
+    void Hold(const uint8_t* data);
+
+    /**
+     * @brief Check whether the data is stored in one of the frame buffers
+     */
+    bool Contains(const uint8_t* data) const;
+
+    uint32_t GetCapacity() const { return mCapacity; }
+
+private:
+    struct FrameBuffer
+    {
+        uint8_t* buffer;
+        uint32_t timestamp;
+        uint32_t size;
+        bool reserved;
+    };
+
+    int32_t Find(const uint8_t* data) const;
+    int32_t Reserve(uint32_t timestamp, ImsMediaDataQueue* queue);
+    void Release();
+
+    FrameBuffer mFrames[VIDEO_FRAME_BUFFER_POOL_SIZE];
+    uint32_t mCapacity;
+    int32_t mHeld[2];
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include <BaseJitterBuffer.h>
 #include <ImsMediaVideoUtil.h>
 #include <ImsMediaTimer.h>
+#include <VideoFrameBufferPool.h>
 #include <mutex>
 #include <list>
 
@@ -60,6 +61,18 @@ public:
      */
     void SetFramerate(uint32_t framerate);
 
+    /**
+     * @brief Set the negotiated resolution to size the buffers assembling the received frames
+     */
+    void SetResolution(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Check whether the data got from the jitter buffer is stored in the frame buffer. The
+     * data of the frame buffer stays valid after the entry is deleted until the next two frames
+     * are got, so the frame can be read in place without copying it.
+     */
+    bool IsFrameBuffer(const uint8_t* data);
+
     /**
      * @brief Set the response wait time. A sender should ignore FIR messages that arrive within
      * Response Wait Time (RWT) duration after responding to a previous FIR message. Response Wait
@@ -85,10 +98,18 @@ public:
 
 private:
     bool CheckHeader(uint8_t* pbBuffer);
+    void StoreToFrameBuffer(DataEntry* pEntry);
     void CheckValidIDR(DataEntry* pIDREntry);
     void InitLostPktList();
     void RemovePacketFromLostList(uint16_t seqNum, bool bRemOldPkt = false);
     void CheckPacketLoss(uint16_t seqNum, uint16_t nLastRecvPkt);
+    void CountDuplicatedPacket();
+
+    /**
+     * @brief Check the queued data with the same sequence number has the same payload. The nal
+     * units of an aggregation packet share the sequence number, so all of them are compared.
+     */
+    bool IsDuplicated(uint32_t nSeqNum, uint8_t* pbBuffer, uint32_t nBufferSize);
     bool UpdateLostPacketList(uint16_t mLossRateThreshold, uint16_t* countSecondNack,
             uint16_t* nPLIPkt, bool* bPLIPkt);
     bool UpdateNackStatus(LostPacket* pTempEntry, uint16_t mLossRateThreshold,
@@ -126,5 +147,6 @@ private:
     uint32_t mCountTimerExpired;
     hTimerHandler mTimer;
     std::mutex mMutexTimer;
+    VideoFrameBufferPool mFramePool;
 };
 #endif
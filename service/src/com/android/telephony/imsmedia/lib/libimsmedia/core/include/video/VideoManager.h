@@ -38,8 +38,8 @@ public:
     class RequestHandler : public ImsMediaEventHandler
     {
     protected:
-        virtual void processEvent(
-                uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB);
+        virtual void processEvent(uint32_t event, uint64_t sessionId, uint64_t paramA,
+                uint64_t paramB, ImsMediaEventPayload& payload);
     };
 
     /**
@@ -48,8 +48,8 @@ public:
     class ResponseHandler : public ImsMediaEventHandler
     {
     protected:
-        virtual void processEvent(
-                uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB);
+        virtual void processEvent(uint32_t event, uint64_t sessionId, uint64_t paramA,
+                uint64_t paramB, ImsMediaEventPayload& payload);
     };
 
     static VideoManager* getInstance();
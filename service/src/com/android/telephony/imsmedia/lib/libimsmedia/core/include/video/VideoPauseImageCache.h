@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIDEO_PAUSE_IMAGE_CACHE_H_INCLUDED
+#define VIDEO_PAUSE_IMAGE_CACHE_H_INCLUDED
+
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PAUSE_IMAGE_CACHE_MAGIC   0x49504D49  // "IMPI"
+#define PAUSE_IMAGE_CACHE_VERSION 3
+#define PAUSE_IMAGE_CACHE_DIR     "/data/user_de/0/com.android.telephony.imsmedia"
+// the number of the streams kept in the memory and in the cache directory
+#define PAUSE_IMAGE_CACHE_MAX_ENTRIES 4
+// the number of the frames of a stream, the stream is looped from the idr frame after the last
+#define PAUSE_IMAGE_CACHE_MAX_FRAMES 300
+#define PAUSE_IMAGE_CACHE_MAX_SIZE   (1024 * 1024)
+
+// the buffer flags of the encoder output, the same values as AMEDIACODEC_BUFFER_FLAG_*
+#define PAUSE_IMAGE_FLAG_KEY_FRAME    1
+#define PAUSE_IMAGE_FLAG_CODEC_CONFIG 2
+
+/**
+ * @brief The source image and the encoder configuration the pause image stream is encoded with
+ */
+struct VideoPauseImageKey
+{
+    int32_t codecType;
+    uint32_t profile;
+    uint32_t level;
+    uint32_t width;
+    uint32_t height;
+    // the bitrate in kbps
+    uint32_t bitrate;
+    uint32_t framerate;
+    // the interval of the idr frames in seconds
+    uint32_t intraInterval;
+    // the hash of the source image file, not to send the stream of an old image after the image
+    // is changed by an update
+    uint32_t imageHash;
+
+    bool operator==(const VideoPauseImageKey& key) const
+    {
+        return codecType == key.codecType && profile == key.profile && level == key.level &&
+                width == key.width && height == key.height && bitrate == key.bitrate &&
+                framerate == key.framerate && intraInterval == key.intraInterval &&
+                imageHash == key.imageHash;
+    }
+};
+
+/**
+ * @brief The encoded bitstream of the pause image, the codec config, an idr frame and the
+ * following frames until the next idr frame. The frames after the idr frame refer to the same
+ * image, so they are mostly skipped macroblocks and the stream can be sent again from the idr
+ * frame in a loop instead of encoding the image for every frame.
+ */
+class VideoPauseImageStream
+{
+public:
+    VideoPauseImageStream();
+    ~VideoPauseImageStream();
+
+    /**
+     * @brief Append a frame of the encoder output. The frames before the first codec config or
+     * idr frame are dropped.
+     *
+     * @param data The bitstream of the frame
+     * @param size The size of the frame in byte
+     * @param flags The buffer flags of the encoder output
+     * @return true when the stream is complete and does not take more frames
+     */
+    bool AddFrame(const uint8_t* data, uint32_t size, uint32_t flags);
+
+    bool IsComplete() const { return mComplete; }
+    uint32_t GetNumFrames() const { return mFrames.size(); }
+    uint32_t GetSize() const { return mData.size(); }
+
+    /**
+     * @brief Get the frame of the given index, the stream starts with the codec config and the
+     * idr frame so it is sent again from the index 0 in a loop or for an idr frame request
+     *
+     * @return false when the index is out of the frames
+     */
+    bool GetFrame(uint32_t index, const uint8_t** data, uint32_t* size, uint32_t* flags) const;
+
+    /**
+     * @brief Write the complete stream to the given file with the key it is encoded with
+     */
+    bool Save(const char* path, const VideoPauseImageKey& key) const;
+
+    /**
+     * @brief Read the stream written by Save
+     *
+     * @return false when the file is not found, broken or written for another key
+     */
+    bool Load(const char* path, const VideoPauseImageKey& key);
+
+private:
+    struct Frame
+    {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t flags;
+    };
+
+    std::vector<uint8_t> mData;
+    std::vector<Frame> mFrames;
+    bool mHasKeyFrame;
+    bool mComplete;
+};
+
+/**
+ * @brief The process wide cache of the pause image streams. A stream found in the memory or in
+ * the cache directory is sent by the video source without running the encoder.
+ */
+class VideoPauseImageCache
+{
+public:
+    /**
+     * @brief Find the stream of the key in the memory, or read it from the cache directory
+     *
+     * @return The stream, nullptr when it is not cached
+     */
+    static std::shared_ptr<const VideoPauseImageStream> Find(const VideoPauseImageKey& key);
+
+    /**
+     * @brief Keep the complete stream in the memory and write it to the cache directory. The
+     * least recently used stream is removed when the cache is full, and the files of the streams
+     * not kept in the memory are removed from the cache directory.
+     */
+    static void Add(
+            const VideoPauseImageKey& key, std::shared_ptr<const VideoPauseImageStream> stream);
+
+    /**
+     * @brief Set the directory the streams are written to, empty not to write the files
+     */
+    static void SetDirectory(const std::string& directory);
+
+    /**
+     * @brief Remove all the streams in the memory, the files are not removed
+     */
+    static void Clear();
+
+    /**
+     * @brief Get the FNV-1a hash of the data to set the image hash of the key
+     */
+    static uint32_t GetHash(const uint8_t* data, size_t size);
+
+private:
+    static std::string getFilePath(const VideoPauseImageKey& key);
+    static void removeUnusedFiles();
+
+    static std::mutex sMutex;
+    static std::list<std::pair<VideoPauseImageKey, std::shared_ptr<const VideoPauseImageStream>>>
+            sEntries;
+    static std::string sDirectory;
+};
+
+#endif
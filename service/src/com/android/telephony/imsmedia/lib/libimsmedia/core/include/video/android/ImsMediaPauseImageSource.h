@@ -52,6 +52,17 @@ public:
      */
     size_t GetYuvImage(uint8_t* buffer, size_t len);
 
+    /**
+     * @brief Get the hash of the image asset of the video resolution to find the pause image
+     * stream encoded from the same image
+     *
+     * @param width width of the video frames.
+     * @param height height of the video frames.
+     *
+     * @return the hash of the image asset, 0 when the asset is not found.
+     */
+    uint32_t GetImageHash(int width, int height);
+
 private:
     int mWidth, mHeight;
     int8_t* mYuvImageBuffer;
@@ -25,6 +25,7 @@
 #include <media/NdkMediaFormat.h>
 #include <media/NdkImageReader.h>
 #include <ImsMediaCondition.h>
+#include <VideoPauseImageCache.h>
 #include "ImsMediaPauseImageSource.h"
 
 class IVideoSourceCallback
@@ -147,6 +148,8 @@ public:
 private:
     void EncodePauseImage();
     void processOutputBuffer();
+    void sendPauseImageFrame();
+    VideoPauseImageKey getPauseImageKey();
     ANativeWindow* CreateImageReader(int width, int height);
 
     ImsMediaCamera* mCamera;
@@ -159,6 +162,13 @@ private:
     ImsMediaCondition mConditionExit;
     IVideoSourceCallback* mListener;
     ImsMediaPauseImageSource mPauseImageSource;
+    // the pause image stream sent instead of encoding the image
+    std::shared_ptr<const VideoPauseImageStream> mPauseImageStream;
+    // the pause image stream being encoded to cache
+    std::shared_ptr<VideoPauseImageStream> mPauseImageEncoded;
+    uint32_t mPauseImageIndex;
+    // the hash of the pause image asset the cached stream is encoded from
+    uint32_t mPauseImageHash;
     int32_t mCodecType;
     int32_t mVideoMode;
     uint32_t mCodecProfile;
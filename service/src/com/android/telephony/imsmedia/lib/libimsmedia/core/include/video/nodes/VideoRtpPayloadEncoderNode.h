@@ -44,8 +44,6 @@ public:
 
 private:
     bool ResetStartTime();
-    uint8_t* FindAvcStartCode(uint8_t* pData, uint32_t nDataSize, uint32_t* pnSkipSize = nullptr);
-    uint8_t* FindHevcStartCode(uint8_t* pData, uint32_t nDataSize, uint32_t* pnSkipSize = nullptr);
     void EncodeAvc(uint8_t* pData, uint32_t nDataSize, uint32_t nTimeStamp, bool bMark);
     /** h.264 start coded has been removed at EncodeAvc()
      * pData starts with nal unit header */
@@ -56,11 +54,27 @@ private:
     /* encode H.265 RTP payload nal unit header */
     void EncodeHevcNALUnit(uint8_t* pData, uint32_t nDataSize, uint32_t nTimeStamp, bool bMark,
             uint32_t nNalUnitType);
+    /**
+     * @brief Append the nal unit to the STAP-A (RFC 6184) or AP (RFC 7798) packet when it fits in
+     * the mtu with the nal units aggregated before. The packet is sent when the nal unit has the
+     * marker bit.
+     *
+     * @return false when the nal unit is not aggregated and has to be sent by itself
+     */
+    bool AggregateNALUnit(
+            uint8_t* pData, uint32_t nDataSize, uint32_t nTimeStamp, bool bMark, bool bIdr);
+    /* send the aggregated nal units, a single nal unit packet is sent when only one is pending */
+    void SendAggregatedNALUnits(bool bMark);
 
     uint32_t mCodecType;
     uint32_t mPayloadMode;
     bool mPrevMark;
     uint8_t* mBuffer;
+    uint8_t* mAggregationBuffer;
+    uint32_t mAggregationSize;
+    uint32_t mAggregationCount;
+    uint32_t mAggregationTimestamp;
+    bool mAggregationIdr;
     uint8_t mVPS[MAX_CONFIG_LEN];
     uint8_t mSPS[MAX_CONFIG_LEN];
     uint8_t mPPS[MAX_CONFIG_LEN];
@@ -17,6 +17,8 @@
 #ifndef IMS_MEDIA_TRACE_H_INCLUDED
 #define IMS_MEDIA_TRACE_H_INCLUDED
 #include <stdint.h>
+#include <atomic>
+#include <type_traits>
 
 enum IM_LOG_MODE
 {
@@ -38,154 +40,157 @@ enum IM_PACKET_LOG_TYPE
     IM_PACKET_LOG_PH = 1 << 5,
     IM_PACKET_LOG_JITTER = 1 << 6,
     IM_PACKET_LOG_RTCP = 1 << 7,
-    IM_PACKET_LOG_RTPSTACK = 1 << 8
+    IM_PACKET_LOG_RTPSTACK = 1 << 8,
+    // records the binary packet events with ImsMediaPacketTracer instead of the text logs
+    IM_PACKET_LOG_BINARY_TRACE = 1 << 9,
+    // collects the node and path latency histograms of the sessions
+    IM_PACKET_LOG_LATENCY = 1 << 10,
 };
 
-#define IMLOGD_PACKET0(type, format)  \
-    ImsMediaTrace::IMLOGD_PACKET_ARG( \
-            type, "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__)
-#define IMLOGD_PACKET1(type, format, a)                       \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a)
-#define IMLOGD_PACKET2(type, format, a, b)                    \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b)
-#define IMLOGD_PACKET3(type, format, a, b, c)                 \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b, c)
-#define IMLOGD_PACKET4(type, format, a, b, c, d)              \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b, c, d)
-#define IMLOGD_PACKET5(type, format, a, b, c, d, e)           \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b, c, d, e)
-#define IMLOGD_PACKET6(type, format, a, b, c, d, e, f)        \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b, c, d, e, f)
-#define IMLOGD_PACKET7(type, format, a, b, c, d, e, f, g)     \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b, c, d, e, f, g)
-#define IMLOGD_PACKET8(type, format, a, b, c, d, e, f, g, h)  \
-    ImsMediaTrace::IMLOGD_PACKET_ARG(type, "[%s:%d] " format, \
-            ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b, c, d, e, f, g, h)
-
-#define IMLOGI0(format)        \
-    ImsMediaTrace::IMLOGI_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__)
-#define IMLOGI1(format, a)     \
-    ImsMediaTrace::IMLOGI_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a)
-#define IMLOGI2(format, a, b)  \
-    ImsMediaTrace::IMLOGI_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b)
-#define IMLOGI3(format, a, b, c)                                                                   \
-    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c)
-#define IMLOGI4(format, a, b, c, d)                                                                \
-    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d)
-#define IMLOGI5(format, a, b, c, d, e)                                                             \
-    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e)
-#define IMLOGI6(format, a, b, c, d, e, f)                                                          \
-    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f)
-#define IMLOGI7(format, a, b, c, d, e, f, g)                                                       \
-    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g)
-#define IMLOGI8(format, a, b, c, d, e, f, g, h)                                                    \
-    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g, h)
-
-#define IMLOGD0(format)        \
-    ImsMediaTrace::IMLOGD_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__)
-#define IMLOGD1(format, a)     \
-    ImsMediaTrace::IMLOGD_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a)
-#define IMLOGD2(format, a, b)  \
-    ImsMediaTrace::IMLOGD_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b)
-#define IMLOGD3(format, a, b, c)                                                                   \
-    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c)
-#define IMLOGD4(format, a, b, c, d)                                                                \
-    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d)
-#define IMLOGD5(format, a, b, c, d, e)                                                             \
-    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e)
-#define IMLOGD6(format, a, b, c, d, e, f)                                                          \
-    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f)
-#define IMLOGD7(format, a, b, c, d, e, f, g)                                                       \
-    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g)
-#define IMLOGD8(format, a, b, c, d, e, f, g, h)                                                    \
-    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g, h)
-
-#define IMLOGW0(format)        \
-    ImsMediaTrace::IMLOGW_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__)
-#define IMLOGW1(format, a)     \
-    ImsMediaTrace::IMLOGW_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a)
-#define IMLOGW2(format, a, b)  \
-    ImsMediaTrace::IMLOGW_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b)
-#define IMLOGW3(format, a, b, c)                                                                   \
-    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c)
-#define IMLOGW4(format, a, b, c, d)                                                                \
-    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d)
-#define IMLOGW5(format, a, b, c, d, e)                                                             \
-    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e)
-#define IMLOGW6(format, a, b, c, d, e, f)                                                          \
-    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f)
-#define IMLOGW7(format, a, b, c, d, e, f, g)                                                       \
-    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g)
-#define IMLOGW8(format, a, b, c, d, e, f, g, h)                                                    \
-    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g, h)
-
-#define IMLOGE0(format)        \
-    ImsMediaTrace::IMLOGE_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__)
-#define IMLOGE1(format, a)     \
-    ImsMediaTrace::IMLOGE_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a)
-#define IMLOGE2(format, a, b)  \
-    ImsMediaTrace::IMLOGE_ARG( \
-            "[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, a, b)
-#define IMLOGE3(format, a, b, c)                                                                   \
-    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c)
-#define IMLOGE4(format, a, b, c, d)                                                                \
-    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d)
-#define IMLOGE5(format, a, b, c, d, e)                                                             \
-    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e)
-#define IMLOGE6(format, a, b, c, d, e, f)                                                          \
-    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f)
-#define IMLOGE7(format, a, b, c, d, e, f, g)                                                       \
-    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g)
-#define IMLOGE8(format, a, b, c, d, e, f, g, h)                                                    \
-    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, ImsMediaTrace::IM_StripFileName((char*)__FILE__), \
-            __LINE__, a, b, c, d, e, f, g, h)
+/**
+ * Get the offset of the file name in the given path. It is evaluated at compile time in
+ * IM_FILE_NAME so no string search is done when a log is printed.
+ */
+constexpr uint32_t IM_FileNameOffset(const char* path)
+{
+    uint32_t offset = 0;
+
+    for (uint32_t i = 0; path[i] != '\0'; i++)
+    {
+        if (path[i] == '/')
+        {
+            offset = i + 1;
+        }
+    }
+
+    return offset;
+}
+
+#ifdef __FILE_NAME__
+#define IM_FILE_NAME __FILE_NAME__
+#else
+#define IM_FILE_NAME \
+    (__FILE__ + std::integral_constant<uint32_t, IM_FileNameOffset(__FILE__)>::value)
+#endif
+
+/**
+ * The packet logs are compiled out when IM_PACKET_LOG_DISABLED is defined. The arguments are
+ * still referenced in the dead branch so the call sites build without unused variable warnings.
+ */
+#ifdef IM_PACKET_LOG_DISABLED
+#define IM_PACKET_LOG_ENABLED(type) (false)
+#else
+#define IM_PACKET_LOG_ENABLED(type) ImsMediaTrace::IMIsPacketLogEnabled(type)
+#endif
+
+/**
+ * The enabled mask is checked inline, the arguments are evaluated only when the type is enabled.
+ */
+#define IM_LOGD_PACKET(type, format, ...)                                            \
+    do                                                                               \
+    {                                                                                \
+        if (IM_PACKET_LOG_ENABLED(type))                                             \
+        {                                                                            \
+            ImsMediaTrace::IMLOGD_PACKET_ARG(                                        \
+                    type, "[%s:%d] " format, IM_FILE_NAME, __LINE__, ##__VA_ARGS__); \
+        }                                                                            \
+    } while (0)
+
+#define IMLOGD_PACKET0(type, format) IM_LOGD_PACKET(type, format)
+#define IMLOGD_PACKET1(type, format, a) IM_LOGD_PACKET(type, format, a)
+#define IMLOGD_PACKET2(type, format, a, b) IM_LOGD_PACKET(type, format, a, b)
+#define IMLOGD_PACKET3(type, format, a, b, c) IM_LOGD_PACKET(type, format, a, b, c)
+#define IMLOGD_PACKET4(type, format, a, b, c, d) IM_LOGD_PACKET(type, format, a, b, c, d)
+#define IMLOGD_PACKET5(type, format, a, b, c, d, e) IM_LOGD_PACKET(type, format, a, b, c, d, e)
+#define IMLOGD_PACKET6(type, format, a, b, c, d, e, f) \
+    IM_LOGD_PACKET(type, format, a, b, c, d, e, f)
+#define IMLOGD_PACKET7(type, format, a, b, c, d, e, f, g) \
+    IM_LOGD_PACKET(type, format, a, b, c, d, e, f, g)
+#define IMLOGD_PACKET8(type, format, a, b, c, d, e, f, g, h) \
+    IM_LOGD_PACKET(type, format, a, b, c, d, e, f, g, h)
+
+#define IMLOGI0(format) ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__)
+#define IMLOGI1(format, a) ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a)
+#define IMLOGI2(format, a, b) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b)
+#define IMLOGI3(format, a, b, c) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c)
+#define IMLOGI4(format, a, b, c, d) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d)
+#define IMLOGI5(format, a, b, c, d, e) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e)
+#define IMLOGI6(format, a, b, c, d, e, f) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f)
+#define IMLOGI7(format, a, b, c, d, e, f, g) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g)
+#define IMLOGI8(format, a, b, c, d, e, f, g, h) \
+    ImsMediaTrace::IMLOGI_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g, h)
+
+#define IMLOGD0(format) ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__)
+#define IMLOGD1(format, a) ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a)
+#define IMLOGD2(format, a, b) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b)
+#define IMLOGD3(format, a, b, c) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c)
+#define IMLOGD4(format, a, b, c, d) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d)
+#define IMLOGD5(format, a, b, c, d, e) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e)
+#define IMLOGD6(format, a, b, c, d, e, f) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f)
+#define IMLOGD7(format, a, b, c, d, e, f, g) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g)
+#define IMLOGD8(format, a, b, c, d, e, f, g, h) \
+    ImsMediaTrace::IMLOGD_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g, h)
+
+#define IMLOGW0(format) ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__)
+#define IMLOGW1(format, a) ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a)
+#define IMLOGW2(format, a, b) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b)
+#define IMLOGW3(format, a, b, c) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c)
+#define IMLOGW4(format, a, b, c, d) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d)
+#define IMLOGW5(format, a, b, c, d, e) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e)
+#define IMLOGW6(format, a, b, c, d, e, f) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f)
+#define IMLOGW7(format, a, b, c, d, e, f, g) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g)
+#define IMLOGW8(format, a, b, c, d, e, f, g, h) \
+    ImsMediaTrace::IMLOGW_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g, h)
+
+#define IMLOGE0(format) ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__)
+#define IMLOGE1(format, a) ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a)
+#define IMLOGE2(format, a, b) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b)
+#define IMLOGE3(format, a, b, c) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c)
+#define IMLOGE4(format, a, b, c, d) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d)
+#define IMLOGE5(format, a, b, c, d, e) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e)
+#define IMLOGE6(format, a, b, c, d, e, f) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f)
+#define IMLOGE7(format, a, b, c, d, e, f, g) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g)
+#define IMLOGE8(format, a, b, c, d, e, f, g, h) \
+    ImsMediaTrace::IMLOGE_ARG("[%s:%d] " format, IM_FILE_NAME, __LINE__, a, b, c, d, e, f, g, h)
 
 #define IMLOGB(a, b, c) ImsMediaTrace::IMLOGD_BINARY(a, b, c)
 
 class ImsMediaTrace
 {
 public:
+    /**
+     * @brief Check whether the packet log of the given type is enabled. It is lock free and
+     * cheap enough to call per packet.
+     */
+    static inline bool IMIsPacketLogEnabled(uint32_t type)
+    {
+        return (sPacketLogMask.load(std::memory_order_relaxed) & type) != 0;
+    }
+
     static void IMLOGD_PACKET_ARG(IM_PACKET_LOG_TYPE type, const char* format, ...);
     static void IMSetLogMode(uint32_t mode);
     static void IMSetDebugLogMode(uint32_t mode);
@@ -197,6 +202,11 @@ public:
     static char* IMTrace_Bin2String(const char* s, int length);
     static void IMLOGD_BINARY(const char* msg, const char* s, int length);
     static char* IM_StripFileName(char* pcFileName);
+
+private:
+    static void UpdatePacketLogMask();
+    // the packet log types enabled with the current log mode
+    static std::atomic<uint32_t> sPacketLogMask;
 };
 
 #endif
\ No newline at end of file
@@ -15,6 +15,8 @@
  */
 
 #include <BaseNode.h>
+#include <SessionLatencyStats.h>
+#include <ImsMediaTimer.h>
 #include <ImsMediaTrace.h>
 #include <stdlib.h>
 
@@ -40,12 +42,16 @@ static std::vector<NODE_ID_PAIR> vectorNodeId{
         std::make_pair(kNodeIdTextRenderer, "TextRenderer"),
         std::make_pair(kNodeIdTextPayloadEncoder, "TextPayloadEncoder"),
         std::make_pair(kNodeIdTextPayloadDecoder, "TextPayloadDecoder"),
+        std::make_pair(kNodeIdImpairment, "Impairment"),
+        std::make_pair(kNodeIdRtpPacer, "RtpPacer"),
 };
 
 BaseNode::BaseNode(BaseSessionCallback* callback)
 {
     mScheduler = nullptr;
     mCallback = callback;
+    mLatencyStats = callback != nullptr ? callback->getLatencyStats() : nullptr;
+    mMetrics = callback != nullptr ? callback->getMetrics() : nullptr;
     mNodeState = kNodeStateStopped;
     mMediaType = IMS_MEDIA_AUDIO;
     mListFrontNodes.clear();
@@ -61,6 +67,8 @@ BaseNode::~BaseNode()
 void BaseNode::SetSessionCallback(BaseSessionCallback* callback)
 {
     mCallback = callback;
+    mLatencyStats = callback != nullptr ? callback->getLatencyStats() : nullptr;
+    mMetrics = callback != nullptr ? callback->getMetrics() : nullptr;
 }
 
 void BaseNode::SetSchedulerCallback(std::shared_ptr<StreamSchedulerCallback>& callback)
@@ -299,13 +307,16 @@ void BaseNode::SendDataToRearNode(ImsMediaSubType subtype, uint8_t* pData, uint3
         uint32_t arrivalTime)
 {
     bool nNeedRunCount = false;
+    uint64_t sendStartTime = GetLatencyStartTime();
 
     for (auto& node : mListRearNodes)
     {
         if (node != nullptr && node->GetState() == kNodeStateRunning)
         {
+            uint64_t startTime = node->GetLatencyStartTime();
             node->OnDataFromFrontNode(
                     subtype, pData, nDataSize, nTimestamp, bMark, nSeqNum, nDataType, arrivalTime);
+            node->AddLatency(kNodeLatencyOnDataFromFrontNode, startTime);
 
             if (node->IsRunTime() == false)
             {
@@ -318,6 +329,8 @@ void BaseNode::SendDataToRearNode(ImsMediaSubType subtype, uint8_t* pData, uint3
     {
         mScheduler->onAwakeScheduler();
     }
+
+    AddLatency(kNodeLatencySendDataToRearNode, sendStartTime);
 }
 
 void BaseNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
@@ -336,6 +349,28 @@ void BaseNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData, uint
     mDataQueue.Add(&entry);
 }
 
+uint64_t BaseNode::GetLatencyStartTime()
+{
+    return mLatencyStats != nullptr && SessionLatencyStats::IsEnabled()
+            ? ImsMediaTimer::GetTimeInMicroSeconds()
+            : 0;
+}
+
+void BaseNode::AddLatency(kNodeLatencyType type, uint64_t startTime)
+{
+    if (mLatencyStats == nullptr || startTime == 0)
+    {
+        return;
+    }
+
+    uint64_t currentTime = ImsMediaTimer::GetTimeInMicroSeconds();
+
+    if (currentTime >= startTime)
+    {
+        mLatencyStats->AddNodeLatency(GetNodeId(), type, currentTime - startTime);
+    }
+}
+
 void BaseNode::DisconnectRearNode(BaseNode* pRearNode)
 {
     if (pRearNode == nullptr)
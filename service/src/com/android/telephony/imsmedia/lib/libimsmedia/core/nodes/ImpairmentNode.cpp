@@ -0,0 +1,355 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ImpairmentNode.h>
+#include <ImsMediaTimer.h>
+#include <ImsMediaTrace.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_LINE_MAX 128
+
+ImpairmentNode::ImpairmentNode(BaseSessionCallback* callback) :
+        BaseNode(callback)
+{
+    mTraceIndex = 0;
+    mBadState = false;
+    mLastReleaseTime = 0;
+    memset(&mStats, 0, sizeof(mStats));
+}
+
+ImpairmentNode::~ImpairmentNode() {}
+
+kBaseNodeId ImpairmentNode::GetNodeId()
+{
+    return kNodeIdImpairment;
+}
+
+ImsMediaResult ImpairmentNode::Start()
+{
+    IMLOGD4("[Start] media[%d], seed[%u], delay[%u], jitter[%u]", mMediaType, mParams.seed,
+            mParams.delayMs, mParams.jitterMs);
+    IMLOGD5("[Start] loss good[%f], bad[%f], p[%f], r[%f], trace[%zu]", mParams.lossRateGood,
+            mParams.lossRateBad, mParams.goodToBadRate, mParams.badToGoodRate, mTrace.size());
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    Reset();
+    mNodeState = kNodeStateRunning;
+    return RESULT_SUCCESS;
+}
+
+void ImpairmentNode::Stop()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    IMLOGD4("[Stop] received[%u], dropped[%u], duplicated[%u], reordered[%u]", mStats.received,
+            mStats.dropped, mStats.duplicated, mStats.reordered);
+    mPendingPackets.clear();
+    mNodeState = kNodeStateStopped;
+}
+
+bool ImpairmentNode::IsRunTime()
+{
+    return false;
+}
+
+bool ImpairmentNode::IsSourceNode()
+{
+    return false;
+}
+
+void ImpairmentNode::ProcessData()
+{
+    uint32_t currentTime = GetCurrentTime();
+    std::list<ImpairedPacket> duePackets;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        auto iter = mPendingPackets.begin();
+
+        while (iter != mPendingPackets.end() &&
+                static_cast<int32_t>(currentTime - iter->releaseTime) >= 0)
+        {
+            iter++;
+            mStats.sent++;
+        }
+
+        duePackets.splice(duePackets.end(), mPendingPackets, mPendingPackets.begin(), iter);
+    }
+
+    for (auto& packet : duePackets)
+    {
+        // the packet read from the socket is stamped again as it arrives now
+        SendDataToRearNode(packet.subtype, packet.data.data(), packet.data.size(),
+                packet.timestamp, packet.mark, packet.seq, packet.dataType,
+                packet.arrivalTime != 0 ? currentTime : 0);
+    }
+}
+
+uint32_t ImpairmentNode::GetDataCount()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mPendingPackets.size();
+}
+
+void ImpairmentNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+        uint32_t timestamp, bool mark, uint32_t seq, ImsMediaSubType dataType,
+        uint32_t arrivalTime)
+{
+    if (data == nullptr || size == 0)
+    {
+        return;
+    }
+
+    uint32_t currentTime = GetCurrentTime();
+    std::lock_guard<std::mutex> guard(mMutex);
+    mStats.received++;
+
+    ImpairedPacket packet = {currentTime, subtype, std::vector<uint8_t>(data, data + size),
+            timestamp, mark, seq, dataType, arrivalTime};
+
+    if (!mTrace.empty())
+    {
+        int32_t delay = mTrace[mTraceIndex];
+        mTraceIndex = (mTraceIndex + 1) % mTrace.size();
+
+        if (delay < 0)
+        {
+            mStats.dropped++;
+            return;
+        }
+
+        packet.releaseTime += delay;
+        Schedule(std::move(packet));
+        return;
+    }
+
+    if (IsLost())
+    {
+        IMLOGD_PACKET1(IM_PACKET_LOG_SOCKET, "[OnDataFromFrontNode] drop seq[%u]", seq);
+        mStats.dropped++;
+        return;
+    }
+
+    std::uniform_real_distribution<double> probability(0.0, 1.0);
+    packet.releaseTime += GetRandomDelay();
+
+    if (probability(mRandom) < mParams.reorderRate)
+    {
+        // hold the packet without updating the last release time to let the next packets pass it
+        packet.releaseTime += mParams.reorderDelayMs;
+        mStats.reordered++;
+    }
+    else
+    {
+        // keep the order of the packets when only the jitter is applied
+        if (!mPendingPackets.empty() &&
+                static_cast<int32_t>(mLastReleaseTime - packet.releaseTime) > 0)
+        {
+            packet.releaseTime = mLastReleaseTime;
+        }
+
+        mLastReleaseTime = packet.releaseTime;
+    }
+
+    if (probability(mRandom) < mParams.duplicateRate)
+    {
+        ImpairedPacket duplicate = packet;
+        Schedule(std::move(packet));
+        Schedule(std::move(duplicate));
+        mStats.duplicated++;
+        return;
+    }
+
+    Schedule(std::move(packet));
+}
+
+void ImpairmentNode::SetParams(const ImpairmentParams& params)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mParams = params;
+    Reset();
+}
+
+void ImpairmentNode::SetTrace(const std::vector<int32_t>& trace)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mTrace = trace;
+    mTraceIndex = 0;
+}
+
+bool ImpairmentNode::LoadTrace(const char* path)
+{
+    if (path == nullptr)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(path, "r");
+
+    if (file == nullptr)
+    {
+        IMLOGE1("[LoadTrace] failed to open[%s]", path);
+        return false;
+    }
+
+    std::vector<int32_t> trace;
+    char line[TRACE_LINE_MAX];
+    bool result = true;
+
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        char* token = line;
+
+        while (isspace(*token))
+        {
+            token++;
+        }
+
+        if (*token == '\0' || *token == '#')
+        {
+            continue;
+        }
+
+        char* end = token;
+
+        if (strncmp(token, "drop", 4) == 0)
+        {
+            trace.push_back(IMPAIRMENT_TRACE_DROP);
+            end = token + 4;
+        }
+        else
+        {
+            long delay = strtol(token, &end, 10);
+
+            if (end == token || delay < 0 || delay > INT32_MAX)
+            {
+                result = false;
+            }
+            else
+            {
+                trace.push_back(static_cast<int32_t>(delay));
+            }
+        }
+
+        while (isspace(*end))
+        {
+            end++;
+        }
+
+        if (!result || *end != '\0')
+        {
+            IMLOGE2("[LoadTrace] invalid entry[%s] at[%zu]", token, trace.size());
+            result = false;
+            break;
+        }
+    }
+
+    fclose(file);
+
+    if (!result || trace.empty())
+    {
+        return false;
+    }
+
+    IMLOGD2("[LoadTrace] path[%s], entries[%zu]", path, trace.size());
+    SetTrace(trace);
+    return true;
+}
+
+ImpairmentStats ImpairmentNode::GetStats()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mStats;
+}
+
+uint32_t ImpairmentNode::GetCurrentTime()
+{
+    return ImsMediaTimer::GetTimeInMilliSeconds();
+}
+
+bool ImpairmentNode::IsLost()
+{
+    std::uniform_real_distribution<double> probability(0.0, 1.0);
+    bool lost = probability(mRandom) < (mBadState ? mParams.lossRateBad : mParams.lossRateGood);
+
+    if (probability(mRandom) < (mBadState ? mParams.badToGoodRate : mParams.goodToBadRate))
+    {
+        mBadState = !mBadState;
+    }
+
+    return lost;
+}
+
+int32_t ImpairmentNode::GetRandomDelay()
+{
+    int32_t delay = mParams.delayMs;
+    int32_t jitter = mParams.jitterMs;
+
+    switch (mParams.distribution)
+    {
+        case kImpairmentDelayUniform:
+        {
+            std::uniform_int_distribution<int32_t> uniform(-jitter, jitter);
+            delay += uniform(mRandom);
+            break;
+        }
+        case kImpairmentDelayNormal:
+        {
+            if (jitter > 0)
+            {
+                std::normal_distribution<double> normal(0.0, jitter);
+                delay += static_cast<int32_t>(lround(normal(mRandom)));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return delay < 0 ? 0 : delay;
+}
+
+void ImpairmentNode::Schedule(ImpairedPacket&& packet)
+{
+    // the packets mostly come in the order of the release time, search from the back
+    auto iter = mPendingPackets.end();
+
+    while (iter != mPendingPackets.begin())
+    {
+        auto prev = std::prev(iter);
+
+        if (static_cast<int32_t>(prev->releaseTime - packet.releaseTime) <= 0)
+        {
+            break;
+        }
+
+        iter = prev;
+    }
+
+    mPendingPackets.insert(iter, std::move(packet));
+}
+
+void ImpairmentNode::Reset()
+{
+    mRandom.seed(mParams.seed);
+    mBadState = false;
+    mTraceIndex = 0;
+    mLastReleaseTime = 0;
+    mPendingPackets.clear();
+    memset(&mStats, 0, sizeof(mStats));
+}
@@ -18,8 +18,16 @@
 #include <AudioJitterBuffer.h>
 #include <VideoJitterBuffer.h>
 #include <TextJitterBuffer.h>
+#include <SessionLatencyStats.h>
+#include <ImsMediaMetrics.h>
 #include <ImsMediaTimer.h>
 
+// the valid flag and the sequence number stored above the time in the latency slot
+static inline uint64_t GetAddTimeTag(uint32_t seq)
+{
+    return (UINT64_C(1) << 63) | (static_cast<uint64_t>(seq & 0xFFFF) << 32);
+}
+
 JitterBufferControlNode::JitterBufferControlNode(BaseSessionCallback* callback, ImsMediaType type) :
         BaseNode(callback),
         mMediaType(type)
@@ -38,6 +46,13 @@ JitterBufferControlNode::JitterBufferControlNode(BaseSessionCallback* callback,
     }
 
     mJitterBuffer->SetSessionCallback(mCallback);
+
+    for (auto& addTime : mAddTime)
+    {
+        addTime.store(0, std::memory_order_relaxed);
+    }
+
+    mLastGetTime = 0;
 }
 
 JitterBufferControlNode::~JitterBufferControlNode()
@@ -81,8 +96,30 @@ void JitterBufferControlNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8
 {
     if (mJitterBuffer)
     {
+        if (mLatencyStats != nullptr && SessionLatencyStats::IsEnabled())
+        {
+            uint64_t currentTime = ImsMediaTimer::GetTimeInMicroSeconds();
+            // the arrival time is stamped by SocketReaderNode in milliseconds
+            uint32_t elapsed = static_cast<uint32_t>(currentTime / 1000) - arrivalTime;
+
+            if (arrivalTime != 0 && elapsed <= INT32_MAX)
+            {
+                mLatencyStats->AddPathLatency(
+                        kPathLatencySocketToJitterBuffer, static_cast<uint64_t>(elapsed) * 1000);
+            }
+
+            mAddTime[nSeqNum & (JITTER_BUFFER_LATENCY_SLOTS - 1)].store(
+                    GetAddTimeTag(nSeqNum) | static_cast<uint32_t>(currentTime),
+                    std::memory_order_relaxed);
+        }
+
         mJitterBuffer->Add(
                 subtype, pData, nDataSize, nTimestamp, bMark, nSeqNum, nDataType, arrivalTime);
+
+        if (mMetrics != nullptr)
+        {
+            mMetrics->SetGauge(kMetricJitterBufferCount, mJitterBuffer->GetCount());
+        }
     }
 }
 
@@ -102,8 +139,36 @@ bool JitterBufferControlNode::GetData(ImsMediaSubType* pSubtype, uint8_t** ppDat
 
     if (mJitterBuffer)
     {
-        return mJitterBuffer->Get(pSubtype, ppData, pnDataSize, pnTimestamp, pbMark, pnSeqNum,
-                ImsMediaTimer::GetTimeInMilliSeconds(), pnDataType);
+        uint32_t seq = 0;
+
+        if (pnSeqNum == nullptr)
+        {
+            pnSeqNum = &seq;
+        }
+
+        if (!mJitterBuffer->Get(pSubtype, ppData, pnDataSize, pnTimestamp, pbMark, pnSeqNum,
+                    ImsMediaTimer::GetTimeInMilliSeconds(), pnDataType))
+        {
+            return false;
+        }
+
+        if (mLatencyStats != nullptr && SessionLatencyStats::IsEnabled())
+        {
+            mLastGetTime = ImsMediaTimer::GetTimeInMicroSeconds();
+            std::atomic<uint64_t>& slot = mAddTime[*pnSeqNum & (JITTER_BUFFER_LATENCY_SLOTS - 1)];
+            uint64_t addTime = slot.load(std::memory_order_relaxed);
+
+            // the same packet can be read again until it is deleted, and the slot can be taken
+            // by the newer packet of the same index
+            if ((addTime & ~UINT64_C(0xFFFFFFFF)) == GetAddTimeTag(*pnSeqNum) &&
+                    slot.compare_exchange_strong(addTime, 0, std::memory_order_relaxed))
+            {
+                mLatencyStats->AddPathLatency(kPathLatencyJitterBufferDwell,
+                        static_cast<uint32_t>(mLastGetTime) - static_cast<uint32_t>(addTime));
+            }
+        }
+
+        return true;
     }
 
     return false;
@@ -126,5 +191,27 @@ void JitterBufferControlNode::DeleteData()
     if (mJitterBuffer)
     {
         mJitterBuffer->Delete();
+
+        if (mMetrics != nullptr)
+        {
+            mMetrics->SetGauge(kMetricJitterBufferCount, mJitterBuffer->GetCount());
+        }
     }
-}
\ No newline at end of file
+}
+
+void JitterBufferControlNode::AddPlayoutLatency()
+{
+    if (mLatencyStats == nullptr || mLastGetTime == 0 || !SessionLatencyStats::IsEnabled())
+    {
+        return;
+    }
+
+    uint64_t currentTime = ImsMediaTimer::GetTimeInMicroSeconds();
+
+    if (currentTime >= mLastGetTime)
+    {
+        mLatencyStats->AddPathLatency(kPathLatencyJitterBufferToPlayer, currentTime - mLastGetTime);
+    }
+
+    mLastGetTime = 0;
+}
@@ -148,6 +148,13 @@ void RtcpDecoderNode::OnRtcpInd(tRtpSvc_IndicationFromStack type, void* data)
             if (mMediaType == IMS_MEDIA_AUDIO)
             {
                 mCallback->SendEvent(kCollectPacketInfo, kStreamRtcp);
+
+                // the packet without the report block does not tell the loss
+                if (payload->numReportBlocks > 0)
+                {
+                    mCallback->SendEvent(
+                            kRequestAudioFractionLostUpdate, payload->stRecvRpt.fractionLost);
+                }
             }
 #ifdef DEBUG_BITRATE_CHANGE_SIMULATION
             else if (mMediaType == IMS_MEDIA_VIDEO)
@@ -167,6 +174,13 @@ void RtcpDecoderNode::OnRtcpInd(tRtpSvc_IndicationFromStack type, void* data)
             if (mMediaType == IMS_MEDIA_AUDIO)
             {
                 mCallback->SendEvent(kCollectPacketInfo, kStreamRtcp);
+
+                // the packet without the report block does not tell the loss
+                if (payload->numReportBlocks > 0)
+                {
+                    mCallback->SendEvent(
+                            kRequestAudioFractionLostUpdate, payload->stRecvRpt.fractionLost);
+                }
             }
 #ifdef DEBUG_BITRATE_CHANGE_SIMULATION
             else if (mMediaType == IMS_MEDIA_VIDEO)
@@ -17,6 +17,7 @@
 #include <RtcpEncoderNode.h>
 #include <ImsMediaTrace.h>
 #include <VideoConfig.h>
+#include <MediaQualityAnalyzer.h>
 
 #define RTCPFBMNGR_PLI_FIR_REQUEST_MIN_INTERVAL 1000
 
@@ -227,7 +228,23 @@ void RtcpEncoderNode::ProcessTimer()
 
     if (mRtcpXrBlockTypes != 0 && mRtcpInterval != 0 && mRtcpXrCounter % mRtcpInterval == 0)
     {
-        mCallback->SendEvent(kGetRtcpXrReportBlock, mRtcpXrBlockTypes);
+        MediaQualityAnalyzer* analyzer = mCallback->getMediaQualityAnalyzer();
+
+        if (analyzer != nullptr)
+        {
+            // the report blocks are encoded from the accumulated statistics, no event round trip
+            uint8_t reportBlock[MAX_BLOCK_LENGTH] = {0};
+            uint32_t size = 0;
+
+            if (analyzer->getRtcpXrReportBlock(mRtcpXrBlockTypes, reportBlock, size))
+            {
+                mRtpSession->SendRtcpXr(reportBlock, size);
+            }
+        }
+        else
+        {
+            mCallback->SendEvent(kGetRtcpXrReportBlock, mRtcpXrBlockTypes);
+        }
     }
 }
 
@@ -370,7 +387,5 @@ bool RtcpEncoderNode::SendRtcpXr(uint8_t* data, uint32_t size)
 
     // send buffer to packets
     mRtpSession->SendRtcpXr(data, size);
-
-    delete data;
     return true;
 }
\ No newline at end of file
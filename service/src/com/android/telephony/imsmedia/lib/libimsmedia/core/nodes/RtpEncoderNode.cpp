@@ -17,12 +17,17 @@
 #include <RtpEncoderNode.h>
 #include <ImsMediaTimer.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
 #include <ImsMediaVideoUtil.h>
 #include <AudioConfig.h>
 #include <VideoConfig.h>
 #include <TextConfig.h>
+#include <MediaQualityAnalyzer.h>
 #include <string.h>
 
+// the maximum number of the video packets of a frame sent in one call of the RtpStack
+#define MAX_VIDEO_PACKETS_IN_BATCH 64
+
 RtpEncoderNode::RtpEncoderNode(BaseSessionCallback* callback) :
         BaseNode(callback)
 {
@@ -153,6 +158,12 @@ void RtpEncoderNode::ProcessData()
         return;
     }
 
+    if (mMediaType == IMS_MEDIA_VIDEO)
+    {
+        ProcessVideoData();
+        return;
+    }
+
     ImsMediaSubType subtype;
     uint8_t* data = nullptr;
     uint32_t size = 0;
@@ -171,10 +182,6 @@ void RtpEncoderNode::ProcessData()
                 return;
             }
         }
-        else if (mMediaType == IMS_MEDIA_VIDEO)
-        {
-            ProcessVideoData(subtype, data, size, timestamp, mark);
-        }
         else if (mMediaType == IMS_MEDIA_TEXT)
         {
             ProcessTextData(subtype, data, size, timestamp, mark);
@@ -292,6 +299,7 @@ bool RtpEncoderNode::IsSameConfig(void* config)
 
 void RtpEncoderNode::OnRtpPacket(unsigned char* data, uint32_t nSize)
 {
+    IMTRACE_RTP_PACKET(kPacketTraceRtpEncode, mCallback, data, nSize);
     SendDataToRearNode(MEDIASUBTYPE_RTPPACKET, data, nSize, 0, 0, 0);
 }
 
@@ -307,7 +315,13 @@ void RtpEncoderNode::SetPeerAddress(const RtpAddress& address)
 
 bool RtpEncoderNode::SetCvoExtension(const int64_t facing, const int64_t orientation)
 {
-    IMLOGD3("[SetCvoExtension] cvoValue[%d], facing[%ld], orientation[%ld]", mCvoValue, facing,
+    std::lock_guard<std::mutex> guard(mMutex);
+    return BuildCvoExtension(facing, orientation);
+}
+
+bool RtpEncoderNode::BuildCvoExtension(const int64_t facing, const int64_t orientation)
+{
+    IMLOGD3("[BuildCvoExtension] cvoValue[%d], facing[%ld], orientation[%ld]", mCvoValue, facing,
             orientation);
 
     if (mCvoValue > 0)
@@ -349,18 +363,14 @@ bool RtpEncoderNode::SetCvoExtension(const int64_t facing, const int64_t orienta
             }
         }
 
-        int8_t extensionData[4];  // 32bit
-        IMLOGD3("[SetCvoExtension] cvoValue[%d], facing[%d], orientation[%d]", mCvoValue, cameraId,
+        IMLOGD3("[BuildCvoExtension] cvoValue[%d], facing[%d], orientation[%d]", mCvoValue, cameraId,
                 rotation);
 
-        extensionData[0] = (mCvoValue << 4) | 1;  // local identifier and data length
-        extensionData[1] = (cameraId << 3) | rotation;
-        extensionData[2] = 0;  // padding
-        extensionData[3] = 0;  // padding
-
-        mListRtpExtension.clear();
-        mListRtpExtension.push_back(RtpHeaderExtensionInfo(
-                RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, 1, extensionData, 4));
+        // camera and rotation followed by a zero byte, it is serialized once and reused for
+        // every IDR frame
+        const uint8_t extensionData[2] = {static_cast<uint8_t>((cameraId << 3) | rotation), 0};
+        mCvoExtension.Clear();
+        mCvoExtension.Add(mCvoValue, extensionData, sizeof(extensionData));
         return true;
     }
 
@@ -374,67 +384,19 @@ void RtpEncoderNode::SetRtpHeaderExtension(std::list<RtpHeaderExtension>* listEx
         return;
     }
 
-    /**
-     * Check number of byte of the header. Based on RFC8285 4.2, one byte header has a local
-     * identifier in range of 1 to 14. Two byte header has is a range of 1 to 255.
-     */
-    bool useTwoByteHeader = false;
-    int32_t totalPayloadLength = 0;  // accumulate payload length except the header size
+    RtpHeaderExtensionBlock block;
 
-    for (auto extension : *listExtension)
+    if (!block.Add(listExtension))
     {
-        if (extension.getLocalIdentifier() > 15)
-        {
-            useTwoByteHeader = true;
-        }
-
-        totalPayloadLength += extension.getExtensionDataSize();
-    }
-
-    // accumulate header size
-    useTwoByteHeader ? totalPayloadLength += 2 * listExtension->size()
-                     : totalPayloadLength += listExtension->size();
-
-    // padding size
-    int32_t paddingSize = totalPayloadLength % IMS_MEDIA_WORD_SIZE == 0
-            ? 0
-            : IMS_MEDIA_WORD_SIZE - totalPayloadLength % IMS_MEDIA_WORD_SIZE;
-    totalPayloadLength += paddingSize;
-
-    int8_t* extensionData = new int8_t[totalPayloadLength];
-    int offset = 0;
-
-    for (auto extension : *listExtension)
-    {
-        if (useTwoByteHeader)
-        {
-            extensionData[offset++] = extension.getLocalIdentifier();
-            extensionData[offset++] = extension.getExtensionDataSize();
-        }
-        else
-        {
-            extensionData[offset++] =
-                    extension.getLocalIdentifier() << 4 | (extension.getExtensionDataSize() - 1);
-        }
-
-        memcpy(extensionData + offset, extension.getExtensionData(),
-                extension.getExtensionDataSize());
-        offset += extension.getExtensionDataSize();
+        IMLOGE1("[SetRtpHeaderExtension] invalid extensions, list size[%d]", listExtension->size());
+        return;
     }
 
-    // add padding
-    memset(extensionData + offset, 0, paddingSize);
-
-    IMLOGD3("[SetRtpHeaderExtension] twoByte[%d], size[%d], list size[%d]", useTwoByteHeader,
-            totalPayloadLength, listExtension->size());
+    IMLOGD3("[SetRtpHeaderExtension] twoByte[%d], size[%d], list size[%d]", block.IsTwoByteHeader(),
+            block.GetDataSize(), listExtension->size());
 
-    int16_t defineByProfile = useTwoByteHeader
-            ? RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader
-            : RtpHeaderExtensionInfo::kBitPatternForOneByteHeader;
-    mListRtpExtension.push_back(RtpHeaderExtensionInfo(
-            defineByProfile, totalPayloadLength / 4, extensionData, totalPayloadLength));
-
-    delete[] extensionData;
+    std::lock_guard<std::mutex> guard(mMutex);
+    mListRtpExtension.push_back(block);
 }
 
 bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, uint32_t size)
@@ -508,10 +470,19 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
                 }
             }
 
-            RtpPacket* packet = new RtpPacket();
-            packet->rtpDataType = kRtpDataTypeNormal;
-            mCallback->SendEvent(
-                    kCollectPacketInfo, kStreamRtpTx, reinterpret_cast<uint64_t>(packet));
+            MediaQualityAnalyzer* analyzer = mCallback->getMediaQualityAnalyzer();
+
+            if (analyzer != nullptr)
+            {
+                analyzer->reportTxRtpPacket();
+            }
+            else
+            {
+                RtpPacket* packet = new RtpPacket();
+                packet->rtpDataType = kRtpDataTypeNormal;
+                mCallback->SendEvent(
+                        kCollectPacketInfo, kStreamRtpTx, reinterpret_cast<uint64_t>(packet));
+            }
 
             timestampDiff = timeDiff * mSamplingRate;
             IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[ProcessAudioData] size[%u], TS[%u], diff[%d]", size,
@@ -519,8 +490,9 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
 
             if (!mListRtpExtension.empty())
             {
+                RtpHeaderExtensionInfo extensionInfo = mListRtpExtension.front().GetInfo();
                 mRtpSession->SendRtpPacket(mRtpPayloadTx, data, size, currentTimestamp, mMark,
-                        timestampDiff, &mListRtpExtension.front());
+                        timestampDiff, &extensionInfo);
                 mListRtpExtension.pop_front();
             }
             else
@@ -539,11 +511,49 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
     return true;
 }
 
-void RtpEncoderNode::ProcessVideoData(
-        ImsMediaSubType subtype, uint8_t* data, uint32_t size, uint32_t timestamp, bool mark)
+void RtpEncoderNode::ProcessVideoData()
 {
-    IMLOGD_PACKET4(IM_PACKET_LOG_RTP, "[ProcessVideoData] subtype[%d], size[%d], TS[%u], mark[%d]",
-            subtype, size, timestamp, mark);
+    tRTP_PAYLOAD_SLICE slices[MAX_VIDEO_PACKETS_IN_BATCH];
+    uint32_t numSlices = 0;
+    uint32_t timestamp = 0;
+    bool hasExtension = false;
+    DataEntry* entry = nullptr;
+
+    // collect the packets of the same frame queued so far, up to the marked one
+    while (numSlices < MAX_VIDEO_PACKETS_IN_BATCH && mDataQueue.GetAt(numSlices, &entry))
+    {
+        if (numSlices > 0 && entry->nTimestamp != timestamp)
+        {
+            break;
+        }
+
+        timestamp = entry->nTimestamp;
+        tRTP_PAYLOAD_SLICE& slice = slices[numSlices++];
+        slice.pucPayload = entry->pbBuffer;
+        slice.usPayloadLen = entry->nBufferSize;
+        slice.bMarker = entry->bMark ? eRTP_TRUE : eRTP_FALSE;
+        slice.usPktLen = 0;
+
+        // the cvo extension is sent with the last packet of the IDR frame
+        bool extension = mCvoValue > 0 && entry->bMark &&
+                entry->subtype == MEDIASUBTYPE_VIDEO_IDR_FRAME;
+        slice.bExtension = extension ? eRTP_TRUE : eRTP_FALSE;
+        hasExtension |= extension;
+
+        IMLOGD_PACKET4(IM_PACKET_LOG_RTP,
+                "[ProcessVideoData] subtype[%d], size[%d], TS[%u], mark[%d]", entry->subtype,
+                entry->nBufferSize, entry->nTimestamp, entry->bMark);
+
+        if (entry->bMark)
+        {
+            break;
+        }
+    }
+
+    if (numSlices == 0)
+    {
+        return;
+    }
 
 #ifdef SIMULATE_VIDEO_CVO_UPDATE
     const int64_t kCameraFacing = kCameraFacingFront;
@@ -551,18 +561,23 @@ void RtpEncoderNode::ProcessVideoData(
     static int64_t sCount = 0;
     if ((++sCount % 100) == 0)
     {
-        SetCvoExtension(kCameraFacing, (sDeviceOrientation += 90) % 360);
+        BuildCvoExtension(kCameraFacing, (sDeviceOrientation += 90) % 360);
     }
 #endif
 
-    if (mCvoValue > 0 && mark && subtype == MEDIASUBTYPE_VIDEO_IDR_FRAME)
+    if (hasExtension && !mCvoExtension.IsEmpty())
     {
-        mRtpSession->SendRtpPacket(mRtpPayloadTx, data, size, timestamp, mark, 0,
-                mListRtpExtension.empty() ? nullptr : &mListRtpExtension.front());
+        RtpHeaderExtensionInfo extensionInfo = mCvoExtension.GetInfo();
+        mRtpSession->SendRtpPackets(mRtpPayloadTx, slices, numSlices, timestamp, &extensionInfo);
     }
     else
     {
-        mRtpSession->SendRtpPacket(mRtpPayloadTx, data, size, timestamp, mark, 0);
+        mRtpSession->SendRtpPackets(mRtpPayloadTx, slices, numSlices, timestamp);
+    }
+
+    for (uint32_t i = 0; i < numSlices; i++)
+    {
+        DeleteData();
     }
 }
 
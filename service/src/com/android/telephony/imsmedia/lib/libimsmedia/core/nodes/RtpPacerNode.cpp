@@ -0,0 +1,372 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpPacerNode.h>
+#include <ImsMediaMetrics.h>
+#include <ImsMediaTimer.h>
+#include <ImsMediaTrace.h>
+#include <VideoConfig.h>
+#include <string.h>
+#include <algorithm>
+
+#define MICROSECONDS_PER_SECOND 1000000.0
+
+RtpPacerNode::RtpPacerNode(BaseSessionCallback* callback) :
+        BaseNode(callback)
+{
+    mQueuedCount = 0;
+    mQueuedBytes = 0;
+    mTargetBitrate = 0;
+    mRateFactor = RTP_PACER_DEFAULT_RATE_FACTOR;
+    mPacingRate = 0;
+    mBurstSize = RTP_PACER_DEFAULT_BURST_SIZE;
+    mMaxQueueDelay = RTP_PACER_DEFAULT_MAX_QUEUE_DELAY;
+    mDraining = false;
+    mTokens = 0;
+    mLastFillTime = 0;
+    memset(&mStats, 0, sizeof(mStats));
+}
+
+RtpPacerNode::~RtpPacerNode() {}
+
+kBaseNodeId RtpPacerNode::GetNodeId()
+{
+    return kNodeIdRtpPacer;
+}
+
+ImsMediaResult RtpPacerNode::Start()
+{
+    IMLOGD3("[Start] media[%d], rate[%u], burst[%u]", mMediaType, mPacingRate, mBurstSize);
+    std::lock_guard<std::mutex> guard(mMutex);
+    Reset();
+    mNodeState = kNodeStateRunning;
+    return RESULT_SUCCESS;
+}
+
+void RtpPacerNode::Stop()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    IMLOGD4("[Stop] sent audio[%u], rtcp[%u], retransmission[%u], video[%u]",
+            mStats.sent[kRtpPacerPriorityAudio], mStats.sent[kRtpPacerPriorityRtcp],
+            mStats.sent[kRtpPacerPriorityRetransmission], mStats.sent[kRtpPacerPriorityVideo]);
+    IMLOGD2("[Stop] max queue delay rtcp[%u], video[%u]",
+            mStats.maxQueueDelay[kRtpPacerPriorityRtcp],
+            mStats.maxQueueDelay[kRtpPacerPriorityVideo]);
+
+    for (auto& queue : mQueues)
+    {
+        queue.clear();
+    }
+
+    mQueuedCount = 0;
+    mQueuedBytes = 0;
+    mNodeState = kNodeStateStopped;
+}
+
+bool RtpPacerNode::IsRunTime()
+{
+    return false;
+}
+
+bool RtpPacerNode::IsSourceNode()
+{
+    return false;
+}
+
+void RtpPacerNode::SetConfig(void* config)
+{
+    if (config == nullptr || mMediaType != IMS_MEDIA_VIDEO)
+    {
+        return;
+    }
+
+    VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(config);
+    SetTargetBitrate(pConfig->getBitrate() * 1000);
+}
+
+bool RtpPacerNode::IsSameConfig(void* config)
+{
+    if (config == nullptr || mMediaType != IMS_MEDIA_VIDEO)
+    {
+        return true;
+    }
+
+    VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(config);
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mTargetBitrate == static_cast<uint32_t>(pConfig->getBitrate() * 1000);
+}
+
+ImsMediaResult RtpPacerNode::UpdateConfig(void* config)
+{
+    // keep the queued packets and only update the pacing rate
+    if (!IsSameConfig(config))
+    {
+        SetConfig(config);
+    }
+
+    return RESULT_SUCCESS;
+}
+
+void RtpPacerNode::ProcessData()
+{
+    uint64_t currentTime = GetCurrentTime();
+    std::list<PacedPacket> duePackets;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        FillTokens(currentTime);
+
+        // the lower priority waits while the higher priority packet does not have the tokens
+        for (int32_t priority = 0; priority < kRtpPacerPriorityMax; priority++)
+        {
+            std::list<PacedPacket>& queue = mQueues[priority];
+
+            if (priority > 0 && !mQueues[priority - 1].empty())
+            {
+                break;
+            }
+
+            while (!queue.empty())
+            {
+                PacedPacket& packet = queue.front();
+                uint32_t delay = currentTime - packet.queuedTime;
+
+                if (mPacingRate != 0)
+                {
+                    // the packet larger than the bucket waits for the full bucket
+                    uint32_t required = std::min<uint32_t>(packet.data.size(), mBurstSize);
+                    bool overdue = mMaxQueueDelay != 0 && delay >= mMaxQueueDelay * 1000;
+
+                    if (mTokens < required && !overdue)
+                    {
+                        break;
+                    }
+
+                    mTokens -= packet.data.size();
+                }
+
+                if (delay > mStats.maxQueueDelay[priority])
+                {
+                    mStats.maxQueueDelay[priority] = delay;
+                }
+
+                if (mMetrics != nullptr)
+                {
+                    mMetrics->AddHistogram(kMetricPacerQueueDelay, delay);
+                }
+
+                mStats.sent[priority]++;
+                mQueuedCount--;
+                mQueuedBytes -= packet.data.size();
+                duePackets.splice(duePackets.end(), queue, queue.begin());
+            }
+        }
+
+        if (duePackets.empty())
+        {
+            return;
+        }
+
+        if (mMetrics != nullptr)
+        {
+            mMetrics->SetGauge(kMetricPacerQueueBytes, mQueuedBytes);
+        }
+
+        mDraining = true;
+    }
+
+    for (auto& packet : duePackets)
+    {
+        SendDataToRearNode(packet.subtype, packet.data.data(), packet.data.size(),
+                packet.timestamp, packet.mark, packet.seq, packet.dataType);
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    mDraining = false;
+}
+
+uint32_t RtpPacerNode::GetDataCount()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mQueuedCount;
+}
+
+void RtpPacerNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+        uint32_t timestamp, bool mark, uint32_t seq, ImsMediaSubType dataType,
+        uint32_t /*arrivalTime*/)
+{
+    kRtpPacerPriority priority = kRtpPacerPriorityVideo;
+
+    if (subtype == MEDIASUBTYPE_RTCPPACKET || subtype == MEDIASUBTYPE_RTCPPACKET_BYE)
+    {
+        priority = kRtpPacerPriorityRtcp;
+    }
+    else if (mMediaType == IMS_MEDIA_AUDIO)
+    {
+        priority = kRtpPacerPriorityAudio;
+    }
+
+    EnqueuePacket(priority, subtype, data, size, timestamp, mark, seq, dataType);
+}
+
+void RtpPacerNode::EnqueuePacket(kRtpPacerPriority priority, ImsMediaSubType subtype,
+        uint8_t* data, uint32_t size, uint32_t timestamp, bool mark, uint32_t seq,
+        ImsMediaSubType dataType)
+{
+    if (data == nullptr || size == 0 || priority >= kRtpPacerPriorityMax)
+    {
+        return;
+    }
+
+    uint64_t currentTime = GetCurrentTime();
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStats.received[priority]++;
+
+        if (mPacingRate != 0 || mQueuedCount != 0 || mDraining)
+        {
+            mQueues[priority].push_back({currentTime, subtype,
+                    std::vector<uint8_t>(data, data + size), timestamp, mark, seq, dataType});
+            mQueuedCount++;
+            mQueuedBytes += size;
+
+            if (mMetrics != nullptr)
+            {
+                mMetrics->SetGauge(kMetricPacerQueueBytes, mQueuedBytes);
+            }
+
+            return;
+        }
+
+        mStats.sent[priority]++;
+    }
+
+    // pass through when the pacing is disabled and no packet is waiting or being sent
+    SendDataToRearNode(subtype, data, size, timestamp, mark, seq, dataType);
+}
+
+void RtpPacerNode::SetTargetBitrate(uint32_t bitrate)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mTargetBitrate = bitrate;
+    UpdatePacingRate();
+}
+
+void RtpPacerNode::SetRateFactor(double factor)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mRateFactor = factor < 1.0 ? 1.0 : factor;
+    UpdatePacingRate();
+}
+
+void RtpPacerNode::SetBurstSize(uint32_t size)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mBurstSize = size;
+
+    if (mTokens > mBurstSize)
+    {
+        mTokens = mBurstSize;
+    }
+}
+
+void RtpPacerNode::SetMaxQueueDelay(uint32_t delay)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mMaxQueueDelay = delay;
+}
+
+uint32_t RtpPacerNode::GetPacingRate()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mPacingRate;
+}
+
+RtpPacerStats RtpPacerNode::GetStats()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mStats;
+}
+
+uint64_t RtpPacerNode::GetCurrentTime()
+{
+    return ImsMediaTimer::GetTimeInMicroSeconds();
+}
+
+void RtpPacerNode::FillTokens(uint64_t currentTime)
+{
+    if (mLastFillTime == 0 || currentTime < mLastFillTime)
+    {
+        mTokens = mBurstSize;
+    }
+    else
+    {
+        uint32_t rate = GetDrainRate(currentTime);
+        double tokens = rate / 8.0 * (currentTime - mLastFillTime) / MICROSECONDS_PER_SECOND;
+        // the bucket takes more than the burst size to keep up the raised rate
+        double size = rate > mPacingRate ? std::max<double>(mBurstSize, tokens) : mBurstSize;
+        mTokens = std::min(mTokens + tokens, size);
+    }
+
+    mLastFillTime = currentTime;
+}
+
+uint32_t RtpPacerNode::GetDrainRate(uint64_t currentTime)
+{
+    if (mMaxQueueDelay == 0 || mQueuedBytes == 0)
+    {
+        return mPacingRate;
+    }
+
+    uint64_t oldestTime = currentTime;
+
+    for (auto& queue : mQueues)
+    {
+        if (!queue.empty())
+        {
+            oldestTime = std::min(oldestTime, queue.front().queuedTime);
+        }
+    }
+
+    // the rate to send the queued bytes until the oldest packet reaches the max queue delay
+    uint64_t maxDelay = mMaxQueueDelay * 1000ULL;
+    uint64_t waited = currentTime - oldestTime;
+    uint64_t remaining = waited + 1000 < maxDelay ? maxDelay - waited : 1000;
+    double drainRate = mQueuedBytes * 8.0 * MICROSECONDS_PER_SECOND / remaining;
+    return std::max(mPacingRate, static_cast<uint32_t>(std::min<double>(drainRate, UINT32_MAX)));
+}
+
+void RtpPacerNode::UpdatePacingRate()
+{
+    mPacingRate = static_cast<uint32_t>(mTargetBitrate * mRateFactor);
+    IMLOGD3("[UpdatePacingRate] target[%u], factor[%f], rate[%u]", mTargetBitrate, mRateFactor,
+            mPacingRate);
+}
+
+void RtpPacerNode::Reset()
+{
+    for (auto& queue : mQueues)
+    {
+        queue.clear();
+    }
+
+    mQueuedCount = 0;
+    mQueuedBytes = 0;
+    mTokens = 0;
+    mLastFillTime = 0;
+    memset(&mStats, 0, sizeof(mStats));
+}
@@ -17,6 +17,8 @@
 #include <SocketReaderNode.h>
 #include <ImsMediaTrace.h>
 #include <ImsMediaTimer.h>
+#include <ImsMediaPacketTracer.h>
+#include <ImsMediaMetrics.h>
 #include <thread>
 
 #define MAX_BUFFER_QUEUE 250  // 5 sec in audio case.
@@ -28,6 +30,7 @@ SocketReaderNode::SocketReaderNode(BaseSessionCallback* callback) :
     mSocket = nullptr;
     mReceiveTtl = false;
     mSocketOpened = false;
+    mLastReceivedTime = 0;
 }
 
 SocketReaderNode::~SocketReaderNode()
@@ -54,6 +57,7 @@ bool SocketReaderNode::Prepare()
 ImsMediaResult SocketReaderNode::Start()
 {
     ClearDataQueue();  // clear the old data stacked
+    mLastReceivedTime = 0;
 
     if (mSocketOpened)
     {
@@ -205,6 +209,11 @@ void SocketReaderNode::OnReadDataFromSocket()
     if (mDataQueue.GetCount() > MAX_BUFFER_QUEUE)
     {
         mDataQueue.Delete();
+
+        if (mMetrics != nullptr)
+        {
+            mMetrics->AddCounter(kMetricSocketQueueDropped);
+        }
     }
 
     if (mSocketOpened && mSocket != nullptr)
@@ -216,6 +225,8 @@ void SocketReaderNode::OnReadDataFromSocket()
             IMLOGD_PACKET3(IM_PACKET_LOG_SOCKET,
                     "[OnReadDataFromSocket] media[%d], data size[%d], queue size[%d]", mMediaType,
                     nLen, GetDataCount());
+            IMTRACE_RTP_PACKET(kPacketTraceSocketRead, mCallback, mBuffer, nLen);
+            UpdateMetrics(nLen);
 
             OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, mBuffer, nLen, 0, 0, 0,
                     MEDIASUBTYPE_UNDEFINED, ImsMediaTimer::GetTimeInMilliSeconds());
@@ -223,6 +234,31 @@ void SocketReaderNode::OnReadDataFromSocket()
     }
 }
 
+void SocketReaderNode::UpdateMetrics(uint32_t size)
+{
+    if (mMetrics == nullptr)
+    {
+        return;
+    }
+
+    if (mProtocolType == kProtocolRtcp)
+    {
+        mMetrics->AddCounter(kMetricRtcpPacketsReceived);
+        return;
+    }
+
+    uint64_t currentTime = ImsMediaTimer::GetTimeInMicroSeconds();
+
+    if (mLastReceivedTime != 0 && currentTime >= mLastReceivedTime)
+    {
+        mMetrics->AddHistogram(kMetricRtpInterArrivalTime, currentTime - mLastReceivedTime);
+    }
+
+    mLastReceivedTime = currentTime;
+    mMetrics->AddCounter(kMetricRtpPacketsReceived);
+    mMetrics->AddCounter(kMetricRtpBytesReceived, size);
+}
+
 void SocketReaderNode::SetLocalFd(int fd)
 {
     mLocalFd = fd;
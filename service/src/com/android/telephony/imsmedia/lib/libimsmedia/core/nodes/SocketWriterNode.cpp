@@ -16,6 +16,8 @@
 
 #include <SocketWriterNode.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
+#include <ImsMediaMetrics.h>
 
 SocketWriterNode::SocketWriterNode(BaseSessionCallback* callback) :
         BaseNode(callback)
@@ -161,7 +163,21 @@ void SocketWriterNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pDa
         return;
     }
 
+    IMTRACE_RTP_PACKET(kPacketTraceSocketWrite, mCallback, pData, nDataSize);
     mSocket->SendTo(pData, nDataSize);
+
+    if (mMetrics != nullptr)
+    {
+        if (mProtocolType == kProtocolRtcp)
+        {
+            mMetrics->AddCounter(kMetricRtcpPacketsSent);
+        }
+        else
+        {
+            mMetrics->AddCounter(kMetricRtpPacketsSent);
+            mMetrics->AddCounter(kMetricRtpBytesSent, nDataSize);
+        }
+    }
 }
 
 void SocketWriterNode::SetLocalFd(int fd)
@@ -16,6 +16,7 @@
 
 #include <TextJitterBuffer.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
 
 TextJitterBuffer::TextJitterBuffer() :
         BaseJitterBuffer()
@@ -39,6 +40,7 @@ void TextJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* buffer, uint32_t si
     IMLOGD_PACKET6(IM_PACKET_LOG_JITTER,
             "[Add] seq[%u], mark[%u], TS[%u], size[%u], lastPlayedSeq[%u], arrivalTime[%u]", seqNum,
             mark, timestamp, size, mLastPlayedSeqNum, arrivalTime);
+    IMTRACE_PACKET(kPacketTraceJitterAdd, mCallback, seqNum, timestamp, size);
 
     std::lock_guard<std::mutex> guard(mMutex);
 
@@ -129,6 +131,8 @@ bool TextJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** data, uint32_t* d
         IMLOGD_PACKET5(IM_PACKET_LOG_JITTER,
                 "[Get] OK - seq[%u], mark[%u], TS[%u], size[%u], queue[%u]", pEntry->nSeqNum,
                 pEntry->bMark, pEntry->nTimestamp, pEntry->nBufferSize, mDataQueue.GetCount());
+        IMTRACE_PACKET(kPacketTraceJitterGet, mCallback, pEntry->nSeqNum, pEntry->nTimestamp,
+                pEntry->nBufferSize);
 
         return true;
     }
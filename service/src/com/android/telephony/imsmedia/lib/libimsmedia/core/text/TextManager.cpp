@@ -15,16 +15,18 @@
  */
 
 #include <TextManager.h>
+#include <ImsMediaEventHandlerId.h>
 #include <ImsMediaTrace.h>
 #include <ImsMediaNetworkUtil.h>
 
 using namespace android;
+
 TextManager* TextManager::manager;
 
 TextManager::TextManager()
 {
-    mRequestHandler.Init("TEXT_REQUEST_EVENT");
-    mResponseHandler.Init("TEXT_RESPONSE_EVENT");
+    mRequestHandler.Init(TEXT_REQUEST_EVENT);
+    mResponseHandler.Init(TEXT_RESPONSE_EVENT);
 }
 
 TextManager::~TextManager()
@@ -167,26 +169,25 @@ void TextManager::sendMessage(const int sessionId, const android::Parcel& parcel
         {
             int rtpFd = parcel.readInt32();
             int rtcpFd = parcel.readInt32();
-            TextConfig* config = new TextConfig();
-            err = config->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<TextConfig>();
+            err = payload.Get<TextConfig>()->readFromParcel(&parcel);
 
             if (err != NO_ERROR && err != -ENODATA)
             {
                 IMLOGE1("[sendMessage] error readFromParcel[%d]", err);
             }
 
-            EventParamOpenSession* param = new EventParamOpenSession(rtpFd, rtcpFd, config);
             ImsMediaEventHandler::SendEvent(
-                    "TEXT_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(param));
+                    kTextRequestHandler, nMsg, std::move(payload), sessionId, rtpFd, rtcpFd);
         }
         break;
         case kTextCloseSession:
-            ImsMediaEventHandler::SendEvent("TEXT_REQUEST_EVENT", nMsg, sessionId);
+            ImsMediaEventHandler::SendEvent(kTextRequestHandler, nMsg, sessionId);
             break;
         case kTextModifySession:
         {
-            TextConfig* config = new TextConfig();
-            config->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<TextConfig>();
+            payload.Get<TextConfig>()->readFromParcel(&parcel);
 
             if (err != NO_ERROR)
             {
@@ -194,24 +195,23 @@ void TextManager::sendMessage(const int sessionId, const android::Parcel& parcel
             }
 
             ImsMediaEventHandler::SendEvent(
-                    "TEXT_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(config));
+                    kTextRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         case kTextSetMediaQualityThreshold:
         {
-            MediaQualityThreshold* threshold = new MediaQualityThreshold();
-            threshold->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<MediaQualityThreshold>();
+            payload.Get<MediaQualityThreshold>()->readFromParcel(&parcel);
             ImsMediaEventHandler::SendEvent(
-                    "TEXT_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(threshold));
+                    kTextRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         case kTextSendRtt:
         {
             android::String16 text;
             parcel.readString16(&text);
-            android::String8* rttText = new String8(text.string());
-            ImsMediaEventHandler::SendEvent(
-                    "TEXT_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(rttText));
+            ImsMediaEventHandler::SendEvent(kTextRequestHandler, nMsg,
+                    ImsMediaEventPayload::Create<android::String8>(text.string()), sessionId);
         }
         break;
         default:
@@ -219,8 +219,8 @@ void TextManager::sendMessage(const int sessionId, const android::Parcel& parcel
     }
 }
 
-void TextManager::RequestHandler::processEvent(
-        uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB)
+void TextManager::RequestHandler::processEvent(uint32_t event, uint64_t sessionId,
+        uint64_t paramA, uint64_t paramB, ImsMediaEventPayload& payload)
 {
     IMLOGI4("[processEvent] event[%d], sessionId[%d], paramA[%d], paramB[%d]", event, sessionId,
             paramA, paramB);
@@ -230,35 +230,18 @@ void TextManager::RequestHandler::processEvent(
     {
         case kTextOpenSession:
         {
-            EventParamOpenSession* param = reinterpret_cast<EventParamOpenSession*>(paramA);
-            if (param != nullptr)
+            result = TextManager::getInstance()->openSession(static_cast<int>(sessionId),
+                    static_cast<int>(paramA), static_cast<int>(paramB), payload.Get<TextConfig>());
+
+            if (result == RESULT_SUCCESS)
             {
-                TextConfig* pConfig = reinterpret_cast<TextConfig*>(param->mConfig);
-                result = TextManager::getInstance()->openSession(
-                        static_cast<int>(sessionId), param->rtpFd, param->rtcpFd, pConfig);
-
-                if (result == RESULT_SUCCESS)
-                {
-                    ImsMediaEventHandler::SendEvent(
-                            "TEXT_RESPONSE_EVENT", kTextOpenSessionSuccess, sessionId);
-                }
-                else
-                {
-                    ImsMediaEventHandler::SendEvent(
-                            "TEXT_RESPONSE_EVENT", kTextOpenSessionFailure, sessionId, result);
-                }
-
-                delete param;
-
-                if (pConfig != nullptr)
-                {
-                    delete pConfig;
-                }
+                ImsMediaEventHandler::SendEvent(
+                        kTextResponseHandler, kTextOpenSessionSuccess, sessionId);
             }
             else
             {
-                ImsMediaEventHandler::SendEvent("TEXT_RESPONSE_EVENT", kTextOpenSessionFailure,
-                        sessionId, RESULT_INVALID_PARAM);
+                ImsMediaEventHandler::SendEvent(
+                        kTextResponseHandler, kTextOpenSessionFailure, sessionId, result);
             }
         }
         break;
@@ -267,37 +250,36 @@ void TextManager::RequestHandler::processEvent(
                     RESULT_SUCCESS)
             {
                 ImsMediaEventHandler::SendEvent(
-                        "TEXT_RESPONSE_EVENT", kTextSessionClosed, sessionId, 0, 0);
+                        kTextResponseHandler, kTextSessionClosed, sessionId, 0, 0);
             }
             break;
         case kTextModifySession:
         {
-            TextConfig* config = reinterpret_cast<TextConfig*>(paramA);
+            TextConfig* config = payload.Get<TextConfig>();
             result = TextManager::getInstance()->modifySession(static_cast<int>(sessionId), config);
-            ImsMediaEventHandler::SendEvent(
-                    "TEXT_RESPONSE_EVENT", kTextModifySessionResponse, sessionId, result, paramA);
+            // the config is sent back with the response
+            ImsMediaEventHandler::SendEvent(kTextResponseHandler, kTextModifySessionResponse,
+                    std::move(payload), sessionId, result);
         }
         break;
         case kTextSetMediaQualityThreshold:
         {
-            MediaQualityThreshold* threshold = reinterpret_cast<MediaQualityThreshold*>(paramA);
+            MediaQualityThreshold* threshold = payload.Get<MediaQualityThreshold>();
 
             if (threshold != nullptr)
             {
                 TextManager::getInstance()->setMediaQualityThreshold(
                         static_cast<int>(sessionId), threshold);
-                delete threshold;
             }
         }
         break;
         case kTextSendRtt:
         {
-            android::String8* text = reinterpret_cast<android::String8*>(paramA);
+            android::String8* text = payload.Get<android::String8>();
 
             if (text != nullptr)
             {
                 TextManager::getInstance()->sendRtt(static_cast<int>(sessionId), text);
-                delete text;
             }
         }
         break;
@@ -306,8 +288,8 @@ void TextManager::RequestHandler::processEvent(
     }
 }
 
-void TextManager::ResponseHandler::processEvent(
-        uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB)
+void TextManager::ResponseHandler::processEvent(uint32_t event, uint64_t sessionId,
+        uint64_t paramA, uint64_t paramB, ImsMediaEventPayload& payload)
 {
     IMLOGI4("[processEvent] event[%d], sessionId[%d], paramA[%d], paramB[%d]", event, sessionId,
             paramA, paramB);
@@ -331,13 +313,12 @@ void TextManager::ResponseHandler::processEvent(
         {
             parcel.writeInt32(event);
             parcel.writeInt32(paramA);  // result
-            TextConfig* config = reinterpret_cast<TextConfig*>(paramB);
+            TextConfig* config = payload.Get<TextConfig>();
 
             if (config != nullptr)
             {
                 config->writeToParcel(&parcel);
                 TextManager::getInstance()->sendResponse(sessionId, parcel);
-                delete config;
             }
         }
         break;
@@ -350,14 +331,13 @@ void TextManager::ResponseHandler::processEvent(
         case kTextRttReceived:
         {
             parcel.writeInt32(event);
-            android::String8* text = reinterpret_cast<String8*>(paramA);
+            android::String8* text = payload.Get<android::String8>();
 
             if (text != nullptr)
             {
                 String16 rttText(*text);
                 parcel.writeString16(rttText);
                 TextManager::getInstance()->sendResponse(sessionId, parcel);
-                delete text;
             }
         }
         break;
@@ -16,12 +16,13 @@
 
 #include <TextSession.h>
 #include <ImsMediaTrace.h>
-#include <ImsMediaEventHandler.h>
+#include <ImsMediaEventHandlerId.h>
 #include <TextConfig.h>
 #include <string>
 #include <sys/socket.h>
 
-TextSession::TextSession()
+TextSession::TextSession() :
+        BaseSession(IMS_MEDIA_TEXT)
 {
     IMLOGD0("[TextSession]");
     mGraphRtpTx = nullptr;
@@ -220,11 +221,12 @@ void TextSession::onEvent(int32_t type, uint64_t param1, uint64_t param2)
             break;
         case kImsMediaEventMediaInactivity:
             ImsMediaEventHandler::SendEvent(
-                    "TEXT_RESPONSE_EVENT", kTextMediaInactivityInd, mSessionId, param1, param2);
+                    kTextResponseHandler, kTextMediaInactivityInd, mSessionId, param1, param2);
             break;
         case kImsMediaEventNotifyRttReceived:
-            ImsMediaEventHandler::SendEvent(
-                    "TEXT_RESPONSE_EVENT", kTextRttReceived, mSessionId, param1, param2);
+            ImsMediaEventHandler::SendEvent(kTextResponseHandler, kTextRttReceived,
+                    ImsMediaEventPayload::Adopt(reinterpret_cast<android::String8*>(param1)),
+                    mSessionId);
             break;
         default:
             break;
@@ -0,0 +1,211 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ImsMediaBitPacker.h>
+#include <endian.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define BIT_PACKER_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BIT_PACKER_NEON
+#endif
+
+#define BIT_PACKER_SIMD_SIZE 16
+
+#if defined(BIT_PACKER_SSE2) || defined(BIT_PACKER_NEON)
+static bool sSimdEnabled = true;
+#else
+static bool sSimdEnabled = false;
+#endif
+
+namespace
+{
+// Shift the bytes to the left by kShift bits pulling in the high bits of the following byte,
+// dst[i] = (src[i] << kShift) | (src[i + 1] >> (8 - kShift)) for i < nSize. The byte src[nSize]
+// is read and should be valid.
+template <uint32_t kShift>
+void funnelShift(uint8_t* dst, const uint8_t* src, uint32_t nSize)
+{
+    static_assert(kShift > 0 && kShift < 8, "the aligned bytes are copied");
+    uint32_t i = 0;
+
+#if defined(BIT_PACKER_SSE2)
+    if (sSimdEnabled)
+    {
+        // SSE2 has no byte shift, the 16 bit lanes are shifted and the bits crossing the bytes
+        // are masked out
+        const __m128i highMask = _mm_set1_epi8(static_cast<char>(0xFF << kShift));
+        const __m128i lowMask = _mm_set1_epi8(static_cast<char>(0xFF >> (8 - kShift)));
+
+        for (; i + BIT_PACKER_SIMD_SIZE <= nSize; i += BIT_PACKER_SIMD_SIZE)
+        {
+            __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1));
+            __m128i value = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(current, kShift), highMask),
+                    _mm_and_si128(_mm_srli_epi16(next, 8 - kShift), lowMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+        }
+    }
+#elif defined(BIT_PACKER_NEON)
+    if (sSimdEnabled)
+    {
+        for (; i + BIT_PACKER_SIMD_SIZE <= nSize; i += BIT_PACKER_SIMD_SIZE)
+        {
+            uint8x16_t current = vld1q_u8(src + i);
+            uint8x16_t next = vld1q_u8(src + i + 1);
+            vst1q_u8(dst + i, vsriq_n_u8(vshlq_n_u8(current, kShift), next, 8 - kShift));
+        }
+    }
+#endif
+
+    for (; i + sizeof(uint64_t) <= nSize; i += sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, src + i, sizeof(value));
+        value = (be64toh(value) << kShift) | (src[i + sizeof(value)] >> (8 - kShift));
+        value = htobe64(value);
+        memcpy(dst + i, &value, sizeof(value));
+    }
+
+    for (; i < nSize; i++)
+    {
+        dst[i] = (src[i] << kShift) | (src[i + 1] >> (8 - kShift));
+    }
+}
+
+void funnelShift(uint8_t* dst, const uint8_t* src, uint32_t nSize, uint32_t nShift)
+{
+    switch (nShift)
+    {
+        case 1:
+            funnelShift<1>(dst, src, nSize);
+            break;
+        case 2:
+            funnelShift<2>(dst, src, nSize);
+            break;
+        case 3:
+            funnelShift<3>(dst, src, nSize);
+            break;
+        case 4:
+            funnelShift<4>(dst, src, nSize);
+            break;
+        case 5:
+            funnelShift<5>(dst, src, nSize);
+            break;
+        case 6:
+            funnelShift<6>(dst, src, nSize);
+            break;
+        case 7:
+            funnelShift<7>(dst, src, nSize);
+            break;
+        default:
+            break;
+    }
+}
+
+// Clear the bits of the last byte after the given number of bits
+inline void clearTrailingBits(uint8_t* pbLast, uint32_t nBitSize)
+{
+    uint32_t nRemainBitSize = nBitSize & 0x07;
+
+    if (nRemainBitSize > 0)
+    {
+        *pbLast &= static_cast<uint8_t>(0xFF << (8 - nRemainBitSize));
+    }
+}
+}  // namespace
+
+void ImsMediaBitPacker::SetSimdEnabled(bool enabled)
+{
+#if defined(BIT_PACKER_SSE2) || defined(BIT_PACKER_NEON)
+    sSimdEnabled = enabled;
+#else
+    (void)enabled;
+#endif
+}
+
+bool ImsMediaBitPacker::IsSimdEnabled()
+{
+    return sSimdEnabled;
+}
+
+void ImsMediaBitPacker::Pack(
+        uint8_t* pbDst, uint32_t nDstBitPos, const uint8_t* pbSrc, uint32_t nBitSize)
+{
+    if (pbDst == nullptr || pbSrc == nullptr || nBitSize == 0)
+    {
+        return;
+    }
+
+    pbDst += nDstBitPos >> 3;
+    uint32_t nShift = nDstBitPos & 0x07;
+    uint32_t nSrcSize = (nBitSize + 7) >> 3;
+    uint32_t nDstSize = (nShift + nBitSize + 7) >> 3;
+
+    if (nShift == 0)
+    {
+        memcpy(pbDst, pbSrc, nSrcSize);
+    }
+    else
+    {
+        // the source byte i is split to the low bits of the destination byte i and the high bits
+        // of the destination byte i + 1, so the bytes from the second one are the source shifted
+        // to the left by 8 - nShift bits
+        pbDst[0] = (pbDst[0] & static_cast<uint8_t>(0xFF << (8 - nShift))) | (pbSrc[0] >> nShift);
+        funnelShift(pbDst + 1, pbSrc, nSrcSize - 1, 8 - nShift);
+
+        if (nDstSize > nSrcSize)
+        {
+            pbDst[nSrcSize] = pbSrc[nSrcSize - 1] << (8 - nShift);
+        }
+    }
+
+    clearTrailingBits(pbDst + nDstSize - 1, nShift + nBitSize);
+}
+
+void ImsMediaBitPacker::Unpack(
+        uint8_t* pbDst, const uint8_t* pbSrc, uint32_t nSrcBitPos, uint32_t nBitSize)
+{
+    if (pbDst == nullptr || pbSrc == nullptr || nBitSize == 0)
+    {
+        return;
+    }
+
+    pbSrc += nSrcBitPos >> 3;
+    uint32_t nShift = nSrcBitPos & 0x07;
+    uint32_t nDstSize = (nBitSize + 7) >> 3;
+    uint32_t nSrcSize = (nShift + nBitSize + 7) >> 3;
+
+    if (nShift == 0)
+    {
+        memcpy(pbDst, pbSrc, nDstSize);
+    }
+    else
+    {
+        funnelShift(pbDst, pbSrc, nSrcSize - 1, nShift);
+
+        // the last byte has no following byte to read when the bits end in the source byte
+        if (nDstSize == nSrcSize)
+        {
+            pbDst[nDstSize - 1] = pbSrc[nSrcSize - 1] << nShift;
+        }
+    }
+
+    clearTrailingBits(pbDst + nDstSize - 1, nBitSize);
+}
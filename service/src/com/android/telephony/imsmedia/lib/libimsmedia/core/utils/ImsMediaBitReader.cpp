@@ -15,15 +15,19 @@
  */
 
 #include <ImsMediaBitReader.h>
+#include <ImsMediaBitPacker.h>
 #include <ImsMediaTrace.h>
+#include <endian.h>
 #include <string.h>
 
+#define BIT_READER_MAX_READ_SIZE 24
+
 ImsMediaBitReader::ImsMediaBitReader()
 {
     mBuffer = nullptr;
     mMaxBufferSize = 0;
     mBytePos = 0;
-    mBitPos = 0;
+    mBitCount = 0;
     mBitBuffer = 0;
     mBufferEOF = false;
 }
@@ -33,7 +37,7 @@ ImsMediaBitReader::~ImsMediaBitReader() {}
 void ImsMediaBitReader::SetBuffer(uint8_t* pbBuffer, uint32_t nBufferSize)
 {
     mBytePos = 0;
-    mBitPos = 32;
+    mBitCount = 0;
     mBitBuffer = 0;
     mBufferEOF = false;
     mBuffer = pbBuffer;
@@ -42,57 +46,36 @@ void ImsMediaBitReader::SetBuffer(uint8_t* pbBuffer, uint32_t nBufferSize)
 
 uint32_t ImsMediaBitReader::Read(uint32_t nSize)
 {
-    uint32_t value;
     if (nSize == 0)
         return 0;
-    if (mBuffer == nullptr || nSize > 24 || mBufferEOF)
+    if (mBuffer == nullptr || nSize > BIT_READER_MAX_READ_SIZE || mBufferEOF)
     {
         IMLOGE2("[Read] nSize[%d], bBufferEOF[%d]", nSize, mBufferEOF);
         return 0;
     }
 
-    // read from byte buffer
-    while ((32 - mBitPos) < nSize)
-    {
-        if (mBytePos >= mMaxBufferSize)
-        {
-            mBufferEOF = true;
-            IMLOGE2("[Read] End of Buffer : nBytePos[%d], nMaxBufferSize[%d]", mBytePos,
-                    mMaxBufferSize);
-            return 0;
-        }
-
-        mBitPos -= 8;
-        mBitBuffer <<= 8;
-        mBitBuffer += mBuffer[mBytePos++];
-    }
-
-    // read from bit buffer
-    value = mBitBuffer << mBitPos >> (32 - nSize);
-    mBitPos += nSize;
-    return value;
+    return readBits(nSize);
 }
 
 void ImsMediaBitReader::ReadByteBuffer(uint8_t* pbDst, uint32_t nBitSize)
 {
-    uint32_t dst_pos = 0;
-    uint32_t nByteSize;
-    uint32_t nRemainBitSize;
-    nByteSize = nBitSize >> 3;
-    nRemainBitSize = nBitSize & 0x07;
+    // the cached bits are returned to the byte buffer and the bits are unpacked from there
+    uint32_t nBitPos = mBytePos * 8 - mBitCount;
 
-    if (mBitPos == 32)
+    if (mBuffer != nullptr && !mBufferEOF && (nBitPos + nBitSize + 7) >> 3 <= mMaxBufferSize)
     {
-        memcpy(pbDst, mBuffer + mBytePos, nByteSize);
-        mBytePos += nByteSize;
-        dst_pos += nByteSize;
+        ImsMediaBitPacker::Unpack(pbDst, mBuffer, nBitPos, nBitSize);
+        seekToBit(nBitPos + nBitSize);
+        return;
     }
-    else
+
+    uint32_t nByteSize = nBitSize >> 3;
+    uint32_t nRemainBitSize = nBitSize & 0x07;
+    uint32_t dst_pos = 0;
+
+    for (dst_pos = 0; dst_pos < nByteSize; dst_pos++)
     {
-        for (dst_pos = 0; dst_pos < nByteSize; dst_pos++)
-        {
-            pbDst[dst_pos] = Read(8);
-        }
+        pbDst[dst_pos] = Read(8);
     }
 
     if (nRemainBitSize > 0)
@@ -111,6 +94,27 @@ uint32_t ImsMediaBitReader::ReadByUEMode()
     uint32_t k = 1;
     uint32_t result = 0;
 
+    if (mBuffer != nullptr && !mBufferEOF)
+    {
+        refill(BIT_READER_MAX_READ_SIZE * 2 + 1);
+
+        // the bits after mBitCount are the next bits of the buffer or zero
+        if (mBitBuffer != 0)
+        {
+            i = __builtin_clzll(mBitBuffer);
+
+            if (i <= BIT_READER_MAX_READ_SIZE && i * 2 + 1 <= mBitCount)
+            {
+                readBits(i + 1);
+                j = readBits(i);
+                return j - 1 + (k << i);
+            }
+        }
+    }
+
+    // the long codes and the codes at the end of the buffer are read bit by bit
+    i = 0;
+
     while (Read(1) == 0 && mBufferEOF == false)
     {
         i++;
@@ -119,4 +123,69 @@ uint32_t ImsMediaBitReader::ReadByUEMode()
     j = Read(i);
     result = j - 1 + (k << i);
     return result;
-}
\ No newline at end of file
+}
+
+bool ImsMediaBitReader::refill(uint32_t nSize)
+{
+    if (mBitCount >= nSize)
+    {
+        return true;
+    }
+
+    if (mBytePos + sizeof(uint64_t) <= mMaxBufferSize)
+    {
+        // load 8 bytes and keep the whole bytes fitting to the free bits of mBitBuffer, the bits
+        // of the partial byte are loaded again with the same value at the next refill
+        uint64_t value;
+        memcpy(&value, mBuffer + mBytePos, sizeof(value));
+        mBitBuffer |= be64toh(value) >> mBitCount;
+        mBytePos += (63 - mBitCount) >> 3;
+        mBitCount |= 56;
+        return true;
+    }
+
+    while (mBitCount <= 56 && mBytePos < mMaxBufferSize)
+    {
+        mBitBuffer |= static_cast<uint64_t>(mBuffer[mBytePos++]) << (56 - mBitCount);
+        mBitCount += 8;
+    }
+
+    return mBitCount >= nSize;
+}
+
+uint32_t ImsMediaBitReader::readBits(uint32_t nSize)
+{
+    if (mBitCount < nSize && !refill(nSize))
+    {
+        mBufferEOF = true;
+        IMLOGE2("[Read] End of Buffer : nBytePos[%d], nMaxBufferSize[%d]", mBytePos,
+                mMaxBufferSize);
+        return 0;
+    }
+
+    if (nSize == 0)
+    {
+        return 0;
+    }
+
+    uint32_t value = mBitBuffer >> (64 - nSize);
+    mBitBuffer <<= nSize;
+    mBitCount -= nSize;
+    return value;
+}
+
+void ImsMediaBitReader::seekToBit(uint32_t nBitPos)
+{
+    mBytePos = nBitPos >> 3;
+    mBitCount = 0;
+    mBitBuffer = 0;
+
+    uint32_t nShift = nBitPos & 0x07;
+
+    if (nShift > 0)
+    {
+        mBitBuffer = static_cast<uint64_t>(static_cast<uint8_t>(mBuffer[mBytePos++] << nShift))
+                << 56;
+        mBitCount = 8 - nShift;
+    }
+}
@@ -15,8 +15,12 @@
  */
 
 #include <ImsMediaBitWriter.h>
+#include <ImsMediaBitPacker.h>
 #include <ImsMediaTrace.h>
 #include <string.h>
+#include <algorithm>
+
+#define BIT_WRITER_MAX_WRITE_SIZE 24
 
 ImsMediaBitWriter::ImsMediaBitWriter()
 {
@@ -47,29 +51,13 @@ bool ImsMediaBitWriter::Write(uint32_t nValue, uint32_t nSize)
         return false;
     }
 
-    if (mBuffer == nullptr || nSize > 24 || mBufferFull)
+    if (mBuffer == nullptr || nSize > BIT_WRITER_MAX_WRITE_SIZE || mBufferFull)
     {
         IMLOGE2("[Write] nSize[%d], BufferFull[%d]", nSize, mBufferFull);
         return false;
     }
 
-    // write to bit buffer
-    mBitBuffer += (nValue << (32 - nSize) >> mBitPos);
-    mBitPos += nSize;
-
-    // write to byte buffer
-    while (mBitPos >= 8)
-    {
-        mBuffer[mBytePos++] = (uint8_t)(mBitBuffer >> 24);
-        mBitBuffer <<= 8;
-        mBitPos -= 8;
-    }
-
-    if (mBytePos >= mMaxBufferSize)
-    {
-        mBufferFull = true;
-    }
-
+    writeBits(nValue, nSize);
     return true;
 }
 
@@ -87,14 +75,29 @@ bool ImsMediaBitWriter::WriteByteBuffer(uint8_t* pbSrc, uint32_t nBitSize)
     }
     else
     {
-        uint32_t i;
+        uint32_t nFreeSize =
+                (mBufferFull || mBytePos >= mMaxBufferSize) ? 0 : mMaxBufferSize - mBytePos;
+        uint32_t nCopySize = std::min(nByteSize, nFreeSize);
+
+        if (nCopySize > 0)
+        {
+            // the bytes are packed after the pending bits and the low bits of the last byte
+            // stay pending
+            mBuffer[mBytePos] = static_cast<uint8_t>(mBitBuffer >> 56);
+            ImsMediaBitPacker::Pack(mBuffer + mBytePos, mBitPos, pbSrc, nCopySize * 8 - mBitPos);
+            mBytePos += nCopySize;
+            mBitBuffer = static_cast<uint64_t>(pbSrc[nCopySize - 1]) << (64 - mBitPos);
+        }
 
-        for (i = 0; i < nByteSize; i++)
+        if (mBytePos >= mMaxBufferSize)
         {
-            if (!Write(pbSrc[i], 8))
-            {
-                return false;
-            }
+            mBufferFull = true;
+        }
+
+        if (nCopySize < nByteSize)
+        {
+            IMLOGE2("[WriteByteBuffer] nByteSize[%d], BufferFull[%d]", nByteSize, mBufferFull);
+            return false;
         }
     }
 
@@ -114,6 +117,13 @@ bool ImsMediaBitWriter::WriteByteBuffer(uint8_t* pbSrc, uint32_t nBitSize)
 
 bool ImsMediaBitWriter::WriteByteBuffer(uint32_t value)
 {
+    if (mBuffer != nullptr && !mBufferFull && mBytePos + sizeof(value) <= mMaxBufferSize)
+    {
+        writeBits(value, 32);
+        return true;
+    }
+
+    // write byte by byte to stop at the end of the buffer
     uint32_t nRemainBitSize = 32;
 
     for (int32_t i = 0; i < 4; i++)
@@ -134,12 +144,8 @@ void ImsMediaBitWriter::Seek(uint32_t nSize)
 {
     Flush();
     mBitPos += nSize;
-
-    while (mBitPos >= 8)
-    {
-        mBytePos++;
-        mBitPos -= 8;
-    }
+    mBytePos += mBitPos >> 3;
+    mBitPos &= 0x07;
 }
 
 void ImsMediaBitWriter::AddPadding()
@@ -162,7 +168,27 @@ void ImsMediaBitWriter::Flush()
 {
     if (mBitPos > 0)
     {
-        mBuffer[mBytePos] += (uint8_t)(mBitBuffer >> 24);
+        mBuffer[mBytePos] += (uint8_t)(mBitBuffer >> 56);
         mBitBuffer = 0;
     }
-}
\ No newline at end of file
+}
+
+void ImsMediaBitWriter::writeBits(uint32_t nValue, uint32_t nSize)
+{
+    // write to bit buffer, the bits above nSize are dropped
+    mBitBuffer |= static_cast<uint64_t>(nValue << (32 - nSize)) << (32 - mBitPos);
+    mBitPos += nSize;
+
+    // write the whole bytes to byte buffer
+    while (mBitPos >= 8)
+    {
+        mBuffer[mBytePos++] = (uint8_t)(mBitBuffer >> 56);
+        mBitBuffer <<= 8;
+        mBitPos -= 8;
+    }
+
+    if (mBytePos >= mMaxBufferSize)
+    {
+        mBufferFull = true;
+    }
+}
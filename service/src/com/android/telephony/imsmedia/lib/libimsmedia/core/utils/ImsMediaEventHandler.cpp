@@ -15,76 +15,266 @@
  */
 
 #include <ImsMediaEventHandler.h>
+#include <ImsMediaEventHandlerId.h>
 #include <ImsMediaTrace.h>
 #include <string.h>
-#include <string>
+#include <thread>
 
-std::list<ImsMediaEventHandler*> ImsMediaEventHandler::gListEventHandler;
+std::atomic<ImsMediaEventHandler*> ImsMediaEventHandler::gHandlers[IM_EVENT_HANDLER_MAX];
+std::atomic<uint32_t> ImsMediaEventHandler::gSenders[IM_EVENT_HANDLER_MAX];
+static_assert(kReservedHandlerMax == kTextResponseHandler + 1 &&
+                kReservedHandlerMax <= IM_EVENT_HANDLER_MAX,
+        "the reserved handler names do not match with the ids");
+// the names of the manager handlers in the order of the reserved ids
+char ImsMediaEventHandler::gHandlerNames[IM_EVENT_HANDLER_MAX][MAX_EVENTHANDLER_NAME] = {
+        AUDIO_REQUEST_EVENT, AUDIO_RESPONSE_EVENT, VIDEO_REQUEST_EVENT, VIDEO_RESPONSE_EVENT,
+        TEXT_REQUEST_EVENT, TEXT_RESPONSE_EVENT};
 std::mutex ImsMediaEventHandler::mMutex;
 
-ImsMediaEventHandler::ImsMediaEventHandler() {}
+ImsMediaEventHandler::ImsMediaEventHandler()
+{
+    mId = IM_EVENT_HANDLER_ID_INVALID;
+    mbTerminate = false;
+    mName[0] = 0;
+    ResetQueue();
+}
 
 ImsMediaEventHandler::~ImsMediaEventHandler() {}
 
 void ImsMediaEventHandler::Init(const char* strName)
 {
-    strncpy(mName, strName, MAX_EVENTHANDLER_NAME);
+    strncpy(mName, strName, MAX_EVENTHANDLER_NAME - 1);
+    mName[MAX_EVENTHANDLER_NAME - 1] = 0;
     mbTerminate = false;
-    gListEventHandler.push_back(this);
-    IMLOGD1("[Init] %s", mName);
+    ResetQueue();
+    mId = RegisterHandlerId(mName);
+
+    if (mId != IM_EVENT_HANDLER_ID_INVALID)
+    {
+        gHandlers[mId].store(this, std::memory_order_release);
+    }
+
+    IMLOGD2("[Init] %s, id[%d]", mName, mId);
     StartThread();
 }
 
 void ImsMediaEventHandler::Deinit()
 {
-    IMLOGD2("[Deinit] %s, queue size[%d]", mName, mListevent.size());
+    IMLOGD1("[Deinit] %s", mName);
     std::lock_guard<std::mutex> guard(mMutexEvent);
+
+    if (mId != IM_EVENT_HANDLER_ID_INVALID)
+    {
+        ImsMediaEventHandler* handler = this;
+        gHandlers[mId].compare_exchange_strong(handler, nullptr);
+
+        // the sender loaded the handler before it is cleared can still push the event
+        while (gSenders[mId].load() != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
     StopThread();
-    gListEventHandler.remove(this);
-    mListevent.clear();
-    mListParamA.clear();
-    mListParamB.clear();
-    mListParamC.clear();
     mCondition.signal();
     mConditionExit.wait();
+
+    // release the payloads of the events left in the queue
+    uint32_t event;
+    uint64_t paramA, paramB, paramC;
+    ImsMediaEventPayload payload;
+
+    while (PopEvent(event, paramA, paramB, paramC, payload))
+    {
+        payload.Reset();
+    }
 }
 
-void ImsMediaEventHandler::SendEvent(const char* strEventHandlerName, uint32_t event,
+int32_t ImsMediaEventHandler::GetHandlerId(const char* strEventHandlerName)
+{
+    if (strEventHandlerName == nullptr || strEventHandlerName[0] == 0)
+    {
+        return IM_EVENT_HANDLER_ID_INVALID;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    for (int32_t i = 0; i < IM_EVENT_HANDLER_MAX && gHandlerNames[i][0] != 0; i++)
+    {
+        if (strncmp(gHandlerNames[i], strEventHandlerName, MAX_EVENTHANDLER_NAME - 1) == 0)
+        {
+            return i;
+        }
+    }
+
+    IMLOGE1("[GetHandlerId] not registered handler name, %s", strEventHandlerName);
+    return IM_EVENT_HANDLER_ID_INVALID;
+}
+
+int32_t ImsMediaEventHandler::RegisterHandlerId(const char* strEventHandlerName)
+{
+    if (strEventHandlerName == nullptr || strEventHandlerName[0] == 0)
+    {
+        return IM_EVENT_HANDLER_ID_INVALID;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    for (int32_t i = 0; i < IM_EVENT_HANDLER_MAX; i++)
+    {
+        if (gHandlerNames[i][0] == 0)
+        {
+            strncpy(gHandlerNames[i], strEventHandlerName, MAX_EVENTHANDLER_NAME - 1);
+            return i;
+        }
+
+        if (strncmp(gHandlerNames[i], strEventHandlerName, MAX_EVENTHANDLER_NAME - 1) == 0)
+        {
+            return i;
+        }
+    }
+
+    IMLOGE1("[RegisterHandlerId] no more handler name, %s", strEventHandlerName);
+    return IM_EVENT_HANDLER_ID_INVALID;
+}
+
+bool ImsMediaEventHandler::SendEvent(
+        int32_t handlerId, uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC)
+{
+    return SendEvent(handlerId, event, ImsMediaEventPayload(), paramA, paramB, paramC);
+}
+
+bool ImsMediaEventHandler::SendEvent(const char* strEventHandlerName, uint32_t event,
         uint64_t paramA, uint64_t paramB, uint64_t paramC)
+{
+    return SendEvent(strEventHandlerName, event, ImsMediaEventPayload(), paramA, paramB, paramC);
+}
+
+bool ImsMediaEventHandler::SendEvent(int32_t handlerId, uint32_t event,
+        ImsMediaEventPayload payload, uint64_t paramA, uint64_t paramB, uint64_t paramC)
+{
+    if (handlerId < 0 || handlerId >= IM_EVENT_HANDLER_MAX)
+    {
+        IMLOGE1("[SendEvent] invalid handler id[%d]", handlerId);
+        return false;
+    }
+
+    IMLOGD5("[SendEvent] id[%d], event[%d], paramA[%p], paramB[%p], paramC[%p]", handlerId,
+            event, paramA, paramB, paramC);
+
+    // counted before the handler is loaded, so Deinit sees the sender or the sender sees nullptr
+    gSenders[handlerId].fetch_add(1);
+    ImsMediaEventHandler* handler = gHandlers[handlerId].load();
+    bool result = false;
+
+    if (handler == nullptr)
+    {
+        IMLOGD2("[SendEvent] no handler, id[%d], event[%d]", handlerId, event);
+    }
+    else if (!handler->PushEvent(event, paramA, paramB, paramC, payload))
+    {
+        IMLOGE2("[SendEvent] %s, queue is full, event[%d]", handler->getName(), event);
+    }
+    else
+    {
+        handler->mCondition.signal();
+        result = true;
+    }
+
+    gSenders[handlerId].fetch_sub(1);
+    return result;
+}
+
+bool ImsMediaEventHandler::SendEvent(const char* strEventHandlerName, uint32_t event,
+        ImsMediaEventPayload payload, uint64_t paramA, uint64_t paramB, uint64_t paramC)
 {
     if (strEventHandlerName == nullptr)
     {
         IMLOGE0("[SendEvent] strEventHandlerName is nullptr");
-        return;
+        return false;
     }
 
-    IMLOGD5("[SendEvent] Name[%s], event[%d], paramA[%p], paramB[%p], paramC[%p]",
-            strEventHandlerName, event, paramA, paramB, paramC);
+    return SendEvent(GetHandlerId(strEventHandlerName), event, std::move(payload), paramA, paramB,
+            paramC);
+}
+
+char* ImsMediaEventHandler::getName()
+{
+    return mName;
+}
+
+bool ImsMediaEventHandler::PushEvent(uint32_t event, uint64_t paramA, uint64_t paramB,
+        uint64_t paramC, ImsMediaEventPayload& payload)
+{
+    /** Bounded multi producer queue: a record is free for the position when its sequence equals
+     * the position and ready for the consumer when it is the position + 1. The producers only
+     * race on the enqueue position. */
+    uint32_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    EventRecord* record;
 
-    for (auto& i : gListEventHandler)
+    for (;;)
     {
-        if (i != nullptr && strcmp(i->getName(), strEventHandlerName) == 0)
+        record = &mRing[pos & IM_EVENT_QUEUE_MASK];
+        uint32_t sequence = record->sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(sequence - pos);
+
+        if (diff == 0)
+        {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
         {
-            i->AddEvent(event, paramA, paramB, paramC);
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
         }
     }
+
+    record->event = event;
+    record->paramA = paramA;
+    record->paramB = paramB;
+    record->paramC = paramC;
+    record->payload = std::move(payload);
+    record->sequence.store(pos + 1, std::memory_order_release);
+    return true;
 }
 
-char* ImsMediaEventHandler::getName()
+bool ImsMediaEventHandler::PopEvent(uint32_t& event, uint64_t& paramA, uint64_t& paramB,
+        uint64_t& paramC, ImsMediaEventPayload& payload)
 {
-    return mName;
+    EventRecord* record = &mRing[mDequeuePos & IM_EVENT_QUEUE_MASK];
+    uint32_t sequence = record->sequence.load(std::memory_order_acquire);
+
+    if (static_cast<int32_t>(sequence - (mDequeuePos + 1)) < 0)
+    {
+        return false;
+    }
+
+    event = record->event;
+    paramA = record->paramA;
+    paramB = record->paramB;
+    paramC = record->paramC;
+    payload = std::move(record->payload);
+    record->sequence.store(mDequeuePos + IM_EVENT_QUEUE_SIZE, std::memory_order_release);
+    mDequeuePos++;
+    return true;
 }
 
-void ImsMediaEventHandler::AddEvent(
-        uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC)
+void ImsMediaEventHandler::ResetQueue()
 {
-    std::lock_guard<std::mutex> guard(mMutexEvent);
-    IMLOGD3("[AddEvent] %s, event[%d], size[%d]", mName, event, mListevent.size());
-    mListevent.push_back(event);
-    mListParamA.push_back(paramA);
-    mListParamB.push_back(paramB);
-    mListParamC.push_back(paramC);
-    mCondition.signal();
+    for (uint32_t i = 0; i < IM_EVENT_QUEUE_SIZE; i++)
+    {
+        mRing[i].sequence.store(i, std::memory_order_relaxed);
+        mRing[i].payload.Reset();
+    }
+
+    mEnqueuePos.store(0, std::memory_order_relaxed);
+    mDequeuePos = 0;
 }
 
 void* ImsMediaEventHandler::run()
@@ -103,26 +293,16 @@ void* ImsMediaEventHandler::run()
                 break;
             }
 
-            mMutexEvent.lock();
+            uint32_t event;
+            uint64_t paramA, paramB, paramC;
+            ImsMediaEventPayload payload;
 
-            if (mListevent.size() == 0)
+            if (!PopEvent(event, paramA, paramB, paramC, payload))
             {
-                mMutexEvent.unlock();
                 break;
             }
 
-            uint32_t event = mListevent.front();
-            uint64_t paramA = mListParamA.front();
-            uint64_t paramB = mListParamB.front();
-            uint64_t paramC = mListParamC.front();
-
-            mListevent.pop_front();
-            mListParamA.pop_front();
-            mListParamB.pop_front();
-            mListParamC.pop_front();
-            mMutexEvent.unlock();
-
-            processEvent(event, paramA, paramB, paramC);
+            processEvent(event, paramA, paramB, paramC, payload);
 
             if (IsThreadStopped())
             {
@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ImsMediaHistogram.h>
+
+uint64_t ImsMediaHistogramSnapshot::GetMean() const
+{
+    return count == 0 ? 0 : sum / count;
+}
+
+uint64_t ImsMediaHistogramSnapshot::GetPercentile(uint32_t percent) const
+{
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < IM_HISTOGRAM_BUCKETS; i++)
+    {
+        total += buckets[i];
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    if (percent == 0)
+    {
+        return min;
+    }
+
+    if (percent >= 100)
+    {
+        return max;
+    }
+
+    uint64_t rank = (total * percent + 99) / 100;
+    uint64_t accumulated = 0;
+
+    for (uint32_t i = 0; i < IM_HISTOGRAM_BUCKETS; i++)
+    {
+        accumulated += buckets[i];
+
+        if (accumulated < rank)
+        {
+            continue;
+        }
+
+        uint64_t lower = ImsMediaHistogram::GetBucketLowerBound(i);
+        uint64_t value = lower;
+
+        if (i + 1 < IM_HISTOGRAM_BUCKETS)
+        {
+            value += (ImsMediaHistogram::GetBucketLowerBound(i + 1) - lower) / 2;
+        }
+
+        // the estimation can not be out of the values counted
+        if (value < min)
+        {
+            value = min;
+        }
+
+        if (value > max)
+        {
+            value = max;
+        }
+
+        return value;
+    }
+
+    return max;
+}
+
+ImsMediaHistogram::ImsMediaHistogram()
+{
+    Reset();
+}
+
+ImsMediaHistogram::~ImsMediaHistogram() {}
+
+void ImsMediaHistogram::Add(uint64_t value)
+{
+    mBuckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t min = mMin.load(std::memory_order_relaxed);
+
+    while (value < min && !mMin.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+
+    uint64_t max = mMax.load(std::memory_order_relaxed);
+
+    while (value > max && !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+
+    mCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ImsMediaHistogram::Reset()
+{
+    mCount.store(0, std::memory_order_relaxed);
+    mSum.store(0, std::memory_order_relaxed);
+    mMin.store(UINT64_MAX, std::memory_order_relaxed);
+    mMax.store(0, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < IM_HISTOGRAM_BUCKETS; i++)
+    {
+        mBuckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void ImsMediaHistogram::GetSnapshot(ImsMediaHistogramSnapshot& snapshot) const
+{
+    snapshot.count = mCount.load(std::memory_order_relaxed);
+    snapshot.sum = mSum.load(std::memory_order_relaxed);
+    snapshot.min = snapshot.count == 0 ? 0 : mMin.load(std::memory_order_relaxed);
+    snapshot.max = mMax.load(std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < IM_HISTOGRAM_BUCKETS; i++)
+    {
+        snapshot.buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+uint32_t ImsMediaHistogram::GetBucketIndex(uint64_t value)
+{
+    if (value < IM_HISTOGRAM_SUB_BUCKETS)
+    {
+        return value;
+    }
+
+    if (value >= (1ULL << IM_HISTOGRAM_MAX_ORDER))
+    {
+        return IM_HISTOGRAM_BUCKETS - 1;
+    }
+
+    uint32_t order = 63 - __builtin_clzll(value);
+    uint32_t subBucket =
+            (value >> (order - IM_HISTOGRAM_SUB_BUCKET_BITS)) & (IM_HISTOGRAM_SUB_BUCKETS - 1);
+    return (order - IM_HISTOGRAM_SUB_BUCKET_BITS + 1) * IM_HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+uint64_t ImsMediaHistogram::GetBucketLowerBound(uint32_t index)
+{
+    if (index < IM_HISTOGRAM_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    uint32_t order = index / IM_HISTOGRAM_SUB_BUCKETS + IM_HISTOGRAM_SUB_BUCKET_BITS - 1;
+    uint64_t subBucket = index % IM_HISTOGRAM_SUB_BUCKETS;
+    return (IM_HISTOGRAM_SUB_BUCKETS + subBucket) << (order - IM_HISTOGRAM_SUB_BUCKET_BITS);
+}
@@ -16,54 +16,348 @@
 
 #include "ImsMediaImageRotate.h"
 #include <ImsMediaTrace.h>
+#include <stddef.h>
+#include <algorithm>
 
-void ImsMediaImageRotate::YUV420_Planar_Rotate90_Flip(
-        uint8_t* pbDst, uint8_t* pbSrc, uint16_t nSrcWidth, uint16_t nSrcHeight)
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define IMAGE_ROTATE_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMAGE_ROTATE_NEON
+#endif
+
+// The planes are rotated in tiles of 8x8 pixels, the rows of a tile are read and written in a
+// few cache lines instead of striding through the whole column of the image
+#define ROTATE_TILE_SIZE 8
+// The tiles are visited in the blocks of 64x64 pixels, the destination rows of a block stay in the
+// cache until the block fills them
+#define ROTATE_BLOCK_SIZE 64
+
+#if defined(IMAGE_ROTATE_SSE2) || defined(IMAGE_ROTATE_NEON)
+static bool sSimdEnabled = true;
+#else
+static bool sSimdEnabled = false;
+#endif
+
+namespace
 {
-    uint16_t x, y;
-    uint64_t srcIdx, dstIdx;
-    const size_t size = nSrcWidth * nSrcHeight;
-    dstIdx = size - 1;
+enum RotateMode
+{
+    // the source pixel (row, col) goes to (col, height - 1 - row)
+    kRotate90,
+    // the source pixel (row, col) goes to (width - 1 - col, row)
+    kRotate270,
+    // the source pixel (row, col) goes to (width - 1 - col, height - 1 - row)
+    kRotate90Flip,
+};
 
-    // Rotate Y buffer
-    for (y = 0; y < nSrcWidth; y++)
+struct Plane
+{
+    const uint8_t* src;
+    size_t srcStride;
+    uint8_t* dst;
+    size_t dstStride;
+    uint32_t width;
+    uint32_t height;
+};
+
+// Get the destination row of the given source column
+inline uint32_t getDstRow(const Plane& plane, RotateMode mode, uint32_t col)
+{
+    return mode == kRotate90 ? col : plane.width - 1 - col;
+}
+
+// The element is a byte of the Y plane or a pair of U and V of the interleaved UV plane
+template <size_t kElementSize>
+void rotateTileScalar(const Plane& plane, RotateMode mode, uint32_t row, uint32_t col,
+        uint32_t rows, uint32_t cols)
+{
+    const ptrdiff_t step = mode == kRotate270 ? static_cast<ptrdiff_t>(kElementSize)
+                                              : -static_cast<ptrdiff_t>(kElementSize);
+    const uint32_t dstCol = mode == kRotate270 ? row : plane.height - 1 - row;
+
+    for (uint32_t c = col; c < col + cols; c++)
     {
-        srcIdx = y;
-        for (x = 0; x < nSrcHeight; x++)
+        uint8_t* dst = plane.dst + getDstRow(plane, mode, c) * plane.dstStride +
+                dstCol * kElementSize;
+        const uint8_t* src = plane.src + row * plane.srcStride + c * kElementSize;
+
+        for (uint32_t r = 0; r < rows; r++)
         {
-            pbDst[dstIdx] = pbSrc[srcIdx];  // Y
+            memcpy(dst, src, kElementSize);
+            src += plane.srcStride;
+            dst += step;
+        }
+    }
+}
+
+#if defined(IMAGE_ROTATE_SSE2)
+inline void storeByteColumn(const Plane& plane, RotateMode mode, uint32_t row, uint32_t col,
+        __m128i columns, bool high)
+{
+    uint64_t value;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&value),
+            high ? _mm_unpackhi_epi64(columns, columns) : columns);
+
+    if (mode != kRotate270)
+    {
+        value = __builtin_bswap64(value);
+    }
+
+    uint32_t dstCol = mode == kRotate270 ? row : plane.height - ROTATE_TILE_SIZE - row;
+    memcpy(plane.dst + getDstRow(plane, mode, col) * plane.dstStride + dstCol, &value,
+            sizeof(value));
+}
+
+void rotateTileBytes(const Plane& plane, RotateMode mode, uint32_t row, uint32_t col)
+{
+    const uint8_t* src = plane.src + row * plane.srcStride + col;
+    __m128i r[ROTATE_TILE_SIZE];
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * plane.srcStride));
+    }
+
+    __m128i b0 = _mm_unpacklo_epi8(r[0], r[1]);
+    __m128i b1 = _mm_unpacklo_epi8(r[2], r[3]);
+    __m128i b2 = _mm_unpacklo_epi8(r[4], r[5]);
+    __m128i b3 = _mm_unpacklo_epi8(r[6], r[7]);
+    __m128i c0 = _mm_unpacklo_epi16(b0, b1);
+    __m128i c1 = _mm_unpackhi_epi16(b0, b1);
+    __m128i c2 = _mm_unpacklo_epi16(b2, b3);
+    __m128i c3 = _mm_unpackhi_epi16(b2, b3);
+    // each register has two columns of the tile
+    __m128i columns[4] = {_mm_unpacklo_epi32(c0, c2), _mm_unpackhi_epi32(c0, c2),
+            _mm_unpacklo_epi32(c1, c3), _mm_unpackhi_epi32(c1, c3)};
+
+    for (int i = 0; i < 4; i++)
+    {
+        storeByteColumn(plane, mode, row, col + i * 2, columns[i], false);
+        storeByteColumn(plane, mode, row, col + i * 2 + 1, columns[i], true);
+    }
+}
+
+void rotateTilePairs(const Plane& plane, RotateMode mode, uint32_t row, uint32_t col)
+{
+    const uint8_t* src = plane.src + row * plane.srcStride + col * 2;
+    __m128i r[ROTATE_TILE_SIZE];
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * plane.srcStride));
+    }
+
+    __m128i b0 = _mm_unpacklo_epi16(r[0], r[1]);
+    __m128i b1 = _mm_unpackhi_epi16(r[0], r[1]);
+    __m128i b2 = _mm_unpacklo_epi16(r[2], r[3]);
+    __m128i b3 = _mm_unpackhi_epi16(r[2], r[3]);
+    __m128i b4 = _mm_unpacklo_epi16(r[4], r[5]);
+    __m128i b5 = _mm_unpackhi_epi16(r[4], r[5]);
+    __m128i b6 = _mm_unpacklo_epi16(r[6], r[7]);
+    __m128i b7 = _mm_unpackhi_epi16(r[6], r[7]);
+    __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+    __m128i c4 = _mm_unpacklo_epi32(b4, b6);
+    __m128i c5 = _mm_unpackhi_epi32(b4, b6);
+    __m128i c6 = _mm_unpacklo_epi32(b5, b7);
+    __m128i c7 = _mm_unpackhi_epi32(b5, b7);
+    __m128i columns[ROTATE_TILE_SIZE] = {_mm_unpacklo_epi64(c0, c4), _mm_unpackhi_epi64(c0, c4),
+            _mm_unpacklo_epi64(c1, c5), _mm_unpackhi_epi64(c1, c5), _mm_unpacklo_epi64(c2, c6),
+            _mm_unpackhi_epi64(c2, c6), _mm_unpacklo_epi64(c3, c7), _mm_unpackhi_epi64(c3, c7)};
+    uint32_t dstCol = mode == kRotate270 ? row : plane.height - ROTATE_TILE_SIZE - row;
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        __m128i value = columns[i];
+
+        if (mode != kRotate270)
+        {
+            value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+            value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+            value = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(plane.dst +
+                                 getDstRow(plane, mode, col + i) * plane.dstStride + dstCol * 2),
+                value);
+    }
+}
+#elif defined(IMAGE_ROTATE_NEON)
+void rotateTileBytes(const Plane& plane, RotateMode mode, uint32_t row, uint32_t col)
+{
+    const uint8_t* src = plane.src + row * plane.srcStride + col;
+    uint8x8_t r[ROTATE_TILE_SIZE];
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        r[i] = vld1_u8(src + i * plane.srcStride);
+    }
+
+    uint8x8x2_t t01 = vtrn_u8(r[0], r[1]);
+    uint8x8x2_t t23 = vtrn_u8(r[2], r[3]);
+    uint8x8x2_t t45 = vtrn_u8(r[4], r[5]);
+    uint8x8x2_t t67 = vtrn_u8(r[6], r[7]);
+    uint16x4x2_t u02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+    uint16x4x2_t u13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+    uint16x4x2_t u46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+    uint16x4x2_t u57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+    uint32x2x2_t v04 =
+            vtrn_u32(vreinterpret_u32_u16(u02.val[0]), vreinterpret_u32_u16(u46.val[0]));
+    uint32x2x2_t v26 =
+            vtrn_u32(vreinterpret_u32_u16(u02.val[1]), vreinterpret_u32_u16(u46.val[1]));
+    uint32x2x2_t v15 =
+            vtrn_u32(vreinterpret_u32_u16(u13.val[0]), vreinterpret_u32_u16(u57.val[0]));
+    uint32x2x2_t v37 =
+            vtrn_u32(vreinterpret_u32_u16(u13.val[1]), vreinterpret_u32_u16(u57.val[1]));
+    uint8x8_t columns[ROTATE_TILE_SIZE] = {vreinterpret_u8_u32(v04.val[0]),
+            vreinterpret_u8_u32(v15.val[0]), vreinterpret_u8_u32(v26.val[0]),
+            vreinterpret_u8_u32(v37.val[0]), vreinterpret_u8_u32(v04.val[1]),
+            vreinterpret_u8_u32(v15.val[1]), vreinterpret_u8_u32(v26.val[1]),
+            vreinterpret_u8_u32(v37.val[1])};
+    uint32_t dstCol = mode == kRotate270 ? row : plane.height - ROTATE_TILE_SIZE - row;
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        uint8x8_t value = mode == kRotate270 ? columns[i] : vrev64_u8(columns[i]);
+        vst1_u8(plane.dst + getDstRow(plane, mode, col + i) * plane.dstStride + dstCol, value);
+    }
+}
+
+void rotateTilePairs(const Plane& plane, RotateMode mode, uint32_t row, uint32_t col)
+{
+    const uint8_t* src = plane.src + row * plane.srcStride + col * 2;
+    uint16x8_t r[ROTATE_TILE_SIZE];
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        r[i] = vreinterpretq_u16_u8(vld1q_u8(src + i * plane.srcStride));
+    }
+
+    uint16x8x2_t t01 = vtrnq_u16(r[0], r[1]);
+    uint16x8x2_t t23 = vtrnq_u16(r[2], r[3]);
+    uint16x8x2_t t45 = vtrnq_u16(r[4], r[5]);
+    uint16x8x2_t t67 = vtrnq_u16(r[6], r[7]);
+    uint32x4x2_t u02 =
+            vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t u13 =
+            vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t u46 =
+            vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t u57 =
+            vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+    // the upper rows of a column come from u02 and u13 and the lower rows from u46 and u57
+    uint32x4_t upper[ROTATE_TILE_SIZE / 2] = {u02.val[0], u13.val[0], u02.val[1], u13.val[1]};
+    uint32x4_t lower[ROTATE_TILE_SIZE / 2] = {u46.val[0], u57.val[0], u46.val[1], u57.val[1]};
+    uint32_t dstCol = mode == kRotate270 ? row : plane.height - ROTATE_TILE_SIZE - row;
+
+    for (int i = 0; i < ROTATE_TILE_SIZE; i++)
+    {
+        uint32x4_t up = upper[i % 4];
+        uint32x4_t low = lower[i % 4];
+        uint16x8_t value = vreinterpretq_u16_u32(i < 4
+                        ? vcombine_u32(vget_low_u32(up), vget_low_u32(low))
+                        : vcombine_u32(vget_high_u32(up), vget_high_u32(low)));
 
-            srcIdx += nSrcWidth;
-            dstIdx--;
+        if (mode != kRotate270)
+        {
+            value = vrev64q_u16(value);
+            value = vcombine_u16(vget_high_u16(value), vget_low_u16(value));
         }
+
+        vst1q_u8(plane.dst + getDstRow(plane, mode, col + i) * plane.dstStride + dstCol * 2,
+                vreinterpretq_u8_u16(value));
     }
+}
+#endif
 
-    dstIdx = (size * 1.5f) - 1;
-    const uint64_t usize = size / 4;
-    nSrcWidth /= 2;
-    nSrcHeight /= 2;
+template <size_t kElementSize>
+void rotateBlock(const Plane& plane, RotateMode mode, uint32_t blockRow, uint32_t blockCol)
+{
+    uint32_t rowEnd = std::min(blockRow + ROTATE_BLOCK_SIZE, plane.height);
+    uint32_t colEnd = std::min(blockCol + ROTATE_BLOCK_SIZE, plane.width);
 
-    // Rotate UV buffer
-    for (y = 0; y < nSrcWidth; y++)
+    for (uint32_t row = blockRow; row < rowEnd; row += ROTATE_TILE_SIZE)
     {
-        srcIdx = size + y;
-        for (x = 0; x < nSrcHeight; x++)
+        uint32_t rows = std::min(rowEnd - row, static_cast<uint32_t>(ROTATE_TILE_SIZE));
+
+        for (uint32_t col = blockCol; col < colEnd; col += ROTATE_TILE_SIZE)
         {
-            pbDst[dstIdx - usize] = pbSrc[srcIdx];  // U
-            pbDst[dstIdx] = pbSrc[usize + srcIdx];  // V
+            uint32_t cols = std::min(colEnd - col, static_cast<uint32_t>(ROTATE_TILE_SIZE));
+#if defined(IMAGE_ROTATE_SSE2) || defined(IMAGE_ROTATE_NEON)
+            if (sSimdEnabled && rows == ROTATE_TILE_SIZE && cols == ROTATE_TILE_SIZE)
+            {
+                if (kElementSize == 1)
+                {
+                    rotateTileBytes(plane, mode, row, col);
+                }
+                else
+                {
+                    rotateTilePairs(plane, mode, row, col);
+                }
+
+                continue;
+            }
+#endif
+            rotateTileScalar<kElementSize>(plane, mode, row, col, rows, cols);
+        }
+    }
+}
 
-            srcIdx += nSrcWidth;
-            dstIdx--;
+template <size_t kElementSize>
+void rotatePlane(const Plane& plane, RotateMode mode)
+{
+    for (uint32_t row = 0; row < plane.height; row += ROTATE_BLOCK_SIZE)
+    {
+        for (uint32_t col = 0; col < plane.width; col += ROTATE_BLOCK_SIZE)
+        {
+            rotateBlock<kElementSize>(plane, mode, row, col);
         }
     }
 }
+}  // namespace
+
+void ImsMediaImageRotate::SetSimdEnabled(bool enabled)
+{
+#if defined(IMAGE_ROTATE_SSE2) || defined(IMAGE_ROTATE_NEON)
+    sSimdEnabled = enabled;
+#else
+    (void)enabled;
+#endif
+}
+
+bool ImsMediaImageRotate::IsSimdEnabled()
+{
+    return sSimdEnabled;
+}
+
+void ImsMediaImageRotate::YUV420_Planar_Rotate90_Flip(
+        uint8_t* pbDst, uint8_t* pbSrc, uint16_t nSrcWidth, uint16_t nSrcHeight)
+{
+    const size_t size = nSrcWidth * nSrcHeight;
+    const size_t usize = size / 4;
+    const uint16_t nUVWidth = nSrcWidth / 2;
+    const uint16_t nUVHeight = nSrcHeight / 2;
+
+    // Rotate Y buffer
+    rotatePlane<1>({pbSrc, nSrcWidth, pbDst, nSrcHeight, nSrcWidth, nSrcHeight}, kRotate90Flip);
+
+    // Rotate U and V buffer
+    rotatePlane<1>({pbSrc + size, nUVWidth, pbDst + size, nUVHeight, nUVWidth, nUVHeight},
+            kRotate90Flip);
+    rotatePlane<1>({pbSrc + size + usize, nUVWidth, pbDst + size + usize, nUVHeight, nUVWidth,
+                           nUVHeight},
+            kRotate90Flip);
+}
 
 int ImsMediaImageRotate::YUV420_SP_Rotate90(uint8_t* pOutBuffer, size_t nOutBufSize,
         uint16_t outputStride, uint8_t* pYPlane, uint8_t* pUVPlane, uint16_t nSrcWidth,
         uint16_t nSrcHeight)
 {
-    uint16_t x, y, nDstWidth = nSrcHeight, nDstHt = nSrcWidth, nPadWidth = outputStride - nDstWidth;
-    uint64_t srcIdx, dstIdx = (outputStride * nDstHt) - 1;
+    uint16_t nDstWidth = nSrcHeight, nDstHt = nSrcWidth, nPadWidth = outputStride - nDstWidth;
     const size_t dstSize = outputStride * nDstHt * 1.5f;
 
     if (nOutBufSize < (dstSize - nPadWidth))
@@ -81,83 +375,37 @@ int ImsMediaImageRotate::YUV420_SP_Rotate90(uint8_t* pOutBuffer, size_t nOutBufS
     }
 
     // Rotate Y buffer
-    for (y = 0; y < nSrcWidth; y++)
-    {
-        dstIdx -= nPadWidth;
-        srcIdx = nSrcWidth - y - 1;
-        for (x = 0; x < nSrcHeight; x++)
-        {
-            pOutBuffer[dstIdx] = pYPlane[srcIdx];  // Y
-            srcIdx += nSrcWidth;
-            dstIdx--;
-        }
-    }
-
-    dstIdx = dstSize - 1;
-    nSrcWidth /= 2;
-    nSrcHeight /= 2;
-
-    // Rotate UV buffer
-    for (y = 0; y < nSrcWidth; y++)
-    {
-        dstIdx -= nPadWidth;
-        srcIdx = (nSrcWidth - y - 1) * 2;
-        for (x = 0; x < nSrcHeight; x++)
-        {
-            pOutBuffer[dstIdx--] = pUVPlane[srcIdx + 1];  // V
-            pOutBuffer[dstIdx--] = pUVPlane[srcIdx];      // U
-            srcIdx += nSrcWidth * 2;
-        }
-    }
+    rotatePlane<1>({pYPlane, nSrcWidth, pOutBuffer, outputStride, nSrcWidth, nSrcHeight},
+            kRotate90);
 
+    // Rotate UV buffer, the interleaved U and V are moved in pairs
+    const uint16_t nUVWidth = nSrcWidth / 2;
+    rotatePlane<2>({pUVPlane, nUVWidth * 2u, pOutBuffer + outputStride * nDstHt, outputStride,
+                           nUVWidth, nSrcHeight / 2u},
+            kRotate90);
     return 0;
 }
 
 void ImsMediaImageRotate::YUV420_SP_Rotate90_Flip(uint8_t* pbDst, uint8_t* pYPlane,
         uint8_t* pUVPlane, uint16_t nSrcWidth, uint16_t nSrcHeight)
 {
-    uint16_t x, y;
-    uint64_t srcIdx, dstIdx;
     const size_t size = nSrcWidth * nSrcHeight;
 
-    dstIdx = size - 1;
-
     // Rotate Y buffer
-    for (y = 0; y < nSrcWidth; y++)
-    {
-        srcIdx = y;
-        for (x = 0; x < nSrcHeight; x++)
-        {
-            pbDst[dstIdx] = pYPlane[srcIdx];  // Y
-            srcIdx += nSrcWidth;
-            dstIdx--;
-        }
-    }
+    rotatePlane<1>({pYPlane, nSrcWidth, pbDst, nSrcHeight, nSrcWidth, nSrcHeight}, kRotate90Flip);
 
-    dstIdx = (size * 1.5f) - 1;
-    nSrcWidth /= 2;
-    nSrcHeight /= 2;
-
-    // Rotate UV buffer
-    for (y = 0; y < nSrcWidth; y++)
-    {
-        srcIdx = y * 2;
-        for (x = 0; x < nSrcHeight; x++)
-        {
-            pbDst[dstIdx--] = pUVPlane[srcIdx + 1];  // V
-            pbDst[dstIdx--] = pUVPlane[srcIdx];      // U
-            srcIdx += nSrcWidth * 2;
-        }
-    }
+    // Rotate UV buffer, the interleaved U and V are moved in pairs
+    const uint16_t nUVWidth = nSrcWidth / 2;
+    const uint16_t nUVHeight = nSrcHeight / 2;
+    rotatePlane<2>({pUVPlane, nUVWidth * 2u, pbDst + size, nUVHeight * 2u, nUVWidth, nUVHeight},
+            kRotate90Flip);
 }
 
 int ImsMediaImageRotate::YUV420_SP_Rotate270(uint8_t* pOutBuffer, size_t nOutBufSize,
         uint16_t outputStride, uint8_t* pYPlane, uint8_t* pUVPlane, uint16_t nSrcWidth,
         uint16_t nSrcHeight)
 {
-    uint16_t x, y, nDstWth = nSrcHeight, nDstHt = nSrcWidth, nPadWidth = outputStride - nDstWth;
-    uint64_t srcIdx, dstIdx = outputStride * nDstHt - 1;
-    const size_t size = nSrcWidth * nSrcHeight;
+    uint16_t nDstWth = nSrcHeight, nDstHt = nSrcWidth, nPadWidth = outputStride - nDstWth;
     const size_t dstSize = outputStride * nDstHt * 1.5f;
 
     if (nOutBufSize < (dstSize - nPadWidth))
@@ -175,34 +423,13 @@ int ImsMediaImageRotate::YUV420_SP_Rotate270(uint8_t* pOutBuffer, size_t nOutBuf
     }
 
     // Rotate Y buffer
-    for (y = 0; y < nSrcWidth; y++)
-    {
-        dstIdx -= nPadWidth;
-        srcIdx = size - nSrcWidth + y;
-        for (x = 0; x < nSrcHeight; x++)
-        {
-            pOutBuffer[dstIdx] = pYPlane[srcIdx];  // Y
-            srcIdx -= nSrcWidth;
-            dstIdx--;
-        }
-    }
-
-    dstIdx = dstSize - 1;
-    nSrcWidth /= 2;
-    nSrcHeight /= 2;
-
-    // Rotate UV buffer
-    for (y = 0; y < nSrcWidth; y++)
-    {
-        dstIdx -= nPadWidth;
-        srcIdx = (size / 2) - (nSrcWidth - y) * 2;
-        for (x = 0; x < nSrcHeight; x++)
-        {
-            pOutBuffer[dstIdx--] = pUVPlane[srcIdx + 1];  // V
-            pOutBuffer[dstIdx--] = pUVPlane[srcIdx];      // U
-            srcIdx -= nSrcWidth * 2;
-        }
-    }
+    rotatePlane<1>({pYPlane, nSrcWidth, pOutBuffer, outputStride, nSrcWidth, nSrcHeight},
+            kRotate270);
 
+    // Rotate UV buffer, the interleaved U and V are moved in pairs
+    const uint16_t nUVWidth = nSrcWidth / 2;
+    rotatePlane<2>({pUVPlane, nUVWidth * 2u, pOutBuffer + outputStride * nDstHt, outputStride,
+                           nUVWidth, nSrcHeight / 2u},
+            kRotate270);
     return 0;
-}
\ No newline at end of file
+}
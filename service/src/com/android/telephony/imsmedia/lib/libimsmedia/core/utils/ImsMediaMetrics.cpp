@@ -0,0 +1,174 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ImsMediaMetrics.h>
+#include <ImsMediaTrace.h>
+
+/**
+ * The slot is reserved by the owner to register the stream. The sequence is odd while the owner
+ * updates the key, so the reader discards the snapshot when the sequence is odd or changed while
+ * the snapshot is taken.
+ */
+struct MetricsSlot
+{
+    std::atomic<bool> reserved;
+    std::atomic<uint32_t> sequence;
+    std::atomic<bool> active;
+    std::atomic<int32_t> sessionId;
+    std::atomic<int32_t> mediaType;
+    ImsMediaMetrics metrics;
+};
+
+static MetricsSlot gMetricsSlots[IM_METRICS_MAX_STREAMS];
+
+static bool readMetricsSlot(const MetricsSlot& slot, int32_t sessionId, int32_t mediaType,
+        bool anyStream, ImsMediaMetricsSnapshot& snapshot)
+{
+    uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+    if ((sequence & 1) != 0 || !slot.active.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    snapshot.sessionId = slot.sessionId.load(std::memory_order_relaxed);
+    snapshot.mediaType = static_cast<ImsMediaType>(slot.mediaType.load(std::memory_order_relaxed));
+
+    if (!anyStream && (snapshot.sessionId != sessionId || snapshot.mediaType != mediaType))
+    {
+        return false;
+    }
+
+    slot.metrics.GetSnapshot(snapshot);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+void ImsMediaMetrics::Reset()
+{
+    for (auto& counter : mCounters)
+    {
+        counter.value.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& gauge : mGauges)
+    {
+        gauge.value.store(0, std::memory_order_relaxed);
+    }
+
+    for (auto& histogram : mHistograms)
+    {
+        histogram.Reset();
+    }
+}
+
+void ImsMediaMetrics::GetSnapshot(ImsMediaMetricsSnapshot& snapshot) const
+{
+    for (uint32_t i = 0; i < kMetricCounterMax; i++)
+    {
+        snapshot.counters[i] = mCounters[i].value.load(std::memory_order_relaxed);
+    }
+
+    for (uint32_t i = 0; i < kMetricGaugeMax; i++)
+    {
+        snapshot.gauges[i] = mGauges[i].value.load(std::memory_order_relaxed);
+    }
+
+    for (uint32_t i = 0; i < kMetricHistogramMax; i++)
+    {
+        mHistograms[i].GetSnapshot(snapshot.histograms[i]);
+    }
+}
+
+ImsMediaMetrics* ImsMediaMetricsRegistry::Acquire(int32_t sessionId, ImsMediaType mediaType)
+{
+    for (auto& slot : gMetricsSlots)
+    {
+        bool reserved = false;
+
+        if (!slot.reserved.compare_exchange_strong(reserved, true, std::memory_order_acq_rel))
+        {
+            continue;
+        }
+
+        slot.sequence.fetch_add(1, std::memory_order_acq_rel);
+        slot.metrics.Reset();
+        slot.sessionId.store(sessionId, std::memory_order_relaxed);
+        slot.mediaType.store(mediaType, std::memory_order_relaxed);
+        slot.active.store(true, std::memory_order_relaxed);
+        slot.sequence.fetch_add(1, std::memory_order_release);
+        return &slot.metrics;
+    }
+
+    IMLOGE2("[Acquire] no slot for session[%d], media[%d]", sessionId, mediaType);
+    return nullptr;
+}
+
+void ImsMediaMetricsRegistry::Release(ImsMediaMetrics* metrics)
+{
+    for (auto& slot : gMetricsSlots)
+    {
+        if (&slot.metrics != metrics)
+        {
+            continue;
+        }
+
+        slot.sequence.fetch_add(1, std::memory_order_acq_rel);
+        slot.active.store(false, std::memory_order_relaxed);
+        slot.sequence.fetch_add(1, std::memory_order_release);
+        slot.reserved.store(false, std::memory_order_release);
+        return;
+    }
+}
+
+bool ImsMediaMetricsRegistry::GetSnapshot(
+        int32_t sessionId, ImsMediaType mediaType, ImsMediaMetricsSnapshot& snapshot)
+{
+    for (const auto& slot : gMetricsSlots)
+    {
+        if (readMetricsSlot(slot, sessionId, mediaType, false, snapshot))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32_t ImsMediaMetricsRegistry::GetSnapshots(
+        ImsMediaMetricsSnapshot* snapshots, uint32_t maxSnapshots)
+{
+    uint32_t count = 0;
+
+    if (snapshots == nullptr)
+    {
+        return 0;
+    }
+
+    for (const auto& slot : gMetricsSlots)
+    {
+        if (count >= maxSnapshots)
+        {
+            break;
+        }
+
+        if (readMetricsSlot(slot, 0, 0, true, snapshots[count]))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
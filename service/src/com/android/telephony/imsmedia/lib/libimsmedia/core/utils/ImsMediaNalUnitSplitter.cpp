@@ -0,0 +1,150 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ImsMediaNalUnitSplitter.h>
+#include <string.h>
+
+#define WORD_SIZE 8
+// the start code is the 3 bytes of "00 00 01"
+#define START_CODE_SHORT_LEN 3
+
+// true when any byte of the 64 bits word is zero
+static inline bool HasZeroByte(uint64_t word)
+{
+    return ((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) != 0;
+}
+
+ImsMediaNalUnitSplitter::ImsMediaNalUnitSplitter(uint8_t* buffer, uint32_t size)
+{
+    mEnd = buffer != nullptr ? buffer + size : nullptr;
+    mNextStartCodeSize = 0;
+    mNextStartCode = FindStartCode(buffer, size, &mNextStartCodeSize);
+}
+
+ImsMediaNalUnitSplitter::~ImsMediaNalUnitSplitter() {}
+
+bool ImsMediaNalUnitSplitter::Next(ImsMediaNalUnit* unit)
+{
+    if (unit == nullptr || mNextStartCode == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t* data = mNextStartCode + mNextStartCodeSize;
+    unit->data = data;
+    unit->startCodeSize = mNextStartCodeSize;
+
+    mNextStartCode = FindStartCode(data, mEnd - data, &mNextStartCodeSize);
+    unit->size = (mNextStartCode != nullptr ? mNextStartCode : mEnd) - data;
+    return true;
+}
+
+uint32_t ImsMediaNalUnitSplitter::Split(
+        uint8_t* buffer, uint32_t size, ImsMediaNalUnit* units, uint32_t maxUnits)
+{
+    if (units == nullptr)
+    {
+        return 0;
+    }
+
+    ImsMediaNalUnitSplitter splitter(buffer, size);
+    uint32_t count = 0;
+
+    while (count < maxUnits && splitter.Next(&units[count]))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+uint8_t* ImsMediaNalUnitSplitter::FindStartCode(
+        uint8_t* buffer, uint32_t size, uint32_t* startCodeSize)
+{
+    if (buffer == nullptr || size < START_CODE_SHORT_LEN)
+    {
+        return nullptr;
+    }
+
+    uint8_t* end = buffer + size;
+    // the last position the start code can begin
+    uint8_t* last = end - START_CODE_SHORT_LEN;
+    uint8_t* pos = buffer;
+
+    while (pos <= last)
+    {
+        // the start code can't begin in the word which has no zero byte
+        while (end - pos >= WORD_SIZE)
+        {
+            uint64_t word;
+            memcpy(&word, pos, WORD_SIZE);
+
+            if (HasZeroByte(word))
+            {
+                break;
+            }
+
+            pos += WORD_SIZE;
+        }
+
+        uint8_t* wordEnd = end - pos >= WORD_SIZE ? pos + WORD_SIZE : last + 1;
+
+        for (; pos < wordEnd && pos <= last; pos++)
+        {
+            if (pos[0] == 0x00 && pos[1] == 0x00 && pos[2] == 0x01)
+            {
+                if (pos > buffer && pos[-1] == 0x00)
+                {
+                    if (startCodeSize != nullptr)
+                    {
+                        *startCodeSize = START_CODE_SHORT_LEN + 1;
+                    }
+
+                    return pos - 1;
+                }
+
+                if (startCodeSize != nullptr)
+                {
+                    *startCodeSize = START_CODE_SHORT_LEN;
+                }
+
+                return pos;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+uint32_t ImsMediaNalUnitSplitter::GetStartCodeSize(const uint8_t* buffer, uint32_t size)
+{
+    if (buffer == nullptr || size < START_CODE_SHORT_LEN || buffer[0] != 0x00 ||
+            buffer[1] != 0x00)
+    {
+        return 0;
+    }
+
+    if (buffer[2] == 0x01)
+    {
+        return START_CODE_SHORT_LEN;
+    }
+
+    if (size > START_CODE_SHORT_LEN && buffer[2] == 0x00 && buffer[3] == 0x01)
+    {
+        return START_CODE_SHORT_LEN + 1;
+    }
+
+    return 0;
+}
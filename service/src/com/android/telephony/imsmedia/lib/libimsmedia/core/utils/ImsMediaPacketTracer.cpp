@@ -0,0 +1,264 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ImsMediaPacketTracer.h>
+#include <ImsMediaTrace.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <mutex>
+#include <vector>
+
+#define RTP_HEADER_SIZE 12
+// the rings of the exited threads are reused when there are more rings than this
+#define MAX_PACKET_TRACE_RINGS 32
+
+/**
+ * The ring is written by the owner thread only. The head is the number of records written and
+ * released after each record so the reader gets the records before the head. The records before
+ * the base are discarded by Reset.
+ */
+struct PacketTraceRing
+{
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> base;
+    std::atomic<bool> inUse;
+    ImsMediaPacketTraceRecord records[IM_PACKET_TRACE_RING_SIZE];
+};
+
+static std::mutex gRingMutex;
+static std::vector<PacketTraceRing*> gRings;
+
+/**
+ * Returns the ring of the thread to the free rings when the thread exits
+ */
+class PacketTraceRingHolder
+{
+public:
+    PacketTraceRingHolder() :
+            ring(nullptr),
+            threadId(0)
+    {
+    }
+
+    ~PacketTraceRingHolder()
+    {
+        if (ring != nullptr)
+        {
+            ring->inUse.store(false, std::memory_order_release);
+        }
+    }
+
+    PacketTraceRing* ring;
+    // the tid is taken once with the ring instead of the syscall for every record
+    uint32_t threadId;
+};
+
+static thread_local PacketTraceRingHolder gThreadRing;
+
+std::atomic<bool> ImsMediaPacketTracer::sEnabled(false);
+
+static PacketTraceRing* AcquireRing()
+{
+    std::lock_guard<std::mutex> guard(gRingMutex);
+
+    // keep the records of the exited threads as long as possible, a reused ring continues from
+    // the head and the old records are overwritten one by one
+    if (gRings.size() >= MAX_PACKET_TRACE_RINGS)
+    {
+        for (auto& ring : gRings)
+        {
+            bool inUse = false;
+
+            if (ring->inUse.compare_exchange_strong(inUse, true))
+            {
+                return ring;
+            }
+        }
+    }
+
+    PacketTraceRing* ring = new PacketTraceRing();
+    ring->head.store(0, std::memory_order_relaxed);
+    ring->base.store(0, std::memory_order_relaxed);
+    ring->inUse.store(true, std::memory_order_relaxed);
+    gRings.push_back(ring);
+    return ring;
+}
+
+static uint64_t GetTimeInNanoSeconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Copy the valid records of the ring. The records overwritten by the writer during the copy are
+ * dropped.
+ */
+static uint32_t CollectRing(
+        PacketTraceRing* ring, ImsMediaPacketTraceRecord* records, uint32_t maxRecords)
+{
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t count = head - ring->base.load(std::memory_order_relaxed);
+
+    // the slot of the head can be in the middle of the next write, so a full ring gives one
+    // record less than its size
+    if (count > IM_PACKET_TRACE_RING_SIZE - 1)
+    {
+        count = IM_PACKET_TRACE_RING_SIZE - 1;
+    }
+
+    if (count > maxRecords)
+    {
+        count = maxRecords;
+    }
+
+    uint64_t start = head - count;
+
+    for (uint64_t i = 0; i < count; i++)
+    {
+        records[i] = ring->records[(start + i) & (IM_PACKET_TRACE_RING_SIZE - 1)];
+    }
+
+    uint64_t newHead = ring->head.load(std::memory_order_acquire);
+
+    // the slot of start is reused by the writer once newHead - start reaches the ring size
+    if (newHead - start < IM_PACKET_TRACE_RING_SIZE)
+    {
+        return count;
+    }
+
+    uint64_t overwritten = newHead - start - IM_PACKET_TRACE_RING_SIZE + 1;
+
+    if (overwritten >= count)
+    {
+        return 0;
+    }
+
+    memmove(records, records + overwritten, (count - overwritten) * sizeof(records[0]));
+    return count - overwritten;
+}
+
+void ImsMediaPacketTracer::SetEnabled(bool enabled)
+{
+    IMLOGD1("[SetEnabled] enabled[%d]", enabled);
+    sEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void ImsMediaPacketTracer::Write(ImsMediaPacketTraceEvent event, int32_t sessionId, uint16_t seq,
+        uint32_t timestamp, uint32_t size)
+{
+    PacketTraceRing* ring = gThreadRing.ring;
+
+    if (ring == nullptr)
+    {
+        ring = AcquireRing();
+        gThreadRing.ring = ring;
+        gThreadRing.threadId = gettid();
+    }
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    ImsMediaPacketTraceRecord& record = ring->records[head & (IM_PACKET_TRACE_RING_SIZE - 1)];
+    record.timeNs = GetTimeInNanoSeconds();
+    record.sessionId = sessionId;
+    record.threadId = gThreadRing.threadId;
+    record.timestamp = timestamp;
+    record.size = size;
+    record.seq = seq;
+    record.event = event;
+    record.reserved = 0;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void ImsMediaPacketTracer::WriteRtp(
+        ImsMediaPacketTraceEvent event, int32_t sessionId, const uint8_t* data, uint32_t size)
+{
+    uint16_t seq = 0;
+    uint32_t timestamp = 0;
+
+    if (data != nullptr && size >= RTP_HEADER_SIZE)
+    {
+        seq = (data[2] << 8) | data[3];
+        timestamp = (data[4] << 24) | (data[5] << 16) | (data[6] << 8) | data[7];
+    }
+
+    Write(event, sessionId, seq, timestamp, size);
+}
+
+uint32_t ImsMediaPacketTracer::Collect(ImsMediaPacketTraceRecord* records, uint32_t maxRecords)
+{
+    if (records == nullptr)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> guard(gRingMutex);
+    uint32_t count = 0;
+
+    for (auto& ring : gRings)
+    {
+        count += CollectRing(ring, records + count, maxRecords - count);
+    }
+
+    return count;
+}
+
+int32_t ImsMediaPacketTracer::Dump(const char* path)
+{
+    if (path == nullptr)
+    {
+        return -1;
+    }
+
+    uint32_t maxRecords = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(gRingMutex);
+        maxRecords = gRings.size() * IM_PACKET_TRACE_RING_SIZE;
+    }
+
+    std::vector<ImsMediaPacketTraceRecord> records(maxRecords);
+    uint32_t count = Collect(records.data(), maxRecords);
+
+    FILE* file = fopen(path, "wb");
+
+    if (file == nullptr)
+    {
+        IMLOGE1("[Dump] failed to open[%s]", path);
+        return -1;
+    }
+
+    ImsMediaPacketTraceFileHeader header = {IM_PACKET_TRACE_MAGIC, IM_PACKET_TRACE_VERSION,
+            sizeof(ImsMediaPacketTraceRecord), count, 0};
+    bool result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            (count == 0 || fwrite(records.data(), sizeof(records[0]), count, file) == count);
+    fclose(file);
+
+    IMLOGD2("[Dump] path[%s], records[%u]", path, count);
+    return result ? count : -1;
+}
+
+void ImsMediaPacketTracer::Reset()
+{
+    std::lock_guard<std::mutex> guard(gRingMutex);
+
+    for (auto& ring : gRings)
+    {
+        ring->base.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,304 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ImsMediaQuantileSketch.h>
+#include <string.h>
+#include <cmath>
+
+static const double kGamma = (1 + IM_SKETCH_RELATIVE_ACCURACY) / (1 - IM_SKETCH_RELATIVE_ACCURACY);
+static const double kLogGamma = std::log(kGamma);
+
+static bool writeVarint(uint8_t* buffer, uint32_t size, uint32_t& offset, uint32_t value)
+{
+    do
+    {
+        if (offset >= size)
+        {
+            return false;
+        }
+
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buffer[offset++] = value != 0 ? (byte | 0x80) : byte;
+    } while (value != 0);
+
+    return true;
+}
+
+static bool readVarint(const uint8_t* buffer, uint32_t size, uint32_t& offset, uint32_t& value)
+{
+    value = 0;
+
+    for (uint32_t shift = 0; shift < 32; shift += 7)
+    {
+        if (offset >= size)
+        {
+            return false;
+        }
+
+        uint8_t byte = buffer[offset++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ImsMediaQuantileSketch::ImsMediaQuantileSketch()
+{
+    Reset();
+}
+
+ImsMediaQuantileSketch::~ImsMediaQuantileSketch() {}
+
+void ImsMediaQuantileSketch::Add(uint32_t value)
+{
+    if (value == 0)
+    {
+        mZeroCount++;
+    }
+    else
+    {
+        mBins[GetBinIndex(value)]++;
+    }
+
+    if (mCount == 0 || value < mMin)
+    {
+        mMin = value;
+    }
+
+    if (value > mMax)
+    {
+        mMax = value;
+    }
+
+    mCount++;
+}
+
+void ImsMediaQuantileSketch::Merge(const ImsMediaQuantileSketch& sketch)
+{
+    if (sketch.mCount == 0)
+    {
+        return;
+    }
+
+    if (mCount == 0 || sketch.mMin < mMin)
+    {
+        mMin = sketch.mMin;
+    }
+
+    if (sketch.mMax > mMax)
+    {
+        mMax = sketch.mMax;
+    }
+
+    mZeroCount += sketch.mZeroCount;
+
+    for (uint32_t i = 0; i < IM_SKETCH_MAX_BINS; i++)
+    {
+        mBins[i] += sketch.mBins[i];
+    }
+
+    mCount += sketch.mCount;
+}
+
+void ImsMediaQuantileSketch::Reset()
+{
+    mCount = 0;
+    mZeroCount = 0;
+    mMin = 0;
+    mMax = 0;
+    memset(mBins, 0, sizeof(mBins));
+}
+
+uint32_t ImsMediaQuantileSketch::GetPercentile(uint32_t percent) const
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    if (percent == 0)
+    {
+        return mMin;
+    }
+
+    if (percent >= 100)
+    {
+        return mMax;
+    }
+
+    uint64_t rank = (mCount * percent + 99) / 100;
+    uint64_t accumulated = mZeroCount;
+
+    if (accumulated >= rank)
+    {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < IM_SKETCH_MAX_BINS; i++)
+    {
+        accumulated += mBins[i];
+
+        if (accumulated < rank)
+        {
+            continue;
+        }
+
+        // the last bin has all the larger values and its middle is unknown
+        if (i == IM_SKETCH_MAX_BINS - 1)
+        {
+            return mMax;
+        }
+
+        // the value in the middle of the bin in the relative error
+        uint32_t value = std::lround(2 * std::pow(kGamma, i) / (1 + kGamma));
+
+        // the estimation can not be out of the values counted
+        if (value < mMin)
+        {
+            value = mMin;
+        }
+
+        if (value > mMax)
+        {
+            value = mMax;
+        }
+
+        return value;
+    }
+
+    return mMax;
+}
+
+uint32_t ImsMediaQuantileSketch::Serialize(uint8_t* buffer, uint32_t size) const
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return 0;
+    }
+
+    uint32_t numBins = 0;
+
+    for (uint32_t i = 0; i < IM_SKETCH_MAX_BINS; i++)
+    {
+        if (mBins[i] != 0)
+        {
+            numBins++;
+        }
+    }
+
+    uint32_t offset = 0;
+    buffer[offset++] = IM_SKETCH_VERSION;
+
+    if (!writeVarint(buffer, size, offset, mZeroCount) ||
+            !writeVarint(buffer, size, offset, GetMin()) ||
+            !writeVarint(buffer, size, offset, mMax) ||
+            !writeVarint(buffer, size, offset, numBins))
+    {
+        return 0;
+    }
+
+    uint32_t prevIndex = 0;
+
+    // each bin is the distance from the previous bin and the count
+    for (uint32_t i = 0; i < IM_SKETCH_MAX_BINS; i++)
+    {
+        if (mBins[i] == 0)
+        {
+            continue;
+        }
+
+        if (!writeVarint(buffer, size, offset, i - prevIndex) ||
+                !writeVarint(buffer, size, offset, mBins[i]))
+        {
+            return 0;
+        }
+
+        prevIndex = i;
+    }
+
+    return offset;
+}
+
+bool ImsMediaQuantileSketch::Deserialize(const uint8_t* buffer, uint32_t size)
+{
+    Reset();
+
+    if (buffer == nullptr || size == 0 || buffer[0] != IM_SKETCH_VERSION)
+    {
+        return false;
+    }
+
+    uint32_t offset = 1;
+    uint32_t zeroCount, min, max, numBins;
+
+    if (!readVarint(buffer, size, offset, zeroCount) || !readVarint(buffer, size, offset, min) ||
+            !readVarint(buffer, size, offset, max) || !readVarint(buffer, size, offset, numBins) ||
+            numBins > IM_SKETCH_MAX_BINS || min > max)
+    {
+        return false;
+    }
+
+    uint64_t count = zeroCount;
+    uint32_t index = 0;
+
+    for (uint32_t i = 0; i < numBins; i++)
+    {
+        uint32_t distance, binCount;
+
+        // compare with the bins left not to wrap the index with the large distance
+        if (!readVarint(buffer, size, offset, distance) ||
+                !readVarint(buffer, size, offset, binCount) ||
+                distance >= IM_SKETCH_MAX_BINS - index || (i > 0 && distance == 0) ||
+                binCount == 0)
+        {
+            Reset();
+            return false;
+        }
+
+        index += distance;
+        mBins[index] = binCount;
+        count += binCount;
+    }
+
+    // the trailing bytes or the min and max without a value are not written by Serialize
+    if (offset != size || (count == 0 && max != 0))
+    {
+        Reset();
+        return false;
+    }
+
+    mZeroCount = zeroCount;
+    mCount = count;
+    mMin = min;
+    mMax = max;
+    return true;
+}
+
+uint32_t ImsMediaQuantileSketch::GetBinIndex(uint32_t value)
+{
+    if (value <= 1)
+    {
+        return 0;
+    }
+
+    uint32_t index = std::ceil(std::log(value) / kLogGamma);
+    return index < IM_SKETCH_MAX_BINS ? index : IM_SKETCH_MAX_BINS - 1;
+}
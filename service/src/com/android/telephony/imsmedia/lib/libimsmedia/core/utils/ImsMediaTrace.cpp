@@ -69,9 +69,11 @@ static uint IM_remove_log = 1;
 static uint gLogMode = kLogEnableDebug;
 static uint gDebugLogMode = 0;
 
+std::atomic<uint32_t> ImsMediaTrace::sPacketLogMask(0);
+
 void ImsMediaTrace::IMLOGD_PACKET_ARG(IM_PACKET_LOG_TYPE type, const char* format, ...)
 {
-    if (gDebugLogMode & type && gLogMode <= kLogEnableDebug)
+    if (IMIsPacketLogEnabled(type))
     {
         __IMLOG__(ANDROID_LOG_DEBUG, IM_DEBUG_TAG);
     }
@@ -80,11 +82,13 @@ void ImsMediaTrace::IMLOGD_PACKET_ARG(IM_PACKET_LOG_TYPE type, const char* forma
 void ImsMediaTrace::IMSetLogMode(uint mode)
 {
     gLogMode = mode;
+    UpdatePacketLogMask();
 }
 
 void ImsMediaTrace::IMSetDebugLogMode(uint type)
 {
     gDebugLogMode = type;
+    UpdatePacketLogMask();
 }
 
 uint ImsMediaTrace::IMGetDebugLog()
@@ -182,3 +186,9 @@ char* ImsMediaTrace::IM_StripFileName(char* pcFileName)
 
     return pcTemp;
 }
+
+void ImsMediaTrace::UpdatePacketLogMask()
+{
+    sPacketLogMask.store(
+            gLogMode <= kLogEnableDebug ? gDebugLogMode : 0, std::memory_order_relaxed);
+}
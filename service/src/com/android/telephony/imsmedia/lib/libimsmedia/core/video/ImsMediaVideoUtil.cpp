@@ -19,16 +19,35 @@
 #include <ImsMediaVideoUtil.h>
 #include <ImsMediaBitReader.h>
 #include <ImsMediaBinaryFormat.h>
+#include <ImsMediaNalUnitSplitter.h>
 #include <ImsMediaTrace.h>
 #include <VideoConfig.h>
 #include <memory>
 #include <string.h>
 
-#define START_CODE_PREFIX_LEN           4
 #define MAX_OUTPUT_BUFFER_READ_ATTEMPTS 5
 #define FRAME_TYPE_SPS                  7
 #define FRAME_TYPE_PPS                  8
 
+// Returns the offset of the sps payload following the 2 bytes nal unit header of the first sps nal
+// unit, or 0 when the buffer has no sps nal unit with the start code
+static uint32_t FindHevcSpsPayload(uint8_t* pbBuffer, uint32_t nBufferSize)
+{
+    ImsMediaNalUnitSplitter splitter(pbBuffer, nBufferSize);
+    ImsMediaNalUnit unit;
+
+    while (splitter.Next(&unit))
+    {
+        // sps of nuh_layer_id 0 and nuh_temporal_id_plus1 1
+        if (unit.size > 2 && unit.data[0] == 0x42 && unit.data[1] == 0x01)
+        {
+            return unit.data + 2 - pbBuffer;
+        }
+    }
+
+    return 0;
+}
+
 ImsMediaVideoUtil::ImsMediaVideoUtil() {}
 
 ImsMediaVideoUtil::~ImsMediaVideoUtil() {}
@@ -288,19 +307,7 @@ ImsMediaResult ImsMediaVideoUtil::ParseHevcSpropParam(const char* szSpropparam,
     ImsMediaTrace::IMLOGD_BINARY("[ParseHevcSpropParam] sps=",
             reinterpret_cast<const char*>(pszSpropparam), nSPSConfigSize);
 
-    uint32_t nOffset = 0;
-
-    for (int32_t i = 0; i < nSPSConfigSize - 6; i++)
-    {
-        // NAL unit header offset
-        if (pszSpropparam[i] == 0x00 && pszSpropparam[i + 1] == 0x00 &&
-                pszSpropparam[i + 2] == 0x00 && pszSpropparam[i + 3] == 0x01 &&
-                pszSpropparam[i + 4] == 0x42 && pszSpropparam[i + 5] == 0x01)
-        {
-            nOffset = i + 6;
-            break;
-        }
-    }
+    uint32_t nOffset = FindHevcSpsPayload(pszSpropparam, nSPSConfigSize);
 
     IMLOGD2("[ParseHevcSpropParam] nSPSConfigSize[%d], offset[%d]", nSPSConfigSize, nOffset);
 
@@ -437,12 +444,24 @@ bool ImsMediaVideoUtil::ParseAvcSps(uint8_t* pbBuffer, uint32_t nBufferSize, tCo
 
     IMLOGD_PACKET1(IM_PACKET_LOG_VIDEO, "[ParseAvcSps] pszSPS[%02X]", pszSPS[0]);
 
-    bitreader.SetBuffer(pszSPS, nBufferSize);
-    bitreader.Read(8);
-    bitreader.Read(8);
-    bitreader.Read(8);
-    bitreader.Read(8);
-    bitreader.Read(8);
+    // the buffer without the start code is parsed as the sps nal unit
+    uint32_t nOffset = 0;
+    uint32_t nSize = nBufferSize;
+    ImsMediaNalUnitSplitter splitter(pszSPS, nBufferSize);
+    ImsMediaNalUnit unit;
+
+    while (splitter.Next(&unit))
+    {
+        if (unit.size > 0 && (unit.data[0] & 0x1F) == 7)
+        {
+            nOffset = unit.data - pszSPS;
+            nSize = unit.size;
+            break;
+        }
+    }
+
+    bitreader.SetBuffer(pszSPS + nOffset, nSize);
+    bitreader.Read(8);  // nal unit header
 
     uint32_t Profile_idc = bitreader.Read(8);  // Read profile_idc
     // Read constraint
@@ -575,18 +594,7 @@ bool ImsMediaVideoUtil::ParseHevcSps(uint8_t* pbBuffer, uint32_t nBufferSize, tC
         return false;
     }
 
-    uint32_t nOffset = 0;
-
-    for (int32_t i = 0; i < nBufferSize - 6; i++)
-    {
-        // NAL unit header offset
-        if (pbBuffer[i] == 0x00 && pbBuffer[i + 1] == 0x00 && pbBuffer[i + 2] == 0x00 &&
-                pbBuffer[i + 3] == 0x01 && pbBuffer[i + 4] == 0x42 && pbBuffer[i + 5] == 0x01)
-        {
-            nOffset = i + 6;
-            break;
-        }
-    }
+    uint32_t nOffset = FindHevcSpsPayload(pbBuffer, nBufferSize);
 
     ImsMediaBitReader objBitReader;
     objBitReader.SetBuffer(pbBuffer + nOffset, nBufferSize - nOffset);
@@ -676,35 +684,6 @@ bool ImsMediaVideoUtil::ParseHevcSps(uint8_t* pbBuffer, uint32_t nBufferSize, tC
     return true;
 }
 
-uint8_t* FindAvcStartCode(uint8_t* pData, uint32_t nDataSize, uint32_t* pnSkipSize)
-{
-    uint8_t* pCurDataPos = pData;
-    uint32_t nSkipSize = 0;
-
-    // Remove leading zero bytes and start code prefix
-    while (nDataSize >= START_CODE_PREFIX_LEN)
-    {
-        // Start Code 00 00 00 01 case.
-        if (pCurDataPos[0] == 0x00 && pCurDataPos[1] == 0x00 && pCurDataPos[2] == 0x00 &&
-                pCurDataPos[3] == 0x01)
-        {
-            if (pnSkipSize)
-                *pnSkipSize = nSkipSize;
-            return pCurDataPos;
-        }
-        else
-        {
-            pCurDataPos += 1;
-            nDataSize -= 1;
-            nSkipSize += 1;
-        }
-    }
-
-    if (pnSkipSize)
-        *pnSkipSize = nSkipSize;
-    return nullptr;
-}
-
 char* ImsMediaVideoUtil::GenerateVideoSprop(VideoConfig* pVideoConfig)
 {
     if (pVideoConfig == nullptr)
@@ -798,36 +777,20 @@ char* ImsMediaVideoUtil::GenerateVideoSprop(VideoConfig* pVideoConfig)
             buf += info.offset;
             buffCapacity = info.size;
 
-            while (buf != nullptr && buffCapacity > 0)
+            ImsMediaNalUnitSplitter splitter(buf, buffCapacity);
+            ImsMediaNalUnit unit;
+
+            while (splitter.Next(&unit))
             {
-                uint32_t skipLen = 0;
-                uint8_t* tempBufPtr = FindAvcStartCode(buf, buffCapacity, &skipLen);
-                if (tempBufPtr != nullptr)
+                if (unit.size == 0)
                 {
-                    buf = tempBufPtr;
-                    buffCapacity -= skipLen;
-                }
-
-                if (buf == nullptr || buffCapacity < START_CODE_PREFIX_LEN)
                     continue;
-
-                // Remove start sequence
-                buf += START_CODE_PREFIX_LEN;
-                buffCapacity -= START_CODE_PREFIX_LEN;
-
-                uint8_t frameType = buf[0] & 0x1F;
-
-                // Extract frame
-                int frameLen = buffCapacity;
-                tempBufPtr = FindAvcStartCode(buf, buffCapacity, &skipLen);
-                if (tempBufPtr != nullptr)
-                {
-                    frameLen = tempBufPtr - buf;
                 }
 
+                uint8_t frameType = unit.data[0] & 0x1F;
                 int16_t SpropStrlen = strlen(pSpropStr);
                 bool ret = ImsMediaBinaryFormat::BinaryToBase00(pSpropStr + SpropStrlen,
-                        MAX_CONFIG_LEN, buf, frameLen, BINARY_FORMAT_BASE64);
+                        MAX_CONFIG_LEN, unit.data, unit.size, BINARY_FORMAT_BASE64);
                 if (ret == false)
                 {
                     IMLOGE0("[GenerateVideoSprop] BinaryToBase64 failed");
@@ -846,9 +809,6 @@ char* ImsMediaVideoUtil::GenerateVideoSprop(VideoConfig* pVideoConfig)
                 {
                     bPpsRead = true;
                 }
-
-                buffCapacity -= frameLen;
-                buf += frameLen;
             }
 
             AMediaCodec_releaseOutputBuffer(pCodec, index, false);
@@ -0,0 +1,200 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VideoFrameBufferPool.h>
+#include <ImsMediaVideoUtil.h>
+#include <ImsMediaTrace.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_FRAME_BUFFER (-1)
+
+VideoFrameBufferPool::VideoFrameBufferPool()
+{
+    memset(mFrames, 0, sizeof(mFrames));
+    mCapacity = 0;
+    mHeld[0] = NO_FRAME_BUFFER;
+    mHeld[1] = NO_FRAME_BUFFER;
+}
+
+VideoFrameBufferPool::~VideoFrameBufferPool()
+{
+    Release();
+}
+
+void VideoFrameBufferPool::SetResolution(uint32_t width, uint32_t height)
+{
+    Release();
+
+    // a coded frame is far smaller than the raw yuv420 frame, the half of it is enough to carry an
+    // intra frame and a larger frame falls back to the copy per packet
+    uint64_t capacity = static_cast<uint64_t>(width) * height * 3 / 4;
+    mCapacity = capacity > MAX_RTP_PAYLOAD_BUFFER_SIZE ? MAX_RTP_PAYLOAD_BUFFER_SIZE : capacity;
+    IMLOGD3("[SetResolution] width[%u], height[%u], capacity[%u]", width, height, mCapacity);
+}
+
+void VideoFrameBufferPool::Reset()
+{
+    for (int32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        mFrames[i].reserved = false;
+        mFrames[i].size = 0;
+    }
+
+    mHeld[0] = NO_FRAME_BUFFER;
+    mHeld[1] = NO_FRAME_BUFFER;
+}
+
+uint8_t* VideoFrameBufferPool::Write(
+        uint32_t timestamp, const uint8_t* data, uint32_t size, ImsMediaDataQueue* queue)
+{
+    if (data == nullptr || size == 0 || size > mCapacity)
+    {
+        return nullptr;
+    }
+
+    int32_t index = NO_FRAME_BUFFER;
+
+    for (int32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        if (mFrames[i].reserved && mFrames[i].timestamp == timestamp)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if (index == NO_FRAME_BUFFER)
+    {
+        index = Reserve(timestamp, queue);
+
+        if (index == NO_FRAME_BUFFER)
+        {
+            return nullptr;
+        }
+    }
+
+    FrameBuffer& frame = mFrames[index];
+
+    if (frame.size + size > mCapacity)
+    {
+        IMLOGD_PACKET3(IM_PACKET_LOG_JITTER, "[Write] no room, TS[%u], frame size[%u], size[%u]",
+                timestamp, frame.size, size);
+        return nullptr;
+    }
+
+    uint8_t* dest = frame.buffer + frame.size;
+    memcpy(dest, data, size);
+    frame.size += size;
+    return dest;
+}
+
+void VideoFrameBufferPool::Hold(const uint8_t* data)
+{
+    int32_t index = Find(data);
+
+    if (index != NO_FRAME_BUFFER && index != mHeld[0])
+    {
+        mHeld[1] = mHeld[0];
+        mHeld[0] = index;
+    }
+}
+
+bool VideoFrameBufferPool::Contains(const uint8_t* data) const
+{
+    return Find(data) != NO_FRAME_BUFFER;
+}
+
+int32_t VideoFrameBufferPool::Find(const uint8_t* data) const
+{
+    if (data == nullptr)
+    {
+        return NO_FRAME_BUFFER;
+    }
+
+    for (int32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        if (mFrames[i].buffer != nullptr && data >= mFrames[i].buffer &&
+                data < mFrames[i].buffer + mCapacity)
+        {
+            return i;
+        }
+    }
+
+    return NO_FRAME_BUFFER;
+}
+
+int32_t VideoFrameBufferPool::Reserve(uint32_t timestamp, ImsMediaDataQueue* queue)
+{
+    bool referred[VIDEO_FRAME_BUFFER_POOL_SIZE] = {false};
+
+    if (queue != nullptr)
+    {
+        DataEntry* entry = nullptr;
+        queue->SetReadPosFirst();
+
+        while (queue->GetNext(&entry))
+        {
+            int32_t index = Find(entry->pbBuffer);
+
+            if (index != NO_FRAME_BUFFER)
+            {
+                referred[index] = true;
+            }
+        }
+    }
+
+    for (int32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        if (referred[i] || i == mHeld[0] || i == mHeld[1])
+        {
+            continue;
+        }
+
+        if (mFrames[i].buffer == nullptr)
+        {
+            mFrames[i].buffer = reinterpret_cast<uint8_t*>(malloc(mCapacity));
+
+            if (mFrames[i].buffer == nullptr)
+            {
+                return NO_FRAME_BUFFER;
+            }
+        }
+
+        mFrames[i].timestamp = timestamp;
+        mFrames[i].size = 0;
+        mFrames[i].reserved = true;
+        return i;
+    }
+
+    IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[Reserve] no frame buffer for TS[%u]", timestamp);
+    return NO_FRAME_BUFFER;
+}
+
+void VideoFrameBufferPool::Release()
+{
+    for (int32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        if (mFrames[i].buffer != nullptr)
+        {
+            free(mFrames[i].buffer);
+        }
+    }
+
+    memset(mFrames, 0, sizeof(mFrames));
+    mHeld[0] = NO_FRAME_BUFFER;
+    mHeld[1] = NO_FRAME_BUFFER;
+}
@@ -18,8 +18,11 @@
 #include <VideoJitterBuffer.h>
 #include <ImsMediaDataQueue.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
+#include <ImsMediaMetrics.h>
 #include <ImsMediaVideoUtil.h>
 #include <ImsMediaTimer.h>
+#include <string.h>
 
 #define DEFAULT_MAX_SAVE_FRAME_NUM          (5)
 #define DEFAULT_IDR_FRAME_CHECK_INTRERVAL   (3)
@@ -92,6 +95,20 @@ void VideoJitterBuffer::SetFramerate(uint32_t framerate)
     IMLOGD2("[SetFramerate] framerate[%u], frameInterval[%d]", mFramerate, mFrameInterval);
 }
 
+void VideoJitterBuffer::SetResolution(uint32_t width, uint32_t height)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    // the entries refer to the frame buffers to be released
+    mDataQueue.Clear();
+    mFramePool.SetResolution(width, height);
+}
+
+bool VideoJitterBuffer::IsFrameBuffer(const uint8_t* data)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mFramePool.Contains(data);
+}
+
 void VideoJitterBuffer::InitLostPktList()
 {
     IMLOGD0("[InitLostPktList]");
@@ -125,6 +142,7 @@ void VideoJitterBuffer::Reset()
     mLastAddedSeqNum = 0;
     InitLostPktList();
     mResponseWaitTime = 0;
+    mFramePool.Reset();
 }
 
 void VideoJitterBuffer::StartTimer(uint32_t time, uint32_t rate)
@@ -202,6 +220,7 @@ void VideoJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
     IMLOGD_PACKET6(IM_PACKET_LOG_JITTER,
             "[Add] eDataType[%u], Seq[%u], Mark[%u], Header[%u], TS[%u], Size[%u]",
             currEntry.eDataType, nSeqNum, bMark, currEntry.bHeader, nTimestamp, nBufferSize);
+    IMTRACE_PACKET(kPacketTraceJitterAdd, mCallback, nSeqNum, nTimestamp, nBufferSize);
 
     // very old frame, don't add this frame, nothing to do
     if ((!USHORT_SEQ_ROUND_COMPARE(nSeqNum, mLastPlayedSeqNum)) && (mLastPlayedTime != 0))
@@ -211,6 +230,7 @@ void VideoJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
     }
     else if (mDataQueue.GetCount() == 0)
     {  // jitter buffer is empty
+        StoreToFrameBuffer(&currEntry);
         mDataQueue.Add(&currEntry);
         mNumAddedPacket++;
         mAccumulatedPacketSize += nBufferSize;
@@ -232,13 +252,16 @@ void VideoJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
 
         if (USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
         {
-            // current data is the latest data
-            if (nSeqNum == pEntry->nSeqNum && nBufferSize == pEntry->nBufferSize)
+            // current data is the latest data, the nal units of an aggregation packet share the
+            // sequence number so the payload is compared as well
+            if (nSeqNum == pEntry->nSeqNum && IsDuplicated(nSeqNum, pbBuffer, nBufferSize))
             {
                 IMLOGD1("[Add] drop duplicate Seq[%u]", nSeqNum);
+                CountDuplicatedPacket();
                 return;
             }
 
+            StoreToFrameBuffer(&currEntry);
             mDataQueue.Add(&currEntry);
             mNumAddedPacket++;
             mAccumulatedPacketSize += nBufferSize;
@@ -254,14 +277,17 @@ void VideoJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
 
             for (i = 0; mDataQueue.GetNext(&pEntry); i++)
             {
-                if (nSeqNum == pEntry->nSeqNum && nBufferSize == pEntry->nBufferSize)
+                if (nSeqNum == pEntry->nSeqNum && nBufferSize == pEntry->nBufferSize &&
+                        memcmp(pbBuffer, pEntry->pbBuffer, nBufferSize) == 0)
                 {
                     IMLOGD1("[Add] drop duplicate Seq[%u]", nSeqNum);
+                    CountDuplicatedPacket();
                     return;
                 }
 
                 if (!USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
                 {
+                    StoreToFrameBuffer(&currEntry);
                     mDataQueue.InsertAt(i, &currEntry);
                     break;
                 }
@@ -318,6 +344,8 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
         uint32_t nIndex = 0;
         uint32_t nHeaderIndex = 0;
         uint16_t nHeaderSeq = 0;
+        // the entries after the header sharing the sequence number of an aggregation packet
+        uint32_t nSharedSeqCount = 0;
         uint32_t nHeaderTimestamp = 0;
         uint32_t nLastTimeStamp = 0;
         uint32_t nSavedIdrFrame = 0;
@@ -334,6 +362,7 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
                 CheckPacketLoss(pEntry->nSeqNum, nLastRecvSeq);
             }
 
+            bool bSharedSeq = nIndex > 0 && pEntry->nSeqNum == nLastRecvSeq;
             nLastRecvSeq = pEntry->nSeqNum;
 
             if (pEntry->nTimestamp != nLastTimeStamp || nLastTimeStamp == 0)
@@ -386,6 +415,7 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
                         nHeaderTimestamp = pEntry->nTimestamp;
                         nHeaderIndex = nIndex;
                         nHeaderSeq = pEntry->nSeqNum;
+                        nSharedSeqCount = 0;
                         bFoundHeader = true;
 
                         IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
@@ -402,13 +432,18 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
                         "nHeaderTimestamp[%u]",
                         bFoundHeader, nHeaderSeq, pEntry->nSeqNum, nHeaderTimestamp);
 
+                if (bSharedSeq && nIndex != nHeaderIndex)
+                {
+                    nSharedSeqCount++;
+                }
+
                 if (pEntry->bMark)
                 {
                     uint32_t nMarkIndex = nIndex;
                     uint16_t nMarkSeq = pEntry->nSeqNum;
 
                     // make sure type of 16bit unsigned int sequence number
-                    if (nMarkIndex - nHeaderIndex == nMarkSeq - nHeaderSeq)
+                    if (nMarkIndex - nHeaderIndex - nSharedSeqCount == nMarkSeq - nHeaderSeq)
                     {
                         uint32_t i;
 
@@ -579,11 +614,18 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
 
         mLastPlayedSeqNum = pEntry->nSeqNum;
 
+        if (pEntry->bExternalBuffer)
+        {
+            mFramePool.Hold(pEntry->pbBuffer);
+        }
+
         IMLOGD_PACKET7(IM_PACKET_LOG_JITTER,
                 "[Get] Seq[%u], Mark[%u], TS[%u], Size[%u], SavedFrame[%u], MarkedFrame[%u], "
                 "queue[%u]",
                 pEntry->nSeqNum, pEntry->bMark, pEntry->nTimestamp, pEntry->nBufferSize,
                 mSavedFrameNum, mMarkedFrameNum, mDataQueue.GetCount());
+        IMTRACE_PACKET(kPacketTraceJitterGet, mCallback, pEntry->nSeqNum, pEntry->nTimestamp,
+                pEntry->nBufferSize);
         return true;
     }
     else
@@ -677,6 +719,20 @@ bool VideoJitterBuffer::CheckHeader(uint8_t* pbBuffer)
     }
 }
 
+void VideoJitterBuffer::StoreToFrameBuffer(DataEntry* pEntry)
+{
+    // the packets of the frame are copied back to back in the frame buffer, the queue copies the
+    // packet by itself when the frame buffer has no room
+    uint8_t* pbBuffer = mFramePool.Write(
+            pEntry->nTimestamp, pEntry->pbBuffer, pEntry->nBufferSize, &mDataQueue);
+
+    if (pbBuffer != nullptr)
+    {
+        pEntry->pbBuffer = pbBuffer;
+        pEntry->bExternalBuffer = true;
+    }
+}
+
 void VideoJitterBuffer::RemovePacketFromLostList(uint16_t seqNum, bool bRemoveOldPacket)
 {
     LostPacket* pEntry = nullptr;
@@ -717,6 +773,31 @@ void VideoJitterBuffer::RemovePacketFromLostList(uint16_t seqNum, bool bRemoveOl
     }
 }
 
+void VideoJitterBuffer::CountDuplicatedPacket()
+{
+    if (mMetrics != nullptr)
+    {
+        mMetrics->AddCounter(kMetricDuplicatedPackets);
+    }
+}
+
+bool VideoJitterBuffer::IsDuplicated(uint32_t nSeqNum, uint8_t* pbBuffer, uint32_t nBufferSize)
+{
+    DataEntry* pEntry;
+    mDataQueue.SetReadPosFirst();
+
+    while (mDataQueue.GetNext(&pEntry))
+    {
+        if (pEntry->nSeqNum == nSeqNum && pEntry->nBufferSize == nBufferSize &&
+                memcmp(pbBuffer, pEntry->pbBuffer, nBufferSize) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void VideoJitterBuffer::CheckPacketLoss(uint16_t seqNum, uint16_t nLastRecvPkt)
 {
     if (mLostPktList.size() > 0)
@@ -15,16 +15,19 @@
  */
 
 #include <VideoManager.h>
+#include <ImsMediaEventHandlerId.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaVideoUtil.h>
 #include <ImsMediaNetworkUtil.h>
 
 using namespace android;
+
 VideoManager* VideoManager::manager;
 
 VideoManager::VideoManager()
 {
-    mRequestHandler.Init("VIDEO_REQUEST_EVENT");
-    mResponseHandler.Init("VIDEO_RESPONSE_EVENT");
+    mRequestHandler.Init(VIDEO_REQUEST_EVENT);
+    mResponseHandler.Init(VIDEO_RESPONSE_EVENT);
 }
 
 VideoManager::~VideoManager()
@@ -176,28 +179,26 @@ void VideoManager::sendMessage(const int sessionId, const android::Parcel& parce
         {
             int rtpFd = parcel.readInt32();
             int rtcpFd = parcel.readInt32();
-            VideoConfig* config = new VideoConfig();
-            err = config->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<VideoConfig>();
+            err = payload.Get<VideoConfig>()->readFromParcel(&parcel);
 
             if (err != NO_ERROR)
             {
                 IMLOGE1("[sendMessage] error readFromParcel[%d]", err);
-                delete config;
-                config = nullptr;
+                payload.Reset();
             }
 
-            EventParamOpenSession* param = new EventParamOpenSession(rtpFd, rtcpFd, config);
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(param));
+                    kVideoRequestHandler, nMsg, std::move(payload), sessionId, rtpFd, rtcpFd);
         }
         break;
         case kVideoCloseSession:
-            ImsMediaEventHandler::SendEvent("VIDEO_REQUEST_EVENT", nMsg, sessionId);
+            ImsMediaEventHandler::SendEvent(kVideoRequestHandler, nMsg, sessionId);
             break;
         case kVideoModifySession:
         {
-            VideoConfig* config = new VideoConfig();
-            err = config->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<VideoConfig>();
+            err = payload.Get<VideoConfig>()->readFromParcel(&parcel);
 
             if (err != NO_ERROR)
             {
@@ -205,7 +206,7 @@ void VideoManager::sendMessage(const int sessionId, const android::Parcel& parce
             }
 
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(config));
+                    kVideoRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         case kVideoSendRtpHeaderExtension:
@@ -213,10 +214,10 @@ void VideoManager::sendMessage(const int sessionId, const android::Parcel& parce
             break;
         case kVideoSetMediaQualityThreshold:
         {
-            MediaQualityThreshold* threshold = new MediaQualityThreshold();
-            threshold->readFromParcel(&parcel);
+            ImsMediaEventPayload payload = ImsMediaEventPayload::Create<MediaQualityThreshold>();
+            payload.Get<MediaQualityThreshold>()->readFromParcel(&parcel);
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_REQUEST_EVENT", nMsg, sessionId, reinterpret_cast<uint64_t>(threshold));
+                    kVideoRequestHandler, nMsg, std::move(payload), sessionId);
         }
         break;
         default:
@@ -227,14 +228,14 @@ void VideoManager::sendMessage(const int sessionId, const android::Parcel& parce
 void VideoManager::setPreviewSurface(const int sessionId, ANativeWindow* surface)
 {
     IMLOGI1("[setPreviewSurface] sessionId[%d]", sessionId);
-    ImsMediaEventHandler::SendEvent("VIDEO_REQUEST_EVENT", kVideoSetPreviewSurface, sessionId,
+    ImsMediaEventHandler::SendEvent(kVideoRequestHandler, kVideoSetPreviewSurface, sessionId,
             reinterpret_cast<uint64_t>(surface));
 }
 
 void VideoManager::setDisplaySurface(const int sessionId, ANativeWindow* surface)
 {
     IMLOGI1("[setDisplaySurface] sessionId[%d]", sessionId);
-    ImsMediaEventHandler::SendEvent("VIDEO_REQUEST_EVENT", kVideoSetDisplaySurface, sessionId,
+    ImsMediaEventHandler::SendEvent(kVideoRequestHandler, kVideoSetDisplaySurface, sessionId,
             reinterpret_cast<uint64_t>(surface));
 }
 
@@ -254,8 +255,8 @@ void VideoManager::SendInternalEvent(
     }
 }
 
-void VideoManager::RequestHandler::processEvent(
-        uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB)
+void VideoManager::RequestHandler::processEvent(uint32_t event, uint64_t sessionId,
+        uint64_t paramA, uint64_t paramB, ImsMediaEventPayload& payload)
 {
     IMLOGI4("[processEvent] event[%d], sessionId[%d], paramA[%d], paramB[%d]", event, sessionId,
             paramA, paramB);
@@ -265,36 +266,18 @@ void VideoManager::RequestHandler::processEvent(
     {
         case kVideoOpenSession:
         {
-            EventParamOpenSession* param = reinterpret_cast<EventParamOpenSession*>(paramA);
+            result = VideoManager::getInstance()->openSession(static_cast<int>(sessionId),
+                    static_cast<int>(paramA), static_cast<int>(paramB), payload.Get<VideoConfig>());
 
-            if (param != nullptr)
+            if (result == RESULT_SUCCESS)
             {
-                VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(param->mConfig);
-                result = VideoManager::getInstance()->openSession(
-                        static_cast<int>(sessionId), param->rtpFd, param->rtcpFd, pConfig);
-
-                if (result == RESULT_SUCCESS)
-                {
-                    ImsMediaEventHandler::SendEvent(
-                            "VIDEO_RESPONSE_EVENT", kVideoOpenSessionSuccess, sessionId);
-                }
-                else
-                {
-                    ImsMediaEventHandler::SendEvent(
-                            "VIDEO_RESPONSE_EVENT", kVideoOpenSessionFailure, sessionId, result);
-                }
-
-                delete param;
-
-                if (pConfig != nullptr)
-                {
-                    delete pConfig;
-                }
+                ImsMediaEventHandler::SendEvent(
+                        kVideoResponseHandler, kVideoOpenSessionSuccess, sessionId);
             }
             else
             {
-                ImsMediaEventHandler::SendEvent("VIDEO_RESPONSE_EVENT", kVideoOpenSessionFailure,
-                        sessionId, RESULT_INVALID_PARAM);
+                ImsMediaEventHandler::SendEvent(
+                        kVideoResponseHandler, kVideoOpenSessionFailure, sessionId, result);
             }
         }
         break;
@@ -303,7 +286,7 @@ void VideoManager::RequestHandler::processEvent(
                     RESULT_SUCCESS)
             {
                 ImsMediaEventHandler::SendEvent(
-                        "VIDEO_RESPONSE_EVENT", kVideoSessionClosed, sessionId, 0, 0);
+                        kVideoResponseHandler, kVideoSessionClosed, sessionId, 0, 0);
             }
             break;
         case kVideoSetPreviewSurface:
@@ -316,11 +299,12 @@ void VideoManager::RequestHandler::processEvent(
             break;
         case kVideoModifySession:
         {
-            VideoConfig* config = reinterpret_cast<VideoConfig*>(paramA);
+            VideoConfig* config = payload.Get<VideoConfig>();
             result =
                     VideoManager::getInstance()->modifySession(static_cast<int>(sessionId), config);
-            ImsMediaEventHandler::SendEvent(
-                    "VIDEO_RESPONSE_EVENT", kVideoModifySessionResponse, sessionId, result, paramA);
+            // the config is sent back with the response
+            ImsMediaEventHandler::SendEvent(kVideoResponseHandler, kVideoModifySessionResponse,
+                    std::move(payload), sessionId, result);
         }
         break;
         case kVideoSendRtpHeaderExtension:
@@ -328,23 +312,26 @@ void VideoManager::RequestHandler::processEvent(
             break;
         case kVideoSetMediaQualityThreshold:
         {
-            MediaQualityThreshold* threshold = reinterpret_cast<MediaQualityThreshold*>(paramA);
+            MediaQualityThreshold* threshold = payload.Get<MediaQualityThreshold>();
 
             if (threshold != nullptr)
             {
                 VideoManager::getInstance()->setMediaQualityThreshold(
                         static_cast<int>(sessionId), threshold);
-                delete threshold;
             }
         }
         break;
-        case kRequestVideoCvoUpdate:
-        case kRequestVideoBitrateChange:
-        case kRequestVideoIdrFrame:
         case kRequestVideoSendNack:
         case kRequestVideoSendPictureLost:
         case kRequestVideoSendTmmbr:
         case kRequestVideoSendTmmbn:
+            // the rtcp graph borrows the parameter released with the payload
+            VideoManager::getInstance()->SendInternalEvent(event, sessionId,
+                    reinterpret_cast<uint64_t>(payload.Get<InternalRequestEventParam>()), paramA);
+            break;
+        case kRequestVideoCvoUpdate:
+        case kRequestVideoBitrateChange:
+        case kRequestVideoIdrFrame:
         case kRequestRoundTripTimeDelayUpdate:
             VideoManager::getInstance()->SendInternalEvent(event, sessionId, paramA, paramB);
             break;
@@ -353,8 +340,8 @@ void VideoManager::RequestHandler::processEvent(
     }
 }
 
-void VideoManager::ResponseHandler::processEvent(
-        uint32_t event, uint64_t sessionId, uint64_t paramA, uint64_t paramB)
+void VideoManager::ResponseHandler::processEvent(uint32_t event, uint64_t sessionId,
+        uint64_t paramA, uint64_t paramB, ImsMediaEventPayload& payload)
 {
     IMLOGI4("[processEvent] event[%d], sessionId[%d], paramA[%d], paramB[%d]", event, sessionId,
             paramA, paramB);
@@ -378,13 +365,12 @@ void VideoManager::ResponseHandler::processEvent(
         {
             parcel.writeInt32(event);
             parcel.writeInt32(static_cast<int>(paramA));  // result
-            VideoConfig* config = reinterpret_cast<VideoConfig*>(paramB);
+            VideoConfig* config = payload.Get<VideoConfig>();
 
             if (config != nullptr)
             {
                 config->writeToParcel(&parcel);
                 VideoManager::getInstance()->sendResponse(sessionId, parcel);
-                delete config;
             }
         }
         break;
@@ -399,7 +385,7 @@ void VideoManager::ResponseHandler::processEvent(
             VideoManager::getInstance()->sendResponse(sessionId, parcel);
             break;
         case kVideoRtpHeaderExtensionInd:
-            // TODO : add implementation
+            // TODO : add implementation, the extensions are released with the payload
             break;
         case kVideoMediaInactivityInd:
         case kVideoBitrateInd:
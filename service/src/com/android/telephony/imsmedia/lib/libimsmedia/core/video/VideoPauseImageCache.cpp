@@ -0,0 +1,401 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VideoPauseImageCache.h>
+#include <ImsMediaTrace.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <set>
+
+#define PAUSE_IMAGE_FILE_PREFIX "pause_image_"
+#define PAUSE_IMAGE_FILE_SUFFIX ".bin"
+
+/**
+ * @brief The header of the cache file followed by numFrames FileFrame and dataSize bytes of the
+ * frames in order
+ */
+struct PauseImageFileHeader
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t numFrames;
+    int32_t codecType;
+    uint32_t profile;
+    uint32_t level;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bitrate;
+    uint32_t framerate;
+    uint32_t intraInterval;
+    uint32_t imageHash;
+    uint32_t dataSize;
+};
+
+struct PauseImageFileFrame
+{
+    uint32_t size;
+    uint32_t flags;
+};
+
+std::mutex VideoPauseImageCache::sMutex;
+std::list<std::pair<VideoPauseImageKey, std::shared_ptr<const VideoPauseImageStream>>>
+        VideoPauseImageCache::sEntries;
+std::string VideoPauseImageCache::sDirectory = PAUSE_IMAGE_CACHE_DIR;
+
+VideoPauseImageStream::VideoPauseImageStream()
+{
+    mHasKeyFrame = false;
+    mComplete = false;
+}
+
+VideoPauseImageStream::~VideoPauseImageStream() {}
+
+bool VideoPauseImageStream::AddFrame(const uint8_t* data, uint32_t size, uint32_t flags)
+{
+    if (mComplete || data == nullptr || size == 0)
+    {
+        return mComplete;
+    }
+
+    bool isSyncFrame = (flags & (PAUSE_IMAGE_FLAG_KEY_FRAME | PAUSE_IMAGE_FLAG_CODEC_CONFIG)) != 0;
+
+    if (mHasKeyFrame && isSyncFrame)
+    {
+        // the next gop starts, the stream is sent again from the first idr frame instead
+        mComplete = true;
+        return true;
+    }
+
+    if (mFrames.empty() && !isSyncFrame)
+    {
+        return false;
+    }
+
+    if (mFrames.size() >= PAUSE_IMAGE_CACHE_MAX_FRAMES ||
+            mData.size() + size > PAUSE_IMAGE_CACHE_MAX_SIZE)
+    {
+        if (!mHasKeyFrame)
+        {
+            IMLOGE1("[AddFrame] no idr frame in [%d] frames", mFrames.size());
+            mData.clear();
+            mFrames.clear();
+            return false;
+        }
+
+        mComplete = true;
+        return true;
+    }
+
+    mFrames.push_back({static_cast<uint32_t>(mData.size()), size, flags});
+    mData.insert(mData.end(), data, data + size);
+
+    if (flags & PAUSE_IMAGE_FLAG_KEY_FRAME)
+    {
+        mHasKeyFrame = true;
+    }
+
+    return false;
+}
+
+bool VideoPauseImageStream::GetFrame(
+        uint32_t index, const uint8_t** data, uint32_t* size, uint32_t* flags) const
+{
+    if (index >= mFrames.size() || data == nullptr || size == nullptr || flags == nullptr)
+    {
+        return false;
+    }
+
+    *data = mData.data() + mFrames[index].offset;
+    *size = mFrames[index].size;
+    *flags = mFrames[index].flags;
+    return true;
+}
+
+bool VideoPauseImageStream::Save(const char* path, const VideoPauseImageKey& key) const
+{
+    if (path == nullptr || !mComplete)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(path, "wb");
+
+    if (file == nullptr)
+    {
+        IMLOGE1("[Save] failed to open[%s]", path);
+        return false;
+    }
+
+    PauseImageFileHeader header = {PAUSE_IMAGE_CACHE_MAGIC, PAUSE_IMAGE_CACHE_VERSION,
+            static_cast<uint16_t>(mFrames.size()), key.codecType, key.profile, key.level,
+            key.width, key.height, key.bitrate, key.framerate, key.intraInterval, key.imageHash,
+            static_cast<uint32_t>(mData.size())};
+    std::vector<PauseImageFileFrame> frames;
+
+    for (auto& frame : mFrames)
+    {
+        frames.push_back({frame.size, frame.flags});
+    }
+
+    bool result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(frames.data(), sizeof(frames[0]), frames.size(), file) == frames.size() &&
+            fwrite(mData.data(), 1, mData.size(), file) == mData.size();
+    fclose(file);
+
+    if (!result)
+    {
+        IMLOGE1("[Save] failed to write[%s]", path);
+        remove(path);
+    }
+
+    return result;
+}
+
+bool VideoPauseImageStream::Load(const char* path, const VideoPauseImageKey& key)
+{
+    if (path == nullptr)
+    {
+        return false;
+    }
+
+    FILE* file = fopen(path, "rb");
+
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    PauseImageFileHeader header;
+    std::vector<PauseImageFileFrame> frames;
+    std::vector<uint8_t> data;
+    bool result = fread(&header, sizeof(header), 1, file) == 1 &&
+            header.magic == PAUSE_IMAGE_CACHE_MAGIC &&
+            header.version == PAUSE_IMAGE_CACHE_VERSION && header.numFrames > 0 &&
+            header.numFrames <= PAUSE_IMAGE_CACHE_MAX_FRAMES &&
+            header.dataSize <= PAUSE_IMAGE_CACHE_MAX_SIZE && header.codecType == key.codecType &&
+            header.profile == key.profile && header.level == key.level &&
+            header.width == key.width && header.height == key.height &&
+            header.bitrate == key.bitrate && header.framerate == key.framerate &&
+            header.intraInterval == key.intraInterval && header.imageHash == key.imageHash;
+
+    if (result)
+    {
+        frames.resize(header.numFrames);
+        data.resize(header.dataSize);
+        result = fread(frames.data(), sizeof(frames[0]), frames.size(), file) == frames.size() &&
+                fread(data.data(), 1, data.size(), file) == data.size();
+    }
+
+    fclose(file);
+
+    if (!result)
+    {
+        IMLOGE1("[Load] invalid file[%s]", path);
+        return false;
+    }
+
+    VideoPauseImageStream stream;
+    uint32_t offset = 0;
+
+    for (auto& frame : frames)
+    {
+        if (frame.size > data.size() - offset)
+        {
+            IMLOGE1("[Load] invalid frame size[%d]", frame.size);
+            return false;
+        }
+
+        stream.AddFrame(data.data() + offset, frame.size, frame.flags);
+        offset += frame.size;
+    }
+
+    if (offset != data.size() || !stream.mHasKeyFrame)
+    {
+        IMLOGE1("[Load] invalid stream in [%s]", path);
+        return false;
+    }
+
+    stream.mComplete = true;
+    *this = std::move(stream);
+    return true;
+}
+
+std::shared_ptr<const VideoPauseImageStream> VideoPauseImageCache::Find(
+        const VideoPauseImageKey& key)
+{
+    std::string path;
+
+    {
+        std::lock_guard<std::mutex> guard(sMutex);
+
+        for (auto it = sEntries.begin(); it != sEntries.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                sEntries.splice(sEntries.begin(), sEntries, it);
+                return sEntries.front().second;
+            }
+        }
+
+        if (sDirectory.empty())
+        {
+            return nullptr;
+        }
+
+        path = getFilePath(key);
+    }
+
+    auto stream = std::make_shared<VideoPauseImageStream>();
+
+    if (!stream->Load(path.c_str(), key))
+    {
+        return nullptr;
+    }
+
+    IMLOGD3("[Find] loaded[%s], frames[%d], size[%d]", path.c_str(), stream->GetNumFrames(),
+            stream->GetSize());
+
+    std::lock_guard<std::mutex> guard(sMutex);
+    sEntries.emplace_front(key, stream);
+
+    if (sEntries.size() > PAUSE_IMAGE_CACHE_MAX_ENTRIES)
+    {
+        sEntries.pop_back();
+        removeUnusedFiles();
+    }
+
+    return stream;
+}
+
+void VideoPauseImageCache::Add(
+        const VideoPauseImageKey& key, std::shared_ptr<const VideoPauseImageStream> stream)
+{
+    if (stream == nullptr || !stream->IsComplete())
+    {
+        return;
+    }
+
+    std::string path;
+
+    {
+        std::lock_guard<std::mutex> guard(sMutex);
+        sEntries.remove_if(
+                [&key](const auto& entry)
+                {
+                    return entry.first == key;
+                });
+        sEntries.emplace_front(key, stream);
+
+        if (sEntries.size() > PAUSE_IMAGE_CACHE_MAX_ENTRIES)
+        {
+            sEntries.pop_back();
+        }
+
+        if (!sDirectory.empty())
+        {
+            path = getFilePath(key);
+            removeUnusedFiles();
+        }
+    }
+
+    IMLOGD3("[Add] codec[%d], frames[%d], size[%d]", key.codecType, stream->GetNumFrames(),
+            stream->GetSize());
+
+    if (!path.empty())
+    {
+        stream->Save(path.c_str(), key);
+    }
+}
+
+void VideoPauseImageCache::SetDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> guard(sMutex);
+    sDirectory = directory;
+}
+
+void VideoPauseImageCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(sMutex);
+    sEntries.clear();
+}
+
+uint32_t VideoPauseImageCache::GetHash(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; data != nullptr && i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+std::string VideoPauseImageCache::getFilePath(const VideoPauseImageKey& key)
+{
+    char name[128];
+    snprintf(name, sizeof(name),
+            "/" PAUSE_IMAGE_FILE_PREFIX "%d_%u_%u_%ux%u_%u_%u_%u_%08x" PAUSE_IMAGE_FILE_SUFFIX,
+            key.codecType, key.profile, key.level, key.width, key.height, key.bitrate,
+            key.framerate, key.intraInterval, key.imageHash);
+    return sDirectory + name;
+}
+
+void VideoPauseImageCache::removeUnusedFiles()
+{
+    // the files of an old image or of the streams removed from the memory are not read anymore
+    DIR* dir = opendir(sDirectory.c_str());
+
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    std::set<std::string> paths;
+
+    for (auto& entry : sEntries)
+    {
+        paths.insert(getFilePath(entry.first));
+    }
+
+    const size_t prefixLength = strlen(PAUSE_IMAGE_FILE_PREFIX);
+    const size_t suffixLength = strlen(PAUSE_IMAGE_FILE_SUFFIX);
+    struct dirent* file;
+
+    while ((file = readdir(dir)) != nullptr)
+    {
+        std::string name = file->d_name;
+
+        if (name.size() <= prefixLength + suffixLength ||
+                name.compare(0, prefixLength, PAUSE_IMAGE_FILE_PREFIX) != 0 ||
+                name.compare(name.size() - suffixLength, suffixLength, PAUSE_IMAGE_FILE_SUFFIX) !=
+                        0)
+        {
+            continue;
+        }
+
+        std::string path = sDirectory + "/" + name;
+
+        if (paths.find(path) == paths.end())
+        {
+            IMLOGD1("[removeUnusedFiles] remove[%s]", path.c_str());
+            remove(path.c_str());
+        }
+    }
+
+    closedir(dir);
+}
@@ -16,12 +16,15 @@
 
 #include <VideoSession.h>
 #include <ImsMediaTrace.h>
-#include <ImsMediaEventHandler.h>
+#include <ImsMediaVideoUtil.h>
+#include <ImsMediaEventHandlerId.h>
 #include <VideoConfig.h>
+#include <RtpHeaderExtensionBlock.h>
 #include <string>
 #include <sys/socket.h>
 
-VideoSession::VideoSession()
+VideoSession::VideoSession() :
+        BaseSession(IMS_MEDIA_VIDEO)
 {
     IMLOGD0("[VideoSession]");
     mGraphRtpTx = nullptr;
@@ -249,38 +252,45 @@ void VideoSession::onEvent(int32_t type, uint64_t param1, uint64_t param2)
             break;
         case kImsMediaEventFirstPacketReceived:
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_RESPONSE_EVENT", kVideoFirstMediaPacketInd, param1, param2);
+                    kVideoResponseHandler, kVideoFirstMediaPacketInd, param1, param2);
             break;
         case kImsMediaEventResolutionChanged:
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_RESPONSE_EVENT", kVideoPeerDimensionChanged, mSessionId, param1, param2);
+                    kVideoResponseHandler, kVideoPeerDimensionChanged, mSessionId, param1, param2);
             break;
         case kImsMediaEventHeaderExtensionReceived:
-            ImsMediaEventHandler::SendEvent("VIDEO_RESPONSE_EVENT", kVideoRtpHeaderExtensionInd,
-                    mSessionId, param1, param2);
+            ImsMediaEventHandler::SendEvent(kVideoResponseHandler, kVideoRtpHeaderExtensionInd,
+                    ImsMediaEventPayload::Adopt(reinterpret_cast<RtpHeaderExtensionBlock*>(param1)),
+                    mSessionId);
             break;
         case kImsMediaEventMediaInactivity:
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_RESPONSE_EVENT", kVideoMediaInactivityInd, mSessionId, param1, param2);
+                    kVideoResponseHandler, kVideoMediaInactivityInd, mSessionId, param1, param2);
             break;
         case kImsMediaEventNotifyVideoDataUsage:
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_RESPONSE_EVENT", kVideoDataUsageInd, mSessionId, param1, param2);
+                    kVideoResponseHandler, kVideoDataUsageInd, mSessionId, param1, param2);
             break;
         case kImsMediaEventNotifyVideoLowestBitrate:
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_RESPONSE_EVENT", kVideoBitrateInd, mSessionId, param1, param2);
+                    kVideoResponseHandler, kVideoBitrateInd, mSessionId, param1, param2);
             break;
-        case kRequestVideoCvoUpdate:
-        case kRequestVideoBitrateChange:
-        case kRequestVideoIdrFrame:
         case kRequestVideoSendNack:
         case kRequestVideoSendPictureLost:
         case kRequestVideoSendTmmbr:
         case kRequestVideoSendTmmbn:
+        {
+            InternalRequestEventParam* param = reinterpret_cast<InternalRequestEventParam*>(param1);
+            ImsMediaEventHandler::SendEvent(kVideoRequestHandler, type,
+                    ImsMediaEventPayload::Adopt(param), mSessionId, param2);
+        }
+        break;
+        case kRequestVideoCvoUpdate:
+        case kRequestVideoBitrateChange:
+        case kRequestVideoIdrFrame:
         case kRequestRoundTripTimeDelayUpdate:
             ImsMediaEventHandler::SendEvent(
-                    "VIDEO_REQUEST_EVENT", type, mSessionId, param1, param2);
+                    kVideoRequestHandler, type, mSessionId, param1, param2);
             break;
         default:
             break;
@@ -214,8 +214,6 @@ bool VideoStreamGraphRtcp::OnEvent(int32_t type, uint64_t param1, uint64_t param
                 {
                     ret = encoder->SendTmmbrn(param->type, &param->tmmbrParams);
                 }
-
-                delete param;
             }
         }
         break;
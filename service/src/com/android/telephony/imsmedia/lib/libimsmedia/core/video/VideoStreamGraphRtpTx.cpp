@@ -19,6 +19,7 @@
 #include <ImsMediaNetworkUtil.h>
 #include <VideoConfig.h>
 #include <RtpEncoderNode.h>
+#include <RtpPacerNode.h>
 #include <SocketWriterNode.h>
 #include <VideoRtpPayloadEncoderNode.h>
 #include <IVideoSourceNode.h>
@@ -79,6 +80,13 @@ ImsMediaResult VideoStreamGraphRtpTx::create(RtpConfig* config)
     AddNode(pNodeRtpEncoder);
     pNodeRtpPayloadEncoder->ConnectRearNode(pNodeRtpEncoder);
 
+    // spread the packets of the large frames not to burst the radio queue shared with the audio
+    BaseNode* pNodeRtpPacer = new RtpPacerNode(mCallback);
+    pNodeRtpPacer->SetMediaType(IMS_MEDIA_VIDEO);
+    pNodeRtpPacer->SetConfig(mConfig);
+    AddNode(pNodeRtpPacer);
+    pNodeRtpEncoder->ConnectRearNode(pNodeRtpPacer);
+
     BaseNode* pNodeSocketWriter = new SocketWriterNode(mCallback);
     pNodeSocketWriter->SetMediaType(IMS_MEDIA_VIDEO);
     (static_cast<SocketWriterNode*>(pNodeSocketWriter))->SetLocalFd(mLocalFd);
@@ -86,7 +94,7 @@ ImsMediaResult VideoStreamGraphRtpTx::create(RtpConfig* config)
     (static_cast<SocketWriterNode*>(pNodeSocketWriter))->SetProtocolType(kProtocolRtp);
     pNodeSocketWriter->SetConfig(config);
     AddNode(pNodeSocketWriter);
-    pNodeRtpEncoder->ConnectRearNode(pNodeSocketWriter);
+    pNodeRtpPacer->ConnectRearNode(pNodeSocketWriter);
 
     setState(kStreamStateCreated);
     mVideoMode = pConfig->getVideoMode();
@@ -374,6 +382,15 @@ bool VideoStreamGraphRtpTx::OnEvent(int32_t type, uint64_t param1, uint64_t para
         }
         break;
         case kRequestVideoBitrateChange:
+        {
+            BaseNode* node = findNode(kNodeIdRtpPacer);
+
+            if (node != nullptr)
+            {
+                reinterpret_cast<RtpPacerNode*>(node)->SetTargetBitrate(param1);
+            }
+        }
+            [[fallthrough]];
         case kRequestVideoIdrFrame:
         {
             BaseNode* node = findNode(kNodeIdVideoSource);
@@ -20,6 +20,7 @@
 #include <android-base/unique_fd.h>
 #include <android/imagedecoder.h>
 #include <ImsMediaTrace.h>
+#include <VideoPauseImageCache.h>
 #include "ImsMediaPauseImageSource.h"
 
 // TODO: Pause images from Irvine source are used. Get new pause images from UX team and replace.
@@ -147,6 +148,30 @@ size_t ImsMediaPauseImageSource::GetYuvImage(uint8_t* buffer, size_t len)
     return 0;
 }
 
+uint32_t ImsMediaPauseImageSource::GetImageHash(int width, int height)
+{
+    mWidth = width;
+    mHeight = height;
+
+    AAsset* asset = getImageAsset();
+    if (asset == nullptr)
+    {
+        IMLOGE0("[ImsMediaPauseImageSource] GetImageHash. Failed to open pause image");
+        return 0;
+    }
+
+    const uint8_t* buffer = static_cast<const uint8_t*>(AAsset_getBuffer(asset));
+    uint32_t hash = 0;
+
+    if (buffer != nullptr)
+    {
+        hash = VideoPauseImageCache::GetHash(buffer, AAsset_getLength(asset));
+    }
+
+    AAsset_close(asset);
+    return hash;
+}
+
 AAsset* ImsMediaPauseImageSource::getImageAsset()
 {
     IMLOGD0("[ImsMediaPauseImageSource] getImageFileFd");
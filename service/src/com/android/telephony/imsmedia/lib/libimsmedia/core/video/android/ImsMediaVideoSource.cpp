@@ -47,6 +47,8 @@ ImsMediaVideoSource::ImsMediaVideoSource()
     mDeviceOrientation = -1;
     mTimestamp = 0;
     mPrevTimestamp = 0;
+    mPauseImageIndex = 0;
+    mPauseImageHash = 0;
     mStopped = false;
 }
 
@@ -164,6 +166,26 @@ bool ImsMediaVideoSource::Start()
 {
     IMLOGD1("[Start], VideoMode[%d]", mVideoMode);
 
+    if (mVideoMode == kVideoModePauseImage)
+    {
+        mPauseImageHash = mPauseImageSource.GetImageHash(mWidth, mHeight);
+        mPauseImageStream = VideoPauseImageCache::Find(getPauseImageKey());
+        mPauseImageIndex = 0;
+
+        if (mPauseImageStream != nullptr)
+        {
+            IMLOGD1("[Start] send the cached pause image, frames[%d]",
+                    mPauseImageStream->GetNumFrames());
+            mStopped = false;
+            std::thread t1(&ImsMediaVideoSource::EncodePauseImage, this);
+            t1.detach();
+            mDeviceOrientation = -1;
+            return true;
+        }
+
+        mPauseImageEncoded = std::make_shared<VideoPauseImageStream>();
+    }
+
     if (mVideoMode == kVideoModeRecording || mVideoMode == kVideoModePauseImage)
     {
         mFormat = AMediaFormat_new();
@@ -330,13 +352,13 @@ void ImsMediaVideoSource::Stop()
         mCamera = nullptr;
     }
 
-    if (mCodec != nullptr)
+    if (mVideoMode == kVideoModePauseImage && (mCodec != nullptr || mPauseImageStream != nullptr))
     {
-        if (mVideoMode == kVideoModePauseImage)
-        {
-            mConditionExit.wait_timeout(mFramerate != 0 ? 1000 / mFramerate : 66);
-        }
+        mConditionExit.wait_timeout(mFramerate != 0 ? 1000 / mFramerate : 66);
+    }
 
+    if (mCodec != nullptr)
+    {
         AMediaCodec_stop(mCodec);
         AMediaCodec_delete(mCodec);
         mCodec = nullptr;
@@ -351,6 +373,8 @@ void ImsMediaVideoSource::Stop()
     if (mVideoMode == kVideoModePauseImage)
     {
         mPauseImageSource.Uninitialize();
+        mPauseImageStream.reset();
+        mPauseImageEncoded.reset();
     }
 }
 
@@ -453,7 +477,7 @@ bool ImsMediaVideoSource::changeBitrate(const uint32_t bitrate)
     IMLOGD1("[changeBitrate] bitrate[%d]", bitrate);
     std::lock_guard<std::mutex> guard(mMutex);
 
-    if (mStopped)
+    if (mStopped || mCodec == nullptr)
     {
         return false;
     }
@@ -481,6 +505,13 @@ void ImsMediaVideoSource::requestIdrFrame()
         return;
     }
 
+    if (mPauseImageStream != nullptr)
+    {
+        // the cached stream starts with the idr frame
+        mPauseImageIndex = 0;
+        return;
+    }
+
     AMediaFormat* params = AMediaFormat_new();
     AMediaFormat_setInt32(params, AMEDIACODEC_KEY_REQUEST_SYNC_FRAME, 0);
     media_status_t status = AMediaCodec_setParameters(mCodec, params);
@@ -506,29 +537,44 @@ void ImsMediaVideoSource::EncodePauseImage()
     while (!IsStopped())
     {
         mMutex.lock();
-        auto index = AMediaCodec_dequeueInputBuffer(mCodec, CODEC_TIMEOUT_NANO);
 
-        if (index >= 0)
+        if (mStopped)
         {
-            size_t buffCapacity = 0;
-            uint8_t* encoderBuf = AMediaCodec_getInputBuffer(mCodec, index, &buffCapacity);
-            if (!encoderBuf || !buffCapacity)
-            {
-                IMLOGE1("[EncodePauseImage] returned null buffer pointer or buffCapacity[%d]",
-                        buffCapacity);
-                return;
-            }
+            mMutex.unlock();
+            break;
+        }
 
-            size_t len = mPauseImageSource.GetYuvImage(encoderBuf, buffCapacity);
-            AMediaCodec_queueInputBuffer(
-                    mCodec, index, 0, len, ImsMediaTimer::GetTimeInMicroSeconds(), 0);
+        if (mPauseImageStream != nullptr)
+        {
+            sendPauseImageFrame();
         }
         else
         {
-            IMLOGE1("[EncodePauseImage] dequeueInputBuffer returned index[%d]", index);
+            auto index = AMediaCodec_dequeueInputBuffer(mCodec, CODEC_TIMEOUT_NANO);
+
+            if (index >= 0)
+            {
+                size_t buffCapacity = 0;
+                uint8_t* encoderBuf = AMediaCodec_getInputBuffer(mCodec, index, &buffCapacity);
+                if (!encoderBuf || !buffCapacity)
+                {
+                    IMLOGE1("[EncodePauseImage] returned null buffer pointer or buffCapacity[%d]",
+                            buffCapacity);
+                    return;
+                }
+
+                size_t len = mPauseImageSource.GetYuvImage(encoderBuf, buffCapacity);
+                AMediaCodec_queueInputBuffer(
+                        mCodec, index, 0, len, ImsMediaTimer::GetTimeInMicroSeconds(), 0);
+            }
+            else
+            {
+                IMLOGE1("[EncodePauseImage] dequeueInputBuffer returned index[%d]", index);
+            }
+
+            processOutputBuffer();
         }
 
-        processOutputBuffer();
         mMutex.unlock();
 
         if (IsStopped())
@@ -562,6 +608,8 @@ void ImsMediaVideoSource::processOutputBuffer()
                 "[processOutputBuffer] index[%d], size[%d], offset[%d], time[%ld], flags[%d]",
                 index, info.size, info.offset, info.presentationTimeUs, info.flags);
 
+        bool isCached = false;
+
         if (info.size > 0)
         {
             size_t buffCapacity;
@@ -569,7 +617,17 @@ void ImsMediaVideoSource::processOutputBuffer()
 
             if (buf != nullptr && buffCapacity > 0)
             {
-                if (mListener != nullptr)
+                if (mPauseImageEncoded != nullptr &&
+                        mPauseImageEncoded->AddFrame(buf + info.offset, info.size, info.flags))
+                {
+                    // the encoder starts the next gop, send the cached stream from its idr frame
+                    // instead of encoding the image again
+                    VideoPauseImageCache::Add(getPauseImageKey(), mPauseImageEncoded);
+                    mPauseImageStream = std::move(mPauseImageEncoded);
+                    mPauseImageIndex = 0;
+                    isCached = true;
+                }
+                else if (mListener != nullptr)
                 {
                     mListener->OnUplinkEvent(
                             buf + info.offset, info.size, info.presentationTimeUs, info.flags);
@@ -578,6 +636,15 @@ void ImsMediaVideoSource::processOutputBuffer()
 
             AMediaCodec_releaseOutputBuffer(mCodec, index, false);
         }
+
+        if (isCached)
+        {
+            // the encoder is not used anymore until the source is started again
+            IMLOGD0("[processOutputBuffer] stop the encoder, send the cached pause image");
+            AMediaCodec_stop(mCodec);
+            AMediaCodec_delete(mCodec);
+            mCodec = nullptr;
+        }
     }
     else if (index == AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED)
     {
@@ -604,6 +671,36 @@ void ImsMediaVideoSource::processOutputBuffer()
     }
 }
 
+void ImsMediaVideoSource::sendPauseImageFrame()
+{
+    const uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t flags = 0;
+
+    // the codec config is sent with the idr frame following it
+    do
+    {
+        if (!mPauseImageStream->GetFrame(mPauseImageIndex, &data, &size, &flags))
+        {
+            return;
+        }
+
+        mPauseImageIndex = (mPauseImageIndex + 1) % mPauseImageStream->GetNumFrames();
+
+        if (mListener != nullptr)
+        {
+            mListener->OnUplinkEvent(const_cast<uint8_t*>(data), size,
+                    ImsMediaTimer::GetTimeInMicroSeconds(), flags);
+        }
+    } while (flags & PAUSE_IMAGE_FLAG_CODEC_CONFIG);
+}
+
+VideoPauseImageKey ImsMediaVideoSource::getPauseImageKey()
+{
+    return {mCodecType, mCodecProfile, mCodecLevel, mWidth, mHeight, mBitrate, mFramerate,
+            mIntraInterval, mPauseImageHash};
+}
+
 static void ImageCallback(void* context, AImageReader* reader)
 {
     if (context == nullptr)
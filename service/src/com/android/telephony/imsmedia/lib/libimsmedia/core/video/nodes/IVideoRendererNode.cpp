@@ -18,7 +18,9 @@
 #include <ImsMediaVideoRenderer.h>
 #include <ImsMediaTrace.h>
 #include <ImsMediaTimer.h>
+#include <ImsMediaMetrics.h>
 #include <ImsMediaBitReader.h>
+#include <ImsMediaNalUnitSplitter.h>
 #include <VideoConfig.h>
 #include <ImsMediaVideoUtil.h>
 #include <VideoJitterBuffer.h>
@@ -72,6 +74,7 @@ ImsMediaResult IVideoRendererNode::Start()
         VideoJitterBuffer* jitter = reinterpret_cast<VideoJitterBuffer*>(mJitterBuffer);
         jitter->SetCodecType(mCodecType);
         jitter->SetFramerate(mFramerate);
+        jitter->SetResolution(mWidth, mHeight);
         jitter->SetJitterBufferSize(15, 15, 25);
         jitter->StartTimer(mLossDuration / 1000, mLossRateThreshold);
     }
@@ -171,6 +174,9 @@ void IVideoRendererNode::ProcessData()
     ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
     uint32_t initialSeq = 0;
     ImsMediaSubType dataType;
+    VideoJitterBuffer* jitter = reinterpret_cast<VideoJitterBuffer*>(mJitterBuffer);
+    // the frame is read in place when the packets are contiguous in the frame buffer
+    uint8_t* frame = nullptr;
 
     while (GetData(&subtype, &data, &dataSize, &timestamp, &mark, &seq, &dataType))
     {
@@ -188,13 +194,32 @@ void IVideoRendererNode::ProcessData()
             break;
         }
 
-        if (dataSize >= MAX_RTP_PAYLOAD_BUFFER_SIZE)
+        if (frameSize + dataSize >= MAX_RTP_PAYLOAD_BUFFER_SIZE)
         {
             IMLOGE1("[ProcessData] exceed buffer size[%d]", dataSize);
             return;
         }
 
-        memcpy(mBuffer + frameSize, data, dataSize);
+        if (frameSize == 0 && jitter != nullptr && jitter->IsFrameBuffer(data))
+        {
+            frame = data;
+        }
+        else if (frame != mBuffer && (frame == nullptr || data != frame + frameSize))
+        {
+            // copy the frame to the local buffer when the packets are not contiguous
+            if (frame != nullptr)
+            {
+                memcpy(mBuffer, frame, frameSize);
+            }
+
+            frame = mBuffer;
+        }
+
+        if (frame == mBuffer)
+        {
+            memcpy(mBuffer + frameSize, data, dataSize);
+        }
+
         frameSize += dataSize;
 
         if (initialSeq == 0)
@@ -217,8 +242,8 @@ void IVideoRendererNode::ProcessData()
 
     // remove AUD nal unit
     uint32_t size = frameSize;
-    uint8_t* buffer = mBuffer;
-    RemoveAUDNalUnit(mBuffer, frameSize, &buffer, &size);
+    uint8_t* buffer = frame;
+    RemoveAUDNalUnit(frame, frameSize, &buffer, &size);
 
     FrameType frameType = GetFrameType(buffer, size);
 
@@ -318,6 +343,12 @@ void IVideoRendererNode::ProcessData()
     }
 
     mVideoRenderer->OnDataFrame(buffer, size, timestamp, false);
+    AddPlayoutLatency();
+
+    if (mMetrics != nullptr)
+    {
+        mMetrics->AddCounter(kMetricFramesPlayed);
+    }
 }
 
 void IVideoRendererNode::UpdateSurface(ANativeWindow* window)
@@ -349,18 +380,9 @@ void IVideoRendererNode::SetPacketLossParam(uint32_t time, uint32_t rate)
 
 bool IVideoRendererNode::hasStartingCode(uint8_t* buffer, uint32_t bufferSize)
 {
-    if (bufferSize <= 4)
-    {
-        return false;
-    }
-
-    // Check for NAL unit delimiter 0x00000001
-    if (buffer[0] == 0x00 && buffer[1] == 0x00 && buffer[2] == 0x00 && buffer[3] == 0x01)
-    {
-        return true;
-    }
-
-    return false;
+    // Check for NAL unit delimiter 0x000001 or 0x00000001 followed by the nal unit header
+    uint32_t startCodeSize = ImsMediaNalUnitSplitter::GetStartCodeSize(buffer, bufferSize);
+    return startCodeSize != 0 && bufferSize > startCodeSize;
 }
 
 FrameType IVideoRendererNode::GetFrameType(uint8_t* buffer, uint32_t bufferSize)
@@ -370,7 +392,7 @@ FrameType IVideoRendererNode::GetFrameType(uint8_t* buffer, uint32_t bufferSize)
         return UNKNOWN;
     }
 
-    uint8_t nalType = buffer[4];
+    uint8_t nalType = buffer[ImsMediaNalUnitSplitter::GetStartCodeSize(buffer, bufferSize)];
 
     switch (mCodecType)
     {
@@ -442,44 +464,37 @@ void IVideoRendererNode::SaveConfigFrame(uint8_t* pbBuffer, uint32_t nBufferSize
             ImsMediaTrace::IMTrace_Bin2String(
                     reinterpret_cast<const char*>(pbBuffer), nBufferSize > 52 ? 52 : nBufferSize));
 
+    ImsMediaNalUnitSplitter splitter(pbBuffer, nBufferSize);
+    ImsMediaNalUnit unit;
+
     switch (mCodecType)
     {
         case kVideoCodecAvc:
         {
-            uint32_t nCurrSize = 0;
             uint32_t nOffset = 0;
             uint32_t nConfigSize = 0;
-            uint8_t* nCurrBuff = pbBuffer;
 
-            while (nCurrSize <= nBufferSize)
+            // save the nal unit from its start code to the next start code
+            while (splitter.Next(&unit))
             {
-                if (nCurrBuff[0] == 0x00 && nCurrBuff[1] == 0x00 && nCurrBuff[2] == 0x00 &&
-                        nCurrBuff[3] == 0x01)
+                uint8_t nalType = unit.size > 0 ? unit.data[0] & 0x1F : 0;
+
+                if (eMode == kConfigSps && nalType == 7)
                 {
-                    if (eMode == kConfigSps && !bSPSString && ((nCurrBuff[4] & 0x1F) == 7))
-                    {
-                        nOffset = nCurrSize;
-                        bSPSString = true;
-                    }
-                    else if (eMode == kConfigPps && !bPPSString && ((nCurrBuff[4] & 0x1F) == 8))
-                    {
-                        nOffset = nCurrSize;
-                        bPPSString = true;
-                    }
-                    else if (bSPSString || bPPSString)
-                    {
-                        nConfigSize = nCurrSize - nOffset;
-                        break;
-                    }
+                    bSPSString = true;
+                }
+                else if (eMode == kConfigPps && nalType == 8)
+                {
+                    bPPSString = true;
+                }
+                else
+                {
+                    continue;
                 }
 
-                nCurrBuff++;
-                nCurrSize++;
-            }
-
-            if ((bSPSString || bPPSString) && nConfigSize == 0)
-            {
-                nConfigSize = nBufferSize - nOffset;
+                nOffset = unit.data - unit.startCodeSize - pbBuffer;
+                nConfigSize = unit.size + unit.startCodeSize;
+                break;
             }
 
             IMLOGD_PACKET3(IM_PACKET_LOG_VIDEO,
@@ -518,49 +533,35 @@ void IVideoRendererNode::SaveConfigFrame(uint8_t* pbBuffer, uint32_t nBufferSize
 
         case kVideoCodecHevc:
         {
-            uint32_t nCurrSize = 0;
             uint32_t nOffset = 0;
             uint32_t nConfigSize = 0;
-            uint8_t* nCurrBuff = pbBuffer;
             bool bVPSString = false;
 
-            while (nCurrSize <= nBufferSize)
+            // save from the start code of the nal unit to the end of the buffer
+            while (splitter.Next(&unit))
             {
-                if (nCurrBuff[0] == 0x00 && nCurrBuff[1] == 0x00 && nCurrBuff[2] == 0x00 &&
-                        nCurrBuff[3] == 0x01)
+                uint8_t nalType = unit.size > 0 ? (unit.data[0] >> 1) & 0x3F : 0;
+
+                if (eMode == kConfigVps && nalType == 32)
                 {
-                    if (eMode == kConfigVps && !bVPSString && (((nCurrBuff[4] >> 1) & 0x3F) == 32))
-                    {
-                        nOffset = nCurrSize;
-                        bVPSString = true;
-                        break;
-                    }
-                    else if (eMode == kConfigSps && !bSPSString &&
-                            (((nCurrBuff[4] >> 1) & 0x3F) == 33))
-                    {
-                        nOffset = nCurrSize;
-                        bSPSString = true;
-                        break;
-                    }
-                    else if (eMode == kConfigPps && !bPPSString &&
-                            (((nCurrBuff[4] >> 1) & 0x3F) == 34))
-                    {
-                        nOffset = nCurrSize;
-                        bPPSString = true;
-                        break;
-                    }
+                    bVPSString = true;
                 }
-
-                nCurrBuff++;
-                nCurrSize++;
-            }
-
-            if (bVPSString || bSPSString || bPPSString)
-            {
-                if ((nBufferSize - nOffset) > 0)
+                else if (eMode == kConfigSps && nalType == 33)
                 {
-                    nConfigSize = nBufferSize - nOffset;
+                    bSPSString = true;
                 }
+                else if (eMode == kConfigPps && nalType == 34)
+                {
+                    bPPSString = true;
+                }
+                else
+                {
+                    continue;
+                }
+
+                nOffset = unit.data - unit.startCodeSize - pbBuffer;
+                nConfigSize = nBufferSize - nOffset;
+                break;
             }
 
             IMLOGD_PACKET4(IM_PACKET_LOG_VIDEO,
@@ -621,29 +622,16 @@ bool IVideoRendererNode::RemoveAUDNalUnit(
     {
         case kVideoCodecAvc:
         {
-            uint32_t currSize = inBufferSize;
-            uint8_t* currBuffer = inBuffer;
-            uint32_t count = 0;
+            ImsMediaNalUnitSplitter splitter(inBuffer, inBufferSize);
+            ImsMediaNalUnit unit;
 
-            while (currSize >= 5 && count <= 12)
+            // the access unit delimiter is the first nal unit of the access unit
+            if (splitter.Next(&unit) && unit.size > 0 && unit.data[0] == 0x09 &&
+                    unit.data + unit.size < inBuffer + inBufferSize)
             {
-                if (IsAudUnit &&
-                        (currBuffer[0] == 0x00 && currBuffer[1] == 0x00 && currBuffer[2] == 0x00 &&
-                                currBuffer[3] == 0x01))
-                {
-                    *outBuffer = currBuffer;
-                    *outBufferSize = currSize;
-                    break;
-                }
-                if (currBuffer[0] == 0x00 && currBuffer[1] == 0x00 && currBuffer[2] == 0x00 &&
-                        currBuffer[3] == 0x01 && currBuffer[4] == 0x09)
-                {
-                    IsAudUnit = true;
-                }
-
-                currBuffer++;
-                currSize--;
-                count++;
+                IsAudUnit = true;
+                *outBuffer = unit.data + unit.size;
+                *outBufferSize = inBuffer + inBufferSize - *outBuffer;
             }
         }
         break;
@@ -180,42 +180,53 @@ void VideoRtpPayloadDecoderNode::DecodeAvc(ImsMediaSubType subtype, uint8_t* pDa
             IMLOGD_PACKET0(IM_PACKET_LOG_PH, "[DecodeAvc] Warning - single nal unit mode");
         }
 
-        bPacketType = pCurrData[2] & 0x1F;
-
-        if ((bPacketType & 0x1F) == 7 || (bPacketType & 0x1F) == 8)
-        {
-            eDataType = MEDIASUBTYPE_VIDEO_CONFIGSTRING;
-        }
-        else if ((bPacketType & 0x1F) == 5)
-        {  // check idr frame
-            eDataType = MEDIASUBTYPE_VIDEO_IDR_FRAME;
-        }
-        else
-        {
-            eDataType = MEDIASUBTYPE_VIDEO_NON_IDR_FRAME;
-        }
-
-        IMLOGD2("[DecodeAvc] eDataType[%u], nRemainSize[%u]", eDataType, nRemainSize);
+        IMLOGD_PACKET1(IM_PACKET_LOG_PH, "[DecodeAvc] STAP-A nRemainSize[%d]", nRemainSize);
 
         while (nRemainSize > 2)
         {
             // read NAL unit size
             uint32_t nNALUnitsize = pCurrData[0];
             nNALUnitsize = (nNALUnitsize << 8) + pCurrData[1];
-            IMLOGD_PACKET1(IM_PACKET_LOG_PH, "[DecodeAvc] STAP-A nNALUnitsize[%d]", nNALUnitsize);
             pCurrData += 2;
             nRemainSize -= 2;
-            // Read and Send NAL
-            if (nRemainSize >= (int32_t)nNALUnitsize)
+
+            if (nNALUnitsize == 0 || nRemainSize < (int32_t)nNALUnitsize)
             {
-                IMLOGD_PACKET1(IM_PACKET_LOG_PH, "[DecodeAvc] STAP-A [%02X] nNALUnitsize[%d]",
-                        nNALUnitsize);
-                memcpy(mBuffer + 4, pCurrData, nNALUnitsize);
-                SendDataToRearNode(
-                        subtype, mBuffer, nNALUnitsize + 4, nTimeStamp, bMark, nSeqNum, eDataType);
+                IMLOGE2("[DecodeAvc] STAP-A invalid nNALUnitsize[%d], nRemainSize[%d]",
+                        nNALUnitsize, nRemainSize);
+                break;
+            }
+
+            // each aggregated nal unit has its own type
+            bPacketType = pCurrData[0] & 0x1F;
+
+            if (bPacketType == 7 || bPacketType == 8)
+            {
+                eDataType = MEDIASUBTYPE_VIDEO_CONFIGSTRING;
+            }
+            else if (bPacketType == 5)
+            {  // check idr frame
+                eDataType = MEDIASUBTYPE_VIDEO_IDR_FRAME;
+            }
+            else if (bPacketType == 6)
+            {
+                eDataType = MEDIASUBTYPE_VIDEO_SEI_FRAME;
+            }
+            else
+            {
+                eDataType = MEDIASUBTYPE_VIDEO_NON_IDR_FRAME;
             }
+
+            IMLOGD_PACKET2(IM_PACKET_LOG_PH, "[DecodeAvc] STAP-A [%02X] nNALUnitsize[%d]",
+                    pCurrData[0], nNALUnitsize);
+            memcpy(mBuffer + 4, pCurrData, nNALUnitsize);
             pCurrData += nNALUnitsize;
             nRemainSize -= nNALUnitsize;
+            // the marker bit belongs to the last nal unit of the packet, the parameter sets are
+            // marked as the complete units as they were sent in their own packets
+            SendDataToRearNode(subtype, mBuffer, nNALUnitsize + 4, nTimeStamp,
+                    (bMark && nRemainSize <= 2) || eDataType == MEDIASUBTYPE_VIDEO_CONFIGSTRING,
+                    nSeqNum, eDataType);
         }
     }
     else if (bPacketType == 28)
@@ -334,7 +345,55 @@ void VideoRtpPayloadDecoderNode::DecodeHevc(ImsMediaSubType subtype, uint8_t* pD
     }
     else if (bPacketType == 48)
     {  // Aggregation packet(AP)
-       // need to implement
+        // skip the payload header, DONL is not present as sprop-max-don-diff is not used
+        uint8_t* pCurrData = pData + 2;
+        int32_t nRemainSize = (int32_t)nDataSize - 2;
+
+        if (mPayloadMode == kRtpPyaloadHeaderModeSingleNalUnit)
+        {
+            IMLOGW0("[DecodeHevc] Warning - invalid packet type(AP, 48) for single nal unit mode");
+        }
+
+        while (nRemainSize > 2)
+        {
+            uint32_t nNALUnitsize = pCurrData[0];
+            nNALUnitsize = (nNALUnitsize << 8) + pCurrData[1];
+            pCurrData += 2;
+            nRemainSize -= 2;
+
+            if (nNALUnitsize < 2 || nRemainSize < (int32_t)nNALUnitsize)
+            {
+                IMLOGE2("[DecodeHevc] AP invalid nNALUnitsize[%d], nRemainSize[%d]", nNALUnitsize,
+                        nRemainSize);
+                break;
+            }
+
+            uint8_t frameType = (pCurrData[0] & 0x7E) >> 1;
+
+            if (frameType >= 32 && frameType <= 34)
+            {  // 32: VPS, 33: SPS, 34: PPS
+                eDataType = MEDIASUBTYPE_VIDEO_CONFIGSTRING;
+            }
+            else if (frameType == 19 || frameType == 20)
+            {  // IDR
+                eDataType = MEDIASUBTYPE_VIDEO_IDR_FRAME;
+            }
+            else
+            {
+                eDataType = MEDIASUBTYPE_VIDEO_NON_IDR_FRAME;
+            }
+
+            IMLOGD_PACKET3(IM_PACKET_LOG_PH, "[DecodeHevc] AP [%02X %02X] nNALUnitsize[%d]",
+                    pCurrData[0], pCurrData[1], nNALUnitsize);
+            memcpy(mBuffer + 4, pCurrData, nNALUnitsize);
+            pCurrData += nNALUnitsize;
+            nRemainSize -= nNALUnitsize;
+            // the marker bit belongs to the last nal unit of the packet, the parameter sets are
+            // marked as the complete units as they were sent in their own packets
+            SendDataToRearNode(subtype, mBuffer, nNALUnitsize + 4, nTimeStamp,
+                    (bMark && nRemainSize <= 2) || eDataType == MEDIASUBTYPE_VIDEO_CONFIGSTRING,
+                    nSeqNum, eDataType);
+        }
     }
     else if (bPacketType == 49)
     {  // FU-A
@@ -17,6 +17,7 @@
 #include <ImsMediaDefine.h>
 #include <VideoRtpPayloadEncoderNode.h>
 #include <ImsMediaBinaryFormat.h>
+#include <ImsMediaNalUnitSplitter.h>
 #include <ImsMediaTimer.h>
 #include <ImsMediaTrace.h>
 #include <VideoConfig.h>
@@ -24,6 +25,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+// the payload header size of the aggregation packet, STAP-A is 1 byte and AP is 2 bytes
+#define AVC_STAP_A_HEADER_SIZE     1
+#define HEVC_AP_HEADER_SIZE        2
+#define AGGREGATION_NAL_SIZE_FIELD 2
+#define AVC_NAL_TYPE_STAP_A        24
+#define HEVC_NAL_TYPE_AP           48
+
 #ifdef DEBUG_JITTER_GEN_SIMULATION_REORDER
 #define MEDIABUF_DATAPACKET_MAX 200
 #else
@@ -39,6 +47,11 @@ VideoRtpPayloadEncoderNode::VideoRtpPayloadEncoderNode(BaseSessionCallback* call
     mPayloadMode = kRtpPyaloadHeaderModeNonInterleaved;
     mPrevMark = false;
     mBuffer = nullptr;
+    mAggregationBuffer = nullptr;
+    mAggregationSize = 0;
+    mAggregationCount = 0;
+    mAggregationTimestamp = 0;
+    mAggregationIdr = false;
     memset(mVPS, 0, sizeof(mVPS));
     memset(mSPS, 0, sizeof(mSPS));
     memset(mPPS, 0, sizeof(mPPS));
@@ -74,6 +87,18 @@ ImsMediaResult VideoRtpPayloadEncoderNode::Start()
         return RESULT_NO_MEMORY;
     }
 
+    mAggregationBuffer = reinterpret_cast<uint8_t*>(malloc(mMaxFragmentUnitSize));
+
+    if (mAggregationBuffer == nullptr)
+    {
+        free(mBuffer);
+        mBuffer = nullptr;
+        return RESULT_NO_MEMORY;
+    }
+
+    mAggregationSize = 0;
+    mAggregationCount = 0;
+
     mNodeState = kNodeStateRunning;
     return RESULT_SUCCESS;
 }
@@ -86,6 +111,12 @@ void VideoRtpPayloadEncoderNode::Stop()
         mBuffer = nullptr;
     }
 
+    if (mAggregationBuffer != nullptr)
+    {
+        free(mAggregationBuffer);
+        mAggregationBuffer = nullptr;
+    }
+
     mNodeState = kNodeStateStopped;
 }
 
@@ -147,75 +178,18 @@ void VideoRtpPayloadEncoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, ui
             SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, pData, nDataSize, nTimestamp, bMark, 0);
             break;
     }
-}
 
-uint8_t* VideoRtpPayloadEncoderNode::FindAvcStartCode(
-        uint8_t* pData, uint32_t nDataSize, uint32_t* pnSkipSize)
-{
-    uint8_t* pCurDataPos = pData;
-    uint32_t nSkipSize = 0;
-
-    // remove leading zero bytes and start code prefix
-    while (nDataSize >= 4)
-    {
-        // Start Code 00 00 00 01 case.
-        if (pCurDataPos[0] == 0x00 && pCurDataPos[1] == 0x00 && pCurDataPos[2] == 0x00 &&
-                pCurDataPos[3] == 0x01)
-        {
-            if (pnSkipSize)
-                *pnSkipSize = nSkipSize;
-            return pCurDataPos;
-        }
-        else
-        {
-            pCurDataPos += 1;
-            nDataSize -= 1;
-            nSkipSize += 1;
-        }
-    }
-
-    if (pnSkipSize)
-        *pnSkipSize = nSkipSize;
-    return nullptr;
-}
-
-// [HEVC] return buffer position of h.265 start code
-uint8_t* VideoRtpPayloadEncoderNode::FindHevcStartCode(
-        uint8_t* pData, uint32_t nDataSize, uint32_t* pnSkipSize)
-{
-    uint8_t* pCurDataPos = pData;
-    uint32_t nSkipSize = 0;
-
-    // remove leading zero bytes and start code prefix
-    while (nDataSize >= 4)
-    {
-        // Start Code 00 00 00 01 case.
-        if (pCurDataPos[0] == 0x00 && pCurDataPos[1] == 0x00 && pCurDataPos[2] == 0x00 &&
-                pCurDataPos[3] == 0x01)
-        {
-            if (pnSkipSize)
-                *pnSkipSize = nSkipSize;
-            return pCurDataPos;
-        }
-        else
-        {
-            pCurDataPos += 1;
-            nDataSize -= 1;
-            nSkipSize += 1;
-        }
-    }
-
-    if (pnSkipSize)
-        *pnSkipSize = nSkipSize;
-    return nullptr;
+    // the nal units are not aggregated across the frames
+    SendAggregatedNALUnits(false);
 }
 
 void VideoRtpPayloadEncoderNode::EncodeAvc(
         uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, bool bMark)
 {
     uint8_t* pCurDataPos = pData;
+    uint8_t* pEnd = pData + nDataSize;
     uint32_t nCurDataSize;
-    uint32_t nSkipSize;
+    uint32_t nStartCodeSize = 0;
     uint8_t* pStartCodePos;
     uint8_t nNalUnitType;
     char spsEncoded[255];
@@ -230,7 +204,8 @@ void VideoRtpPayloadEncoderNode::EncodeAvc(
                 pData[1], pData[2], pData[3], pData[4], nDataSize, nTimestamp, bMark);
     }
 
-    pStartCodePos = FindAvcStartCode(pCurDataPos, nDataSize, &nSkipSize);
+    pStartCodePos =
+            ImsMediaNalUnitSplitter::FindStartCode(pCurDataPos, nDataSize, &nStartCodeSize);
 
     if (pStartCodePos == nullptr)
     {
@@ -238,14 +213,21 @@ void VideoRtpPayloadEncoderNode::EncodeAvc(
     }
 
     // remove padding
-    pCurDataPos = pStartCodePos + 4;
-    nDataSize -= (nSkipSize + 4);
+    pCurDataPos = pStartCodePos + nStartCodeSize;
+    nDataSize = pEnd - pCurDataPos;
+
+    if (nDataSize == 0)
+    {
+        return;
+    }
+
     nNalUnitType = pCurDataPos[0] & 0x1F;
 
     while (nNalUnitType == 7 || nNalUnitType == 8)  // config frame
     {
         // extract nal unit
-        pStartCodePos = FindAvcStartCode(pCurDataPos + 1, nDataSize - 1);
+        pStartCodePos = ImsMediaNalUnitSplitter::FindStartCode(
+                pCurDataPos + 1, nDataSize - 1, &nStartCodeSize);
 
         if (pStartCodePos == nullptr)
         {
@@ -276,22 +258,21 @@ void VideoRtpPayloadEncoderNode::EncodeAvc(
             IMLOGD2("[EncodeAvc] save pps, size[%d], data : %s", mPpsSize, ppsEncoded);
         }
 
-        if (nDataSize < nCurDataSize + 4)
+        if (pStartCodePos == nullptr || pStartCodePos + nStartCodeSize >= pEnd)
         {
             return;
         }
 
-        nDataSize -= (nCurDataSize + 4);
-        pCurDataPos += (nCurDataSize + 4);
+        pCurDataPos = pStartCodePos + nStartCodeSize;
+        nDataSize = pEnd - pCurDataPos;
         nNalUnitType = pCurDataPos[0] & 0x1F;
     }
 
     if (nNalUnitType == 5)  // check idf frame, send sps/pps
     {
-        // sps
-        EncodeAvcNALUnit(mSPS, mSpsSize, nTimestamp, 1, 7);
-        // pps
-        EncodeAvcNALUnit(mPPS, mPpsSize, nTimestamp, 1, 8);
+        // sps and pps are aggregated with the marker bit of the frame
+        EncodeAvcNALUnit(mSPS, mSpsSize, nTimestamp, false, 7);
+        EncodeAvcNALUnit(mPPS, mPpsSize, nTimestamp, false, 8);
         IMLOGD0("[EncodeAvc] Send SPS, PPS when an I frame send");
     }
 
@@ -325,6 +306,13 @@ void VideoRtpPayloadEncoderNode::EncodeAvcNALUnit(
         return;
     }
 
+    if (AggregateNALUnit(pData, nDataSize, nTimestamp, bMark, nNalUnitType == 5))
+    {
+        return;
+    }
+
+    SendAggregatedNALUnits(false);
+
     // make FU-A packets
     if (mPayloadMode == kRtpPyaloadHeaderModeNonInterleaved && nDataSize > nMtu)
     {
@@ -445,7 +433,8 @@ void VideoRtpPayloadEncoderNode::EncodeHevc(
         uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, bool bMark)
 {
     uint8_t* pCurDataPos = pData;
-    uint32_t nSkipSize;
+    uint8_t* pEnd = pData + nDataSize;
+    uint32_t nStartCodeSize = 0;
     uint8_t* pStartCodePos;
     uint8_t nNalUnitType;
 
@@ -457,15 +446,22 @@ void VideoRtpPayloadEncoderNode::EncodeHevc(
                 nTimestamp, bMark);
     }
 
-    pStartCodePos = FindHevcStartCode(pCurDataPos, nDataSize, &nSkipSize);
+    pStartCodePos =
+            ImsMediaNalUnitSplitter::FindStartCode(pCurDataPos, nDataSize, &nStartCodeSize);
 
     if (pStartCodePos == nullptr)
     {
         return;
     }
 
-    pCurDataPos = pStartCodePos + 4;
-    nDataSize -= (nSkipSize + 4);
+    pCurDataPos = pStartCodePos + nStartCodeSize;
+    nDataSize = pEnd - pCurDataPos;
+
+    if (nDataSize < 2)
+    {
+        return;
+    }
+
     nNalUnitType = (pCurDataPos[0] >> 1) & 0x3F;
 
     // 32: VPS, 33: SPS, 34: PPS
@@ -473,7 +469,8 @@ void VideoRtpPayloadEncoderNode::EncodeHevc(
     {
         // extract nal unit
         // NAL unit header is 2 bytes on HEVC.
-        pStartCodePos = FindHevcStartCode(pCurDataPos + 2, nDataSize - 2);
+        pStartCodePos = ImsMediaNalUnitSplitter::FindStartCode(
+                pCurDataPos + 2, nDataSize - 2, &nStartCodeSize);
 
         if (pStartCodePos == nullptr)
         {
@@ -481,7 +478,7 @@ void VideoRtpPayloadEncoderNode::EncodeHevc(
         }
 
         uint32_t nCurDataSize = pStartCodePos - pCurDataPos;
-        EncodeHevcNALUnit(pCurDataPos, nCurDataSize, nTimestamp, bMark, nNalUnitType);
+        EncodeHevcNALUnit(pCurDataPos, nCurDataSize, nTimestamp, false, nNalUnitType);
 
         if (nNalUnitType == 32)
         {
@@ -505,15 +502,15 @@ void VideoRtpPayloadEncoderNode::EncodeHevc(
             IMLOGD1("[EncodeHevc] PPS Size [%d]", mPpsSize);
         }
 
-        if (nDataSize < nCurDataSize + 4)
+        if (pStartCodePos + nStartCodeSize + 2 > pEnd)
         {
             IMLOGE0("[EncodeHevc] error - extract nal unit!!!");
             return;
         }
 
         // exclude start code
-        nDataSize -= (nCurDataSize + 4);
-        pCurDataPos += (nCurDataSize + 4);
+        pCurDataPos = pStartCodePos + nStartCodeSize;
+        nDataSize = pEnd - pCurDataPos;
         nNalUnitType = (pCurDataPos[0] >> 1) & 0x3F;
     }
 
@@ -521,9 +518,9 @@ void VideoRtpPayloadEncoderNode::EncodeHevc(
     if ((nNalUnitType == 19) || (nNalUnitType == 20) || (nNalUnitType == 21))
     {
         // sending vps/sps/pps on I-frame
-        EncodeHevcNALUnit(mVPS, mVPSsize, nTimestamp, 1, nNalUnitType);
-        EncodeHevcNALUnit(mSPS, mSpsSize, nTimestamp, 1, nNalUnitType);
-        EncodeHevcNALUnit(mPPS, mPpsSize, nTimestamp, 1, nNalUnitType);
+        EncodeHevcNALUnit(mVPS, mVPSsize, nTimestamp, false, nNalUnitType);
+        EncodeHevcNALUnit(mSPS, mSpsSize, nTimestamp, false, nNalUnitType);
+        EncodeHevcNALUnit(mPPS, mPpsSize, nTimestamp, false, nNalUnitType);
     }
 
     if (nDataSize > 0)
@@ -553,11 +550,19 @@ void VideoRtpPayloadEncoderNode::EncodeHevcNALUnit(
                 pData[0], pData[1], pData[2], pData[3], nDataSize, nTimestamp, bMark, nNalUnitType);
     }
 
-    if (mBuffer == nullptr)
+    if (mBuffer == nullptr || nDataSize < 2)
+    {
+        return;
+    }
+
+    if (AggregateNALUnit(pData, nDataSize, nTimestamp, bMark,
+                nNalUnitType == 19 || nNalUnitType == 20 || nNalUnitType == 21))
     {
         return;
     }
 
+    SendAggregatedNALUnits(false);
+
     // Share payload header mode with h.264 - single nal unit mode, non interleaved mode
     // make FU-A packets
     if (mPayloadMode == kRtpPyaloadHeaderModeNonInterleaved && nDataSize > nMtu)
@@ -667,3 +672,125 @@ void VideoRtpPayloadEncoderNode::EncodeHevcNALUnit(
         }
     }
 }
+
+bool VideoRtpPayloadEncoderNode::AggregateNALUnit(
+        uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, bool bMark, bool bIdr)
+{
+    // the aggregation packet is not allowed in the single nal unit mode
+    if (mPayloadMode != kRtpPyaloadHeaderModeNonInterleaved || mAggregationBuffer == nullptr ||
+            pData == nullptr || nDataSize == 0)
+    {
+        return false;
+    }
+
+    // the nal unit of the marker bit is sent by itself when there is nothing to aggregate with
+    if (mAggregationCount == 0 && bMark)
+    {
+        return false;
+    }
+
+    bool bAvc = mCodecType == VideoConfig::CODEC_AVC;
+    uint32_t nHeaderSize = bAvc ? AVC_STAP_A_HEADER_SIZE : HEVC_AP_HEADER_SIZE;
+    uint32_t nMtu = mMaxFragmentUnitSize * 0.9;
+
+    if (nHeaderSize + AGGREGATION_NAL_SIZE_FIELD + nDataSize > nMtu)
+    {
+        return false;
+    }
+
+    if (mAggregationCount > 0 &&
+            (nTimestamp != mAggregationTimestamp ||
+                    mAggregationSize + AGGREGATION_NAL_SIZE_FIELD + nDataSize > nMtu))
+    {
+        SendAggregatedNALUnits(false);
+    }
+
+    if (mAggregationCount == 0)
+    {
+        if (bAvc)
+        {
+            mAggregationBuffer[0] = AVC_NAL_TYPE_STAP_A;
+        }
+        else
+        {
+            // the layer id and the temporal id are the lowest of the nal units aggregated
+            mAggregationBuffer[0] = (HEVC_NAL_TYPE_AP << 1) | (pData[0] & 0x01);
+            mAggregationBuffer[1] = pData[1];
+        }
+
+        mAggregationSize = nHeaderSize;
+        mAggregationTimestamp = nTimestamp;
+        mAggregationIdr = false;
+    }
+
+    if (bAvc)
+    {
+        // F bit is set when any of the nal units has it and NRI is the highest
+        uint8_t nri = (mAggregationBuffer[0] & 0x60) > (pData[0] & 0x60)
+                ? mAggregationBuffer[0] & 0x60
+                : pData[0] & 0x60;
+        mAggregationBuffer[0] = ((mAggregationBuffer[0] | pData[0]) & 0x80) | nri |
+                AVC_NAL_TYPE_STAP_A;
+    }
+    else
+    {
+        uint32_t nLayerId = ((pData[0] & 0x01) << 5) | (pData[1] >> 3);
+        uint32_t nAggregatedLayerId =
+                ((mAggregationBuffer[0] & 0x01) << 5) | (mAggregationBuffer[1] >> 3);
+        uint32_t nTid = pData[1] & 0x07;
+        uint32_t nAggregatedTid = mAggregationBuffer[1] & 0x07;
+
+        nLayerId = nLayerId < nAggregatedLayerId ? nLayerId : nAggregatedLayerId;
+        nTid = nTid < nAggregatedTid ? nTid : nAggregatedTid;
+        mAggregationBuffer[0] = ((mAggregationBuffer[0] | pData[0]) & 0x80) |
+                (HEVC_NAL_TYPE_AP << 1) | (nLayerId >> 5);
+        mAggregationBuffer[1] = ((nLayerId & 0x1F) << 3) | nTid;
+    }
+
+    mAggregationBuffer[mAggregationSize++] = (nDataSize >> 8) & 0xFF;
+    mAggregationBuffer[mAggregationSize++] = nDataSize & 0xFF;
+    memcpy(mAggregationBuffer + mAggregationSize, pData, nDataSize);
+    mAggregationSize += nDataSize;
+    mAggregationCount++;
+    mAggregationIdr |= bIdr;
+
+    if (bMark)
+    {
+        SendAggregatedNALUnits(true);
+    }
+
+    return true;
+}
+
+void VideoRtpPayloadEncoderNode::SendAggregatedNALUnits(bool bMark)
+{
+    if (mAggregationCount == 0)
+    {
+        return;
+    }
+
+    ImsMediaSubType subtype = mAggregationIdr ? MEDIASUBTYPE_VIDEO_IDR_FRAME
+                                              : MEDIASUBTYPE_RTPPAYLOAD;
+    uint32_t nHeaderSize =
+            mCodecType == VideoConfig::CODEC_AVC ? AVC_STAP_A_HEADER_SIZE : HEVC_AP_HEADER_SIZE;
+
+    IMLOGD_PACKET4(IM_PACKET_LOG_PH,
+            "[SendAggregatedNALUnits] count[%u], size[%u], TS[%u], mark[%d]", mAggregationCount,
+            mAggregationSize, mAggregationTimestamp, bMark);
+
+    if (mAggregationCount == 1)
+    {
+        uint32_t nOffset = nHeaderSize + AGGREGATION_NAL_SIZE_FIELD;
+        SendDataToRearNode(subtype, mAggregationBuffer + nOffset, mAggregationSize - nOffset,
+                mAggregationTimestamp, bMark, 0);
+    }
+    else
+    {
+        SendDataToRearNode(subtype, mAggregationBuffer, mAggregationSize, mAggregationTimestamp,
+                bMark, 0);
+    }
+
+    mAggregationSize = 0;
+    mAggregationCount = 0;
+    mAggregationIdr = false;
+}
@@ -25,90 +25,222 @@
 #include <VideoManager.h>
 #include <ImsMediaVideoUtil.h>
 #include <ImsMediaTrace.h>
+#include <ImsMediaPacketTracer.h>
+#include <SessionLatencyStats.h>
 #include <android/native_window_jni.h>
 #include <android/asset_manager_jni.h>
+#include <pthread.h>
 
 #define IMS_MEDIA_JNI_VERSION JNI_VERSION_1_4
+// the initial size of the byte array kept by each thread to send the parcel to java
+#define JNI_BUFFER_SIZE_MIN 1024
+// the parcel larger than this size is sent with a byte array allocated for the message
+#define JNI_BUFFER_SIZE_MAX 65536
 
 static const char* gClassPath = "com/android/telephony/imsmedia/JNIImsMediaService";
 
 static JavaVM* gJVM = nullptr;
 static jclass gClass_JNIImsMediaService = nullptr;
 static jmethodID gMethod_sendData2Java = nullptr;
+static jmethodID gMethod_setAudioThreadPriority = nullptr;
+static pthread_key_t gThreadKey;
+static bool gThreadKeyCreated = false;
 AAssetManager* gpAssetManager = nullptr;
 
+/**
+ * The JNIEnv of the native thread and the byte array reused to send the parcels to java, kept
+ * in the thread specific data until the thread exits
+ */
+struct JniThreadContext
+{
+    JNIEnv* env;
+    jbyteArray buffer;
+    jsize bufferSize;
+    bool attached;
+};
+
 JavaVM* GetJavaVM()
 {
     return gJVM;
 }
 
-static int SendData2Java(int sessionId, const android::Parcel& objParcel)
+static void ReleaseThreadContext(void* data)
 {
-    JNIEnv* env;
+    JniThreadContext* context = reinterpret_cast<JniThreadContext*>(data);
 
-    if ((gClass_JNIImsMediaService == nullptr) || (gMethod_sendData2Java == nullptr))
+    if (context == nullptr)
     {
-        ALOGE(0, "SendData2Java: Method is null", 0, 0, 0);
-        return 0;
+        return;
+    }
+
+    if (context->buffer != nullptr)
+    {
+        context->env->DeleteGlobalRef(context->buffer);
+    }
+
+    if (context->attached && gJVM != nullptr)
+    {
+        gJVM->DetachCurrentThread();
+    }
+
+    delete context;
+}
+
+static JniThreadContext* GetThreadContext()
+{
+    if (!gThreadKeyCreated)
+    {
+        return nullptr;
+    }
+
+    JniThreadContext* context =
+            reinterpret_cast<JniThreadContext*>(pthread_getspecific(gThreadKey));
+
+    if (context != nullptr)
+    {
+        return context;
     }
 
     JavaVM* jvm = GetJavaVM();
+    JNIEnv* env = nullptr;
+    bool attached = false;
 
-    if (jvm->AttachCurrentThread(&env, nullptr) != JNI_OK)
+    if (jvm == nullptr)
     {
-        ALOGE(0, "SendData2Java: AttachCurrentThread fail", 0, 0, 0);
-        return 0;
+        return nullptr;
     }
 
-    jbyteArray baData = env->NewByteArray(objParcel.dataSize());
-    jbyte* pBuffer = env->GetByteArrayElements(baData, nullptr);
+    if (jvm->GetEnv(reinterpret_cast<void**>(&env), IMS_MEDIA_JNI_VERSION) != JNI_OK)
+    {
+        if (jvm->AttachCurrentThread(&env, nullptr) != JNI_OK)
+        {
+            return nullptr;
+        }
 
-    if (pBuffer != nullptr)
+        attached = true;
+    }
+
+    context = new JniThreadContext{env, nullptr, 0, attached};
+
+    if (pthread_setspecific(gThreadKey, context) != 0)
     {
-        memcpy(pBuffer, objParcel.data(), objParcel.dataSize());
-        env->ReleaseByteArrayElements(baData, pBuffer, 0);
-        env->CallStaticIntMethod(
-                gClass_JNIImsMediaService, gMethod_sendData2Java, sessionId, baData);
+        ReleaseThreadContext(context);
+        return nullptr;
     }
 
-    env->DeleteLocalRef(baData);
+    return context;
+}
 
-    return 1;
+/**
+ * @brief Get the byte array of the thread to copy the data of the given size. The array grows
+ * by doubling and is kept for the following messages of the native threads attached here. A
+ * local array is returned for the java threads, which may be detached before the thread specific
+ * data is released, and for the data larger than JNI_BUFFER_SIZE_MAX. The local array should be
+ * deleted by the caller.
+ */
+static jbyteArray GetByteArray(JniThreadContext* context, jsize size, bool& isLocal)
+{
+    JNIEnv* env = context->env;
+    isLocal = false;
+
+    if (!context->attached || size > JNI_BUFFER_SIZE_MAX)
+    {
+        jbyteArray array = env->NewByteArray(size);
+
+        if (array == nullptr)
+        {
+            env->ExceptionClear();
+        }
+
+        isLocal = true;
+        return array;
+    }
+
+    if (context->buffer != nullptr && size <= context->bufferSize)
+    {
+        return context->buffer;
+    }
+
+    jsize bufferSize = context->bufferSize == 0 ? JNI_BUFFER_SIZE_MIN : context->bufferSize;
+
+    while (bufferSize < size)
+    {
+        bufferSize *= 2;
+    }
+
+    jbyteArray array = env->NewByteArray(bufferSize);
+
+    if (array == nullptr)
+    {
+        env->ExceptionClear();
+        return nullptr;
+    }
+
+    if (context->buffer != nullptr)
+    {
+        env->DeleteGlobalRef(context->buffer);
+    }
+
+    context->buffer = reinterpret_cast<jbyteArray>(env->NewGlobalRef(array));
+    context->bufferSize = context->buffer != nullptr ? bufferSize : 0;
+    env->DeleteLocalRef(array);
+    return context->buffer;
 }
 
-void setAudioThreadPriority(int threadId)
+static int SendData2Java(int sessionId, const android::Parcel& objParcel)
 {
-    JNIEnv* env = nullptr;
-    JavaVM* jvm = GetJavaVM();
+    if ((gClass_JNIImsMediaService == nullptr) || (gMethod_sendData2Java == nullptr))
+    {
+        ALOGE(0, "SendData2Java: Method is null", 0, 0, 0);
+        return 0;
+    }
 
-    if (gClass_JNIImsMediaService == nullptr)
+    JniThreadContext* context = GetThreadContext();
+
+    if (context == nullptr)
     {
-        IMLOGE0("gClass_JNIImsMediaService is null");
-        return;
+        ALOGE(0, "SendData2Java: AttachCurrentThread fail", 0, 0, 0);
+        return 0;
     }
 
-    if (jvm == nullptr || jvm->AttachCurrentThread(&env, nullptr) != JNI_OK)
+    JNIEnv* env = context->env;
+    jsize size = objParcel.dataSize();
+    bool isLocal = false;
+    jbyteArray baData = GetByteArray(context, size, isLocal);
+
+    if (baData != nullptr)
     {
-        IMLOGE0("setAudioThreadPriority: AttachCurrentThread fail");
-        return;
+        env->SetByteArrayRegion(baData, 0, size, reinterpret_cast<const jbyte*>(objParcel.data()));
+        env->CallStaticIntMethod(
+                gClass_JNIImsMediaService, gMethod_sendData2Java, sessionId, baData, size);
+
+        if (isLocal)
+        {
+            env->DeleteLocalRef(baData);
+        }
     }
 
-    if (env == nullptr)
+    return 1;
+}
+
+void setAudioThreadPriority(int threadId)
+{
+    if (gClass_JNIImsMediaService == nullptr || gMethod_setAudioThreadPriority == nullptr)
     {
-        IMLOGE0("env is null");
+        IMLOGE0("gClass_JNIImsMediaService is null");
         return;
     }
 
-    jmethodID gMethod_setAudioThreadPriority =
-            env->GetStaticMethodID(gClass_JNIImsMediaService, "setAudioThreadPriority", "(I)V");
+    JniThreadContext* context = GetThreadContext();
 
-    if (gMethod_setAudioThreadPriority == nullptr)
+    if (context == nullptr)
     {
-        IMLOGE0("setAudioThreadPriority: GetStaticMethodID gMethod_setAudioThreadPriority failed");
+        IMLOGE0("setAudioThreadPriority: AttachCurrentThread fail");
         return;
     }
 
-    env->CallStaticIntMethod(gClass_JNIImsMediaService, gMethod_setAudioThreadPriority, threadId);
+    context->env->CallStaticVoidMethod(
+            gClass_JNIImsMediaService, gMethod_setAudioThreadPriority, threadId);
 }
 
 static jlong JNIImsMediaService_getInterface(
@@ -200,6 +332,21 @@ static void JNIImsMediaService_setLogMode(JNIEnv*, jobject, jint logMode, jint d
 {
     ImsMediaTrace::IMSetLogMode(logMode);
     ImsMediaTrace::IMSetDebugLogMode(debugLogMode);
+
+    bool traceEnabled = (debugLogMode & IM_PACKET_LOG_BINARY_TRACE) != 0;
+
+    if (ImsMediaPacketTracer::IsEnabled() && !traceEnabled)
+    {
+        ImsMediaPacketTracer::SetEnabled(false);
+        ImsMediaPacketTracer::Dump(IM_PACKET_TRACE_FILE);
+        ImsMediaPacketTracer::Reset();
+    }
+    else if (traceEnabled)
+    {
+        ImsMediaPacketTracer::SetEnabled(true);
+    }
+
+    SessionLatencyStats::SetEnabled((debugLogMode & IM_PACKET_LOG_LATENCY) != 0);
 }
 
 static JNINativeMethod gMethods[] = {
@@ -218,6 +365,11 @@ jint ImsMediaServiceJni_OnLoad(JavaVM* vm, JNIEnv* env)
 {
     gJVM = vm;
 
+    if (!gThreadKeyCreated)
+    {
+        gThreadKeyCreated = pthread_key_create(&gThreadKey, ReleaseThreadContext) == 0;
+    }
+
     jclass _jclassImsMediaService = env->FindClass(gClassPath);
 
     if (_jclassImsMediaService == nullptr)
@@ -241,9 +393,11 @@ jint ImsMediaServiceJni_OnLoad(JavaVM* vm, JNIEnv* env)
     }
 
     gMethod_sendData2Java =
-            env->GetStaticMethodID(gClass_JNIImsMediaService, "sendData2Java", "(I[B)I");
+            env->GetStaticMethodID(gClass_JNIImsMediaService, "sendData2Java", "(I[BI)I");
+    gMethod_setAudioThreadPriority =
+            env->GetStaticMethodID(gClass_JNIImsMediaService, "setAudioThreadPriority", "(I)V");
 
-    if (gMethod_sendData2Java == nullptr)
+    if (gMethod_sendData2Java == nullptr || gMethod_setAudioThreadPriority == nullptr)
     {
         ALOGE("ImsMediaServiceJni_OnLoad: GetStaticMethodID failed");
         return -1;
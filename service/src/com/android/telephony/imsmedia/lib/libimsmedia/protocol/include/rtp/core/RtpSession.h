@@ -245,6 +245,12 @@ class RtpSession
     eRTP_STATUS_CODE populateRtpHeader(
             IN RtpHeader* pobjRtpHdr, IN eRtp_Bool eSetMarker, IN RtpDt_UChar ucPayloadType);
 
+    /**
+     * It updates the RTP timestamp of the next packet to send
+     */
+    RtpDt_Void updateRtpTimestamp(
+            IN eRtp_Bool bUseLastTimestamp, IN RtpDt_UInt32 uiRtpTimestampDiff);
+
     /**
      * It calculates number of senders in the receiver list
      */
@@ -454,6 +460,24 @@ public:
             IN RtpDt_UChar ucPayloadType, IN eRtp_Bool bUseLastTimestamp,
             IN RtpDt_UInt32 uiRtpTimestampDiff, IN RtpBuffer* pobjXHdr, OUT RtpBuffer* pRtpPkt);
 
+    /**
+     * It constructs the RTP packets of the payloads sharing one RTP timestamp such as the
+     * fragments of a video frame.
+     *     - The packets get consecutive sequence numbers under the session lock.
+     *     - The packets are serialized back to back into one buffer allocated once, the length
+     *       of each packet is set to usPktLen of the slice.
+     *     - The memory of pRtpPkts is released by the Application.
+     *
+     * @param[in,out] pstSlices Rtp payloads of the packets in the sending order
+     * @param[in] uiNumSlices Number of the payloads
+     * @param[in] pobjXHdr Rtp header extension added to the slices with bExtension set
+     * @param[out] pRtpPkts Rtp packets with the total length
+     */
+    eRTP_STATUS_CODE createRtpPackets(IN_OUT tRTP_PAYLOAD_SLICE* pstSlices,
+            IN RtpDt_UInt32 uiNumSlices, IN RtpDt_UChar ucPayloadType,
+            IN eRtp_Bool bUseLastTimestamp, IN RtpDt_UInt32 uiRtpTimestampDiff,
+            IN RtpBuffer* pobjXHdr, OUT RtpBuffer* pRtpPkts);
+
     /**
      * - Decode a received RTCP packet.
      * - Check for ssrc collision.
@@ -42,12 +42,33 @@ public:
     static RtpDt_Void GetNtpTime(tRTP_NTP_TIME& pstNtpTime);
 
     /**
-     *  Initializes pseudo-random number generator using system time as seed
+     * It gets the monotonic time in the same format as the Ntp time stamp. It is not affected by
+     * the wall clock adjustment, use it for the media timing and GetNtpTime only for the time
+     * sent in the RTCP SR.
+     *
+     * @param pstTime    Monotonic time stamp
+     */
+    static RtpDt_Void GetMonotonicTime(tRTP_NTP_TIME& pstTime);
+
+    /**
+     * Samples the clocks once and makes GetNtpTime and GetMonotonicTime of the calling thread
+     * return the sampled time until EndTimeBatch is called. The calls can be nested.
+     */
+    static RtpDt_Void BeginTimeBatch();
+
+    /**
+     * Ends the time batch started by BeginTimeBatch
+     */
+    static RtpDt_Void EndTimeBatch();
+
+    /**
+     *  Re-seeds the pseudo-random number generator of the calling thread. The generator is seeded
+     *  automatically on its first use in each thread.
      */
     static RtpDt_Void Srand();
 
     /**
-     * Generates a pseudo-random integral number using a new seed.
+     * Generates a pseudo-random integral number from the xorshift generator of the calling thread
      *
      * @return Random number
      */
@@ -62,7 +83,7 @@ public:
     static RtpDt_UInt32 Ntohl(RtpDt_UInt32 uiNetlong);
 
     /**
-     * It returns Random number between 0 and 1
+     * It returns Random number uniformly distributed in [0, 1)
      *
      * @return Generated random fraction
      */
@@ -70,6 +91,16 @@ public:
 
 };  // end RtpOsUtil
 
+/**
+ * Scoped helper to sample the time once for a processing batch such as a compound RTCP packet.
+ */
+class RtpOsTimeBatch
+{
+public:
+    RtpOsTimeBatch() { RtpOsUtil::BeginTimeBatch(); }
+    ~RtpOsTimeBatch() { RtpOsUtil::EndTimeBatch(); }
+};
+
 #endif  // _RtpOsUtil_h_
 
 /** @}*/
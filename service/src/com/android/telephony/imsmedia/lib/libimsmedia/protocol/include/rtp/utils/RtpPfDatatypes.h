@@ -114,6 +114,7 @@ typedef uint16_t RtpDt_UInt16;
 typedef int16_t RtpDt_Int16;
 typedef uint32_t RtpDt_UInt32;
 typedef int32_t RtpDt_Int32;
+typedef uint64_t RtpDt_UInt64;
 typedef double RtpDt_Double;
 
 typedef struct
@@ -122,6 +123,18 @@ typedef struct
     RtpDt_UInt32 m_uiNtpLow32Bits;
 } tRTP_NTP_TIME;
 
+/* One RTP payload of the packets sharing the same RTP timestamp */
+typedef struct
+{
+    RtpDt_UChar* pucPayload;
+    RtpDt_UInt16 usPayloadLen;
+    eRtp_Bool bMarker;
+    /* adds the RTP header extension of the batch to the packet */
+    eRtp_Bool bExtension;
+    /* set by the RTP stack, the length of the RTP packet built from the payload */
+    RtpDt_UInt16 usPktLen;
+} tRTP_PAYLOAD_SLICE;
+
 typedef RtpDt_UInt16 RtpSvc_Length;
 
 #endif  //_RTP_PF_DATATYPES_H_
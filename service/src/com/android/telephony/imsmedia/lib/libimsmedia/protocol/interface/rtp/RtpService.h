@@ -37,6 +37,22 @@ public:
     virtual ~RtpServiceListener() {}
     // receive RTP packet, send it to rtp tx node
     virtual int OnRtpPacket(unsigned char* pData, RtpSvc_Length wLen) = 0;
+    // receive RTP packets stored back to back, send them to rtp tx node
+    virtual int OnRtpPackets(
+            unsigned char* pData, tRTP_PAYLOAD_SLICE* pstSlices, RtpDt_UInt32 uiNumSlices)
+    {
+        for (RtpDt_UInt32 i = 0; i < uiNumSlices; i++)
+        {
+            if (OnRtpPacket(pData, pstSlices[i].usPktLen) == -1)
+            {
+                return -1;
+            }
+
+            pData += pstSlices[i].usPktLen;
+        }
+
+        return 0;
+    }
     // receive RTCP packet, send it to rtcp node
     virtual int OnRtcpPacket(unsigned char* pData, RtpSvc_Length wLen) = 0;
     // indication from the RtpStack
@@ -130,6 +146,28 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtpPacket(IN RtpServiceListener* pobjRtpServiceL
         IN RTPSESSIONID hRtpSession, IN RtpDt_Char* pBuffer, IN RtpDt_UInt16 wBufferLength,
         IN tRtpSvc_SendRtpPacketParam* pstRtpParam);
 
+/**
+ * This API RTP encodes and sends the payloads sharing one RTP timestamp, such as the fragments of
+ * a video frame, in one call. The packets get consecutive sequence numbers and are passed to
+ * OnRtpPackets of the listener at once.
+ *
+ * @param pobjRtpServiceListener media session Listener which will be used for sending the packets
+ * to network nodes after RTP encoding.
+ *
+ * @param hRtpSession A session handled associated with the media stream.
+ *
+ * @param pstSlices Media payloads to be transferred to peer device in the sending order. The
+ * marker bit and the header extension are set per payload.
+ *
+ * @param uiNumSlices Number of the payloads.
+ *
+ * @param pstRtpParam Packet info such as payload-type number, Flag to use Previous RTP time-stamp,
+ * time difference since last media packet/buffer and the header extension. bMbit is not used.
+ */
+GLOBAL eRtp_Bool IMS_RtpSvc_SendRtpPackets(IN RtpServiceListener* pobjRtpServiceListener,
+        IN RTPSESSIONID hRtpSession, IN_OUT tRTP_PAYLOAD_SLICE* pstSlices,
+        IN RtpDt_UInt32 uiNumSlices, IN tRtpSvc_SendRtpPacketParam* pstRtpParam);
+
 /**
  * This API processes the received RTP packet. Processed information is sent using
  * callback OnPeerInd.
@@ -158,12 +158,14 @@ typedef struct
     unsigned int rtpTimestamp;
     unsigned int sendPktCount;
     unsigned int sendOctCount;
-    tRtpSvcRecvReport stRecvRpt;  // only one RR block is supported.
+    unsigned int numReportBlocks;  // stRecvRpt is all zero when it is 0
+    tRtpSvcRecvReport stRecvRpt;   // only one RR block is supported.
 } tNotifyReceiveRtcpSrInd;
 
 typedef struct
 {
-    tRtpSvcRecvReport stRecvRpt;  // only one RR block is supported.
+    unsigned int numReportBlocks;  // stRecvRpt is all zero when it is 0
+    tRtpSvcRecvReport stRecvRpt;   // only one RR block is supported.
 } tNotifyReceiveRtcpRrInd;
 
 #endif /* End of _RTP_SERVICE_TYPES_H_*/
@@ -148,6 +148,7 @@ eRtp_Bool populateRcvdRrInfoFromStk(
 
     tRtpSvcRecvReport* pstRcvdReport = &(pstRrInfo->stRecvRpt);
     std::list<RtcpReportBlock*>& pobjRepBlkList = pobjRrPkt->getReportBlockList();
+    pstRrInfo->numReportBlocks = pobjRepBlkList.size();
     return populateRcvdReportFromStk(pobjRepBlkList, pstRcvdReport);
 }  // populateRcvdRrInfoFromStk
 
@@ -184,6 +185,7 @@ eRtp_Bool populateRcvdSrInfoFromStk(
     tRtpSvcRecvReport* pstRcvdReport = &(pstSrInfo->stRecvRpt);
     RtcpRrPacket* pobjRepBlk = pobjSrPkt->getRrPktInfo();
     std::list<RtcpReportBlock*>& pobjRepBlkList = pobjRepBlk->getReportBlockList();
+    pstSrInfo->numReportBlocks = pobjRepBlkList.size();
     return populateRcvdReportFromStk(pobjRepBlkList, pstRcvdReport);
 }
 
@@ -486,6 +488,52 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtpPacket(IN RtpServiceListener* pobjRtpServiceL
     return eRTP_TRUE;
 }
 
+GLOBAL eRtp_Bool IMS_RtpSvc_SendRtpPackets(IN RtpServiceListener* pobjRtpServiceListener,
+        IN RTPSESSIONID hRtpSession, IN_OUT tRTP_PAYLOAD_SLICE* pstSlices,
+        IN RtpDt_UInt32 uiNumSlices, IN tRtpSvc_SendRtpPacketParam* pstRtpParam)
+{
+    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+
+    if (g_pobjRtpStack == nullptr ||
+            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+        return eRTP_FALSE;
+
+    if (pobjRtpSession->isRtpEnabled() == eRTP_FALSE)
+    {
+        return eRTP_FALSE;
+    }
+
+    RtpBuffer* pobjXHdr = SetRtpHeaderExtension(pstRtpParam);
+    RtpBuffer objRtpBuf;
+    eRtp_Bool bUseLastTimestamp = pstRtpParam->bUseLastTimestamp ? eRTP_TRUE : eRTP_FALSE;
+
+    eRTP_STATUS_CODE eRtpCreateStat = pobjRtpSession->createRtpPackets(pstSlices, uiNumSlices,
+            pstRtpParam->byPayLoadType, bUseLastTimestamp, pstRtpParam->diffFromLastRtpTimestamp,
+            pobjXHdr, &objRtpBuf);
+    delete pobjXHdr;
+
+    if (eRtpCreateStat != RTP_SUCCESS)
+    {
+        RTP_TRACE_WARNING("IMS_RtpSvc_SendRtpPackets - eRtpCreateStat[%d], slices[%d]",
+                eRtpCreateStat, uiNumSlices);
+        return eRTP_FALSE;
+    }
+
+    if (pobjRtpSession->isRtpEnabled() == eRTP_FALSE)
+    {
+        return eRTP_FALSE;
+    }
+
+    // dispatch to peer
+    if (pobjRtpServiceListener->OnRtpPackets(objRtpBuf.getBuffer(), pstSlices, uiNumSlices) == -1)
+    {
+        RTP_TRACE_WARNING("On Rtp packets failed ..! OnRtpPackets", RTP_ZERO, RTP_ZERO);
+        return eRTP_FALSE;
+    }
+
+    return eRTP_TRUE;
+}
+
 GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtpPacket(IN RtpServiceListener* pvIRtpSession,
         IN RTPSESSIONID hRtpSession, IN RtpDt_UChar* pMsg, IN RtpDt_UInt16 uiMsgLength,
         IN RtpDt_Char* pPeerIp, IN RtpDt_UInt16 uiPeerPort, OUT RtpDt_UInt32& uiPeerSsrc)
@@ -450,7 +450,10 @@ RtpDt_UInt32 RtpSession::calculateTotalRtcpSize(
 
 RtpDt_Void RtpSession::rtpSetTimestamp()
 {
+    // the wall clock is only for the NTP timestamp of the SR, the media timing is monotonic
     RtpOsUtil::GetNtpTime(m_stCurNtpRtcpTs);
+    tRTP_NTP_TIME stCurTime = {RTP_ZERO, RTP_ZERO};
+    RtpOsUtil::GetMonotonicTime(stCurTime);
     if (m_bRtcpSendPkt == eRTP_FALSE)
     {
         m_bRtcpSendPkt = eRTP_TRUE;
@@ -465,7 +468,7 @@ RtpDt_Void RtpSession::rtpSetTimestamp()
     // RTP Timestamp = Last RTP Pkt timestamp
     //                 + timegap between last RTP packet and current RTCP packet
     m_curRtcpTimestamp = RtpStackUtil::calcRtpTimestamp(
-            m_curRtpTimestamp, &m_stCurNtpRtcpTs, &m_stCurNtpTimestamp, uiSamplingRate);
+            m_curRtpTimestamp, &stCurTime, &m_stCurNtpTimestamp, uiSamplingRate);
 }
 
 eRTP_STATUS_CODE RtpSession::rtpMakeCompoundRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt)
@@ -646,6 +649,7 @@ RtpDt_Void RtpSession::rtcpTimerExpiry(IN RtpDt_Void* pvTimerId)
 {
     // RtpDt_UInt32 uiSamplingRate = RTP_ZERO;
     std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    RtpOsTimeBatch objTimeBatch;
 
     eRtp_Bool bSessAlive = eRTP_FALSE;
 
@@ -1244,7 +1248,7 @@ eRTP_STATUS_CODE RtpSession::initSession(
     // generate sequence number
     m_usSeqNum = (RtpDt_UInt16)RtpOsUtil::Rand();
     m_curRtpTimestamp = (RtpDt_UInt16)RtpOsUtil::Rand();
-    RtpOsUtil::GetNtpTime(m_stCurNtpTimestamp);
+    RtpOsUtil::GetMonotonicTime(m_stCurNtpTimestamp);
     return RTP_SUCCESS;
 }  // initSession
 
@@ -1684,33 +1688,7 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
         pobjRtpHdr->setExtension(RTP_ZERO);
 
     // set timestamp
-    m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
-    m_prevRtpTimestamp = m_curRtpTimestamp;
-    RtpDt_UInt32 uiSamplingRate = RTP_ZERO;
-
-    if (!bUseLastTimestamp)
-    {
-        m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
-        m_prevRtpTimestamp = m_curRtpTimestamp;
-        RtpOsUtil::GetNtpTime(m_stCurNtpTimestamp);
-
-        if (m_uiRtpSendPktCount == RTP_ZERO)
-        {
-            m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
-        }
-
-        if (uiRtpTimestampDiff)
-        {
-            m_curRtpTimestamp += uiRtpTimestampDiff;
-        }
-        else
-        {
-            uiSamplingRate = m_pobjPayloadInfo->getSamplingRate();
-            m_curRtpTimestamp = RtpStackUtil::calcRtpTimestamp(m_prevRtpTimestamp,
-                    &m_stCurNtpTimestamp, &m_stPrevNtpTimestamp, uiSamplingRate);
-        }
-    }
-
+    updateRtpTimestamp(bUseLastTimestamp, uiRtpTimestampDiff);
     pobjRtpHdr->setRtpTimestamp(m_curRtpTimestamp);
 
     // set pobjPayload to RtpPacket
@@ -1782,6 +1760,122 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
     return RTP_SUCCESS;
 }  // createRtpPacket
 
+RtpDt_Void RtpSession::updateRtpTimestamp(
+        IN eRtp_Bool bUseLastTimestamp, IN RtpDt_UInt32 uiRtpTimestampDiff)
+{
+    m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
+    m_prevRtpTimestamp = m_curRtpTimestamp;
+
+    if (bUseLastTimestamp)
+    {
+        return;
+    }
+
+    RtpOsUtil::GetMonotonicTime(m_stCurNtpTimestamp);
+
+    if (m_uiRtpSendPktCount == RTP_ZERO)
+    {
+        m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
+    }
+
+    if (uiRtpTimestampDiff)
+    {
+        m_curRtpTimestamp += uiRtpTimestampDiff;
+    }
+    else
+    {
+        RtpDt_UInt32 uiSamplingRate = m_pobjPayloadInfo->getSamplingRate();
+        m_curRtpTimestamp = RtpStackUtil::calcRtpTimestamp(m_prevRtpTimestamp,
+                &m_stCurNtpTimestamp, &m_stPrevNtpTimestamp, uiSamplingRate);
+    }
+}  // updateRtpTimestamp
+
+eRTP_STATUS_CODE RtpSession::createRtpPackets(IN_OUT tRTP_PAYLOAD_SLICE* pstSlices,
+        IN RtpDt_UInt32 uiNumSlices, IN RtpDt_UChar ucPayloadType,
+        IN eRtp_Bool bUseLastTimestamp, IN RtpDt_UInt32 uiRtpTimestampDiff,
+        IN RtpBuffer* pobjXHdr, OUT RtpBuffer* pRtpPkts)
+{
+    if (pstSlices == nullptr || uiNumSlices == RTP_ZERO || pRtpPkts == nullptr)
+    {
+        return RTP_INVALID_PARAMS;
+    }
+
+    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+
+    RtpDt_UInt32 uiXHdrLen = (pobjXHdr != nullptr) ? pobjXHdr->getLength() : RTP_ZERO;
+    RtpDt_UInt32 uiTotalLen = RTP_ZERO;
+
+    for (RtpDt_UInt32 i = RTP_ZERO; i < uiNumSlices; i++)
+    {
+        RtpDt_UInt32 uiPktLen = RTP_FIXED_HDR_LEN + pstSlices[i].usPayloadLen;
+
+        if (pstSlices[i].bExtension == eRTP_TRUE)
+        {
+            uiPktLen += uiXHdrLen;
+        }
+
+        if (uiPktLen > RTP_HEX_16_BIT_MAX)
+        {
+            return RTP_INVALID_LEN;
+        }
+
+        pstSlices[i].usPktLen = uiPktLen;
+        uiTotalLen += uiPktLen;
+    }
+
+    RtpDt_UChar* pucRtpBuffer = new RtpDt_UChar[uiTotalLen];
+
+    // all the packets share the timestamp
+    updateRtpTimestamp(bUseLastTimestamp, uiRtpTimestampDiff);
+
+    RtpDt_UChar* pucPkt = pucRtpBuffer;
+    RtpBuffer objHdrBuf;
+
+    for (RtpDt_UInt32 i = RTP_ZERO; i < uiNumSlices; i++)
+    {
+        eRtp_Bool bExtension = (pstSlices[i].bExtension == eRTP_TRUE && uiXHdrLen > RTP_ZERO)
+                ? eRTP_TRUE
+                : eRTP_FALSE;
+
+        RtpHeader objRtpHdr;
+        populateRtpHeader(&objRtpHdr, pstSlices[i].bMarker, ucPayloadType);
+        objRtpHdr.setExtension(bExtension == eRTP_TRUE ? RTP_ONE : RTP_ZERO);
+        objRtpHdr.setRtpTimestamp(m_curRtpTimestamp);
+
+        objHdrBuf.setBufferInfo(pstSlices[i].usPktLen, pucPkt);
+        objRtpHdr.formHeader(&objHdrBuf);
+        pucPkt += objHdrBuf.getLength();
+
+        if (bExtension == eRTP_TRUE)
+        {
+            memcpy(pucPkt, pobjXHdr->getBuffer(), uiXHdrLen);
+            pucPkt += uiXHdrLen;
+        }
+
+        if (pstSlices[i].usPayloadLen > RTP_ZERO)
+        {
+            memcpy(pucPkt, pstSlices[i].pucPayload, pstSlices[i].usPayloadLen);
+            pucPkt += pstSlices[i].usPayloadLen;
+        }
+
+        // update statistics
+        m_uiRtpSendPktCount++;
+        m_uiRtpSendOctCount += pstSlices[i].usPayloadLen;
+    }
+
+    // the header buffer is a view of pucRtpBuffer
+    objHdrBuf.setBufferInfo(RTP_ZERO, nullptr);
+    pRtpPkts->setBufferInfo(uiTotalLen, pucRtpBuffer);
+
+    // set we_sent flag as true
+    m_objTimerInfo.setWeSent(RTP_TWO);
+
+    // set m_bRtpSendPkt to true
+    m_bRtpSendPkt = eRTP_TRUE;
+
+    return RTP_SUCCESS;
+}  // createRtpPackets
+
 RtpReceiverInfo* RtpSession::processRtcpPkt(
         IN RtpDt_UInt32 uiRcvdSsrc, IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort)
 {
@@ -1961,6 +2055,8 @@ eRTP_STATUS_CODE RtpSession::processRcvdRtcpPkt(IN RtpBuffer* pobjRtcpAddr, IN R
     RtpDt_UInt16 usExtHdrLen = RTP_ZERO;
     eRTP_STATUS_CODE eDecodeStatus = RTP_FAILURE;
 
+    // sample the time once for all the packets of the compound packet
+    RtpOsTimeBatch objTimeBatch;
     tRTP_NTP_TIME stNtpTs = {RTP_ZERO, RTP_ZERO};
     RtpOsUtil::GetNtpTime(stNtpTs);
     RtpDt_UInt32 currentTime = RtpStackUtil::getMidFourOctets(&stNtpTs);
@@ -2006,7 +2102,7 @@ eRTP_STATUS_CODE RtpSession::processRcvdRtcpPkt(IN RtpBuffer* pobjRtcpAddr, IN R
         {
             stNtpTs = {RTP_ZERO, RTP_ZERO};
             pobjRcvInfo->setpreSrTimestamp(pobjSrPkt->getNtpTime());
-            RtpOsUtil::GetNtpTime(stNtpTs);
+            RtpOsUtil::GetMonotonicTime(stNtpTs);
             pobjRcvInfo->setLastSrNtpTimestamp(&stNtpTs);
         }
     }  // RTCP SR
@@ -15,38 +15,128 @@
  */
 
 #include <sys/time.h>
+#include <time.h>
 #include <stdlib.h>
 #include <netinet/in.h>
 #include <RtpOsUtil.h>
 
+// To convert a UNIX timestamp (seconds since 1970) to NTP time, add 2,208,988,800 seconds
+#define RTP_NTP_UNIX_EPOCH_DIFF  2208988800UL
+#define RTP_NTP_FRACTION_PER_USEC 4294UL
+#define RTP_NSEC_PER_USEC        1000
+#define RTP_NSEC_PER_SEC         1000000000ULL
+
+typedef struct
+{
+    RtpDt_UInt32 uiBatchDepth;
+    tRTP_NTP_TIME stBatchNtpTime;
+    tRTP_NTP_TIME stBatchMonotonicTime;
+    RtpDt_UInt64 ulRandState;
+} tRTP_OS_THREAD_CONTEXT;
+
+static thread_local tRTP_OS_THREAD_CONTEXT gstThreadContext = {
+        RTP_ZERO, {RTP_ZERO, RTP_ZERO}, {RTP_ZERO, RTP_ZERO}, RTP_ZERO};
+
+static RtpDt_Void readClock(clockid_t clockId, RtpDt_UInt32 uiSecOffset, tRTP_NTP_TIME& pstTime)
+{
+    struct timespec stTs;
+
+    if (clock_gettime(clockId, &stTs) != -1)
+    {
+        pstTime.m_uiNtpHigh32Bits = stTs.tv_sec + uiSecOffset;
+        pstTime.m_uiNtpLow32Bits =
+                (RtpDt_UInt32)((stTs.tv_nsec / RTP_NSEC_PER_USEC) * RTP_NTP_FRACTION_PER_USEC);
+    }
+}
+
+// splitmix64, spreads a weak seed over the whole state of the xorshift generator
+static RtpDt_UInt64 mixSeed(RtpDt_UInt64 ulSeed)
+{
+    ulSeed += 0x9E3779B97F4A7C15ULL;
+    ulSeed = (ulSeed ^ (ulSeed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    ulSeed = (ulSeed ^ (ulSeed >> 27)) * 0x94D049BB133111EBULL;
+    return ulSeed ^ (ulSeed >> 31);
+}
+
+// xorshift64*
+static RtpDt_UInt64 nextRand()
+{
+    if (gstThreadContext.ulRandState == RTP_ZERO)
+    {
+        RtpOsUtil::Srand();
+    }
+
+    RtpDt_UInt64 ulState = gstThreadContext.ulRandState;
+    ulState ^= ulState >> 12;
+    ulState ^= ulState << 25;
+    ulState ^= ulState >> 27;
+    gstThreadContext.ulRandState = ulState;
+    return ulState * 0x2545F4914F6CDD1DULL;
+}
+
 RtpOsUtil::RtpOsUtil() {}
 
 RtpOsUtil::~RtpOsUtil() {}
 
 RtpDt_Void RtpOsUtil::GetNtpTime(tRTP_NTP_TIME& pstNtpTime)
 {
-    struct timeval stAndrodTp;
+    if (gstThreadContext.uiBatchDepth > RTP_ZERO)
+    {
+        pstNtpTime = gstThreadContext.stBatchNtpTime;
+        return;
+    }
 
-    if (gettimeofday(&stAndrodTp, nullptr) != -1)
+    readClock(CLOCK_REALTIME, RTP_NTP_UNIX_EPOCH_DIFF, pstNtpTime);
+}
+
+RtpDt_Void RtpOsUtil::GetMonotonicTime(tRTP_NTP_TIME& pstTime)
+{
+    if (gstThreadContext.uiBatchDepth > RTP_ZERO)
+    {
+        pstTime = gstThreadContext.stBatchMonotonicTime;
+        return;
+    }
+
+    readClock(CLOCK_MONOTONIC, RTP_ZERO, pstTime);
+}
+
+RtpDt_Void RtpOsUtil::BeginTimeBatch()
+{
+    if (gstThreadContext.uiBatchDepth++ == RTP_ZERO)
+    {
+        readClock(CLOCK_REALTIME, RTP_NTP_UNIX_EPOCH_DIFF, gstThreadContext.stBatchNtpTime);
+        readClock(CLOCK_MONOTONIC, RTP_ZERO, gstThreadContext.stBatchMonotonicTime);
+    }
+}
+
+RtpDt_Void RtpOsUtil::EndTimeBatch()
+{
+    if (gstThreadContext.uiBatchDepth > RTP_ZERO)
     {
-        // To convert a UNIX timestamp (seconds since 1970) to NTP time, add 2,208,988,800 seconds
-        pstNtpTime.m_uiNtpHigh32Bits = stAndrodTp.tv_sec + 2208988800UL;
-        pstNtpTime.m_uiNtpLow32Bits = (RtpDt_UInt32)(stAndrodTp.tv_usec * 4294UL);
+        gstThreadContext.uiBatchDepth--;
     }
 }
 
 RtpDt_Void RtpOsUtil::Srand()
 {
-    struct timeval stSysTime;
-    gettimeofday(&stSysTime, nullptr);
-    RtpDt_UInt32 uiSeed = stSysTime.tv_usec * 1000;
-    srand(uiSeed);
+    struct timespec stMonoTs = {RTP_ZERO, RTP_ZERO};
+    struct timespec stRealTs = {RTP_ZERO, RTP_ZERO};
+    clock_gettime(CLOCK_MONOTONIC, &stMonoTs);
+    clock_gettime(CLOCK_REALTIME, &stRealTs);
+
+    // the address of the context differs per thread
+    RtpDt_UInt64 ulSeed = (RtpDt_UInt64)stRealTs.tv_sec * RTP_NSEC_PER_SEC + stRealTs.tv_nsec;
+    ulSeed ^= mixSeed((RtpDt_UInt64)stMonoTs.tv_sec * RTP_NSEC_PER_SEC + stMonoTs.tv_nsec);
+    ulSeed ^= mixSeed(
+            reinterpret_cast<uintptr_t>(&gstThreadContext) ^ gstThreadContext.ulRandState);
+    ulSeed = mixSeed(ulSeed);
+
+    gstThreadContext.ulRandState = (ulSeed != RTP_ZERO) ? ulSeed : 0x9E3779B97F4A7C15ULL;
 }
 
 RtpDt_UInt32 RtpOsUtil::Rand()
 {
-    RtpOsUtil::Srand();
-    return rand();
+    return (RtpDt_UInt32)(nextRand() >> RTP_32);
 }
 
 RtpDt_UInt32 RtpOsUtil::Ntohl(RtpDt_UInt32 uiNetlong)
@@ -56,19 +146,6 @@ RtpDt_UInt32 RtpOsUtil::Ntohl(RtpDt_UInt32 uiNetlong)
 
 RtpDt_Double RtpOsUtil::RRand()
 {
-    tRTP_NTP_TIME stNtpTs = {0, 0};
-    RtpOsUtil::Srand();
-    RtpDt_Double dRandNum = static_cast<RtpDt_Double>(rand()) / static_cast<RtpDt_Double>(RAND_MAX);
-    RtpOsUtil::GetNtpTime(stNtpTs);
-    RtpDt_Double dTemp = ((dRandNum * stNtpTs.m_uiNtpHigh32Bits) +
-            (stNtpTs.m_uiNtpLow32Bits / static_cast<RtpDt_Double>(RTP_MILLISEC_MICRO)));
-
-    if (dTemp > RTP_ZERO)
-    {
-        return 1.0 / dTemp;
-    }
-    else
-    {
-        return 1.0;
-    }
+    // 53 bits of the random number fill the mantissa of the double
+    return (RtpDt_Double)(nextRand() >> 11) * (1.0 / (RtpDt_Double)(1ULL << 53));
 }
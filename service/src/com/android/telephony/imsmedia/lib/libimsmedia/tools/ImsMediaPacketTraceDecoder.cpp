@@ -0,0 +1,149 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Decodes the binary dump of ImsMediaPacketTracer to text or csv. The records of all the threads
+ * are merged in the time order.
+ *
+ * usage: imsmedia_packet_trace_decoder [--csv] <dump file>
+ */
+
+#include <ImsMediaPacketTracer.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+static void PrintUsage(const char* name)
+{
+    fprintf(stderr, "usage: %s [--csv] <dump file>\n", name);
+}
+
+static bool ReadRecords(const char* path, std::vector<ImsMediaPacketTraceRecord>& records)
+{
+    FILE* file = fopen(path, "rb");
+
+    if (file == nullptr)
+    {
+        fprintf(stderr, "failed to open %s\n", path);
+        return false;
+    }
+
+    ImsMediaPacketTraceFileHeader header;
+    bool result = false;
+
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != IM_PACKET_TRACE_MAGIC)
+    {
+        fprintf(stderr, "%s is not a packet trace dump\n", path);
+    }
+    else if (header.version != IM_PACKET_TRACE_VERSION ||
+            header.recordSize != sizeof(ImsMediaPacketTraceRecord))
+    {
+        fprintf(stderr, "not supported version[%u], record size[%u]\n", header.version,
+                header.recordSize);
+    }
+    else
+    {
+        records.resize(header.numRecords);
+        size_t count = fread(records.data(), sizeof(records[0]), records.size(), file);
+
+        if (count != records.size())
+        {
+            fprintf(stderr, "truncated dump, %zu of %u records\n", count, header.numRecords);
+            records.resize(count);
+        }
+
+        result = true;
+    }
+
+    fclose(file);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    bool csv = false;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--csv") == 0)
+        {
+            csv = true;
+        }
+        else if (path == nullptr)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (path == nullptr)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<ImsMediaPacketTraceRecord> records;
+
+    if (!ReadRecords(path, records))
+    {
+        return 1;
+    }
+
+    std::stable_sort(records.begin(), records.end(),
+            [](const ImsMediaPacketTraceRecord& a, const ImsMediaPacketTraceRecord& b)
+            {
+                return a.timeNs < b.timeNs;
+            });
+
+    if (csv)
+    {
+        printf("time_ns,delta_us,session,thread,event,seq,timestamp,size\n");
+    }
+
+    uint64_t prevTime = records.empty() ? 0 : records.front().timeNs;
+
+    for (auto& record : records)
+    {
+        uint64_t delta = (record.timeNs - prevTime) / 1000;
+        prevTime = record.timeNs;
+
+        if (csv)
+        {
+            printf("%" PRIu64 ",%" PRIu64 ",%d,%u,%s,%u,%u,%u\n", record.timeNs, delta,
+                    record.sessionId, record.threadId,
+                    ImsMediaPacketTracer::GetEventName(record.event), record.seq,
+                    record.timestamp, record.size);
+        }
+        else
+        {
+            printf("%" PRIu64 ".%06" PRIu64 " +%" PRIu64 "us session[%d] tid[%u] %-18s seq[%u] "
+                   "TS[%u] size[%u]\n",
+                    record.timeNs / 1000000000, (record.timeNs / 1000) % 1000000, delta,
+                    record.sessionId, record.threadId,
+                    ImsMediaPacketTracer::GetEventName(record.event), record.seq,
+                    record.timestamp, record.size);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <AudioJitterBuffer.h>
+
+namespace
+{
+const uint32_t kAudioFrameInterval = 20;
+
+// releases the parameters of the events sent by the jitter buffer
+class FakeSessionCallback : public BaseSessionCallback
+{
+public:
+    virtual ~FakeSessionCallback() {}
+
+    virtual void onEvent(int32_t type, uint64_t param1, uint64_t param2)
+    {
+        switch (type)
+        {
+            case kCollectPacketInfo:
+                delete reinterpret_cast<RtpPacket*>(param2);
+                break;
+            case kCollectRxRtpStatus:
+            case kCollectOptionalInfo:
+                delete reinterpret_cast<SessionCallbackParameter*>(param1);
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+/**
+ * Gets the sequence number of the index with the pairs of the packets swapped at every given
+ * period, the period 0 keeps the order
+ */
+uint32_t getReorderedIndex(uint32_t index, uint32_t period)
+{
+    if (period == 0 || (index / 2) % period != 0)
+    {
+        return index;
+    }
+
+    return index ^ 1;
+}
+}  // namespace
+
+// Adds a frame and gets a frame in every 20ms with the given reordering period
+static void BM_AudioJitterBufferAddGet(benchmark::State& state)
+{
+    const uint32_t period = state.range(0);
+    uint8_t frame[33] = {0x24};
+    FakeSessionCallback callback;
+    AudioJitterBuffer jitterBuffer;
+    jitterBuffer.SetCodecType(kAudioCodecAmrWb);
+    jitterBuffer.SetSessionCallback(&callback);
+    jitterBuffer.SetJitterBufferSize(4, 4, 9);
+    jitterBuffer.SetJitterOptions(200, 100, 2, 1.8f);
+    jitterBuffer.SetStartTime(0);
+
+    ImsMediaSubType subtype;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    uint32_t index = 0;
+    uint64_t countGet = 0;
+
+    for (auto _ : state)
+    {
+        uint32_t packetIndex = getReorderedIndex(index, period);
+        uint32_t currentTime = index * kAudioFrameInterval;
+        jitterBuffer.Add(MEDIASUBTYPE_UNDEFINED, frame, sizeof(frame),
+                packetIndex * kAudioFrameInterval, false, packetIndex & 0xFFFF,
+                MEDIASUBTYPE_UNDEFINED, currentTime);
+
+        if (jitterBuffer.Get(&subtype, &data, &size, &timestamp, &mark, &seq, currentTime))
+        {
+            jitterBuffer.Delete();
+            countGet++;
+        }
+
+        index++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["delivered"] =
+            benchmark::Counter(static_cast<double>(countGet) / state.iterations());
+}
+BENCHMARK(BM_AudioJitterBufferAddGet)->ArgName("reorder")->Arg(0)->Arg(8)->Arg(2);
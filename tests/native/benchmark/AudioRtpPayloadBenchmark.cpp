@@ -0,0 +1,162 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <AudioConfig.h>
+#include <AudioRtpPayloadEncoderNode.h>
+#include <AudioRtpPayloadDecoderNode.h>
+#include <string.h>
+
+using namespace android::telephony::imsmedia;
+using namespace android;
+
+namespace
+{
+enum kAudioPayloadFormat
+{
+    kAudioPayloadAmrWbBandwidthEfficient = 0,
+    kAudioPayloadAmrWbOctetAligned,
+    kAudioPayloadEvsCompact,
+    kAudioPayloadEvsHeaderFull,
+};
+
+// AMR-WB mode 8 audio frame with toc field
+const uint8_t kAmrWbFrame[] = {0x44, 0xe6, 0x6e, 0x84, 0x8a, 0xa4, 0xda, 0xc8, 0xf2, 0x6c, 0xeb,
+        0x87, 0xe4, 0x56, 0x0f, 0x49, 0x47, 0xfa, 0xdc, 0xa7, 0x9d, 0xbb, 0xcf, 0xda, 0xda, 0x67,
+        0x80, 0xc2, 0x7f, 0x8d, 0x5b, 0xab, 0xd9, 0xbb, 0xd7, 0x1e, 0x60, 0x96, 0x5d, 0xdd, 0x28,
+        0x65, 0x5f, 0x43, 0xf4, 0xb9, 0x0d, 0x7d, 0x05, 0x4e, 0x30, 0x50, 0xe1, 0x98, 0x03, 0xed,
+        0xee, 0x8a, 0xa8, 0x34, 0x40};
+
+// EVS mode 13.2 kbps frame without toc field
+const uint8_t kEvsFrame[] = {0xce, 0x40, 0xf2, 0xb2, 0xa4, 0xce, 0x4f, 0xd9, 0xfa, 0xe9, 0x77,
+        0xdc, 0x9b, 0xc0, 0xa8, 0x10, 0xc8, 0xc3, 0x0f, 0xc9, 0x52, 0xc1, 0xda, 0x45, 0x7e, 0x6c,
+        0x55, 0x47, 0xff, 0xff, 0xff, 0xff, 0xe0};
+
+// counts the frames decoded by the payload decoder
+class FakeNode : public BaseNode
+{
+public:
+    FakeNode() :
+            BaseNode(nullptr),
+            mCount(0)
+    {
+    }
+    virtual ~FakeNode() {}
+    virtual ImsMediaResult Start() { return RESULT_SUCCESS; }
+    virtual void Stop() {}
+    virtual bool IsRunTime() { return true; }
+    virtual bool IsSourceNode() { return false; }
+    virtual void SetConfig(void* config) { (void)config; }
+    virtual void OnDataFromFrontNode(ImsMediaSubType /*subtype*/, uint8_t* data, uint32_t size,
+            uint32_t /*timestamp*/, bool /*mark*/, uint32_t /*seq*/,
+            ImsMediaSubType /*dataType*/, uint32_t /*arrivalTime*/)
+    {
+        benchmark::DoNotOptimize(data);
+        mCount += size > 0 ? 1 : 0;
+    }
+    virtual kBaseNodeState GetState() { return kNodeStateRunning; }
+
+    uint64_t GetCount() { return mCount; }
+
+private:
+    uint64_t mCount;
+};
+
+void setupAudioConfig(AudioConfig& config, kAudioPayloadFormat format)
+{
+    AmrParams amr;
+    amr.setAmrMode(AmrParams::AMR_MODE_8);
+    amr.setOctetAligned(format == kAudioPayloadAmrWbOctetAligned);
+    amr.setMaxRedundancyMillis(0);
+
+    EvsParams evs;
+    evs.setEvsBandwidth(EvsParams::EVS_SUPER_WIDE_BAND);
+    evs.setEvsMode(EvsParams::EVS_MODE_13);
+    evs.setChannelAwareMode(0);
+    evs.setUseHeaderFullOnly(format == kAudioPayloadEvsHeaderFull);
+    evs.setCodecModeRequest(-1);
+
+    config.setMediaDirection(RtpConfig::MEDIA_DIRECTION_SEND_RECEIVE);
+    config.setRxPayloadTypeNumber(96);
+    config.setTxPayloadTypeNumber(96);
+    config.setSamplingRateKHz(16);
+    config.setPtimeMillis(20);
+    config.setMaxPtimeMillis(240);
+    config.setDtxEnabled(true);
+    config.setCodecType(format == kAudioPayloadEvsCompact || format == kAudioPayloadEvsHeaderFull
+                    ? AudioConfig::CODEC_EVS
+                    : AudioConfig::CODEC_AMR_WB);
+    config.setAmrParams(amr);
+    config.setEvsParams(evs);
+}
+}  // namespace
+
+// Packs a frame to the rtp payload and unpacks it back to the frame
+static void BM_AudioRtpPayloadEncodeDecode(benchmark::State& state)
+{
+    kAudioPayloadFormat format = static_cast<kAudioPayloadFormat>(state.range(0));
+    bool isEvs = format == kAudioPayloadEvsCompact || format == kAudioPayloadEvsHeaderFull;
+    const uint8_t* frame = isEvs ? kEvsFrame : kAmrWbFrame;
+    uint32_t frameSize = isEvs ? sizeof(kEvsFrame) : sizeof(kAmrWbFrame);
+    uint8_t data[sizeof(kAmrWbFrame)];
+    memcpy(data, frame, frameSize);
+
+    AudioConfig config;
+    setupAudioConfig(config, format);
+
+    AudioRtpPayloadEncoderNode encoder;
+    AudioRtpPayloadDecoderNode decoder;
+    FakeNode sink;
+    encoder.SetMediaType(IMS_MEDIA_AUDIO);
+    encoder.SetConfig(&config);
+    decoder.SetMediaType(IMS_MEDIA_AUDIO);
+    decoder.SetConfig(&config);
+    encoder.ConnectRearNode(&decoder);
+    decoder.ConnectRearNode(&sink);
+
+    if (encoder.Start() != RESULT_SUCCESS || decoder.Start() != RESULT_SUCCESS)
+    {
+        state.SkipWithError("start failed");
+        return;
+    }
+
+    uint32_t timestamp = 0;
+
+    for (auto _ : state)
+    {
+        encoder.OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, data, frameSize, timestamp, false, 0,
+                MEDIASUBTYPE_UNDEFINED, 0);
+        timestamp += 20;
+    }
+
+    if (sink.GetCount() != state.iterations())
+    {
+        state.SkipWithError("frame is not decoded");
+    }
+
+    encoder.Stop();
+    decoder.Stop();
+    encoder.DisconnectNodes();
+    decoder.DisconnectNodes();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * frameSize);
+}
+BENCHMARK(BM_AudioRtpPayloadEncodeDecode)
+        ->ArgName("format")
+        ->Arg(kAudioPayloadAmrWbBandwidthEfficient)
+        ->Arg(kAudioPayloadAmrWbOctetAligned)
+        ->Arg(kAudioPayloadEvsCompact)
+        ->Arg(kAudioPayloadEvsHeaderFull);
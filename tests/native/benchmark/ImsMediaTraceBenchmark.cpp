@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <ImsMediaTrace.h>
+#include <list>
+#include <mutex>
+
+namespace
+{
+// The packet log call sites read the queue count under the lock of the jitter buffer
+class FakeQueue
+{
+public:
+    FakeQueue() :
+            mList(16, 0)
+    {
+    }
+
+    uint32_t GetCount()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        return mList.size();
+    }
+
+private:
+    std::list<uint32_t> mList;
+    std::mutex mMutex;
+};
+}  // namespace
+
+// The packet log before the inline check. The file name and the arguments are evaluated and the
+// trace is called for each packet even when the log type is disabled.
+static void BM_PacketLogCallDisabled(benchmark::State& state)
+{
+    ImsMediaTrace::IMSetDebugLogMode(0);
+    FakeQueue queue;
+    uint32_t seq = 0;
+
+    for (auto _ : state)
+    {
+        seq++;
+        ImsMediaTrace::IMLOGD_PACKET_ARG(IM_PACKET_LOG_JITTER, "[%s:%d] [Add] seq[%d], queue[%d]",
+                ImsMediaTrace::IM_StripFileName((char*)__FILE__), __LINE__, seq,
+                queue.GetCount());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PacketLogCallDisabled);
+
+static void BM_PacketLogDisabled(benchmark::State& state)
+{
+    ImsMediaTrace::IMSetDebugLogMode(0);
+    FakeQueue queue;
+    uint32_t seq = 0;
+
+    for (auto _ : state)
+    {
+        seq++;
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Add] seq[%d], queue[%d]", seq, queue.GetCount());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PacketLogDisabled);
+
+static void BM_PacketLogOtherTypeEnabled(benchmark::State& state)
+{
+    ImsMediaTrace::IMSetDebugLogMode(IM_PACKET_LOG_RTP | IM_PACKET_LOG_SOCKET);
+    FakeQueue queue;
+    uint32_t seq = 0;
+
+    for (auto _ : state)
+    {
+        seq++;
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Add] seq[%d], queue[%d]", seq, queue.GetCount());
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaTrace::IMSetDebugLogMode(0);
+}
+BENCHMARK(BM_PacketLogOtherTypeEnabled);
+
+static void BM_PacketLogLevelDisabled(benchmark::State& state)
+{
+    ImsMediaTrace::IMSetDebugLogMode(IM_PACKET_LOG_JITTER);
+    ImsMediaTrace::IMSetLogMode(kLogEnableInfo);
+    FakeQueue queue;
+    uint32_t seq = 0;
+
+    for (auto _ : state)
+    {
+        seq++;
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Add] seq[%d], queue[%d]", seq, queue.GetCount());
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaTrace::IMSetLogMode(kLogEnableDebug);
+    ImsMediaTrace::IMSetDebugLogMode(0);
+}
+BENCHMARK(BM_PacketLogLevelDisabled);
@@ -0,0 +1,43 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The same packet log as ImsMediaTraceBenchmark built with the packet logs compiled out
+#define IM_PACKET_LOG_DISABLED
+
+#include <benchmark/benchmark.h>
+#include <ImsMediaTrace.h>
+
+static uint32_t GetQueueCount(uint32_t seq)
+{
+    benchmark::DoNotOptimize(seq);
+    return seq & 0xF;
+}
+
+static void BM_PacketLogCompiledOut(benchmark::State& state)
+{
+    ImsMediaTrace::IMSetDebugLogMode(IM_PACKET_LOG_JITTER);
+    uint32_t seq = 0;
+
+    for (auto _ : state)
+    {
+        seq++;
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Add] seq[%d], queue[%d]", seq, GetQueueCount(seq));
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaTrace::IMSetDebugLogMode(0);
+}
+BENCHMARK(BM_PacketLogCompiledOut);
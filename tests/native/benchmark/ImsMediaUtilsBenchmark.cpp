@@ -0,0 +1,293 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <ImsMediaBitPacker.h>
+#include <ImsMediaBitReader.h>
+#include <ImsMediaBitWriter.h>
+#include <ImsMediaImageRotate.h>
+#include <vector>
+
+namespace
+{
+// the field sizes of the AMR-WB bandwidth efficient payload header and a speech frame
+const uint32_t kFieldSizes[] = {4, 1, 4, 1, 8, 3, 5, 7, 16, 2};
+const uint32_t kNumFields = sizeof(kFieldSizes) / sizeof(kFieldSizes[0]);
+const uint32_t kBitBufferSize = 1024;
+}  // namespace
+
+static void BM_BitWriterWrite(benchmark::State& state)
+{
+    uint8_t buffer[kBitBufferSize];
+    ImsMediaBitWriter writer;
+    uint32_t bits = 0;
+
+    for (auto _ : state)
+    {
+        writer.SetBuffer(buffer, sizeof(buffer));
+        bits = 0;
+
+        while (bits + 32 < sizeof(buffer) * 8)
+        {
+            for (uint32_t i = 0; i < kNumFields; i++)
+            {
+                writer.Write(bits & ((1 << kFieldSizes[i]) - 1), kFieldSizes[i]);
+                bits += kFieldSizes[i];
+            }
+        }
+
+        writer.Flush();
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    state.SetBytesProcessed(state.iterations() * (bits / 8));
+}
+BENCHMARK(BM_BitWriterWrite);
+
+static void BM_BitReaderRead(benchmark::State& state)
+{
+    uint8_t buffer[kBitBufferSize];
+
+    for (uint32_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = i * 37;
+    }
+
+    ImsMediaBitReader reader;
+    uint32_t bits = 0;
+
+    for (auto _ : state)
+    {
+        reader.SetBuffer(buffer, sizeof(buffer));
+        bits = 0;
+        uint32_t sum = 0;
+
+        while (bits + 32 < sizeof(buffer) * 8)
+        {
+            for (uint32_t i = 0; i < kNumFields; i++)
+            {
+                sum += reader.Read(kFieldSizes[i]);
+                bits += kFieldSizes[i];
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(state.iterations() * (bits / 8));
+}
+BENCHMARK(BM_BitReaderRead);
+
+static void BM_BitReaderReadExpGolomb(benchmark::State& state)
+{
+    // the exp-golomb codes of 0 to 7 repeated, as found in the sps of the video configuration
+    uint8_t buffer[kBitBufferSize];
+    ImsMediaBitWriter writer;
+    writer.SetBuffer(buffer, sizeof(buffer));
+    uint32_t count = 0;
+
+    for (uint32_t bits = 0; bits + 16 < sizeof(buffer) * 8; count++)
+    {
+        uint32_t value = (count % 8) + 1;
+        uint32_t length = 0;
+
+        while ((value >> length) > 1)
+        {
+            length++;
+        }
+
+        writer.Write(0, length);
+        writer.Write(value, length + 1);
+        bits += length * 2 + 1;
+    }
+
+    writer.Flush();
+    ImsMediaBitReader reader;
+
+    for (auto _ : state)
+    {
+        reader.SetBuffer(buffer, sizeof(buffer));
+        uint32_t sum = 0;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            sum += reader.ReadByUEMode();
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_BitReaderReadExpGolomb);
+
+// Copies the speech frames following the 10 bits header as in the AMR-WB bandwidth efficient mode
+static void BM_BitWriterWriteByteBufferUnaligned(benchmark::State& state)
+{
+    uint8_t frame[60];
+    uint8_t buffer[kBitBufferSize];
+    ImsMediaBitWriter writer;
+    ImsMediaBitPacker::SetSimdEnabled(state.range(0));
+
+    for (uint32_t i = 0; i < sizeof(frame); i++)
+    {
+        frame[i] = i * 37;
+    }
+
+    for (auto _ : state)
+    {
+        writer.SetBuffer(buffer, sizeof(buffer));
+        writer.Write(0x3FF, 10);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            writer.WriteByteBuffer(frame, 477);
+        }
+
+        writer.Flush();
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    ImsMediaBitPacker::SetSimdEnabled(true);
+    state.SetBytesProcessed(state.iterations() * 16 * 477 / 8);
+}
+BENCHMARK(BM_BitWriterWriteByteBufferUnaligned)->ArgName("simd")->Arg(0)->Arg(1);
+
+static void BM_BitReaderReadByteBufferUnaligned(benchmark::State& state)
+{
+    uint8_t frame[60];
+    uint8_t buffer[kBitBufferSize];
+
+    for (uint32_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = i * 37;
+    }
+
+    ImsMediaBitReader reader;
+    ImsMediaBitPacker::SetSimdEnabled(state.range(0));
+
+    for (auto _ : state)
+    {
+        reader.SetBuffer(buffer, sizeof(buffer));
+        reader.Read(10);
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            reader.ReadByteBuffer(frame, 477);
+        }
+
+        benchmark::DoNotOptimize(frame);
+    }
+
+    ImsMediaBitPacker::SetSimdEnabled(true);
+    state.SetBytesProcessed(state.iterations() * 16 * 477 / 8);
+}
+BENCHMARK(BM_BitReaderReadByteBufferUnaligned)->ArgName("simd")->Arg(0)->Arg(1);
+
+// The camera resolutions with the scalar and the SIMD tiles
+static void ImageRotateArguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"width", "height", "simd"});
+
+    for (int simd : {0, 1})
+    {
+        benchmark->Args({640, 480, simd})->Args({1280, 720, simd})->Args({1920, 1080, simd});
+    }
+}
+
+// Rotates the camera image of the given width and height in YUV420 semi planar format
+static void BM_ImageRotateYuv420SpRotate90(benchmark::State& state)
+{
+    const uint16_t width = state.range(0);
+    const uint16_t height = state.range(1);
+    const size_t imageSize = width * height * 3 / 2;
+    std::vector<uint8_t> input(imageSize, 0x80);
+    std::vector<uint8_t> output(imageSize);
+    ImsMediaImageRotate::SetSimdEnabled(state.range(2));
+
+    for (auto _ : state)
+    {
+        ImsMediaImageRotate::YUV420_SP_Rotate90(output.data(), output.size(), height,
+                input.data(), input.data() + width * height, width, height);
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaImageRotate::SetSimdEnabled(true);
+    state.SetBytesProcessed(state.iterations() * imageSize);
+}
+BENCHMARK(BM_ImageRotateYuv420SpRotate90)->Apply(ImageRotateArguments);
+
+static void BM_ImageRotateYuv420SpRotate270(benchmark::State& state)
+{
+    const uint16_t width = state.range(0);
+    const uint16_t height = state.range(1);
+    const size_t imageSize = width * height * 3 / 2;
+    std::vector<uint8_t> input(imageSize, 0x80);
+    std::vector<uint8_t> output(imageSize);
+    ImsMediaImageRotate::SetSimdEnabled(state.range(2));
+
+    for (auto _ : state)
+    {
+        ImsMediaImageRotate::YUV420_SP_Rotate270(output.data(), output.size(), height,
+                input.data(), input.data() + width * height, width, height);
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaImageRotate::SetSimdEnabled(true);
+    state.SetBytesProcessed(state.iterations() * imageSize);
+}
+BENCHMARK(BM_ImageRotateYuv420SpRotate270)->Apply(ImageRotateArguments);
+
+static void BM_ImageRotateYuv420SpRotate90Flip(benchmark::State& state)
+{
+    const uint16_t width = state.range(0);
+    const uint16_t height = state.range(1);
+    const size_t imageSize = width * height * 3 / 2;
+    std::vector<uint8_t> input(imageSize, 0x80);
+    std::vector<uint8_t> output(imageSize);
+    ImsMediaImageRotate::SetSimdEnabled(state.range(2));
+
+    for (auto _ : state)
+    {
+        ImsMediaImageRotate::YUV420_SP_Rotate90_Flip(
+                output.data(), input.data(), input.data() + width * height, width, height);
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaImageRotate::SetSimdEnabled(true);
+    state.SetBytesProcessed(state.iterations() * imageSize);
+}
+BENCHMARK(BM_ImageRotateYuv420SpRotate90Flip)->Apply(ImageRotateArguments);
+
+static void BM_ImageRotateYuv420PlanarRotate90Flip(benchmark::State& state)
+{
+    const uint16_t width = state.range(0);
+    const uint16_t height = state.range(1);
+    const size_t imageSize = width * height * 3 / 2;
+    std::vector<uint8_t> input(imageSize, 0x80);
+    std::vector<uint8_t> output(imageSize);
+    ImsMediaImageRotate::SetSimdEnabled(state.range(2));
+
+    for (auto _ : state)
+    {
+        ImsMediaImageRotate::YUV420_Planar_Rotate90_Flip(
+                output.data(), input.data(), width, height);
+        benchmark::ClobberMemory();
+    }
+
+    ImsMediaImageRotate::SetSimdEnabled(true);
+    state.SetBytesProcessed(state.iterations() * imageSize);
+}
+BENCHMARK(BM_ImageRotateYuv420PlanarRotate90Flip)->Apply(ImageRotateArguments);
@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <RtpPacket.h>
+#include <RtcpPacket.h>
+#include <string.h>
+
+extern RtpDt_Void addSdesItem(
+        OUT RtcpConfigInfo* pobjRtcpCfgInfo, IN RtpDt_UChar* sdesName, IN RtpDt_UInt32 uiLength);
+
+namespace
+{
+// rtp packet of the payload type 99 with a one-byte header extension
+const uint8_t kRtpPacket[] = {0x90, 0xe3, 0xa5, 0x83, 0x00, 0x00, 0xe1, 0xc8, 0x92, 0x7d, 0xcd,
+        0x02, 0xbe, 0xde, 0x00, 0x01, 0x41, 0x78, 0x42, 0x00, 0x67, 0x42, 0xc0, 0x0c, 0xda, 0x0f,
+        0x0a, 0x69, 0xa8, 0x10, 0x10, 0x10, 0x3c, 0x58, 0xba, 0x80};
+
+// compound rtcp packet of a sender report and a source description with a cname
+const uint8_t kRtcpSrSdesPacket[] = {0x80, 0xc8, 0x00, 0x06, 0xb1, 0xc8, 0xcb, 0x02, 0xe6, 0x5f,
+        0xa5, 0x31, 0x53, 0x91, 0x24, 0xc2, 0x00, 0x04, 0x01, 0x85, 0x00, 0x00, 0x00, 0x41, 0x00,
+        0x00, 0xc8, 0x53, 0x81, 0xca, 0x00, 0x0a, 0xb1, 0xc8, 0xcb, 0x02, 0x01, 0x1f, 0x32, 0x36,
+        0x30, 0x30, 0x3a, 0x31, 0x30, 0x30, 0x65, 0x3a, 0x31, 0x30, 0x30, 0x38, 0x3a, 0x61, 0x66,
+        0x34, 0x66, 0x3a, 0x3a, 0x31, 0x65, 0x62, 0x65, 0x3a, 0x36, 0x38, 0x35, 0x31, 0x00, 0x00,
+        0x00, 0x00};
+
+const uint32_t kRtcpSrSdesPacketSize = 72;
+const uint32_t kRtpBufferSize = 1500;
+}  // namespace
+
+static void BM_RtpPacketEncode(benchmark::State& state)
+{
+    const uint32_t payloadSize = state.range(0);
+    uint8_t payload[kRtpBufferSize];
+    memset(payload, 0xA5, sizeof(payload));
+    RtpBuffer buffer(RTP_FIXED_HDR_LEN + payloadSize, nullptr);
+    uint16_t seq = 0;
+
+    for (auto _ : state)
+    {
+        RtpPacket packet;
+        RtpHeader* header = packet.getRtpHeader();
+        header->setVersion(RTP_TWO);
+        header->setPayloadType(99);
+        header->setSequenceNumber(seq++);
+        header->setRtpTimestamp(seq * 320);
+        header->setRtpSsrc(0x927dcd02);
+
+        packet.setRtpPayload(new RtpBuffer(payloadSize, payload));
+        buffer.setLength(RTP_FIXED_HDR_LEN + payloadSize);
+        benchmark::DoNotOptimize(packet.formPacket(&buffer));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (RTP_FIXED_HDR_LEN + payloadSize));
+}
+BENCHMARK(BM_RtpPacketEncode)->Arg(32)->Arg(160)->Arg(1200);
+
+static void BM_RtpPacketDecode(benchmark::State& state)
+{
+    uint8_t data[sizeof(kRtpPacket)];
+    memcpy(data, kRtpPacket, sizeof(kRtpPacket));
+
+    // the buffer copies the packet as RtpDecoderNode does for each received packet
+    for (auto _ : state)
+    {
+        RtpPacket packet;
+        RtpBuffer buffer(sizeof(data), data);
+        benchmark::DoNotOptimize(packet.decodePacket(&buffer));
+        benchmark::DoNotOptimize(packet.getRtpPayload());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(kRtpPacket));
+}
+BENCHMARK(BM_RtpPacketDecode);
+
+static void BM_RtcpPacketDecode(benchmark::State& state)
+{
+    uint8_t data[sizeof(kRtcpSrSdesPacket)];
+    memcpy(data, kRtcpSrSdesPacket, sizeof(kRtcpSrSdesPacket));
+    RtpDt_UChar cname[] = "2600:100e:1008:af4f::1ebe:6851";
+    RtcpConfigInfo configInfo;
+    addSdesItem(&configInfo, cname, strlen(reinterpret_cast<char*>(cname)));
+
+    for (auto _ : state)
+    {
+        RtcpPacket packet;
+        RtpBuffer buffer(kRtcpSrSdesPacketSize, data);
+        benchmark::DoNotOptimize(packet.decodeRtcpPacket(&buffer, 0, &configInfo));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * kRtcpSrSdesPacketSize);
+}
+BENCHMARK(BM_RtcpPacketDecode);
+
+static void BM_RtcpPacketForm(benchmark::State& state)
+{
+    uint8_t data[sizeof(kRtcpSrSdesPacket)];
+    memcpy(data, kRtcpSrSdesPacket, sizeof(kRtcpSrSdesPacket));
+    RtpDt_UChar cname[] = "2600:100e:1008:af4f::1ebe:6851";
+    RtcpConfigInfo configInfo;
+    addSdesItem(&configInfo, cname, strlen(reinterpret_cast<char*>(cname)));
+
+    // form the decoded compound packet again
+    RtcpPacket packet;
+    RtpBuffer input(kRtcpSrSdesPacketSize, data);
+
+    if (packet.decodeRtcpPacket(&input, 0, &configInfo) != RTP_SUCCESS)
+    {
+        state.SkipWithError("decode failed");
+        return;
+    }
+
+    RtpBuffer buffer(RTP_DEF_MTU_SIZE, nullptr);
+
+    for (auto _ : state)
+    {
+        buffer.setLength(RTP_DEF_MTU_SIZE);
+        benchmark::DoNotOptimize(packet.formRtcpPacket(&buffer));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RtcpPacketForm);
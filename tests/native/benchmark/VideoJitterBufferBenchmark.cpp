@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <VideoJitterBuffer.h>
+#include <VideoConfig.h>
+
+using namespace android::telephony::imsmedia;
+
+namespace
+{
+const uint32_t kVideoTimestampInterval = 3000;
+const uint32_t kVideoFrameInterval = 33;
+
+// releases the parameters of the events sent by the jitter buffer
+class FakeSessionCallback : public BaseSessionCallback
+{
+public:
+    virtual ~FakeSessionCallback() {}
+
+    virtual void onEvent(int32_t type, uint64_t param1, uint64_t /*param2*/)
+    {
+        switch (type)
+        {
+            case kRequestVideoSendNack:
+            case kRequestVideoSendPictureLost:
+            case kRequestVideoSendTmmbr:
+                delete reinterpret_cast<InternalRequestEventParam*>(param1);
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+/**
+ * Gets the sequence number of the index with the pairs of the packets swapped at every given
+ * period, the period 0 keeps the order
+ */
+uint32_t getReorderedIndex(uint32_t index, uint32_t period)
+{
+    if (period == 0 || (index / 2) % period != 0)
+    {
+        return index;
+    }
+
+    return index ^ 1;
+}
+}  // namespace
+
+// Adds the packets of a frame and gets the frame in every 33ms with the given reordering period
+static void BM_VideoJitterBufferAddGet(benchmark::State& state)
+{
+    const uint32_t period = state.range(0);
+    const uint32_t kPacketsPerFrame = 4;
+    // the first packet of the frame starts with the start code as the payload decoder outputs
+    uint8_t firstPacket[1200] = {0x00, 0x00, 0x00, 0x01, 0x41};
+    uint8_t packet[1200] = {0x5A};
+    FakeSessionCallback callback;
+    VideoJitterBuffer jitterBuffer;
+    jitterBuffer.SetCodecType(VideoConfig::CODEC_AVC);
+    jitterBuffer.SetSessionCallback(&callback);
+    jitterBuffer.SetJitterBufferSize(3, 3, 9);
+    jitterBuffer.SetFramerate(30);
+
+    ImsMediaSubType subtype;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    uint32_t frameIndex = 0;
+    uint64_t countGet = 0;
+
+    for (auto _ : state)
+    {
+        uint32_t currentTime = frameIndex * kVideoFrameInterval;
+
+        for (uint32_t i = 0; i < kPacketsPerFrame; i++)
+        {
+            uint32_t packetIndex =
+                    getReorderedIndex(frameIndex * kPacketsPerFrame + i, period);
+            uint32_t packetFrame = packetIndex / kPacketsPerFrame;
+            uint32_t packetPosition = packetIndex % kPacketsPerFrame;
+            jitterBuffer.Add(MEDIASUBTYPE_UNDEFINED, packetPosition == 0 ? firstPacket : packet,
+                    sizeof(packet), packetFrame * kVideoTimestampInterval,
+                    packetPosition == kPacketsPerFrame - 1, packetIndex & 0xFFFF,
+                    MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, currentTime);
+        }
+
+        while (jitterBuffer.Get(&subtype, &data, &size, &timestamp, &mark, &seq, currentTime))
+        {
+            jitterBuffer.Delete();
+            countGet++;
+        }
+
+        frameIndex++;
+    }
+
+    state.SetItemsProcessed(state.iterations() * kPacketsPerFrame);
+    state.counters["delivered"] = benchmark::Counter(
+            static_cast<double>(countGet) / (state.iterations() * kPacketsPerFrame));
+}
+BENCHMARK(BM_VideoJitterBufferAddGet)->ArgName("reorder")->Arg(0)->Arg(8)->Arg(2);
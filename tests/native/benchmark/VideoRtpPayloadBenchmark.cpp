@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <benchmark/benchmark.h>
+#include <VideoConfig.h>
+#include <VideoRtpPayloadEncoderNode.h>
+#include <ImsMediaNalUnitSplitter.h>
+#include <string.h>
+#include <vector>
+
+using namespace android::telephony::imsmedia;
+
+namespace
+{
+const uint32_t kMtu = 1300;
+
+// counts the rtp payloads of the fragmented access unit
+class FakeNode : public BaseNode
+{
+public:
+    FakeNode() :
+            BaseNode(nullptr),
+            mCount(0)
+    {
+    }
+    virtual ~FakeNode() {}
+    virtual ImsMediaResult Start() { return RESULT_SUCCESS; }
+    virtual void Stop() {}
+    virtual bool IsRunTime() { return true; }
+    virtual bool IsSourceNode() { return false; }
+    virtual void SetConfig(void* config) { (void)config; }
+    virtual void OnDataFromFrontNode(ImsMediaSubType /*subtype*/, uint8_t* data, uint32_t size,
+            uint32_t /*timestamp*/, bool /*mark*/, uint32_t /*seq*/,
+            ImsMediaSubType /*dataType*/, uint32_t /*arrivalTime*/)
+    {
+        benchmark::DoNotOptimize(data);
+        mCount += size > 0 ? 1 : 0;
+    }
+    virtual kBaseNodeState GetState() { return kNodeStateRunning; }
+
+    uint64_t GetCount() { return mCount; }
+
+private:
+    uint64_t mCount;
+};
+
+/**
+ * Builds an access unit of a non-IDR slice with the start code. The payload does not contain
+ * the start code pattern.
+ */
+std::vector<uint8_t> buildAccessUnit(int32_t codecType, uint32_t size)
+{
+    std::vector<uint8_t> frame(size, 0x5A);
+    frame[0] = 0x00;
+    frame[1] = 0x00;
+    frame[2] = 0x00;
+    frame[3] = 0x01;
+
+    if (codecType == VideoConfig::CODEC_AVC)
+    {
+        frame[4] = 0x41;  // nal_ref_idc 2, coded slice of a non-IDR picture
+    }
+    else
+    {
+        frame[4] = 0x02;  // TRAIL_R
+        frame[5] = 0x01;
+    }
+
+    return frame;
+}
+
+/**
+ * Builds an access unit of the sps, pps and the slices of the given size. The slice data is the
+ * pseudo random bytes which have zero bytes as the entropy coded data does.
+ */
+std::vector<uint8_t> buildMultiSliceAccessUnit(uint32_t size, uint32_t slices)
+{
+    const uint8_t kConfig[] = {0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0xC0, 0x0C, 0x00, 0x00, 0x01,
+            0x68, 0xCE, 0x3C, 0x80};
+    std::vector<uint8_t> frame(kConfig, kConfig + sizeof(kConfig));
+    uint32_t seed = 1;
+
+    for (uint32_t i = 0; i < slices; i++)
+    {
+        const uint8_t kSliceHeader[] = {0x00, 0x00, 0x01, 0x65};
+        frame.insert(frame.end(), kSliceHeader, kSliceHeader + sizeof(kSliceHeader));
+
+        for (uint32_t j = 0; j < size / slices; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            uint8_t value = seed >> 16;
+            // avoid the start code emulation in the slice data
+            frame.push_back(value <= 0x03 ? 0x04 : value);
+        }
+    }
+
+    return frame;
+}
+}  // namespace
+
+// Splits the access unit to the single nal unit or the fragmentation units of the mtu
+static void BM_VideoRtpPayloadEncode(benchmark::State& state)
+{
+    int32_t codecType = state.range(0);
+    uint32_t frameSize = state.range(1);
+    std::vector<uint8_t> frame = buildAccessUnit(codecType, frameSize);
+
+    VideoConfig config;
+    config.setCodecType(codecType);
+    config.setPacketizationMode(VideoConfig::MODE_NON_INTERLEAVED);
+    config.setMaxMtuBytes(kMtu);
+
+    VideoRtpPayloadEncoderNode encoder;
+    FakeNode sink;
+    encoder.SetMediaType(IMS_MEDIA_VIDEO);
+    encoder.SetConfig(&config);
+    encoder.ConnectRearNode(&sink);
+
+    if (encoder.Start() != RESULT_SUCCESS)
+    {
+        state.SkipWithError("start failed");
+        return;
+    }
+
+    uint32_t timestamp = 0;
+
+    for (auto _ : state)
+    {
+        encoder.OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, frame.data(), frame.size(), timestamp,
+                true, 0, MEDIASUBTYPE_UNDEFINED, 0);
+        timestamp += 3000;
+    }
+
+    encoder.Stop();
+    encoder.DisconnectNodes();
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * frameSize);
+    state.counters["packets"] = benchmark::Counter(
+            static_cast<double>(sink.GetCount()) / state.iterations());
+}
+BENCHMARK(BM_VideoRtpPayloadEncode)
+        ->ArgNames({"codec", "size"})
+        ->ArgsProduct({{VideoConfig::CODEC_AVC, VideoConfig::CODEC_HEVC}, {1000, 10000, 60000}});
+
+// Finds all the nal unit boundaries of the access unit
+static void BM_NalUnitSplit(benchmark::State& state)
+{
+    uint32_t frameSize = state.range(0);
+    uint32_t slices = state.range(1);
+    std::vector<uint8_t> frame = buildMultiSliceAccessUnit(frameSize, slices);
+    ImsMediaNalUnit units[16];
+
+    for (auto _ : state)
+    {
+        uint32_t count = ImsMediaNalUnitSplitter::Split(frame.data(), frame.size(), units, 16);
+        benchmark::DoNotOptimize(count);
+        benchmark::DoNotOptimize(units);
+    }
+
+    state.SetBytesProcessed(state.iterations() * frame.size());
+}
+BENCHMARK(BM_NalUnitSplit)->ArgNames({"size", "slices"})->ArgsProduct({{10000, 60000}, {1, 4}});
@@ -0,0 +1,509 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <AudioManager.h>
+#include <ImsMediaCondition.h>
+#include <ImsMediaFakeAudioFrame.h>
+#include <ImsMediaNetworkUtil.h>
+#include <ImsMediaQuantileSketch.h>
+#include <ImsMediaTimer.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+using namespace android::telephony::imsmedia;
+
+#define LOAD_LOCAL_ADDRESS       "127.0.0.1"
+#define LOAD_RESPONSE_TIMEOUT_MS 3000
+#define LOAD_MAX_SESSIONS        512
+// the latency is counted in the sketch in the unit of 100 microseconds
+#define LOAD_LATENCY_UNIT_US 100
+
+/**
+ * The load generator of the audio sessions. It opens the sessions through the AudioManager in
+ * pairs sending to each other over the localhost udp sockets, with the fake audio source and
+ * player of libimsmedia_fake_audio_codec generating and consuming the AMR-WB frames, and reports
+ * the cost and the quality of the calls for each number of the concurrent sessions given.
+ *
+ * Usage: ImsMediaAudioLoadTest [--sessions=1,2,4,8] [--duration=10] [--warmup=2] [--mode=8]
+ *        [--port=40000]
+ */
+
+static std::atomic<uint64_t> gAllocations(0);
+
+// count the heap allocations of the whole process
+void* operator new(size_t size)
+{
+    gAllocations++;
+    void* p = malloc(size == 0 ? 1 : size);
+
+    if (p == nullptr)
+    {
+        abort();
+    }
+
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void* p, size_t /*size*/) noexcept
+{
+    operator delete(p);
+}
+
+struct LoadOption
+{
+    std::vector<int32_t> sessions;
+    int32_t durationSec;
+    int32_t warmupSec;
+    int32_t amrWbMode;
+    int32_t basePort;
+};
+
+struct LoadResult
+{
+    double cpuPercentPerSession;
+    int32_t threads;
+    double allocationsPerSec;
+    uint64_t framesGenerated;
+    uint64_t framesPlayed;
+    double lossPercent;
+    double missedPerSec;
+    ImsMediaQuantileSketch latency;
+};
+
+class LoadFrameListener : public IFakeAudioFrameListener
+{
+public:
+    LoadFrameListener() :
+            mMeasuring(false),
+            mMissed(0)
+    {
+    }
+
+    virtual ~LoadFrameListener() {}
+
+    virtual void onFrameGenerated(const FakeAudioFrameInfo& info)
+    {
+        if (!mMeasuring)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStreams[info.sourceId].generated++;
+    }
+
+    virtual void onFramePlayed(const FakeAudioFrameInfo& info)
+    {
+        if (!mMeasuring)
+        {
+            return;
+        }
+
+        uint64_t latencyUs = ImsMediaTimer::GetTimeInMicroSeconds() - info.timeUs;
+        std::lock_guard<std::mutex> guard(mMutex);
+        StreamStats& stream = mStreams[info.sourceId];
+
+        if (stream.played == 0)
+        {
+            stream.firstSequence = info.sequence;
+        }
+
+        stream.lastSequence = info.sequence;
+        stream.played++;
+        stream.latency.Add(latencyUs / LOAD_LATENCY_UNIT_US);
+    }
+
+    virtual void onFrameMissed()
+    {
+        if (mMeasuring)
+        {
+            mMissed++;
+        }
+    }
+
+    void Start()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStreams.clear();
+        mMissed = 0;
+        mMeasuring = true;
+    }
+
+    void Stop() { mMeasuring = false; }
+
+    void Collect(LoadResult& result)
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        uint64_t expected = 0;
+        result.framesGenerated = 0;
+        result.framesPlayed = 0;
+        result.latency.Reset();
+
+        for (auto& stream : mStreams)
+        {
+            result.framesGenerated += stream.second.generated;
+            result.framesPlayed += stream.second.played;
+            result.latency.Merge(stream.second.latency);
+
+            if (stream.second.played > 0)
+            {
+                expected += stream.second.lastSequence - stream.second.firstSequence + 1;
+            }
+        }
+
+        result.lossPercent = expected == 0
+                ? 0
+                : 100.0 * (expected - std::min(expected, result.framesPlayed)) / expected;
+        result.missedPerSec = mMissed;
+    }
+
+private:
+    struct StreamStats
+    {
+        StreamStats() :
+                generated(0),
+                played(0),
+                firstSequence(0),
+                lastSequence(0)
+        {
+        }
+
+        uint64_t generated;
+        uint64_t played;
+        uint32_t firstSequence;
+        uint32_t lastSequence;
+        ImsMediaQuantileSketch latency;
+    };
+
+    std::atomic<bool> mMeasuring;
+    std::atomic<uint64_t> mMissed;
+    std::mutex mMutex;
+    std::unordered_map<uint32_t, StreamStats> mStreams;
+};
+
+static ImsMediaCondition gCondition;
+static std::atomic<int32_t> gResponse(-1);
+
+static int onResponse(int /*sessionId*/, const android::Parcel& parcel)
+{
+    parcel.setDataPosition(0);
+    int32_t response = parcel.readInt32();
+
+    if (response == kAudioOpenSessionSuccess || response == kAudioOpenSessionFailure ||
+            response == kAudioSessionClosed)
+    {
+        gResponse = response;
+        gCondition.signal();
+    }
+
+    return 0;
+}
+
+static bool sendAndWait(int32_t sessionId, android::Parcel& parcel, int32_t expected)
+{
+    gResponse = -1;
+    gCondition.reset();
+    parcel.setDataPosition(0);
+    AudioManager::getInstance()->sendMessage(sessionId, parcel);
+
+    if (gCondition.wait_timeout(LOAD_RESPONSE_TIMEOUT_MS) || gResponse != expected)
+    {
+        fprintf(stderr, "session[%d] response[%d], expected[%d]\n", sessionId,
+                gResponse.load(), expected);
+        return false;
+    }
+
+    return true;
+}
+
+static AudioConfig createConfig(const LoadOption& option, int32_t remotePort)
+{
+    RtcpConfig rtcp;
+    rtcp.setCanonicalName(android::String8("load"));
+    rtcp.setTransmitPort(remotePort + 1);
+    rtcp.setIntervalSec(5);
+    rtcp.setRtcpXrBlockTypes(RtcpConfig::FLAG_RTCPXR_NONE);
+
+    AmrParams amr;
+    amr.setAmrMode(1 << option.amrWbMode);
+    amr.setOctetAligned(false);
+    amr.setMaxRedundancyMillis(0);
+
+    AudioConfig config;
+    config.setMediaDirection(RtpConfig::MEDIA_DIRECTION_SEND_RECEIVE);
+    config.setRemoteAddress(android::String8(LOAD_LOCAL_ADDRESS));
+    config.setRemotePort(remotePort);
+    config.setRtcpConfig(rtcp);
+    config.setDscp(0);
+    config.setRxPayloadTypeNumber(96);
+    config.setTxPayloadTypeNumber(96);
+    config.setSamplingRateKHz(16);
+    config.setPtimeMillis(20);
+    config.setMaxPtimeMillis(240);
+    config.setDtxEnabled(false);
+    config.setCodecType(AudioConfig::CODEC_AMR_WB);
+    config.setTxDtmfPayloadTypeNumber(100);
+    config.setRxDtmfPayloadTypeNumber(101);
+    config.setDtmfsamplingRateKHz(16);
+    config.setAmrParams(amr);
+    return config;
+}
+
+static int32_t getThreadCount()
+{
+    int32_t count = 0;
+    DIR* dir = opendir("/proc/self/task");
+
+    if (dir == nullptr)
+    {
+        return 0;
+    }
+
+    while (struct dirent* entry = readdir(dir))
+    {
+        if (entry->d_name[0] != '.')
+        {
+            count++;
+        }
+    }
+
+    closedir(dir);
+    return count;
+}
+
+static uint64_t getCpuTimeUs()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL +
+            usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+static bool runLoad(const LoadOption& option, int32_t numSessions, LoadFrameListener& listener,
+        LoadResult& result)
+{
+    std::vector<int> rtpFds(numSessions, -1);
+    std::vector<int> rtcpFds(numSessions, -1);
+    int32_t numOpened = 0;
+    bool success = true;
+
+    for (int32_t i = 0; i < numSessions && success; i++)
+    {
+        rtpFds[i] = ImsMediaNetworkUtil::openSocket(
+                LOAD_LOCAL_ADDRESS, option.basePort + i * 2, AF_INET);
+        rtcpFds[i] = ImsMediaNetworkUtil::openSocket(
+                LOAD_LOCAL_ADDRESS, option.basePort + i * 2 + 1, AF_INET);
+        success = rtpFds[i] != -1 && rtcpFds[i] != -1;
+    }
+
+    // the sessions send to each other in pairs and the last one of the odd number sends to itself
+    for (int32_t i = 0; i < numSessions && success; i++)
+    {
+        int32_t peer = (i ^ 1) < numSessions ? (i ^ 1) : i;
+        AudioConfig config = createConfig(option, option.basePort + peer * 2);
+        android::Parcel parcel;
+        parcel.writeInt32(kAudioOpenSession);
+        parcel.writeInt32(rtpFds[i]);
+        parcel.writeInt32(rtcpFds[i]);
+        config.writeToParcel(&parcel);
+        success = sendAndWait(i, parcel, kAudioOpenSessionSuccess);
+
+        if (success)
+        {
+            numOpened++;
+        }
+    }
+
+    if (success)
+    {
+        ImsMediaTimer::Sleep(option.warmupSec * 1000);
+
+        uint64_t startTime = ImsMediaTimer::GetTimeInMicroSeconds();
+        uint64_t startCpu = getCpuTimeUs();
+        uint64_t startAllocations = gAllocations;
+        listener.Start();
+
+        ImsMediaTimer::Sleep(option.durationSec * 1000);
+        result.threads = getThreadCount();
+
+        listener.Stop();
+        double elapsedSec = (ImsMediaTimer::GetTimeInMicroSeconds() - startTime) / 1000000.0;
+        result.cpuPercentPerSession =
+                100.0 * (getCpuTimeUs() - startCpu) / 1000000.0 / elapsedSec / numSessions;
+        result.allocationsPerSec = (gAllocations - startAllocations) / elapsedSec;
+        listener.Collect(result);
+        result.missedPerSec /= elapsedSec;
+    }
+
+    for (int32_t i = 0; i < numOpened; i++)
+    {
+        android::Parcel parcel;
+        parcel.writeInt32(kAudioCloseSession);
+        sendAndWait(i, parcel, kAudioSessionClosed);
+    }
+
+    for (int32_t i = 0; i < numSessions; i++)
+    {
+        if (rtpFds[i] != -1)
+        {
+            ImsMediaNetworkUtil::closeSocket(rtpFds[i]);
+        }
+
+        if (rtcpFds[i] != -1)
+        {
+            ImsMediaNetworkUtil::closeSocket(rtcpFds[i]);
+        }
+    }
+
+    return success;
+}
+
+static bool parseOption(int argc, char** argv, LoadOption& option)
+{
+    option.sessions = {1, 2, 4, 8};
+    option.durationSec = 10;
+    option.warmupSec = 2;
+    option.amrWbMode = 8;
+    option.basePort = 40000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* value = strchr(argv[i], '=');
+
+        if (value == nullptr)
+        {
+            return false;
+        }
+
+        value++;
+
+        if (strncmp(argv[i], "--sessions=", 11) == 0)
+        {
+            option.sessions.clear();
+
+            for (char* next = const_cast<char*>(value); *next != '\0';)
+            {
+                int32_t sessions = strtol(next, &next, 10);
+
+                if (sessions <= 0 || sessions > LOAD_MAX_SESSIONS)
+                {
+                    return false;
+                }
+
+                option.sessions.push_back(sessions);
+                next += (*next == ',') ? 1 : 0;
+            }
+        }
+        else if (strncmp(argv[i], "--duration=", 11) == 0)
+        {
+            option.durationSec = atoi(value);
+        }
+        else if (strncmp(argv[i], "--warmup=", 9) == 0)
+        {
+            option.warmupSec = atoi(value);
+        }
+        else if (strncmp(argv[i], "--mode=", 7) == 0)
+        {
+            option.amrWbMode = atoi(value);
+        }
+        else if (strncmp(argv[i], "--port=", 7) == 0)
+        {
+            option.basePort = atoi(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return !option.sessions.empty() && option.durationSec > 0 && option.warmupSec >= 0 &&
+            option.amrWbMode >= 0 && option.amrWbMode <= 8 &&
+            option.basePort > 0 && option.basePort < 65536 - LOAD_MAX_SESSIONS * 2;
+}
+
+int main(int argc, char** argv)
+{
+    LoadOption option;
+
+    if (!parseOption(argc, argv, option))
+    {
+        fprintf(stderr,
+                "usage: %s [--sessions=1,2,4,8] [--duration=10] [--warmup=2] [--mode=8] "
+                "[--port=40000]\n",
+                argv[0]);
+        return 1;
+    }
+
+    LoadFrameListener listener;
+    ImsMediaFakeAudioFrame::SetListener(&listener);
+    AudioManager::getInstance()->setCallback(&onResponse);
+
+    printf("%8s %10s %8s %10s %10s %8s %8s %8s %8s %8s %8s\n", "sessions", "cpu/ses(%)",
+            "threads", "allocs/s", "played", "loss(%)", "missed/s", "p50(ms)", "p90(ms)",
+            "p99(ms)", "max(ms)");
+
+    for (int32_t sessions : option.sessions)
+    {
+        LoadResult result;
+
+        if (!runLoad(option, sessions, listener, result))
+        {
+            fprintf(stderr, "failed to run %d sessions\n", sessions);
+            ImsMediaFakeAudioFrame::SetListener(nullptr);
+            return 1;
+        }
+
+        const double unitMs = LOAD_LATENCY_UNIT_US / 1000.0;
+        printf("%8d %10.2f %8d %10.0f %10llu %8.2f %8.1f %8.1f %8.1f %8.1f %8.1f\n", sessions,
+                result.cpuPercentPerSession, result.threads, result.allocationsPerSec,
+                static_cast<unsigned long long>(result.framesPlayed), result.lossPercent,
+                result.missedPerSec, result.latency.GetPercentile(50) * unitMs,
+                result.latency.GetPercentile(90) * unitMs,
+                result.latency.GetPercentile(99) * unitMs, result.latency.GetMax() * unitMs);
+        fflush(stdout);
+    }
+
+    ImsMediaFakeAudioFrame::SetListener(nullptr);
+    return 0;
+}
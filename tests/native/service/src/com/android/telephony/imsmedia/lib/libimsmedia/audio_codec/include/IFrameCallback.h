@@ -0,0 +1,27 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IFRAME_CALLBACK_INCLUDED
+#define IFRAME_CALLBACK_INCLUDED
+
+class IFrameCallback
+{
+public:
+    IFrameCallback() {}
+    virtual ~IFrameCallback() {}
+    virtual void onDataFrame(uint8_t* buffer, uint32_t size, int64_t timestamp, uint32_t flag) = 0;
+};
+#endif
\ No newline at end of file
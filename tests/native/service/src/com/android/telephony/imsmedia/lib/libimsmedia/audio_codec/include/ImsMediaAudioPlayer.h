@@ -19,6 +19,19 @@
 
 #include <stdint.h>
 
+enum FrameType : uint8_t
+{
+    SPEECH = 0,
+    SID,
+    LOST,
+    NO_DATA
+};
+
+/**
+ * @brief The fake audio player of the tests. It does not play any audio, but passes the
+ * FakeAudioFrameInfo of the speech frames generated by the fake ImsMediaAudioSource to the frame
+ * listener set by ImsMediaFakeAudioFrame::SetListener().
+ */
 class ImsMediaAudioPlayer
 {
 public:
@@ -119,10 +132,14 @@ public:
      *
      * @param buffer The audio frames to decode and play
      * @param size The size of encoded audio frame
+     * @param frameType The type of the frame, SPEECH, SID, LOST or NO_DATA
+     * @param hasNextFrame Whether the next frame is available to conceal the lost frame
+     * @param nextFrameByte The first byte of the next frame
      * @return true
      * @return false
      */
-    bool onDataFrame(uint8_t* buffer, uint32_t size, bool isSid);
+    virtual bool onDataFrame(uint8_t* buffer, uint32_t size, FrameType frameType, bool hasNextFrame,
+            uint8_t nextFrameByte);
 };
 
 #endif
@@ -17,17 +17,18 @@
 #ifndef IMSMEDIA_AUDIO_SOURCE_INCLUDED
 #define IMSMEDIA_AUDIO_SOURCE_INCLUDED
 
+#include <IImsMediaThread.h>
+#include <ImsMediaCondition.h>
+#include <IFrameCallback.h>
 #include <stdint.h>
 
-class IFrameCallback
-{
-public:
-    IFrameCallback() {}
-    virtual ~IFrameCallback() {}
-    virtual void onDataFrame(uint8_t* buffer, uint32_t size, int64_t timestamp, uint32_t flag) = 0;
-};
-
-class ImsMediaAudioSource
+/**
+ * @brief The fake audio source of the tests. It does not capture any audio, but when the frame
+ * listener is set by ImsMediaFakeAudioFrame::SetListener(), it generates the AMR and AMR-WB frames
+ * of the configured mode every ptime with the FakeAudioFrameInfo written at the beginning of the
+ * frame data.
+ */
+class ImsMediaAudioSource : public IImsMediaThread
 {
 public:
     ImsMediaAudioSource();
@@ -113,18 +114,14 @@ public:
     void SetOctetAligned(bool isOctetAligned);
 
     /**
-     * @brief Starts aaudio and ndk audio codec to get the audio frame and encode the audio frames
-     * with given configuration
+     * @brief Starts the thread to generate the frames when the frame listener is set
      *
-     * @return true Returns when the audio codec and aaduio starts without error
-     * @return false Returns when the audio codec and aaudio configuration is invalid during the
-     * start
+     * @return true Always returns true
      */
     bool Start();
 
     /**
-     * @brief Stops the audio encoder and aaudio
-     *
+     * @brief Stops the thread generating the frames
      */
     void Stop();
 
@@ -134,6 +131,20 @@ public:
      * @param cmr The codec mode request value
      */
     void ProcessCmr(const uint32_t cmr);
+
+protected:
+    virtual void* run();
+
+private:
+    uint32_t getFrameSize();
+
+    IFrameCallback* mCallback;
+    int32_t mCodecType;
+    uint32_t mMode;
+    uint32_t mPtime;
+    uint32_t mSourceId;
+    uint32_t mSequence;
+    ImsMediaCondition mConditionExit;
 };
 
 #endif
@@ -0,0 +1,78 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMSMEDIA_FAKE_AUDIO_FRAME_INCLUDED
+#define IMSMEDIA_FAKE_AUDIO_FRAME_INCLUDED
+
+#include <stdint.h>
+
+/**
+ * @brief The information the fake audio source writes at the beginning of the frame data and the
+ * fake audio player reads back, to trace each frame through the audio session
+ */
+struct FakeAudioFrameInfo
+{
+    /** The unique identifier of the fake audio source in the process, starting from 1 */
+    uint32_t sourceId;
+    /** The sequence number of the frame in the source, starting from 0 */
+    uint32_t sequence;
+    /** The time the frame is generated in microseconds of ImsMediaTimer */
+    uint64_t timeUs;
+};
+
+class IFakeAudioFrameListener
+{
+public:
+    IFakeAudioFrameListener() {}
+    virtual ~IFakeAudioFrameListener() {}
+
+    /**
+     * @brief Called in the thread of the fake audio source when a frame is generated
+     */
+    virtual void onFrameGenerated(const FakeAudioFrameInfo& info) = 0;
+
+    /**
+     * @brief Called in the thread of the audio player node when a speech frame generated by a fake
+     * audio source is played
+     */
+    virtual void onFramePlayed(const FakeAudioFrameInfo& info) = 0;
+
+    /**
+     * @brief Called in the thread of the audio player node when the player has no frame to play
+     * in the ptime or plays the lost frame
+     */
+    virtual void onFrameMissed() = 0;
+};
+
+class ImsMediaFakeAudioFrame
+{
+public:
+    /**
+     * @brief Set the listener of the frames of all the fake audio sources and players. The fake
+     * sources generate the frames only when the listener is set before they start.
+     *
+     * @param listener The listener, nullptr to stop the frame generation of the next sources
+     */
+    static void SetListener(IFakeAudioFrameListener* listener);
+    static IFakeAudioFrameListener* GetListener();
+
+    /**
+     * @brief Get the unique identifier of a new fake audio source
+     */
+    static uint32_t GetNextSourceId();
+};
+
+#endif
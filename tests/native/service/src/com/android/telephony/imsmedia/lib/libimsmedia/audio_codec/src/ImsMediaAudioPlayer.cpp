@@ -15,6 +15,8 @@
  */
 
 #include <ImsMediaAudioPlayer.h>
+#include <ImsMediaFakeAudioFrame.h>
+#include <string.h>
 
 ImsMediaAudioPlayer::ImsMediaAudioPlayer() {}
 
@@ -47,7 +49,31 @@ bool ImsMediaAudioPlayer::Start()
 
 void ImsMediaAudioPlayer::Stop() {}
 
-bool ImsMediaAudioPlayer::onDataFrame(uint8_t* /*buffer*/, uint32_t /*size*/, bool /*isSid*/)
+bool ImsMediaAudioPlayer::onDataFrame(uint8_t* buffer, uint32_t size, FrameType frameType,
+        bool /*hasNextFrame*/, uint8_t /*nextFrameByte*/)
 {
+    IFakeAudioFrameListener* listener = ImsMediaFakeAudioFrame::GetListener();
+
+    if (listener == nullptr)
+    {
+        return true;
+    }
+
+    // skip the toc of the storage format
+    if (frameType == SPEECH && buffer != nullptr && size > sizeof(FakeAudioFrameInfo))
+    {
+        FakeAudioFrameInfo info;
+        memcpy(&info, buffer + 1, sizeof(info));
+
+        if (info.sourceId != 0)
+        {
+            listener->onFramePlayed(info);
+        }
+    }
+    else if (frameType == LOST || frameType == NO_DATA)
+    {
+        listener->onFrameMissed();
+    }
+
     return true;
 }
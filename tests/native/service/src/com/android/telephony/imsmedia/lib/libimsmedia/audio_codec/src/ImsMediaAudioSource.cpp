@@ -15,20 +15,48 @@
  */
 
 #include <ImsMediaAudioSource.h>
+#include <ImsMediaFakeAudioFrame.h>
+#include <ImsMediaAudioUtil.h>
+#include <ImsMediaDefine.h>
+#include <ImsMediaTimer.h>
+#include <string.h>
 
-ImsMediaAudioSource::ImsMediaAudioSource() {}
+#define FAKE_FRAME_BUFFER_SIZE 64
+#define FAKE_STOP_TIMEOUT      1000
+
+ImsMediaAudioSource::ImsMediaAudioSource()
+{
+    mCallback = nullptr;
+    mCodecType = kAudioCodecNone;
+    mMode = 0;
+    mPtime = 20;
+    mSourceId = ImsMediaFakeAudioFrame::GetNextSourceId();
+    mSequence = 0;
+}
 
 ImsMediaAudioSource::~ImsMediaAudioSource() {}
 
-void ImsMediaAudioSource::SetUplinkCallback(IFrameCallback* /*callback*/) {}
+void ImsMediaAudioSource::SetUplinkCallback(IFrameCallback* callback)
+{
+    mCallback = callback;
+}
 
-void ImsMediaAudioSource::SetCodec(int32_t /* type*/) {}
+void ImsMediaAudioSource::SetCodec(int32_t type)
+{
+    mCodecType = type;
+}
 
-void ImsMediaAudioSource::SetCodecMode(uint32_t /* mode*/) {}
+void ImsMediaAudioSource::SetCodecMode(uint32_t mode)
+{
+    mMode = mode;
+}
 
 void ImsMediaAudioSource::SetEvsBitRate(uint32_t /* mode*/) {}
 
-void ImsMediaAudioSource::SetPtime(uint32_t /* time*/) {}
+void ImsMediaAudioSource::SetPtime(uint32_t time)
+{
+    mPtime = time;
+}
 
 void ImsMediaAudioSource::SetEvsBandwidth(int32_t /* evsBandwidth*/) {}
 
@@ -44,8 +72,91 @@ void ImsMediaAudioSource::SetOctetAligned(bool /*isOctetAligned*/) {}
 
 bool ImsMediaAudioSource::Start()
 {
+    if (ImsMediaFakeAudioFrame::GetListener() != nullptr && mCallback != nullptr &&
+            mPtime > 0 && getFrameSize() > 0)
+    {
+        StartThread();
+    }
+
     return true;
 }
-void ImsMediaAudioSource::Stop() {}
 
-void ImsMediaAudioSource::ProcessCmr(const uint32_t /* cmr*/) {}
\ No newline at end of file
+void ImsMediaAudioSource::Stop()
+{
+    if (!IsThreadStopped())
+    {
+        mConditionExit.reset();
+        StopThread();
+        mConditionExit.wait_timeout(FAKE_STOP_TIMEOUT);
+    }
+}
+
+void ImsMediaAudioSource::ProcessCmr(const uint32_t cmr)
+{
+    mMode = cmr;
+}
+
+void* ImsMediaAudioSource::run()
+{
+    uint8_t buffer[FAKE_FRAME_BUFFER_SIZE];
+    uint64_t nextTime = ImsMediaTimer::GetTimeInMicroSeconds();
+
+    for (;;)
+    {
+        if (IsThreadStopped())
+        {
+            break;
+        }
+
+        IFakeAudioFrameListener* listener = ImsMediaFakeAudioFrame::GetListener();
+        uint32_t size = getFrameSize();
+
+        if (size > 0)
+        {
+            // the toc of the storage format, the frame type and the quality bit
+            buffer[0] = (mMode << 3) | 0x04;
+            memset(buffer + 1, 0, size);
+
+            FakeAudioFrameInfo info = {mSourceId, mSequence++, nextTime};
+
+            if (size >= sizeof(info))
+            {
+                memcpy(buffer + 1, &info, sizeof(info));
+            }
+
+            if (listener != nullptr)
+            {
+                listener->onFrameGenerated(info);
+            }
+
+            mCallback->onDataFrame(buffer, size + 1, nextTime, 0);
+        }
+
+        nextTime += mPtime * 1000;
+        uint64_t currTime = ImsMediaTimer::GetTimeInMicroSeconds();
+
+        if (nextTime > currTime)
+        {
+            ImsMediaTimer::USleep(nextTime - currTime);
+        }
+    }
+
+    mConditionExit.signal();
+    return nullptr;
+}
+
+uint32_t ImsMediaAudioSource::getFrameSize()
+{
+    uint32_t size = 0;
+
+    if (mCodecType == kAudioCodecAmr)
+    {
+        size = ImsMediaAudioUtil::ConvertAmrModeToLen(mMode);
+    }
+    else if (mCodecType == kAudioCodecAmrWb)
+    {
+        size = ImsMediaAudioUtil::ConvertAmrWbModeToLen(mMode);
+    }
+
+    return size < FAKE_FRAME_BUFFER_SIZE ? size : 0;
+}
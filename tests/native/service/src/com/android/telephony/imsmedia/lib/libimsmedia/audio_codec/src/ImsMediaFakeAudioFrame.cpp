@@ -0,0 +1,36 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ImsMediaFakeAudioFrame.h>
+#include <atomic>
+
+static std::atomic<IFakeAudioFrameListener*> gListener(nullptr);
+static std::atomic<uint32_t> gNextSourceId(1);
+
+void ImsMediaFakeAudioFrame::SetListener(IFakeAudioFrameListener* listener)
+{
+    gListener = listener;
+}
+
+IFakeAudioFrameListener* ImsMediaFakeAudioFrame::GetListener()
+{
+    return gListener;
+}
+
+uint32_t ImsMediaFakeAudioFrame::GetNextSourceId()
+{
+    return gNextSourceId++;
+}
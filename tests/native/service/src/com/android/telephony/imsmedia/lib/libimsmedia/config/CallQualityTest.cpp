@@ -171,3 +171,25 @@ TEST_F(CallQualityTest, TestNotEqual)
     quality3.setNumRtpDuplicatePackets(kNumRtpDuplicatePackets);
     EXPECT_NE(quality3, quality1);
 }
+
+TEST_F(CallQualityTest, TestPercentiles)
+{
+    quality1.setPlayoutDelayPercentileMillis(CallQuality::kPercentile50, 60);
+    quality1.setPlayoutDelayPercentileMillis(CallQuality::kPercentile99, 180);
+    quality1.setRelativeJitterPercentileMillis(CallQuality::kPercentile95, 12);
+    quality1.setInterArrivalTimePercentileMillis(CallQuality::kPercentile50, 20);
+    quality1.setInterArrivalTimePercentileMillis(CallQuality::kPercentileMax, 1);
+
+    EXPECT_EQ(quality1.getPlayoutDelayPercentileMillis(CallQuality::kPercentile50), 60);
+    EXPECT_EQ(quality1.getPlayoutDelayPercentileMillis(CallQuality::kPercentile95), 0);
+    EXPECT_EQ(quality1.getPlayoutDelayPercentileMillis(CallQuality::kPercentile99), 180);
+    EXPECT_EQ(quality1.getRelativeJitterPercentileMillis(CallQuality::kPercentile95), 12);
+    EXPECT_EQ(quality1.getInterArrivalTimePercentileMillis(CallQuality::kPercentile50), 20);
+    EXPECT_EQ(quality1.getInterArrivalTimePercentileMillis(CallQuality::kPercentileMax), 0);
+
+    CallQuality testQuality = quality1;
+    EXPECT_EQ(testQuality, quality1);
+
+    testQuality.setRelativeJitterPercentileMillis(CallQuality::kPercentile95, 13);
+    EXPECT_NE(testQuality, quality1);
+}
@@ -0,0 +1,149 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <RtpHeaderExtensionBlock.h>
+
+class RtpHeaderExtensionBlockTest : public ::testing::Test
+{
+public:
+    RtpHeaderExtensionBlock block;
+};
+
+TEST_F(RtpHeaderExtensionBlockTest, TestParseOneByteHeader)
+{
+    // id 1 with 1 byte, padding, id 2 with 2 bytes, padding to the word
+    const uint8_t kPayload[] = {0x10, 0xAA, 0x00, 0x21, 0xBB, 0xCC, 0x00, 0x00};
+
+    EXPECT_TRUE(block.Parse(
+            RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, kPayload, sizeof(kPayload)));
+    EXPECT_FALSE(block.IsTwoByteHeader());
+    ASSERT_EQ(block.GetCount(), 2);
+
+    RtpHeaderExtensionElement element = block.GetElement(0);
+    EXPECT_EQ(element.localIdentifier, 1);
+    EXPECT_EQ(element.dataSize, 1);
+    EXPECT_EQ(element.data[0], 0xAA);
+
+    EXPECT_TRUE(block.Find(2, element));
+    EXPECT_EQ(element.dataSize, 2);
+    EXPECT_EQ(element.data[0], 0xBB);
+    EXPECT_EQ(element.data[1], 0xCC);
+
+    EXPECT_FALSE(block.Find(3, element));
+}
+
+TEST_F(RtpHeaderExtensionBlockTest, TestParseTwoByteHeader)
+{
+    const uint8_t kPayload[] = {0x20, 0x00, 0x21, 0x03, 0x01, 0x02, 0x03, 0x00};
+
+    EXPECT_TRUE(block.Parse(
+            RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader, kPayload, sizeof(kPayload)));
+    EXPECT_TRUE(block.IsTwoByteHeader());
+    ASSERT_EQ(block.GetCount(), 2);
+    EXPECT_EQ(block.GetElement(0).localIdentifier, 0x20);
+    EXPECT_EQ(block.GetElement(0).dataSize, 0);
+    EXPECT_EQ(block.GetElement(1).localIdentifier, 0x21);
+    EXPECT_EQ(block.GetElement(1).dataSize, 3);
+    EXPECT_EQ(block.GetElement(1).data[2], 0x03);
+}
+
+TEST_F(RtpHeaderExtensionBlockTest, TestParseInvalid)
+{
+    const uint8_t kTruncated[] = {0x13, 0x01, 0x02};
+    EXPECT_FALSE(block.Parse(
+            RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, kTruncated, sizeof(kTruncated)));
+    EXPECT_EQ(block.GetCount(), 0);
+
+    const uint8_t kPayload[] = {0x10, 0xAA, 0x00, 0x00};
+    EXPECT_FALSE(block.Parse(0x1234, kPayload, sizeof(kPayload)));
+    EXPECT_FALSE(block.Parse(RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, nullptr, 4));
+}
+
+TEST_F(RtpHeaderExtensionBlockTest, TestBuildOneByteHeader)
+{
+    const uint8_t kData1[] = {0xAA};
+    const uint8_t kData2[] = {0xBB, 0xCC};
+
+    EXPECT_TRUE(block.Add(1, kData1, sizeof(kData1)));
+    EXPECT_TRUE(block.Add(2, kData2, sizeof(kData2)));
+    EXPECT_FALSE(block.IsTwoByteHeader());
+
+    const uint8_t kExpected[] = {0x10, 0xAA, 0x21, 0xBB, 0xCC, 0x00, 0x00, 0x00};
+    ASSERT_EQ(block.GetDataSize(), sizeof(kExpected));
+    EXPECT_EQ(memcmp(block.GetData(), kExpected, sizeof(kExpected)), 0);
+
+    RtpHeaderExtensionInfo info = block.GetInfo();
+    EXPECT_EQ(info.definedByProfile, RtpHeaderExtensionInfo::kBitPatternForOneByteHeader);
+    EXPECT_EQ(info.length, 2);
+    EXPECT_EQ(info.extensionDataSize, sizeof(kExpected));
+}
+
+TEST_F(RtpHeaderExtensionBlockTest, TestBuildSwitchToTwoByteHeader)
+{
+    const uint8_t kData1[] = {0xAA};
+    const uint8_t kData2[] = {0xBB, 0xCC};
+
+    EXPECT_TRUE(block.Add(1, kData1, sizeof(kData1)));
+    EXPECT_TRUE(block.Add(15, kData2, sizeof(kData2)));
+    EXPECT_TRUE(block.IsTwoByteHeader());
+
+    const uint8_t kExpected[] = {0x01, 0x01, 0xAA, 0x0F, 0x02, 0xBB, 0xCC, 0x00};
+    ASSERT_EQ(block.GetDataSize(), sizeof(kExpected));
+    EXPECT_EQ(memcmp(block.GetData(), kExpected, sizeof(kExpected)), 0);
+    EXPECT_EQ(block.GetDefinedByProfile(), RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader);
+
+    // round trip
+    RtpHeaderExtensionBlock parsed;
+    EXPECT_TRUE(parsed.Parse(block.GetDefinedByProfile(), block.GetData(), block.GetDataSize()));
+    ASSERT_EQ(parsed.GetCount(), 2);
+    EXPECT_EQ(parsed.GetElement(0).data[0], 0xAA);
+    EXPECT_EQ(parsed.GetElement(1).localIdentifier, 15);
+}
+
+TEST_F(RtpHeaderExtensionBlockTest, TestBuildFromList)
+{
+    const uint8_t kData[] = {0x01, 0x02};
+    std::list<RtpHeaderExtension> listExtension;
+    RtpHeaderExtension extension;
+    extension.setLocalIdentifier(3);
+    extension.setExtensionData(kData, sizeof(kData));
+    listExtension.push_back(extension);
+
+    EXPECT_TRUE(block.Add(&listExtension));
+    ASSERT_EQ(block.GetCount(), 1);
+    EXPECT_EQ(block.GetElement(0).localIdentifier, 3);
+    EXPECT_EQ(memcmp(block.GetElement(0).data, kData, sizeof(kData)), 0);
+}
+
+TEST_F(RtpHeaderExtensionBlockTest, TestCapacity)
+{
+    // two-byte header of 2 bytes and 252 bytes of data leaves 2 bytes in the block
+    uint8_t data[252] = {0};
+    EXPECT_TRUE(block.Add(1, data, sizeof(data)));
+    EXPECT_FALSE(block.Add(2, data, 1));
+    EXPECT_EQ(block.GetCount(), 1);
+    EXPECT_FALSE(block.Add(0, data, 1));
+
+    block.Clear();
+
+    for (uint32_t i = 0; i < RTP_HEADER_EXTENSION_MAX_ELEMENTS; i++)
+    {
+        EXPECT_TRUE(block.Add(1, data, 1));
+    }
+
+    EXPECT_FALSE(block.Add(1, data, 1));
+}
@@ -18,9 +18,12 @@
 #include <ImsMediaNetworkUtil.h>
 #include <AudioConfig.h>
 #include <MockAudioManager.h>
+#include <RtpHeaderExtensionBlock.h>
 #include <ImsMediaCondition.h>
+#include <MediaQualityAnalyzer.h>
 #include <unordered_map>
 #include <algorithm>
+#include <vector>
 
 using namespace android::telephony::imsmedia;
 
@@ -83,6 +86,7 @@ public:
     char receivedDtmfDigit;
     int32_t receivedDtmfDuration;
     CallQuality callQuality;
+    std::vector<uint8_t> qualitySketch;
 
     void resetRespond()
     {
@@ -138,6 +142,13 @@ public:
         response = event;
         callQuality = status;
     }
+
+    void onCallbackQualitySketch(const int id, const int event, const uint8_t* data, int32_t size)
+    {
+        resSessionId = id;
+        response = event;
+        qualitySketch.assign(data, data + size);
+    }
 };
 
 static std::unordered_map<int, AudioManagerCallback*> gMapCallback;
@@ -356,6 +367,18 @@ protected:
                     (callback->second)->onCallbackCallQuality(sessionId, response, quality);
                 }
                 break;
+                case kAudioCallQualitySketchInd:
+                {
+                    int32_t size = parcel.readInt32();
+                    const uint8_t* data = static_cast<const uint8_t*>(parcel.readInplace(size));
+
+                    if (data != nullptr)
+                    {
+                        (callback->second)
+                                ->onCallbackQualitySketch(sessionId, response, data, size);
+                    }
+                }
+                break;
                 default:
                     (callback->second)->onCallback(sessionId, response, result);
                     break;
@@ -470,6 +493,25 @@ TEST_F(AudioManagerTest, testSendDtmf)
     closeSession(kSessionId);
 }
 
+TEST_F(AudioManagerTest, testSetPtime)
+{
+    openSession(kSessionId);
+
+    const int32_t kPtime = 60;
+
+    android::Parcel parcel;
+    parcel.writeInt32(kAudioSetPtime);
+    parcel.writeInt32(kPtime);
+    parcel.setDataPosition(0);
+
+    EXPECT_CALL(manager, setPtime(kSessionId, kPtime)).Times(1).WillOnce(Return());
+
+    manager.sendMessage(kSessionId, parcel);
+
+    gCondition.wait_timeout(20);
+    closeSession(kSessionId);
+}
+
 TEST_F(AudioManagerTest, testSendHeaderExtension)
 {
     openSession(kSessionId);
@@ -561,15 +603,18 @@ TEST_F(AudioManagerTest, testSendInternalEventRtcpXr)
 {
     openSession(kSessionId);
 
-    const int32_t param1 = 10;
-    const int32_t param2 = 20;
+    const uint32_t kSize = 20;
+    uint8_t* reportBlock = new uint8_t[kSize];
 
-    EXPECT_CALL(manager, SendInternalEvent(kRequestSendRtcpXrReport, kSessionId, param1, param2))
+    // the report block is passed to the session and released with the payload
+    EXPECT_CALL(manager,
+            SendInternalEvent(kRequestSendRtcpXrReport, kSessionId,
+                    reinterpret_cast<uint64_t>(reportBlock), kSize))
             .Times(1)
             .WillOnce(Return());
 
-    ImsMediaEventHandler::SendEvent(
-            "AUDIO_REQUEST_EVENT", kRequestSendRtcpXrReport, kSessionId, param1, param2);
+    ImsMediaEventHandler::SendEvent("AUDIO_REQUEST_EVENT", kRequestSendRtcpXrReport,
+            ImsMediaEventPayload::AdoptArray(reportBlock), kSessionId, kSize);
 
     gCondition.wait_timeout(20);
     closeSession(kSessionId);
@@ -579,8 +624,8 @@ TEST_F(AudioManagerTest, testFirstMediaPacketInd)
 {
     AudioConfig* param = new AudioConfig(config);
 
-    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioFirstMediaPacketInd, kSessionId,
-            reinterpret_cast<uint64_t>(param), 0);
+    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioFirstMediaPacketInd,
+            ImsMediaEventPayload::Adopt(param), kSessionId);
 
     gCondition.wait_timeout(20);
     EXPECT_EQ(callback.resSessionId, kSessionId);
@@ -598,19 +643,11 @@ TEST_F(AudioManagerTest, testRtpHeaderExtensionInd)
     extension.setExtensionData(kExtensionData, kExtensionDataSize);
     extensions.push_back(extension);
 
-    std::list<RtpHeaderExtension>* param = new std::list<RtpHeaderExtension>();
-    std::copy(extensions.begin(), extensions.end(), std::back_inserter(*param));
+    RtpHeaderExtensionBlock* param = new RtpHeaderExtensionBlock();
+    EXPECT_TRUE(param->Add(&extensions));
 
-    android::Parcel parcel;
-    parcel.writeInt32(param->size());
-
-    for (auto& item : *param)
-    {
-        item.writeToParcel(&parcel);
-    }
-
-    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioRtpHeaderExtensionInd, kSessionId,
-            reinterpret_cast<uint64_t>(param), 0);
+    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioRtpHeaderExtensionInd,
+            ImsMediaEventPayload::Adopt(param), kSessionId);
 
     gCondition.wait_timeout(20);
     EXPECT_EQ(callback.resSessionId, kSessionId);
@@ -628,8 +665,8 @@ TEST_F(AudioManagerTest, testMediaQualityStatusInd)
 
     MediaQualityStatus* param = new MediaQualityStatus(status);
 
-    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioMediaQualityStatusInd, kSessionId,
-            reinterpret_cast<uint64_t>(param), 0);
+    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioMediaQualityStatusInd,
+            ImsMediaEventPayload::Adopt(param), kSessionId);
 
     gCondition.wait_timeout(20);
     EXPECT_EQ(callback.resSessionId, kSessionId);
@@ -679,11 +716,39 @@ TEST_F(AudioManagerTest, testCallQualityInd)
 
     CallQuality* param = new CallQuality(quality);
 
-    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioCallQualityChangedInd, kSessionId,
-            reinterpret_cast<uint64_t>(param), 0);
+    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioCallQualityChangedInd,
+            ImsMediaEventPayload::Adopt(param), kSessionId);
 
     gCondition.wait_timeout(20);
     EXPECT_EQ(callback.resSessionId, kSessionId);
     EXPECT_EQ(callback.response, kAudioCallQualityChangedInd);
     EXPECT_EQ(callback.callQuality, quality);
-}
\ No newline at end of file
+}
+
+TEST_F(AudioManagerTest, testCallQualitySketchInd)
+{
+    ImsMediaQuantileSketch sketch;
+
+    for (uint32_t value = 20; value < 200; value++)
+    {
+        sketch.Add(value);
+    }
+
+    uint8_t* block = new uint8_t[IM_SKETCH_MAX_SERIALIZED_SIZE + 1];
+    block[0] = kQualitySketchPlayoutDelay;
+    uint32_t size = sketch.Serialize(block + 1, IM_SKETCH_MAX_SERIALIZED_SIZE) + 1;
+
+    ImsMediaEventHandler::SendEvent("AUDIO_RESPONSE_EVENT", kAudioCallQualitySketchInd,
+            ImsMediaEventPayload::AdoptArray(block), kSessionId, size);
+
+    gCondition.wait_timeout(20);
+    EXPECT_EQ(callback.resSessionId, kSessionId);
+    EXPECT_EQ(callback.response, kAudioCallQualitySketchInd);
+    ASSERT_EQ(callback.qualitySketch.size(), size);
+    EXPECT_EQ(callback.qualitySketch[0], kQualitySketchPlayoutDelay);
+
+    ImsMediaQuantileSketch received;
+    EXPECT_TRUE(received.Deserialize(callback.qualitySketch.data() + 1, size - 1));
+    EXPECT_EQ(received.GetCount(), sketch.GetCount());
+    EXPECT_EQ(received.GetPercentile(50), sketch.GetPercentile(50));
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <AudioPtimeAdapter.h>
+
+const uint32_t kLossHigh = 26;  // about 10 percent
+const uint32_t kLossLow = 2;
+
+class AudioPtimeAdapterTest : public ::testing::Test
+{
+public:
+    AudioPtimeAdapter adapter;
+
+protected:
+    virtual void SetUp() override { adapter.SetConfig(20, 80); }
+};
+
+TEST_F(AudioPtimeAdapterTest, TestIncreaseOnCongestion)
+{
+    EXPECT_EQ(adapter.GetPtime(), 20);
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 20);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 40);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 60);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 80);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 80);
+
+    adapter.SetConfig(20, 80);
+    adapter.OnRoundTripTime(500);
+    EXPECT_EQ(adapter.OnFractionLost(0), 40);
+    adapter.OnRoundTripTime(100);
+    EXPECT_EQ(adapter.OnFractionLost(0), 40);
+}
+
+TEST_F(AudioPtimeAdapterTest, TestDecreaseOnRecovery)
+{
+    adapter.OnFractionLost(kLossHigh);
+    adapter.OnFractionLost(kLossHigh);
+    EXPECT_EQ(adapter.GetPtime(), 60);
+
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 60);
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 60);
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 40);
+
+    // a congested report restarts the recovery
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 40);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 60);
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 60);
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 60);
+    EXPECT_EQ(adapter.OnFractionLost(kLossLow), 40);
+
+    for (int i = 0; i < 10; i++)
+    {
+        adapter.OnFractionLost(kLossLow);
+    }
+
+    EXPECT_EQ(adapter.GetPtime(), 20);
+}
+
+TEST_F(AudioPtimeAdapterTest, TestSetPtime)
+{
+    EXPECT_EQ(adapter.SetPtime(40), 40);
+    EXPECT_FALSE(adapter.IsAdaptive());
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 40);
+
+    EXPECT_EQ(adapter.SetPtime(55), 60);
+    EXPECT_EQ(adapter.SetPtime(5), 20);
+    EXPECT_EQ(adapter.SetPtime(200), 80);
+
+    EXPECT_EQ(adapter.SetPtime(0), 20);
+    EXPECT_TRUE(adapter.IsAdaptive());
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 40);
+}
+
+TEST_F(AudioPtimeAdapterTest, TestNotAdaptiveWithoutMaxPtime)
+{
+    adapter.SetConfig(40, 0);
+    EXPECT_EQ(adapter.GetPtime(), 40);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 40);
+
+    adapter.SetConfig(20, 20);
+    EXPECT_EQ(adapter.OnFractionLost(kLossHigh), 20);
+    EXPECT_EQ(adapter.SetPtime(60), 20);
+}
@@ -202,6 +202,56 @@ TEST_F(AudioStreamGraphRtpTxTest, TestRtpTxStreamCodecUpdate)
     EXPECT_EQ(graph->getState(), kStreamStateCreated);
 }
 
+TEST_F(AudioStreamGraphRtpTxTest, TestPtimeKeptOnUpdate)
+{
+    config.setMediaDirection(RtpConfig::MEDIA_DIRECTION_SEND_RECEIVE);
+    EXPECT_EQ(graph->create(&config), RESULT_SUCCESS);
+    EXPECT_EQ(graph->start(), RESULT_SUCCESS);
+    EXPECT_EQ(graph->getPtime(), kPTimeMillis);
+
+    // the report with the high fraction lost raises the ptime by a frame
+    graph->processFractionLost(255);
+    EXPECT_EQ(graph->getPtime(), 40);
+
+    // the payload encoder is not restarted
+    amr.setAmrMode(7);
+    config.setAmrParams(amr);
+    EXPECT_EQ(graph->update(&config), RESULT_SUCCESS);
+    EXPECT_EQ(graph->getPtime(), 40);
+
+    // the payload encoder is restarted with the new codec
+    amr.setOctetAligned(true);
+    config.setCodecType(AudioConfig::CODEC_AMR);
+    config.setAmrParams(amr);
+    EXPECT_EQ(graph->update(&config), RESULT_SUCCESS);
+    EXPECT_EQ(graph->getPtime(), 40);
+
+    // pause and resume the tx
+    config.setMediaDirection(RtpConfig::MEDIA_DIRECTION_INACTIVE);
+    EXPECT_EQ(graph->update(&config), RESULT_SUCCESS);
+    config.setMediaDirection(RtpConfig::MEDIA_DIRECTION_SEND_RECEIVE);
+    EXPECT_EQ(graph->update(&config), RESULT_SUCCESS);
+    EXPECT_EQ(graph->getState(), kStreamStateRunning);
+    EXPECT_EQ(graph->getPtime(), 40);
+
+    // the adaptation goes on from the kept ptime
+    for (int i = 0; i < 3; i++)
+    {
+        graph->processFractionLost(0);
+    }
+
+    EXPECT_EQ(graph->getPtime(), kPTimeMillis);
+    graph->processFractionLost(255);
+    EXPECT_EQ(graph->getPtime(), 40);
+
+    // the renegotiated maxptime restarts the adaptation
+    config.setMaxPtimeMillis(60);
+    EXPECT_EQ(graph->update(&config), RESULT_SUCCESS);
+    EXPECT_EQ(graph->getPtime(), kPTimeMillis);
+
+    EXPECT_EQ(graph->stop(), RESULT_SUCCESS);
+}
+
 TEST_F(AudioStreamGraphRtpTxTest, TestDtmf)
 {
     EXPECT_EQ(graph->createDtmfGraph(nullptr, nullptr), false);
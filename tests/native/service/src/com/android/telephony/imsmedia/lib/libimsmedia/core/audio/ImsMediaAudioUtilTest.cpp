@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ImsMediaAudioUtil.h>
+
+TEST(ImsMediaAudioUtilTest, TestAmrFrameLength)
+{
+    // 3GPP TS 26.101 Table 1a, the octet aligned frame lengths
+    const uint32_t kAmrLength[] = {12, 13, 15, 17, 19, 20, 26, 31, 5};
+
+    for (uint32_t mode = 0; mode <= kImsAudioAmrModeSID; mode++)
+    {
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrModeToLen(mode), kAmrLength[mode]);
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrMode(kAmrLength[mode]), mode);
+    }
+
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrMode(0), kImsAudioAmrModeNoData);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrMode(14), 0);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrMode(1000), 0);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrModeToBitLen(kImsAudioAmrMode1220), 244);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrModeToBitrate(kImsAudioAmrMode475), 4750);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrModeToBitrate(kImsAudioAmrModeSID), 12200);
+}
+
+TEST(ImsMediaAudioUtilTest, TestAmrWbFrameLength)
+{
+    // 3GPP TS 26.201 Table 1a, the octet aligned frame lengths
+    const uint32_t kAmrWbLength[] = {17, 23, 32, 36, 40, 46, 50, 58, 60, 5};
+
+    for (uint32_t mode = 0; mode <= kImsAudioAmrWbModeSID; mode++)
+    {
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrWbModeToLen(mode), kAmrWbLength[mode]);
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrWbMode(kAmrWbLength[mode]), mode);
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToEVSAMRIOAudioMode(kAmrWbLength[mode]), mode);
+        EXPECT_EQ(ImsMediaAudioUtil::CheckEVSCodecMode(kAmrWbLength[mode]), kEvsCodecModeAmrIo);
+    }
+
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrWbMode(0), kImsAudioAmrWbModeNoData);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToAmrWbMode(61), 0);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrWbModeToBitLen(kImsAudioAmrWbMode2385), 477);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrWbModeToBitrate(kImsAudioAmrWbMode1265), 12650);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertAmrWbModeToBitrate(kImsAudioAmrWbModeNoData), 23850);
+}
+
+TEST(ImsMediaAudioUtilTest, TestEvsPrimaryFrameLength)
+{
+    // 3GPP TS 26.445 Table A.1, the compact frame lengths of 2.8 kbps to 128 kbps and SID
+    const uint32_t kEvsLength[] = {7, 18, 20, 24, 33, 41, 61, 80, 120, 160, 240, 320, 6};
+
+    for (uint32_t id = 0; id < EVS_COMPACT_PRIMARY_PAYLOAD_NUM; id++)
+    {
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToEVSAudioMode(kEvsLength[id]), id);
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSAudioModeToBitLen(id), kEvsLength[id] * 8);
+        EXPECT_EQ(ImsMediaAudioUtil::CheckEVSCodecMode(kEvsLength[id]), kEvsCodecModePrimary);
+        EXPECT_TRUE(ImsMediaAudioUtil::CheckEVSPrimaryHeaderFullModeFromSize(kEvsLength[id] + 1));
+
+        kEvsCodecMode codecMode = kEvsCodecModeMax;
+        uint32_t compactId = 0;
+        EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSPayloadMode(kEvsLength[id], &codecMode, &compactId),
+                kRtpPyaloadHeaderModeEvsCompact);
+        EXPECT_EQ(codecMode, kEvsCodecModePrimary);
+        EXPECT_EQ(compactId, id);
+    }
+
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToEVSAudioMode(0), kImsAudioEvsPrimaryModeNoData);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertLenToEVSAudioMode(19), 0);
+    EXPECT_FALSE(ImsMediaAudioUtil::CheckEVSPrimaryHeaderFullModeFromSize(20));
+    EXPECT_FALSE(ImsMediaAudioUtil::CheckEVSPrimaryHeaderFullModeFromSize(1000));
+}
+
+TEST(ImsMediaAudioUtilTest, TestEvsPayloadMode)
+{
+    kEvsCodecMode codecMode = kEvsCodecModeMax;
+    uint32_t compactId = 0;
+
+    // 23.85 kbps AMR-WB IO with the 3 bits CMR in the compact format
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSPayloadMode(60, &codecMode, &compactId),
+            kRtpPyaloadHeaderModeEvsCompact);
+    EXPECT_EQ(codecMode, kEvsCodecModeAmrIo);
+    EXPECT_EQ(compactId, kImsAudioEvsAmrWbIoMode2385);
+
+    // 13.2 kbps with the ToC byte
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSPayloadMode(34, &codecMode, &compactId),
+            kRtpPyaloadHeaderModeEvsHeaderFull);
+    EXPECT_EQ(codecMode, kEvsCodecModePrimary);
+    EXPECT_EQ(compactId, EVS_COMPACT_PAYLOAD_MAX_NUM);
+}
+
+TEST(ImsMediaAudioUtilTest, TestBitrateAndMaximumMode)
+{
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSModeToBitRate(kImsAudioEvsAmrWbIoMode660), 6600);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSModeToBitRate(kImsAudioEvsPrimaryMode5900), 5900);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSModeToBitRate(kImsAudioEvsPrimaryMode128000), 128000);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSModeToBitRate(kImsAudioEvsPrimaryModeSID), 13200);
+    EXPECT_EQ(ImsMediaAudioUtil::ConvertEVSModeToBitRate(-1), 13200);
+
+    EXPECT_EQ(ImsMediaAudioUtil::GetMaximumAmrMode(0), 0);
+    EXPECT_EQ(ImsMediaAudioUtil::GetMaximumAmrMode(0x85), 7);
+    EXPECT_EQ(ImsMediaAudioUtil::GetMaximumAmrMode(0xFFFF), 8);
+    EXPECT_EQ(ImsMediaAudioUtil::GetMaximumEvsMode(1 << kImsAudioEvsPrimaryMode13200), 13);
+    EXPECT_EQ(ImsMediaAudioUtil::GetMaximumEvsMode(-1), 20);
+}
@@ -75,7 +75,7 @@ public:
     FakeMediaQualityCallback() {}
     virtual ~FakeMediaQualityCallback() {}
 
-    virtual void SendEvent(int32_t type, uint64_t param1, uint64_t /*param2*/)
+    virtual void SendEvent(int32_t type, uint64_t param1, uint64_t param2)
     {
         if (type == kAudioCallQualityChangedInd)
         {
@@ -97,15 +97,31 @@ public:
                 delete status;
             }
         }
+        else if (type == kImsMediaEventCallQualitySketch)
+        {
+            uint8_t* block = reinterpret_cast<uint8_t*>(param1);
+
+            if (block != nullptr)
+            {
+                if (param2 > 1 && block[0] < kQualitySketchMax)
+                {
+                    mSketches[block[0]].Deserialize(block + 1, param2 - 1);
+                }
+
+                delete[] block;
+            }
+        }
     }
 
     virtual void onEvent(int32_t /* type */, uint64_t /* param1 */, uint64_t /* param2 */) {}
     CallQuality getCallQuality() { return mCallQuality; }
     MediaQualityStatus getMediaQualityStatus() { return mStatus; }
+    ImsMediaQuantileSketch& getSketch(kQualitySketchType type) { return mSketches[type]; }
 
 private:
     CallQuality mCallQuality;
     MediaQualityStatus mStatus;
+    ImsMediaQuantileSketch mSketches[kQualitySketchMax];
 };
 
 class FakeMediaQualityAnalyzer : public MediaQualityAnalyzer
@@ -147,6 +163,8 @@ public:
         }
     }
 
+    void testNotifyQualitySketches() { notifyQualitySketches(); }
+
 private:
     int32_t counter;
 };
@@ -640,4 +658,61 @@ TEST_F(MediaQualityAnalyzerTest, TestNotifyMediaQualityStatus)
     mAnalyzer->start();
     mAnalyzer->testProcessCycle(2);
     mAnalyzer->stop();
-}
\ No newline at end of file
+}
+
+TEST_F(MediaQualityAnalyzerTest, TestQualityPercentiles)
+{
+    EXPECT_CALL(mCallback, onEvent(kAudioCallQualityChangedInd, _, _)).Times(1);
+    EXPECT_CALL(mCallback, onEvent(kImsMediaEventCallQualitySketch, _, _)).Times(kQualitySketchMax);
+    mAnalyzer->start();
+
+    const int32_t numPackets = 100;
+    const int32_t jitter = 20;
+    const int32_t interval = 20;
+    const uint32_t ssrc = 10000;
+
+    for (int32_t i = 0; i < numPackets; i++)
+    {
+        RtpPacket* packet = new RtpPacket();
+        packet->seqNum = i;
+        packet->jitter = jitter;
+        packet->ssrc = ssrc;
+        packet->arrival = i * interval;
+        mAnalyzer->SendEvent(kCollectPacketInfo, kStreamRtpRx, reinterpret_cast<uint64_t>(packet));
+
+        // the playout delay from 40 to 139 milliseconds
+        SessionCallbackParameter* param =
+                new SessionCallbackParameter(i, kRtpStatusNormal, i * interval + 40 + i);
+        mAnalyzer->SendEvent(kCollectRxRtpStatus, reinterpret_cast<uint64_t>(param));
+    }
+
+    mAnalyzer->testProcessCycle(1);
+
+    ImsMediaQuantileSketch sketch;
+    EXPECT_TRUE(mAnalyzer->getQualitySketch(kQualitySketchPlayoutDelay, sketch));
+    EXPECT_EQ(sketch.GetCount(), numPackets);
+    EXPECT_EQ(sketch.GetMin(), 40);
+    EXPECT_EQ(sketch.GetMax(), 139);
+    EXPECT_TRUE(mAnalyzer->getQualitySketch(kQualitySketchInterArrival, sketch));
+    EXPECT_EQ(sketch.GetCount(), numPackets - 1);
+    EXPECT_FALSE(mAnalyzer->getQualitySketch(kQualitySketchMax, sketch));
+
+    // the sketches sent at the end of the call
+    mAnalyzer->testNotifyQualitySketches();
+    mAnalyzer->stop();
+
+    ImsMediaQuantileSketch& delay = mFakeCallback.getSketch(kQualitySketchPlayoutDelay);
+    EXPECT_EQ(delay.GetCount(), numPackets);
+    EXPECT_EQ(delay.GetMin(), 40);
+    EXPECT_EQ(delay.GetMax(), 139);
+    EXPECT_EQ(mFakeCallback.getSketch(kQualitySketchJitter).GetCount(), numPackets);
+    EXPECT_EQ(mFakeCallback.getSketch(kQualitySketchInterArrival).GetCount(), numPackets - 1);
+
+    CallQuality quality = mFakeCallback.getCallQuality();
+    EXPECT_NEAR(quality.getPlayoutDelayPercentileMillis(CallQuality::kPercentile50), 89, 2);
+    EXPECT_NEAR(quality.getPlayoutDelayPercentileMillis(CallQuality::kPercentile95), 134, 3);
+    EXPECT_NEAR(quality.getPlayoutDelayPercentileMillis(CallQuality::kPercentile99), 138, 3);
+    EXPECT_EQ(quality.getRelativeJitterPercentileMillis(CallQuality::kPercentile50), jitter);
+    EXPECT_EQ(quality.getRelativeJitterPercentileMillis(CallQuality::kPercentile99), jitter);
+    EXPECT_EQ(quality.getInterArrivalTimePercentileMillis(CallQuality::kPercentile95), interval);
+}
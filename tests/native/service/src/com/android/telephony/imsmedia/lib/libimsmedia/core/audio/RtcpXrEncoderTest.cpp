@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <RtcpXrEncoder.h>
+#include <RtcpConfig.h>
+
+class RtcpXrEncoderTest : public ::testing::Test
+{
+public:
+    RtcpXrEncoder encoder;
+    uint8_t data[MAX_BLOCK_LENGTH];
+    uint32_t size;
+
+protected:
+    virtual void SetUp() override
+    {
+        memset(data, 0, sizeof(data));
+        size = 0;
+        encoder.setSsrc(0x11223344);
+        encoder.setSamplingRate(16);
+    }
+
+    uint32_t readWord(const uint32_t offset)
+    {
+        return (data[offset] << 24) | (data[offset + 1] << 16) | (data[offset + 2] << 8) |
+                data[offset + 3];
+    }
+
+    uint16_t readShort(const uint32_t offset) { return (data[offset] << 8) | data[offset + 1]; }
+};
+
+TEST_F(RtcpXrEncoderTest, TestCreateStatisticsSummaryReport)
+{
+    const int32_t kJitters[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    uint16_t seq = 100;
+
+    for (int32_t jitter : kJitters)
+    {
+        encoder.stackRxRtpStatus(seq++, kRtpStatusNormal, 20, jitter);
+    }
+
+    encoder.stackRxRtpStatus(seq++, kRtpStatusLost, 0);
+    encoder.stackRxRtpStatus(seq++, kRtpStatusLost, 0);
+    encoder.stackRxRtpStatus(105, kRtpStatusDuplicated, 20, 5);
+
+    EXPECT_TRUE(encoder.createRtcpXrReport(
+            RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK, data, size));
+    EXPECT_EQ(size, BLOCK_LENGTH_STATISTICS);
+    EXPECT_EQ(data[0], 6);
+    EXPECT_EQ(readWord(4), 0x11223344);
+    EXPECT_EQ(readShort(8), 100);
+    EXPECT_EQ(readShort(10), 109);
+    // lost and duplicated packets
+    EXPECT_EQ(readWord(12), 2);
+    EXPECT_EQ(readWord(16), 1);
+    // min, max, mean and deviation of the jitter in the timestamp unit
+    EXPECT_EQ(readWord(20), 2 * 16);
+    EXPECT_EQ(readWord(24), 9 * 16);
+    EXPECT_EQ(readWord(28), 5 * 16);
+    EXPECT_EQ(readWord(32), 2 * 16);
+}
+
+TEST_F(RtcpXrEncoderTest, TestSequenceRangeOfInterval)
+{
+    // the range follows the stacked statuses across the wrap around and the late status
+    encoder.stackRxRtpStatus(65534, kRtpStatusNormal, 20, 1);
+    encoder.stackRxRtpStatus(65535, kRtpStatusNormal, 20, 1);
+    encoder.stackRxRtpStatus(0, kRtpStatusNormal, 20, 1);
+    encoder.stackRxRtpStatus(1, kRtpStatusLost, 0);
+    encoder.stackRxRtpStatus(65533, kRtpStatusLate, 20, 1);
+
+    EXPECT_TRUE(encoder.createRtcpXrReport(
+            RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK, data, size));
+    EXPECT_EQ(readShort(8), 65533);
+    EXPECT_EQ(readShort(10), 1);
+
+    // the next interval starts from the next stacked status
+    encoder.stackRxRtpStatus(2, kRtpStatusNormal, 20, 1);
+    EXPECT_TRUE(encoder.createRtcpXrReport(
+            RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK, data, size));
+    EXPECT_EQ(readShort(8), 2);
+    EXPECT_EQ(readShort(10), 2);
+}
+
+TEST_F(RtcpXrEncoderTest, TestStatisticsResetAfterReport)
+{
+    encoder.stackRxRtpStatus(0, kRtpStatusNormal, 20, 10);
+    encoder.stackRxRtpStatus(1, kRtpStatusLost, 0);
+    EXPECT_TRUE(encoder.createRtcpXrReport(
+            RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK, data, size));
+    EXPECT_EQ(readWord(12), 1);
+
+    encoder.stackRxRtpStatus(2, kRtpStatusNormal, 20, 3);
+    EXPECT_TRUE(encoder.createRtcpXrReport(
+            RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK, data, size));
+    EXPECT_EQ(readWord(12), 0);
+    EXPECT_EQ(readWord(16), 0);
+    EXPECT_EQ(readWord(20), 3 * 16);
+    EXPECT_EQ(readWord(24), 3 * 16);
+    EXPECT_EQ(readWord(32), 0);
+}
+
+TEST_F(RtcpXrEncoderTest, TestCreateReportInvalidParameters)
+{
+    EXPECT_FALSE(encoder.createRtcpXrReport(RtcpConfig::FLAG_RTCPXR_NONE, data, size));
+    EXPECT_EQ(size, 0);
+    EXPECT_FALSE(encoder.createRtcpXrReport(
+            RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK, nullptr, size));
+}
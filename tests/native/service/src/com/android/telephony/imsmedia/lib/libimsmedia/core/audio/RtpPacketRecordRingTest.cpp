@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <RtpPacketRecordRing.h>
+
+class RtpPacketRecordRingTest : public ::testing::Test
+{
+public:
+    RtpPacketRecordRing ring;
+
+protected:
+    bool add(uint32_t seq, int32_t jitter = 0, int32_t arrival = 0, uint32_t ssrc = 1)
+    {
+        RtpPacket packet;
+        packet.ssrc = ssrc;
+        packet.seqNum = seq;
+        packet.jitter = jitter;
+        packet.arrival = arrival;
+        return ring.Add(packet);
+    }
+};
+
+TEST_F(RtpPacketRecordRingTest, TestAddFind)
+{
+    EXPECT_EQ(ring.Find(0), nullptr);
+
+    for (uint32_t seq = 100; seq < 110; seq++)
+    {
+        EXPECT_TRUE(add(seq, seq - 100, seq * 20));
+    }
+
+    EXPECT_EQ(ring.GetCount(), 10);
+
+    RtpPacketRecord* record = ring.Find(105);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->jitter, 5);
+    EXPECT_EQ(record->arrival, 2100);
+    EXPECT_EQ(record->numArrival, 1);
+    EXPECT_EQ(ring.Find(110), nullptr);
+    EXPECT_EQ(ring.Find(99), nullptr);
+
+    ring.Clear();
+    EXPECT_EQ(ring.GetCount(), 0);
+    EXPECT_EQ(ring.Find(105), nullptr);
+}
+
+TEST_F(RtpPacketRecordRingTest, TestUpdateStatus)
+{
+    add(1);
+    add(2);
+    add(2);
+
+    EXPECT_EQ(ring.GetCount(), 3);
+    ASSERT_NE(ring.UpdateStatus(1, kRtpStatusNormal), nullptr);
+    ASSERT_NE(ring.UpdateStatus(2, kRtpStatusNormal), nullptr);
+    ASSERT_NE(ring.UpdateStatus(2, kRtpStatusDuplicated), nullptr);
+    EXPECT_EQ(ring.UpdateStatus(3, kRtpStatusNormal), nullptr);
+
+    RtpPacketRecord* record = ring.Find(2);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->status, kRtpStatusNormal);
+    EXPECT_EQ(record->numArrival, 2);
+    EXPECT_EQ(record->numDuplicated, 1);
+
+    record = ring.Find(1);
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->numArrival, 1);
+    EXPECT_EQ(record->numDuplicated, 0);
+}
+
+TEST_F(RtpPacketRecordRingTest, TestSequenceWrapAround)
+{
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        add((0xFFF6 + i) & 0xFFFF, i);
+    }
+
+    EXPECT_EQ(ring.GetCount(), 20);
+    ASSERT_NE(ring.Find(0xFFFF), nullptr);
+    ASSERT_NE(ring.Find(9), nullptr);
+    EXPECT_EQ(ring.Find(9)->jitter, 19);
+
+    EXPECT_EQ(ring.Find(0xFFFE)->jitter, 8);
+    EXPECT_EQ(ring.Find(1)->jitter, 11);
+
+    ring.RemoveUntil(0);
+    EXPECT_EQ(ring.GetCount(), 9);
+    EXPECT_EQ(ring.Find(0xFFFF), nullptr);
+    EXPECT_NE(ring.Find(1), nullptr);
+}
+
+TEST_F(RtpPacketRecordRingTest, TestOverwriteOldRecords)
+{
+    for (uint32_t seq = 0; seq < RTP_PACKET_RECORD_RING_SIZE + 10; seq++)
+    {
+        add(seq);
+    }
+
+    EXPECT_EQ(ring.GetCount(), RTP_PACKET_RECORD_RING_SIZE);
+    EXPECT_EQ(ring.Find(9), nullptr);
+    EXPECT_NE(ring.Find(10), nullptr);
+
+    // too old packet of the same stream is ignored
+    EXPECT_FALSE(add(5));
+
+    // the skipped slots are emptied
+    add(RTP_PACKET_RECORD_RING_SIZE + 20);
+    EXPECT_EQ(ring.GetCount(), RTP_PACKET_RECORD_RING_SIZE - 10);
+
+    // a packet of the new stream out of the range restarts the ring
+    EXPECT_TRUE(add(5, 0, 0, 2));
+    EXPECT_EQ(ring.GetCount(), 1);
+    EXPECT_NE(ring.Find(5), nullptr);
+}
+
+TEST_F(RtpPacketRecordRingTest, TestCountReceivedInDuration)
+{
+    add(1, 0, 1000);
+    add(2, 0, 2000);
+    add(3, 0, 3000);
+    add(3, 0, 3010);
+
+    EXPECT_EQ(ring.CountReceivedInDuration(3500, 1000), 2);
+    EXPECT_EQ(ring.CountReceivedInDuration(3500, 2000), 3);
+    EXPECT_EQ(ring.CountReceivedInDuration(3500, 0), 0);
+}
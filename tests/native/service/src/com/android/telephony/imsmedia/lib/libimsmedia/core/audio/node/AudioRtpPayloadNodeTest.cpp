@@ -64,6 +64,7 @@ public:
             BaseNode(callback)
     {
         frameSize = 0;
+        numFrames = 0;
         memset(dataFrame, 0, sizeof(dataFrame));
         subType = MEDIASUBTYPE_UNDEFINED;
     }
@@ -83,17 +84,20 @@ public:
             memcpy(dataFrame, data, size);
             frameSize = size;
             subType = dataType;
+            numFrames++;
         }
     }
 
     virtual kBaseNodeState GetState() { return kNodeStateRunning; }
 
     uint32_t GetFrameSize() { return frameSize; }
+    uint32_t GetNumFrames() { return numFrames; }
     uint8_t* GetDataFrame() { return dataFrame; }
     ImsMediaSubType GetSubType() { return subType; }
 
 private:
     uint32_t frameSize;
+    uint32_t numFrames;
     uint8_t dataFrame[DEFAULT_MTU];
     ImsMediaSubType subType;
 };
@@ -230,6 +234,38 @@ TEST_F(AudioRtpPayloadNodeTest, testAmrBandwidthEfficientDataProcess)
     EXPECT_EQ(memcmp(fakeNode->GetDataFrame(), testFrame, fakeNode->GetFrameSize()), 0);
 }
 
+TEST_F(AudioRtpPayloadNodeTest, testAmrBandwidthEfficientSetPtime)
+{
+    EXPECT_EQ(encoder->Start(), RESULT_SUCCESS);
+    EXPECT_EQ(decoder->Start(), RESULT_SUCCESS);
+
+    // AMR-WB mode 8 audio frame with toc field
+    uint8_t testFrame[] = {0x44, 0xe6, 0x6e, 0x84, 0x8a, 0xa4, 0xda, 0xc8, 0xf2, 0x6c, 0xeb, 0x87,
+            0xe4, 0x56, 0x0f, 0x49, 0x47, 0xfa, 0xdc, 0xa7, 0x9d, 0xbb, 0xcf, 0xda, 0xda, 0x67,
+            0x80, 0xc2, 0x7f, 0x8d, 0x5b, 0xab, 0xd9, 0xbb, 0xd7, 0x1e, 0x60, 0x96, 0x5d, 0xdd,
+            0x28, 0x65, 0x5f, 0x43, 0xf4, 0xb9, 0x0d, 0x7d, 0x05, 0x4e, 0x30, 0x50, 0xe1, 0x98,
+            0x03, 0xed, 0xee, 0x8a, 0xa8, 0x34, 0x40};
+
+    // the packet of two frames is sent with the second frame
+    encoder->SetPtime(40);
+    encoder->OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 0, false, 0,
+            MEDIASUBTYPE_UNDEFINED);
+    EXPECT_EQ(fakeNode->GetNumFrames(), 0);
+
+    encoder->OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 20, false,
+            0, MEDIASUBTYPE_UNDEFINED);
+    EXPECT_EQ(fakeNode->GetNumFrames(), 2);
+    EXPECT_EQ(fakeNode->GetSubType(), MEDIASUBTYPE_AUDIO_NORMAL);
+    EXPECT_EQ(fakeNode->GetFrameSize(), sizeof(testFrame));
+    EXPECT_EQ(memcmp(fakeNode->GetDataFrame(), testFrame, fakeNode->GetFrameSize()), 0);
+
+    // back to a frame per packet from the next packet
+    encoder->SetPtime(20);
+    encoder->OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 40, false,
+            0, MEDIASUBTYPE_UNDEFINED);
+    EXPECT_EQ(fakeNode->GetNumFrames(), 3);
+}
+
 TEST_F(AudioRtpPayloadNodeTest, testAmrBandwidthEfficientSIDDataProcess)
 {
     audioConfig.setCodecType(AudioConfig::CODEC_AMR);
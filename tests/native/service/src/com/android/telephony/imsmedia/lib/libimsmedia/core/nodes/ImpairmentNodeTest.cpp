@@ -0,0 +1,329 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <FakeRearNode.h>
+#include <ImpairmentNode.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+const uint32_t kStartTime = 1000;
+const uint32_t kPacketIntervalMs = 20;
+
+class FakeImpairmentNode : public ImpairmentNode
+{
+public:
+    virtual ~FakeImpairmentNode() {}
+    void SetTime(uint32_t time) { mTime = time; }
+
+protected:
+    virtual uint32_t GetCurrentTime() { return mTime; }
+
+private:
+    uint32_t mTime = kStartTime;
+};
+
+class ImpairmentNodeTest : public ::testing::Test
+{
+public:
+    ImpairmentNodeTest() {}
+    virtual ~ImpairmentNodeTest() {}
+
+protected:
+    FakeImpairmentNode mNode;
+    FakeRearNode mRearNode;
+
+    virtual void SetUp() override { mNode.ConnectRearNode(&mRearNode); }
+
+    virtual void TearDown() override
+    {
+        mNode.Stop();
+        mNode.DisconnectNodes();
+    }
+
+    void SendPacket(uint32_t seq, uint32_t time)
+    {
+        uint8_t data[4] = {static_cast<uint8_t>(seq >> 8), static_cast<uint8_t>(seq), 0xAB, 0xCD};
+        mNode.SetTime(time);
+        mNode.OnDataFromFrontNode(MEDIASUBTYPE_RTPPACKET, data, sizeof(data), seq * 160, false,
+                seq, MEDIASUBTYPE_UNDEFINED, time);
+        mNode.ProcessData();
+    }
+
+    // send the packets in every packet interval and drain all the pending packets
+    void SendPackets(uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            SendPacket(i, kStartTime + i * kPacketIntervalMs);
+        }
+
+        mNode.SetTime(kStartTime + count * kPacketIntervalMs + 10000);
+        mNode.ProcessData();
+    }
+
+    std::vector<uint32_t> GetReceivedSequence()
+    {
+        std::vector<uint32_t> sequence;
+
+        for (auto& packet : mRearNode.mPackets)
+        {
+            sequence.push_back(packet.seq);
+        }
+
+        return sequence;
+    }
+};
+
+TEST_F(ImpairmentNodeTest, TestPassThrough)
+{
+    EXPECT_EQ(mNode.GetNodeId(), kNodeIdImpairment);
+    EXPECT_FALSE(mNode.IsRunTime());
+    EXPECT_EQ(mNode.Start(), RESULT_SUCCESS);
+
+    SendPacket(7, kStartTime);
+    ASSERT_EQ(mRearNode.mPackets.size(), 1);
+    EXPECT_EQ(mRearNode.mPackets[0].seq, 7);
+    EXPECT_EQ(mRearNode.mPackets[0].arrivalTime, kStartTime);
+    const std::vector<uint8_t> kExpected = {0x00, 0x07, 0xAB, 0xCD};
+    EXPECT_EQ(mRearNode.mPackets[0].data, kExpected);
+    EXPECT_EQ(mNode.GetDataCount(), 0);
+}
+
+TEST_F(ImpairmentNodeTest, TestConstantDelay)
+{
+    ImpairmentParams params;
+    params.delayMs = 40;
+    mNode.SetParams(params);
+    mNode.Start();
+
+    SendPacket(0, kStartTime);
+    EXPECT_EQ(mNode.GetDataCount(), 1);
+
+    mNode.SetTime(kStartTime + 39);
+    mNode.ProcessData();
+    EXPECT_TRUE(mRearNode.mPackets.empty());
+
+    mNode.SetTime(kStartTime + 40);
+    mNode.ProcessData();
+    ASSERT_EQ(mRearNode.mPackets.size(), 1);
+    // the arrival time is updated to the time released
+    EXPECT_EQ(mRearNode.mPackets[0].arrivalTime, kStartTime + 40);
+}
+
+TEST_F(ImpairmentNodeTest, TestJitterKeepsOrder)
+{
+    ImpairmentParams params;
+    params.seed = 1;
+    params.delayMs = 60;
+    params.jitterMs = 40;
+    params.distribution = kImpairmentDelayNormal;
+    mNode.SetParams(params);
+    mNode.Start();
+
+    const uint32_t kCount = 500;
+    SendPackets(kCount);
+
+    std::vector<uint32_t> sequence = GetReceivedSequence();
+    ASSERT_EQ(sequence.size(), kCount);
+
+    for (uint32_t i = 0; i < kCount; i++)
+    {
+        EXPECT_EQ(sequence[i], i);
+    }
+}
+
+TEST_F(ImpairmentNodeTest, TestUniformJitterRange)
+{
+    ImpairmentParams params;
+    params.seed = 3;
+    params.delayMs = 50;
+    params.jitterMs = 10;
+    params.distribution = kImpairmentDelayUniform;
+    mNode.SetParams(params);
+    mNode.Start();
+
+    // send one packet at a time to measure the delay of each packet
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        uint32_t sendTime = kStartTime + i * 1000;
+        SendPacket(i, sendTime);
+
+        for (uint32_t time = sendTime; mRearNode.mPackets.size() == i; time++)
+        {
+            mNode.SetTime(time);
+            mNode.ProcessData();
+        }
+
+        uint32_t delay = mRearNode.mPackets[i].arrivalTime - sendTime;
+        EXPECT_GE(delay, 40);
+        EXPECT_LE(delay, 60);
+    }
+}
+
+TEST_F(ImpairmentNodeTest, TestSameSeedReproducesLoss)
+{
+    ImpairmentParams params;
+    params.seed = 1234;
+    params.lossRateGood = 0.1;
+    params.lossRateBad = 0.8;
+    params.goodToBadRate = 0.05;
+    params.badToGoodRate = 0.3;
+    mNode.SetParams(params);
+    mNode.Start();
+    SendPackets(1000);
+    std::vector<uint32_t> first = GetReceivedSequence();
+
+    mRearNode.mPackets.clear();
+    mNode.Start();
+    SendPackets(1000);
+    EXPECT_EQ(GetReceivedSequence(), first);
+
+    mRearNode.mPackets.clear();
+    params.seed = 4321;
+    mNode.SetParams(params);
+    mNode.Start();
+    SendPackets(1000);
+    EXPECT_NE(GetReceivedSequence(), first);
+}
+
+TEST_F(ImpairmentNodeTest, TestGilbertElliottBurstLoss)
+{
+    ImpairmentParams params;
+    params.seed = 42;
+    params.goodToBadRate = 0.05;
+    params.badToGoodRate = 0.25;
+    params.lossRateGood = 0.0;
+    params.lossRateBad = 1.0;
+    mNode.SetParams(params);
+    mNode.Start();
+
+    const uint32_t kCount = 20000;
+    SendPackets(kCount);
+
+    std::vector<uint32_t> sequence = GetReceivedSequence();
+    ImpairmentStats stats = mNode.GetStats();
+    EXPECT_EQ(stats.received, kCount);
+    EXPECT_EQ(stats.dropped + sequence.size(), kCount);
+
+    // the stationary loss rate is p / (p + r) and the mean burst length is 1 / r
+    double lossRate = static_cast<double>(stats.dropped) / kCount;
+    EXPECT_NEAR(lossRate, 0.05 / (0.05 + 0.25), 0.03);
+
+    uint32_t bursts = 0;
+    uint32_t expectedSeq = 0;
+
+    for (uint32_t seq : sequence)
+    {
+        if (seq != expectedSeq)
+        {
+            bursts++;
+        }
+
+        expectedSeq = seq + 1;
+    }
+
+    bursts += expectedSeq != kCount ? 1 : 0;
+    ASSERT_GT(bursts, 0);
+    EXPECT_NEAR(static_cast<double>(stats.dropped) / bursts, 1 / 0.25, 1.0);
+}
+
+TEST_F(ImpairmentNodeTest, TestReorder)
+{
+    ImpairmentParams params;
+    params.seed = 7;
+    params.delayMs = 20;
+    params.reorderRate = 0.1;
+    params.reorderDelayMs = 50;
+    mNode.SetParams(params);
+    mNode.Start();
+
+    const uint32_t kCount = 1000;
+    SendPackets(kCount);
+
+    std::vector<uint32_t> sequence = GetReceivedSequence();
+    ImpairmentStats stats = mNode.GetStats();
+    ASSERT_EQ(sequence.size(), kCount);
+    EXPECT_GT(stats.reordered, 50);
+    EXPECT_LT(stats.reordered, 150);
+
+    uint32_t outOfOrder = 0;
+
+    for (uint32_t i = 1; i < kCount; i++)
+    {
+        outOfOrder += sequence[i] < sequence[i - 1] ? 1 : 0;
+    }
+
+    EXPECT_GT(outOfOrder, 0);
+    EXPECT_LE(outOfOrder, stats.reordered);
+}
+
+TEST_F(ImpairmentNodeTest, TestDuplicate)
+{
+    ImpairmentParams params;
+    params.seed = 9;
+    params.duplicateRate = 0.2;
+    mNode.SetParams(params);
+    mNode.Start();
+
+    const uint32_t kCount = 1000;
+    SendPackets(kCount);
+
+    ImpairmentStats stats = mNode.GetStats();
+    EXPECT_EQ(mRearNode.mPackets.size(), kCount + stats.duplicated);
+    EXPECT_EQ(stats.sent, mRearNode.mPackets.size());
+    EXPECT_NEAR(static_cast<double>(stats.duplicated) / kCount, 0.2, 0.05);
+}
+
+TEST_F(ImpairmentNodeTest, TestTrace)
+{
+    mNode.SetTrace({0, IMPAIRMENT_TRACE_DROP, 50, 10});
+    mNode.Start();
+
+    // the trace repeats from the start after the 4th packet
+    SendPackets(8);
+
+    const std::vector<uint32_t> kExpected = {0, 3, 4, 2, 7, 6};
+    EXPECT_EQ(GetReceivedSequence(), kExpected);
+    EXPECT_EQ(mNode.GetStats().dropped, 2);
+}
+
+TEST_F(ImpairmentNodeTest, TestLoadTrace)
+{
+    std::string path = testing::TempDir() + "impairment_trace_test.txt";
+    FILE* file = fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fprintf(file, "# delay in ms per packet\n0\n\ndrop\n  50\n10\n");
+    fclose(file);
+
+    EXPECT_TRUE(mNode.LoadTrace(path.c_str()));
+    mNode.Start();
+    SendPackets(4);
+
+    const std::vector<uint32_t> kExpected = {0, 3, 2};
+    EXPECT_EQ(GetReceivedSequence(), kExpected);
+
+    file = fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fprintf(file, "10\nlost\n");
+    fclose(file);
+    EXPECT_FALSE(mNode.LoadTrace(path.c_str()));
+    EXPECT_FALSE(mNode.LoadTrace("/nonexistent/impairment_trace.txt"));
+    remove(path.c_str());
+}
+}  // namespace
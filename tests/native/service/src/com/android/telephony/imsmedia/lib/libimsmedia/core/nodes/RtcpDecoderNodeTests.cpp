@@ -239,6 +239,29 @@ TEST_F(RtcpDecoderNodeTests, TestOnRtcpRrInd)
     EXPECT_EQ(pCallback->mParam1, kStreamRtcp);
 }
 
+TEST_F(RtcpDecoderNodeTests, TestOnRtcpSrIndWithReportBlock)
+{
+    pRtcpDecNode->SetMediaType(IMS_MEDIA_AUDIO);
+    tNotifyReceiveRtcpSrInd payload;
+    memset(&payload, 0x00, sizeof(payload));
+    payload.numReportBlocks = 1;
+    payload.stRecvRpt.fractionLost = 25;
+    pRtcpDecNode->OnRtcpInd(RTPSVC_RECEIVE_RTCP_SR_IND, &payload);
+    EXPECT_EQ(pCallback->mType, kRequestAudioFractionLostUpdate);
+    EXPECT_EQ(pCallback->mParam1, 25);
+}
+
+TEST_F(RtcpDecoderNodeTests, TestOnRtcpRrIndWithReportBlock)
+{
+    pRtcpDecNode->SetMediaType(IMS_MEDIA_AUDIO);
+    tNotifyReceiveRtcpRrInd payload;
+    memset(&payload, 0x00, sizeof(payload));
+    payload.numReportBlocks = 1;
+    pRtcpDecNode->OnRtcpInd(RTPSVC_RECEIVE_RTCP_RR_IND, &payload);
+    EXPECT_EQ(pCallback->mType, kRequestAudioFractionLostUpdate);
+    EXPECT_EQ(pCallback->mParam1, 0);
+}
+
 TEST_F(RtcpDecoderNodeTests, TestOnRtcpFbInd)
 {
     pRtcpDecNode->SetMediaType(IMS_MEDIA_AUDIO);
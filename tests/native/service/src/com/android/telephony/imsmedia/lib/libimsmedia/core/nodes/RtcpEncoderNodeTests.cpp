@@ -340,8 +340,8 @@ TEST_F(RtcpEncoderNodeTests, SendRtcpXr)
     bool bRet = pRtcpEncNode->SendRtcpXr(nullptr, 0);
     EXPECT_EQ(bRet, false);
 
-    uint8_t* pDummyRtcpXrPacket = new uint8_t[10];
-    bRet = pRtcpEncNode->SendRtcpXr(pDummyRtcpXrPacket, 10);
+    uint8_t dummyRtcpXrPacket[10] = {0};
+    bRet = pRtcpEncNode->SendRtcpXr(dummyRtcpXrPacket, 10);
     EXPECT_EQ(bRet, true);
     pRtcpEncNode->Stop();
     delete pRtcpEncNode;
@@ -89,13 +89,13 @@ public:
     {
         dtmfDigit = 0;
         dtmfDuration = 0;
-        listExtensions = nullptr;
+        extensionBlock = nullptr;
     }
     virtual ~FakeRtpDecoderCallback()
     {
-        if (listExtensions != nullptr)
+        if (extensionBlock != nullptr)
         {
-            delete listExtensions;
+            delete extensionBlock;
         }
     }
     virtual void onEvent(int32_t type, uint64_t param1, uint64_t param2)
@@ -107,22 +107,22 @@ public:
         }
         else if (type == kImsMediaEventHeaderExtensionReceived)
         {
-            if (listExtensions != nullptr)
+            if (extensionBlock != nullptr)
             {
-                delete listExtensions;
+                delete extensionBlock;
             }
 
-            listExtensions = reinterpret_cast<std::list<RtpHeaderExtension>*>(param1);
+            extensionBlock = reinterpret_cast<RtpHeaderExtensionBlock*>(param1);
         }
     }
     uint8_t GetDtmfDigit() { return dtmfDigit; }
     uint32_t GetDtmfDuration() { return dtmfDuration; }
-    std::list<RtpHeaderExtension>* GetListExtension() { return listExtensions; }
+    RtpHeaderExtensionBlock* GetExtensionBlock() { return extensionBlock; }
 
 private:
     uint8_t dtmfDigit;
     uint32_t dtmfDuration;
-    std::list<RtpHeaderExtension>* listExtensions;
+    RtpHeaderExtensionBlock* extensionBlock;
 };
 
 class FakeRtpDecoderNode : public BaseNode
@@ -418,12 +418,18 @@ TEST_F(RtpDecoderNodeTest, testAudioRtpExtension)
     encoder->OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 0, false, 0);
     encoder->ProcessData();
 
-    std::list<RtpHeaderExtension>* receivedExtension = callback.GetListExtension();
+    RtpHeaderExtensionBlock* receivedExtension = callback.GetExtensionBlock();
     ASSERT_TRUE(receivedExtension != nullptr);
+    ASSERT_EQ(receivedExtension->GetCount(), listExtension.size());
+    EXPECT_FALSE(receivedExtension->IsTwoByteHeader());
 
-    for (auto& extension : *receivedExtension)
+    for (uint32_t i = 0; i < receivedExtension->GetCount(); i++)
     {
-        EXPECT_EQ(extension, listExtension.front());
+        RtpHeaderExtensionElement element = receivedExtension->GetElement(i);
+        EXPECT_EQ(element.localIdentifier, listExtension.front().getLocalIdentifier());
+        EXPECT_EQ(element.dataSize, listExtension.front().getExtensionDataSize());
+        EXPECT_EQ(memcmp(element.data, listExtension.front().getExtensionData(), element.dataSize),
+                0);
         listExtension.pop_front();
     }
 }
@@ -19,6 +19,7 @@
 #include <VideoConfig.h>
 #include <TextConfig.h>
 #include <RtpEncoderNode.h>
+#include <vector>
 
 using namespace android::telephony::imsmedia;
 using namespace android;
@@ -116,21 +117,27 @@ public:
             uint32_t arrivalTime)
     {
         (void)subtype;
-        (void)data;
         (void)timestamp;
         (void)mark;
         (void)seq;
         (void)dataType;
         (void)arrivalTime;
         mFrameSize = size;
+
+        if (data != nullptr && size >= static_cast<uint32_t>(kRtpHeaderSize))
+        {
+            mSequenceNumbers.push_back((data[2] << 8) | data[3]);
+        }
     }
 
     virtual kBaseNodeState GetState() { return kNodeStateRunning; }
 
     uint32_t GetFrameSize() { return mFrameSize; }
+    std::vector<uint16_t>& GetSequenceNumbers() { return mSequenceNumbers; }
 
 private:
     uint32_t mFrameSize;
+    std::vector<uint16_t> mSequenceNumbers;
 };
 
 class RtpEncoderNodeTest : public ::testing::Test
@@ -349,6 +356,45 @@ TEST_F(RtpEncoderNodeTest, testVideoDataProcess)
     EXPECT_EQ(mFakeNode->GetFrameSize(), sizeof(testFrame) + kRtpHeaderSizeWithExtension);
 }
 
+TEST_F(RtpEncoderNodeTest, testVideoDataProcessInBatch)
+{
+    setupVideoConfig();
+    EXPECT_EQ(mNode->Start(), RESULT_SUCCESS);
+    EXPECT_TRUE(mNode->SetCvoExtension(0, 0));
+
+    // FU-A fragments of a frame
+    uint8_t testFragment[] = {0x7c, 0x85, 0x88, 0x82, 0x00, 0x0f, 0xf4, 0x4c, 0x00, 0x5d};
+    const uint32_t kNumFragments = 3;
+
+    for (uint32_t i = 0; i < kNumFragments; i++)
+    {
+        mNode->OnDataFromFrontNode(MEDIASUBTYPE_VIDEO_IDR_FRAME, testFragment,
+                sizeof(testFragment), 100, i == kNumFragments - 1, 0);
+    }
+
+    // the next frame
+    mNode->OnDataFromFrontNode(
+            MEDIASUBTYPE_VIDEO_IDR_FRAME, testFragment, sizeof(testFragment), 200, true, 0);
+
+    mNode->ProcessData();
+
+    std::vector<uint16_t>& sequenceNumbers = mFakeNode->GetSequenceNumbers();
+    ASSERT_EQ(sequenceNumbers.size(), kNumFragments);
+
+    for (uint32_t i = 1; i < kNumFragments; i++)
+    {
+        EXPECT_EQ(static_cast<uint16_t>(sequenceNumbers[i - 1] + 1), sequenceNumbers[i]);
+    }
+
+    // the cvo extension is added to the last packet of the frame only
+    EXPECT_EQ(mFakeNode->GetFrameSize(), sizeof(testFragment) + kRtpHeaderSizeWithExtension);
+    EXPECT_EQ(mNode->GetDataCount(), 1);
+
+    mNode->ProcessData();
+    EXPECT_EQ(sequenceNumbers.size(), kNumFragments + 1);
+    EXPECT_EQ(mNode->GetDataCount(), 0);
+}
+
 TEST_F(RtpEncoderNodeTest, startTextAndUpdate)
 {
     setupTextConfig();
@@ -0,0 +1,342 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <FakeRearNode.h>
+#include <RtpPacerNode.h>
+#include <VideoConfig.h>
+#include <vector>
+
+namespace
+{
+const uint64_t kStartTime = 1000000;
+const uint32_t kPacketSize = 1000;
+// 1000 bytes per 10 ms
+const uint32_t kTargetBitrate = 320000;
+const uint32_t kPacingRate = 800000;
+
+class FakeRtpPacerNode : public RtpPacerNode
+{
+public:
+    virtual ~FakeRtpPacerNode() {}
+    void SetTime(uint64_t time) { mTime = time; }
+
+protected:
+    virtual uint64_t GetCurrentTime() { return mTime; }
+
+private:
+    uint64_t mTime = kStartTime;
+};
+
+// the rear node sending a new packet to the pacer while the first packet is delivered
+class ReentrantRearNode : public FakeRearNode
+{
+public:
+    ReentrantRearNode(RtpPacerNode* pacer) :
+            mPacer(pacer)
+    {
+    }
+    virtual ~ReentrantRearNode() {}
+    void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+            uint32_t timestamp, bool mark, uint32_t seq, ImsMediaSubType dataType,
+            uint32_t arrivalTime)
+    {
+        FakeRearNode::OnDataFromFrontNode(
+                subtype, data, size, timestamp, mark, seq, dataType, arrivalTime);
+
+        if (mPackets.size() == 1)
+        {
+            std::vector<uint8_t> packet(kPacketSize, 0);
+            mPacer->OnDataFromFrontNode(
+                    MEDIASUBTYPE_RTPPACKET, packet.data(), kPacketSize, 0, false, 100);
+        }
+    }
+
+private:
+    RtpPacerNode* mPacer;
+};
+
+class RtpPacerNodeTest : public ::testing::Test
+{
+public:
+    RtpPacerNodeTest() {}
+    virtual ~RtpPacerNodeTest() {}
+
+protected:
+    FakeRtpPacerNode mNode;
+    FakeRearNode mRearNode;
+
+    virtual void SetUp() override
+    {
+        mNode.SetMediaType(IMS_MEDIA_VIDEO);
+        mNode.ConnectRearNode(&mRearNode);
+    }
+
+    virtual void TearDown() override
+    {
+        mNode.Stop();
+        mNode.DisconnectNodes();
+    }
+
+    void SendPacket(ImsMediaSubType subtype, uint32_t seq, uint32_t size = kPacketSize)
+    {
+        std::vector<uint8_t> data(size, 0xAB);
+        mNode.OnDataFromFrontNode(subtype, data.data(), size, 0, false, seq);
+    }
+
+    void ProcessAt(uint64_t time)
+    {
+        mNode.SetTime(time);
+        mNode.ProcessData();
+    }
+};
+
+TEST_F(RtpPacerNodeTest, TestPassThroughWithoutRate)
+{
+    EXPECT_EQ(mNode.GetNodeId(), kNodeIdRtpPacer);
+    EXPECT_FALSE(mNode.IsRunTime());
+    EXPECT_EQ(mNode.Start(), RESULT_SUCCESS);
+    EXPECT_EQ(mNode.GetPacingRate(), 0);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        SendPacket(MEDIASUBTYPE_RTPPACKET, i);
+    }
+
+    EXPECT_EQ(mRearNode.mPackets.size(), 10);
+    EXPECT_EQ(mNode.GetDataCount(), 0);
+}
+
+TEST_F(RtpPacerNodeTest, TestRateFromConfig)
+{
+    VideoConfig config;
+    config.setBitrate(384);
+    mNode.SetConfig(&config);
+    EXPECT_EQ(mNode.GetPacingRate(), 960000);
+    EXPECT_TRUE(mNode.IsSameConfig(&config));
+
+    config.setBitrate(512);
+    EXPECT_FALSE(mNode.IsSameConfig(&config));
+    EXPECT_EQ(mNode.UpdateConfig(&config), RESULT_SUCCESS);
+    EXPECT_EQ(mNode.GetPacingRate(), 1280000);
+
+    mNode.SetRateFactor(1.5);
+    EXPECT_EQ(mNode.GetPacingRate(), 768000);
+}
+
+TEST_F(RtpPacerNodeTest, TestPaceBurst)
+{
+    mNode.SetTargetBitrate(kTargetBitrate);
+    ASSERT_EQ(mNode.GetPacingRate(), kPacingRate);
+    mNode.SetBurstSize(2 * kPacketSize);
+    mNode.Start();
+
+    // a frame of 20 packets given at once
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        SendPacket(MEDIASUBTYPE_RTPPACKET, i);
+    }
+
+    EXPECT_TRUE(mRearNode.mPackets.empty());
+    EXPECT_EQ(mNode.GetDataCount(), 20);
+
+    // the full bucket sends the burst size at first
+    ProcessAt(kStartTime);
+    EXPECT_EQ(mRearNode.mPackets.size(), 2);
+
+    // a packet every 10 ms after the burst
+    for (uint32_t i = 1; i <= 18; i++)
+    {
+        ProcessAt(kStartTime + i * 10000 - 100);
+        EXPECT_EQ(mRearNode.mPackets.size(), i + 1);
+        ProcessAt(kStartTime + i * 10000);
+        EXPECT_EQ(mRearNode.mPackets.size(), i + 2);
+    }
+
+    EXPECT_EQ(mNode.GetDataCount(), 0);
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        EXPECT_EQ(mRearNode.mPackets[i].seq, i);
+    }
+
+    RtpPacerStats stats = mNode.GetStats();
+    EXPECT_EQ(stats.received[kRtpPacerPriorityVideo], 20);
+    EXPECT_EQ(stats.sent[kRtpPacerPriorityVideo], 20);
+    EXPECT_EQ(stats.maxQueueDelay[kRtpPacerPriorityVideo], 180000);
+}
+
+TEST_F(RtpPacerNodeTest, TestLargePacketDebt)
+{
+    mNode.SetTargetBitrate(kTargetBitrate);
+    mNode.SetBurstSize(kPacketSize);
+    mNode.Start();
+
+    // the packet larger than the bucket is sent with the full bucket and the next one waits
+    SendPacket(MEDIASUBTYPE_RTPPACKET, 0, 3 * kPacketSize);
+    SendPacket(MEDIASUBTYPE_RTPPACKET, 1);
+    ProcessAt(kStartTime);
+    EXPECT_EQ(mRearNode.mPackets.size(), 1);
+
+    ProcessAt(kStartTime + 29900);
+    EXPECT_EQ(mRearNode.mPackets.size(), 1);
+    ProcessAt(kStartTime + 30000);
+    EXPECT_EQ(mRearNode.mPackets.size(), 2);
+}
+
+TEST_F(RtpPacerNodeTest, TestPriority)
+{
+    mNode.SetTargetBitrate(kTargetBitrate);
+    mNode.SetBurstSize(kPacketSize);
+    mNode.Start();
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        SendPacket(MEDIASUBTYPE_RTPPACKET, i);
+    }
+
+    std::vector<uint8_t> data(kPacketSize, 0);
+    mNode.EnqueuePacket(kRtpPacerPriorityRetransmission, MEDIASUBTYPE_RTPPACKET, data.data(),
+            kPacketSize, 0, false, 100);
+    SendPacket(MEDIASUBTYPE_RTCPPACKET, 200, 100);
+
+    // the rtcp and the retransmission overtake the queued video packets
+    for (uint32_t i = 0; i <= 6; i++)
+    {
+        ProcessAt(kStartTime + i * 10000);
+    }
+
+    const std::vector<uint32_t> kExpected = {200, 100, 0, 1, 2, 3, 4};
+    ASSERT_EQ(mRearNode.mPackets.size(), kExpected.size());
+
+    for (uint32_t i = 0; i < kExpected.size(); i++)
+    {
+        EXPECT_EQ(mRearNode.mPackets[i].seq, kExpected[i]);
+    }
+
+    EXPECT_EQ(mRearNode.mPackets[0].subtype, MEDIASUBTYPE_RTCPPACKET);
+
+    RtpPacerStats stats = mNode.GetStats();
+    EXPECT_EQ(stats.sent[kRtpPacerPriorityRtcp], 1);
+    EXPECT_EQ(stats.sent[kRtpPacerPriorityRetransmission], 1);
+    EXPECT_EQ(stats.sent[kRtpPacerPriorityVideo], 5);
+}
+
+TEST_F(RtpPacerNodeTest, TestAudioPriority)
+{
+    mNode.SetMediaType(IMS_MEDIA_AUDIO);
+    mNode.SetTargetBitrate(kTargetBitrate);
+    mNode.Start();
+
+    SendPacket(MEDIASUBTYPE_RTPPACKET, 1, 100);
+    ProcessAt(kStartTime);
+
+    RtpPacerStats stats = mNode.GetStats();
+    EXPECT_EQ(stats.sent[kRtpPacerPriorityAudio], 1);
+    EXPECT_EQ(stats.sent[kRtpPacerPriorityVideo], 0);
+}
+
+TEST_F(RtpPacerNodeTest, TestStopClearsQueue)
+{
+    mNode.SetTargetBitrate(kTargetBitrate);
+    mNode.SetBurstSize(kPacketSize);
+    mNode.Start();
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        SendPacket(MEDIASUBTYPE_RTPPACKET, i);
+    }
+
+    ProcessAt(kStartTime);
+    EXPECT_EQ(mNode.GetDataCount(), 4);
+
+    mNode.Stop();
+    EXPECT_EQ(mNode.GetDataCount(), 0);
+    ProcessAt(kStartTime + 100000);
+    EXPECT_EQ(mRearNode.mPackets.size(), 1);
+}
+TEST_F(RtpPacerNodeTest, TestMaxQueueDelay)
+{
+    mNode.SetTargetBitrate(kTargetBitrate);
+    mNode.SetBurstSize(kPacketSize);
+    mNode.SetMaxQueueDelay(100);
+    mNode.Start();
+
+    // 200 ms at the pacing rate
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        SendPacket(MEDIASUBTYPE_RTPPACKET, i);
+    }
+
+    for (uint32_t i = 0; i <= 10; i++)
+    {
+        ProcessAt(kStartTime + i * 10000);
+    }
+
+    // the rate is raised to send all the packets within the max queue delay
+    ASSERT_EQ(mRearNode.mPackets.size(), 20);
+    EXPECT_LE(mNode.GetStats().maxQueueDelay[kRtpPacerPriorityVideo], 100000);
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        EXPECT_EQ(mRearNode.mPackets[i].seq, i);
+    }
+
+    // the packet waited longer than the max queue delay is sent without the tokens
+    SendPacket(MEDIASUBTYPE_RTPPACKET, 20, 3 * kPacketSize);
+    SendPacket(MEDIASUBTYPE_RTPPACKET, 21);
+    ProcessAt(kStartTime + 110000);
+    EXPECT_EQ(mRearNode.mPackets.size(), 21);
+    mNode.SetMaxQueueDelay(0);
+    ProcessAt(kStartTime + 130000);
+    EXPECT_EQ(mRearNode.mPackets.size(), 21);
+    mNode.SetMaxQueueDelay(10);
+    ProcessAt(kStartTime + 130000);
+    EXPECT_EQ(mRearNode.mPackets.size(), 22);
+}
+
+TEST_F(RtpPacerNodeTest, TestNoOvertakeWhileDraining)
+{
+    ReentrantRearNode rearNode(&mNode);
+    mNode.DisconnectNodes();
+    mNode.ConnectRearNode(&rearNode);
+    mNode.SetTargetBitrate(kTargetBitrate);
+    mNode.SetBurstSize(kPacketSize);
+    mNode.Start();
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        SendPacket(MEDIASUBTYPE_RTPPACKET, i);
+    }
+
+    // the pacing is disabled with the packets in the queue, they are sent at once and the packet
+    // given during the sending waits for them
+    mNode.SetTargetBitrate(0);
+    ProcessAt(kStartTime);
+    EXPECT_EQ(mNode.GetDataCount(), 1);
+    ProcessAt(kStartTime + 1000);
+
+    const std::vector<uint32_t> kExpected = {0, 1, 2, 100};
+    ASSERT_EQ(rearNode.mPackets.size(), kExpected.size());
+
+    for (uint32_t i = 0; i < kExpected.size(); i++)
+    {
+        EXPECT_EQ(rearNode.mPackets[i].seq, kExpected[i]);
+    }
+
+    mNode.DisconnectNodes();
+}
+}  // namespace
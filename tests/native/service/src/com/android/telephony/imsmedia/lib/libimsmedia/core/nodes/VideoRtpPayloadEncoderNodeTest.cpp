@@ -0,0 +1,329 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <VideoConfig.h>
+#include <VideoRtpPayloadEncoderNode.h>
+#include <VideoRtpPayloadDecoderNode.h>
+#include <vector>
+
+using namespace android::telephony::imsmedia;
+
+namespace
+{
+const int32_t kMtu = 1300;
+const uint32_t kTimestamp = 3000;
+
+const std::vector<uint8_t> kAvcSps = {0x67, 0x42, 0xC0, 0x0C, 0xDA, 0x0F};
+const std::vector<uint8_t> kAvcPps = {0x68, 0xCE, 0x3C, 0x80};
+const std::vector<uint8_t> kAvcIdr = {0x65, 0x88, 0x84, 0x21, 0xA0};
+const std::vector<uint8_t> kHevcVps = {0x40, 0x01, 0x0C, 0x01};
+const std::vector<uint8_t> kHevcSps = {0x42, 0x01, 0x01, 0x01, 0x60};
+const std::vector<uint8_t> kHevcPps = {0x44, 0x01, 0xC1, 0x72};
+const std::vector<uint8_t> kHevcIdr = {0x26, 0x01, 0xAF, 0x06, 0xB8};
+
+struct ReceivedPacket
+{
+    ImsMediaSubType subtype;
+    std::vector<uint8_t> data;
+    bool mark;
+    ImsMediaSubType dataType;
+};
+
+class FakeNode : public BaseNode
+{
+public:
+    virtual ~FakeNode() {}
+    void Stop() {}
+    bool IsRunTime() { return true; }
+    bool IsSourceNode() { return false; }
+    virtual kBaseNodeState GetState() { return kNodeStateRunning; }
+    void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size, uint32_t,
+            bool mark, uint32_t, ImsMediaSubType dataType, uint32_t)
+    {
+        mPackets.push_back({subtype, std::vector<uint8_t>(data, data + size), mark, dataType});
+    }
+
+    ImsMediaResult Start() { return RESULT_SUCCESS; }
+
+    std::vector<ReceivedPacket> mPackets;
+};
+
+void appendNalUnit(std::vector<uint8_t>& frame, const std::vector<uint8_t>& nal)
+{
+    frame.insert(frame.end(), {0x00, 0x00, 0x00, 0x01});
+    frame.insert(frame.end(), nal.begin(), nal.end());
+}
+
+std::vector<uint8_t> withStartCode(const std::vector<uint8_t>& nal)
+{
+    std::vector<uint8_t> data;
+    appendNalUnit(data, nal);
+    return data;
+}
+
+class VideoRtpPayloadEncoderNodeTest : public ::testing::Test
+{
+public:
+    VideoRtpPayloadEncoderNodeTest() {}
+    virtual ~VideoRtpPayloadEncoderNodeTest() {}
+
+protected:
+    VideoConfig mConfig;
+    VideoRtpPayloadEncoderNode mEncoder;
+    VideoRtpPayloadDecoderNode mDecoder;
+    FakeNode mEncoderRearNode;
+    FakeNode mDecoderRearNode;
+
+    virtual void SetUp() override
+    {
+        mConfig.setMaxMtuBytes(kMtu);
+        mConfig.setPacketizationMode(VideoConfig::MODE_NON_INTERLEAVED);
+        mEncoder.SetMediaType(IMS_MEDIA_VIDEO);
+        mDecoder.SetMediaType(IMS_MEDIA_VIDEO);
+        mEncoder.ConnectRearNode(&mEncoderRearNode);
+        mDecoder.ConnectRearNode(&mDecoderRearNode);
+    }
+
+    virtual void TearDown() override
+    {
+        mEncoder.Stop();
+        mDecoder.Stop();
+        mEncoder.DisconnectNodes();
+        mDecoder.DisconnectNodes();
+    }
+
+    void StartNodes(int32_t codecType)
+    {
+        mConfig.setCodecType(codecType);
+        mEncoder.SetConfig(&mConfig);
+        mDecoder.SetConfig(&mConfig);
+        ASSERT_EQ(mEncoder.Start(), RESULT_SUCCESS);
+        ASSERT_EQ(mDecoder.Start(), RESULT_SUCCESS);
+    }
+
+    void SendFrame(std::vector<uint8_t>& frame, bool mark = true)
+    {
+        mEncoder.OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, frame.data(), frame.size(),
+                kTimestamp, mark, 0, MEDIASUBTYPE_UNDEFINED, 0);
+    }
+
+    // decode all the packets sent by the encoder
+    void DecodePackets()
+    {
+        uint32_t seq = 0;
+
+        for (auto& packet : mEncoderRearNode.mPackets)
+        {
+            mDecoder.OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, packet.data.data(),
+                    packet.data.size(), kTimestamp, packet.mark, seq++, MEDIASUBTYPE_UNDEFINED, 0);
+        }
+    }
+};
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestAvcStapA)
+{
+    StartNodes(VideoConfig::CODEC_AVC);
+
+    std::vector<uint8_t> frame;
+    appendNalUnit(frame, kAvcSps);
+    appendNalUnit(frame, kAvcPps);
+    appendNalUnit(frame, kAvcIdr);
+    SendFrame(frame);
+
+    // sps, pps and the idr slice are sent in one STAP-A packet
+    ASSERT_EQ(mEncoderRearNode.mPackets.size(), 1);
+    ReceivedPacket& packet = mEncoderRearNode.mPackets[0];
+    EXPECT_EQ(packet.subtype, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    EXPECT_TRUE(packet.mark);
+
+    std::vector<uint8_t> expected = {0x78, 0x00, static_cast<uint8_t>(kAvcSps.size())};
+    expected.insert(expected.end(), kAvcSps.begin(), kAvcSps.end());
+    expected.insert(expected.end(), {0x00, static_cast<uint8_t>(kAvcPps.size())});
+    expected.insert(expected.end(), kAvcPps.begin(), kAvcPps.end());
+    expected.insert(expected.end(), {0x00, static_cast<uint8_t>(kAvcIdr.size())});
+    expected.insert(expected.end(), kAvcIdr.begin(), kAvcIdr.end());
+    EXPECT_EQ(packet.data, expected);
+
+    DecodePackets();
+    ASSERT_EQ(mDecoderRearNode.mPackets.size(), 3);
+    EXPECT_EQ(mDecoderRearNode.mPackets[0].data, withStartCode(kAvcSps));
+    EXPECT_EQ(mDecoderRearNode.mPackets[0].dataType, MEDIASUBTYPE_VIDEO_CONFIGSTRING);
+    EXPECT_FALSE(mDecoderRearNode.mPackets[0].mark);
+    EXPECT_EQ(mDecoderRearNode.mPackets[1].data, withStartCode(kAvcPps));
+    EXPECT_EQ(mDecoderRearNode.mPackets[1].dataType, MEDIASUBTYPE_VIDEO_CONFIGSTRING);
+    EXPECT_EQ(mDecoderRearNode.mPackets[2].data, withStartCode(kAvcIdr));
+    EXPECT_EQ(mDecoderRearNode.mPackets[2].dataType, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    EXPECT_TRUE(mDecoderRearNode.mPackets[2].mark);
+}
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestAvcSingleNalUnitWithoutAggregation)
+{
+    StartNodes(VideoConfig::CODEC_AVC);
+
+    std::vector<uint8_t> frame;
+    const std::vector<uint8_t> kSlice = {0x41, 0x9A, 0x02, 0x03};
+    appendNalUnit(frame, kSlice);
+    SendFrame(frame);
+
+    ASSERT_EQ(mEncoderRearNode.mPackets.size(), 1);
+    EXPECT_EQ(mEncoderRearNode.mPackets[0].data, kSlice);
+    EXPECT_EQ(mEncoderRearNode.mPackets[0].subtype, MEDIASUBTYPE_RTPPAYLOAD);
+    EXPECT_TRUE(mEncoderRearNode.mPackets[0].mark);
+}
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestAvcFlushBeforeFragmentation)
+{
+    StartNodes(VideoConfig::CODEC_AVC);
+
+    std::vector<uint8_t> idr(kMtu * 2, 0x5A);
+    idr[0] = 0x65;
+    std::vector<uint8_t> frame;
+    appendNalUnit(frame, kAvcSps);
+    appendNalUnit(frame, kAvcPps);
+    appendNalUnit(frame, idr);
+    SendFrame(frame);
+
+    // the parameter sets are aggregated without the marker bit and the slice is fragmented
+    ASSERT_GE(mEncoderRearNode.mPackets.size(), 3);
+    EXPECT_EQ(mEncoderRearNode.mPackets[0].data[0] & 0x1F, 24);
+    EXPECT_FALSE(mEncoderRearNode.mPackets[0].mark);
+    EXPECT_EQ(mEncoderRearNode.mPackets[1].data[0] & 0x1F, 28);
+    EXPECT_TRUE(mEncoderRearNode.mPackets.back().mark);
+
+    for (auto& packet : mEncoderRearNode.mPackets)
+    {
+        EXPECT_LE(packet.data.size(), kMtu);
+    }
+
+    DecodePackets();
+    ASSERT_GE(mDecoderRearNode.mPackets.size(), 3);
+    EXPECT_EQ(mDecoderRearNode.mPackets[0].data, withStartCode(kAvcSps));
+    EXPECT_EQ(mDecoderRearNode.mPackets[1].data, withStartCode(kAvcPps));
+
+    std::vector<uint8_t> reassembled;
+
+    for (size_t i = 2; i < mDecoderRearNode.mPackets.size(); i++)
+    {
+        std::vector<uint8_t>& data = mDecoderRearNode.mPackets[i].data;
+        reassembled.insert(reassembled.end(), data.begin(), data.end());
+    }
+
+    EXPECT_EQ(reassembled, withStartCode(idr));
+}
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestAvcSingleNalUnitMode)
+{
+    mConfig.setPacketizationMode(VideoConfig::MODE_SINGLE_NAL_UNIT);
+    StartNodes(VideoConfig::CODEC_AVC);
+
+    std::vector<uint8_t> frame;
+    appendNalUnit(frame, kAvcSps);
+    appendNalUnit(frame, kAvcPps);
+    appendNalUnit(frame, kAvcIdr);
+    SendFrame(frame);
+
+    // the aggregation packet is not allowed in the single nal unit mode
+    ASSERT_EQ(mEncoderRearNode.mPackets.size(), 3);
+    EXPECT_EQ(mEncoderRearNode.mPackets[0].data, kAvcSps);
+    EXPECT_EQ(mEncoderRearNode.mPackets[1].data, kAvcPps);
+    EXPECT_EQ(mEncoderRearNode.mPackets[2].data, kAvcIdr);
+    EXPECT_TRUE(mEncoderRearNode.mPackets[2].mark);
+}
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestAggregationBoundedByMtu)
+{
+    StartNodes(VideoConfig::CODEC_AVC);
+
+    // the slice fits in a single nal unit packet but not in the STAP-A with the parameter sets
+    const uint32_t kPayloadLimit = kMtu * 0.9;
+    std::vector<uint8_t> idr(kPayloadLimit - 10, 0x5A);
+    idr[0] = 0x65;
+    std::vector<uint8_t> frame;
+    appendNalUnit(frame, kAvcSps);
+    appendNalUnit(frame, kAvcPps);
+    appendNalUnit(frame, idr);
+    SendFrame(frame);
+
+    ASSERT_EQ(mEncoderRearNode.mPackets.size(), 2);
+    EXPECT_EQ(mEncoderRearNode.mPackets[0].data[0] & 0x1F, 24);
+    EXPECT_FALSE(mEncoderRearNode.mPackets[0].mark);
+    EXPECT_EQ(mEncoderRearNode.mPackets[1].data, idr);
+    EXPECT_EQ(mEncoderRearNode.mPackets[1].subtype, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    EXPECT_TRUE(mEncoderRearNode.mPackets[1].mark);
+
+    // the nal units are not aggregated across the frames
+    const std::vector<uint8_t> kSlice = {0x41, 0x9A, 0x02, 0x03};
+
+    for (int i = 0; i < 3; i++)
+    {
+        frame.clear();
+        appendNalUnit(frame, kSlice);
+        SendFrame(frame, false);
+    }
+
+    ASSERT_EQ(mEncoderRearNode.mPackets.size(), 5);
+    EXPECT_EQ(mEncoderRearNode.mPackets[4].data, kSlice);
+}
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestHevcAggregationPacket)
+{
+    StartNodes(VideoConfig::CODEC_HEVC);
+
+    std::vector<uint8_t> frame;
+    appendNalUnit(frame, kHevcVps);
+    appendNalUnit(frame, kHevcSps);
+    appendNalUnit(frame, kHevcPps);
+    appendNalUnit(frame, kHevcIdr);
+    SendFrame(frame);
+
+    ASSERT_EQ(mEncoderRearNode.mPackets.size(), 1);
+    ReceivedPacket& packet = mEncoderRearNode.mPackets[0];
+    EXPECT_EQ(packet.subtype, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    EXPECT_TRUE(packet.mark);
+    // type 48 with the layer id 0 and the temporal id 1
+    EXPECT_EQ(packet.data[0], 0x60);
+    EXPECT_EQ(packet.data[1], 0x01);
+
+    DecodePackets();
+    // the parameter sets of the stream are followed by the ones sent again for the idr
+    const std::vector<std::vector<uint8_t>> kExpected = {
+            kHevcVps, kHevcSps, kHevcPps, kHevcVps, kHevcSps, kHevcPps, kHevcIdr};
+    ASSERT_EQ(mDecoderRearNode.mPackets.size(), kExpected.size());
+
+    for (size_t i = 0; i < kExpected.size(); i++)
+    {
+        EXPECT_EQ(mDecoderRearNode.mPackets[i].data, withStartCode(kExpected[i]));
+    }
+
+    EXPECT_EQ(mDecoderRearNode.mPackets[0].dataType, MEDIASUBTYPE_VIDEO_CONFIGSTRING);
+    EXPECT_EQ(mDecoderRearNode.mPackets.back().dataType, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    EXPECT_TRUE(mDecoderRearNode.mPackets.back().mark);
+}
+
+TEST_F(VideoRtpPayloadEncoderNodeTest, TestDecodeMalformedAggregationPacket)
+{
+    StartNodes(VideoConfig::CODEC_AVC);
+
+    // the size of the second nal unit exceeds the packet
+    std::vector<uint8_t> packet = {0x78, 0x00, 0x02, 0x67, 0x42, 0x00, 0x10, 0x68};
+    mDecoder.OnDataFromFrontNode(MEDIASUBTYPE_UNDEFINED, packet.data(), packet.size(), kTimestamp,
+            true, 0, MEDIASUBTYPE_UNDEFINED, 0);
+
+    ASSERT_EQ(mDecoderRearNode.mPackets.size(), 1);
+    EXPECT_EQ(mDecoderRearNode.mPackets[0].data, withStartCode({0x67, 0x42}));
+}
+}  // namespace
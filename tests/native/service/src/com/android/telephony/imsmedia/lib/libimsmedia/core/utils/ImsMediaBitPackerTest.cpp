@@ -0,0 +1,268 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ImsMediaAudioUtil.h>
+#include <ImsMediaBitPacker.h>
+#include <ImsMediaBitReader.h>
+#include <ImsMediaBitWriter.h>
+#include <BaseNode.h>
+#include <stdlib.h>
+#include <vector>
+
+class ImsMediaBitPackerTest : public ::testing::Test
+{
+public:
+protected:
+    virtual void SetUp() override { srand(1234); }
+
+    virtual void TearDown() override { ImsMediaBitPacker::SetSimdEnabled(true); }
+};
+
+namespace
+{
+const uint32_t kMaxBitSize = 640;
+const uint32_t kGuardSize = 4;
+
+// The bit by bit accesses to verify the packer against
+uint32_t getBit(const uint8_t* buffer, uint32_t pos)
+{
+    return (buffer[pos >> 3] >> (7 - (pos & 0x07))) & 0x01;
+}
+
+void setBit(uint8_t* buffer, uint32_t pos, uint32_t bit)
+{
+    uint8_t mask = 0x80 >> (pos & 0x07);
+    buffer[pos >> 3] = bit ? (buffer[pos >> 3] | mask) : (buffer[pos >> 3] & ~mask);
+}
+
+void fillRandom(std::vector<uint8_t>& buffer)
+{
+    for (auto& value : buffer)
+    {
+        value = rand() & 0xFF;
+    }
+}
+
+// The bandwidth efficient payload of frames following the header fields, e.g. the CMR and ToC
+// fields of the AMR payload of RFC 4867 4.4 or the CMR of the EVS AMR-WB IO compact payload of
+// 3GPP TS 26.445 A.2.1
+struct PayloadLayout
+{
+    uint32_t headerBitSize;
+    uint32_t tocBitSize;
+    std::vector<uint32_t> frameBitSizes;
+};
+
+std::vector<PayloadLayout> getPayloadLayouts()
+{
+    std::vector<PayloadLayout> layouts;
+
+    for (uint32_t mode = kImsAudioAmrMode475; mode <= kImsAudioAmrModeSID; mode++)
+    {
+        uint32_t bits = ImsMediaAudioUtil::ConvertAmrModeToBitLen(mode);
+
+        for (uint32_t frames = 1; frames <= MAX_FRAME_IN_PACKET; frames++)
+        {
+            layouts.push_back({4, 6, std::vector<uint32_t>(frames, bits)});
+        }
+    }
+
+    for (uint32_t mode = kImsAudioAmrWbMode660; mode <= kImsAudioAmrWbModeSID; mode++)
+    {
+        uint32_t bits = ImsMediaAudioUtil::ConvertAmrWbModeToBitLen(mode);
+
+        for (uint32_t frames = 1; frames <= MAX_FRAME_IN_PACKET; frames++)
+        {
+            layouts.push_back({4, 6, std::vector<uint32_t>(frames, bits)});
+        }
+    }
+
+    for (uint32_t mode = kImsAudioEvsAmrWbIoMode660; mode <= kImsAudioEvsAmrWbIoMode2385; mode++)
+    {
+        layouts.push_back(
+                {3, 0, {ImsMediaAudioUtil::ConvertEVSAMRIOAudioModeToBitLen(mode) - 3}});
+    }
+
+    for (uint32_t mode = kImsAudioEvsPrimaryMode5900; mode <= kImsAudioEvsPrimaryMode128000;
+            mode++)
+    {
+        layouts.push_back({0, 0, {ImsMediaAudioUtil::ConvertEVSAudioModeToBitLen(mode)}});
+    }
+
+    // the frames of the different modes in a packet
+    layouts.push_back({4, 6, {95, 477, 40, 132, 253, 35, 244}});
+    return layouts;
+}
+}  // namespace
+
+TEST_F(ImsMediaBitPackerTest, PackMatchesReference)
+{
+    for (bool simd : {false, true})
+    {
+        ImsMediaBitPacker::SetSimdEnabled(simd);
+
+        for (uint32_t pos = 0; pos < 8; pos++)
+        {
+            for (uint32_t size = 0; size <= kMaxBitSize; size++)
+            {
+                std::vector<uint8_t> src((size + 7) / 8 + kGuardSize);
+                std::vector<uint8_t> dst((pos + size + 7) / 8 + kGuardSize);
+                fillRandom(src);
+                fillRandom(dst);
+                std::vector<uint8_t> expected(dst);
+
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    setBit(expected.data(), pos + i, getBit(src.data(), i));
+                }
+
+                // the bits after the packed bits in the last byte are cleared
+                for (uint32_t i = pos + size; size > 0 && (i & 0x07) != 0; i++)
+                {
+                    setBit(expected.data(), i, 0);
+                }
+
+                ImsMediaBitPacker::Pack(dst.data(), pos, src.data(), size);
+                ASSERT_EQ(dst, expected) << "simd=" << simd << " pos=" << pos << " size=" << size;
+            }
+        }
+    }
+}
+
+TEST_F(ImsMediaBitPackerTest, UnpackMatchesReference)
+{
+    for (bool simd : {false, true})
+    {
+        ImsMediaBitPacker::SetSimdEnabled(simd);
+
+        for (uint32_t pos = 0; pos < 8; pos++)
+        {
+            for (uint32_t size = 0; size <= kMaxBitSize; size++)
+            {
+                std::vector<uint8_t> src((pos + size + 7) / 8);
+                std::vector<uint8_t> dst((size + 7) / 8 + kGuardSize);
+                fillRandom(src);
+                fillRandom(dst);
+                std::vector<uint8_t> expected(dst);
+
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    setBit(expected.data(), i, getBit(src.data(), pos + i));
+                }
+
+                for (uint32_t i = size; size > 0 && (i & 0x07) != 0; i++)
+                {
+                    setBit(expected.data(), i, 0);
+                }
+
+                // the source is sized to the last bit to catch the reads after it
+                ImsMediaBitPacker::Unpack(dst.data(), src.data(), pos, size);
+                ASSERT_EQ(dst, expected) << "simd=" << simd << " pos=" << pos << " size=" << size;
+            }
+        }
+    }
+}
+
+TEST_F(ImsMediaBitPackerTest, PayloadRoundTrip)
+{
+    std::vector<PayloadLayout> layouts = getPayloadLayouts();
+
+    for (bool simd : {false, true})
+    {
+        ImsMediaBitPacker::SetSimdEnabled(simd);
+
+        for (const auto& layout : layouts)
+        {
+            uint32_t numFrames = layout.frameBitSizes.size();
+            uint32_t totalBitSize = layout.headerBitSize + layout.tocBitSize * numFrames;
+
+            for (uint32_t bits : layout.frameBitSizes)
+            {
+                totalBitSize += bits;
+            }
+
+            if (totalBitSize > MAX_AUDIO_PAYLOAD_SIZE * 8)
+            {
+                continue;
+            }
+
+            std::vector<uint8_t> payload(MAX_AUDIO_PAYLOAD_SIZE, 0);
+            std::vector<uint8_t> expected(MAX_AUDIO_PAYLOAD_SIZE, 0);
+            std::vector<std::vector<uint8_t>> frames;
+            std::vector<uint32_t> fields;
+            uint32_t pos = 0;
+
+            ImsMediaBitWriter writer;
+            writer.SetBuffer(payload.data(), payload.size());
+
+            // the header and the ToC fields
+            for (uint32_t i = 0; i < 1 + numFrames; i++)
+            {
+                uint32_t size = i == 0 ? layout.headerBitSize : layout.tocBitSize;
+                uint32_t value = size > 0 ? rand() & ((1 << size) - 1) : 0;
+                fields.push_back(value);
+                writer.Write(value, size);
+
+                for (uint32_t bit = 0; bit < size; bit++)
+                {
+                    setBit(expected.data(), pos++, (value >> (size - 1 - bit)) & 0x01);
+                }
+            }
+
+            for (uint32_t bits : layout.frameBitSizes)
+            {
+                std::vector<uint8_t> frame((bits + 7) / 8);
+                fillRandom(frame);
+                writer.WriteByteBuffer(frame.data(), bits);
+
+                for (uint32_t bit = 0; bit < bits; bit++)
+                {
+                    setBit(expected.data(), pos++, getBit(frame.data(), bit));
+                }
+
+                // the bits after the frame are not part of the payload
+                for (uint32_t bit = bits; (bit & 0x07) != 0; bit++)
+                {
+                    setBit(frame.data(), bit, 0);
+                }
+
+                frames.push_back(frame);
+            }
+
+            writer.AddPadding();
+            writer.Flush();
+            ASSERT_EQ(writer.GetBufferSize(), (totalBitSize + 7) / 8);
+            ASSERT_EQ(payload, expected) << "simd=" << simd << " bits=" << totalBitSize;
+
+            ImsMediaBitReader reader;
+            reader.SetBuffer(payload.data(), writer.GetBufferSize());
+
+            for (uint32_t i = 0; i < 1 + numFrames; i++)
+            {
+                EXPECT_EQ(reader.Read(i == 0 ? layout.headerBitSize : layout.tocBitSize),
+                        fields[i]);
+            }
+
+            for (uint32_t i = 0; i < numFrames; i++)
+            {
+                std::vector<uint8_t> frame(frames[i].size());
+                reader.ReadByteBuffer(frame.data(), layout.frameBitSizes[i]);
+                ASSERT_EQ(frame, frames[i]) << "simd=" << simd << " frame=" << i;
+            }
+        }
+    }
+}
@@ -73,3 +73,63 @@ TEST_F(ImsMediaBitReaderTest, SetBufferAndReadUEModeTest)
     EXPECT_EQ(reader.ReadByUEMode(), 2);
     EXPECT_EQ(reader.ReadByUEMode(), 1);
 }
+
+TEST_F(ImsMediaBitReaderTest, ReadAcrossRefillTest)
+{
+    uint8_t testBuffer[32];
+
+    for (uint32_t i = 0; i < sizeof(testBuffer); i++)
+    {
+        testBuffer[i] = i * 37 + 11;
+    }
+
+    ImsMediaBitReader reader;
+    reader.SetBuffer(testBuffer, sizeof(testBuffer));
+
+    // read 3, 5, 7 ... bits and compare with the bits picked one by one
+    uint32_t bitPos = 0;
+
+    for (uint32_t size = 3; bitPos + size <= sizeof(testBuffer) * 8; size = (size + 2) % 24 + 1)
+    {
+        uint32_t expected = 0;
+
+        for (uint32_t i = 0; i < size; i++, bitPos++)
+        {
+            expected = (expected << 1) | ((testBuffer[bitPos / 8] >> (7 - bitPos % 8)) & 1);
+        }
+
+        EXPECT_EQ(reader.Read(size), expected) << "bit position " << bitPos;
+    }
+}
+
+TEST_F(ImsMediaBitReaderTest, ReadByteBufferUnalignedTest)
+{
+    uint8_t testBuffer[] = {0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6, 0x07, 0x18, 0x29, 0x3A, 0x4B, 0x5C};
+
+    ImsMediaBitReader reader;
+    reader.SetBuffer(testBuffer, sizeof(testBuffer));
+    EXPECT_EQ(reader.Read(4), 0xA);
+
+    // 10 bytes and 3 bits shifted by 4 bits
+    uint8_t dstBuffer[11] = {0};
+    reader.ReadByteBuffer(dstBuffer, 83);
+
+    const uint8_t kExpected[] = {
+            0x1B, 0x2C, 0x3D, 0x4E, 0x5F, 0x60, 0x71, 0x82, 0x93, 0xA4, 0xA0};
+    EXPECT_EQ(memcmp(dstBuffer, kExpected, sizeof(kExpected)), 0);
+    EXPECT_EQ(reader.Read(5), 0x15);
+    EXPECT_EQ(reader.Read(8), 0);
+}
+
+TEST_F(ImsMediaBitReaderTest, ReadUEModeLongCodeTest)
+{
+    // 11 zeros, 1 and 000 0000 0011 : 2^11 - 1 + 3, then 1 : 0, then 1000 000
+    uint8_t testBuffer[] = {0x00, 0x10, 0x07, 0x80};
+
+    ImsMediaBitReader reader;
+    reader.SetBuffer(testBuffer, sizeof(testBuffer));
+
+    EXPECT_EQ(reader.ReadByUEMode(), 2050);
+    EXPECT_EQ(reader.ReadByUEMode(), 0);
+    EXPECT_EQ(reader.Read(7), 0x40);
+}
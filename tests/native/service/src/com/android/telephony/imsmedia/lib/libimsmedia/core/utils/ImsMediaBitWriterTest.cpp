@@ -75,3 +75,42 @@ TEST_F(ImsMediaBitWriterTest, SetBufferAndSeekToWriteTest)
 
     EXPECT_EQ(memcmp(dstBuffer, testBuffer, sizeof(testBuffer)), 0);
 }
+
+TEST_F(ImsMediaBitWriterTest, WriteByteBufferUnalignedTest)
+{
+    const uint8_t kSource[] = {0x1B, 0x2C, 0x3D, 0x4E, 0x5F, 0x60, 0x71, 0x82, 0x93, 0xA4, 0xA0};
+    uint8_t dstBuffer[12] = {0};
+
+    ImsMediaBitWriter writer;
+    writer.SetBuffer(dstBuffer, sizeof(dstBuffer));
+    EXPECT_TRUE(writer.Write(0xA, 4));
+    EXPECT_TRUE(writer.WriteByteBuffer(const_cast<uint8_t*>(kSource), 83));
+    EXPECT_TRUE(writer.Write(0x15, 5));
+    EXPECT_TRUE(writer.Write(0xC, 4));
+    EXPECT_EQ(writer.GetBufferSize(), 12);
+
+    const uint8_t kExpected[] = {
+            0xA1, 0xB2, 0xC3, 0xD4, 0xE5, 0xF6, 0x07, 0x18, 0x29, 0x3A, 0x4B, 0x5C};
+    EXPECT_EQ(memcmp(dstBuffer, kExpected, sizeof(kExpected)), 0);
+    EXPECT_FALSE(writer.Write(0, 1));
+}
+
+TEST_F(ImsMediaBitWriterTest, WriteWordUnalignedTest)
+{
+    uint8_t dstBuffer[6] = {0};
+
+    ImsMediaBitWriter writer;
+    writer.SetBuffer(dstBuffer, sizeof(dstBuffer));
+    EXPECT_TRUE(writer.Write(0x5, 3));
+    EXPECT_TRUE(writer.WriteByteBuffer(0x12345678u));
+    writer.AddPadding();
+    writer.Flush();
+
+    // 101 + 0001 0010 0011 0100 0101 0110 0111 1000 + 0 0000
+    const uint8_t kExpected[] = {0xA2, 0x46, 0x8A, 0xCF, 0x00};
+    EXPECT_EQ(writer.GetBufferSize(), sizeof(kExpected));
+    EXPECT_EQ(memcmp(dstBuffer, kExpected, sizeof(kExpected)), 0);
+
+    // the word does not fit to the remaining byte
+    EXPECT_FALSE(writer.WriteByteBuffer(0x12345678u));
+}
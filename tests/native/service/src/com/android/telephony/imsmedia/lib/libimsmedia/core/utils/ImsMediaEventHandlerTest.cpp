@@ -0,0 +1,342 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <ImsMediaEventHandler.h>
+#include <ImsMediaEventHandlerId.h>
+#include <ImsMediaCondition.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct TrackedPayload
+{
+    explicit TrackedPayload(int32_t v = 0) :
+            value(v)
+    {
+        sAlive++;
+    }
+
+    ~TrackedPayload() { sAlive--; }
+
+    int32_t value;
+    static std::atomic<int32_t> sAlive;
+};
+
+std::atomic<int32_t> TrackedPayload::sAlive(0);
+
+class FakeEventHandler : public ImsMediaEventHandler
+{
+public:
+    FakeEventHandler() :
+            mBlocked(false),
+            mCount(0)
+    {
+    }
+
+    void setBlocked(bool blocked) { mBlocked = blocked; }
+
+    void release() { mConditionRelease.signal(); }
+
+    int32_t getCount() { return mCount.load(); }
+
+    std::vector<uint64_t> getEvents()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        return mEvents;
+    }
+
+    std::vector<int32_t> getPayloadValues()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        return mPayloadValues;
+    }
+
+    ImsMediaCondition mConditionReceived;
+    ImsMediaCondition mConditionBlocked;
+
+private:
+    virtual void processEvent(uint32_t event, uint64_t paramA, uint64_t paramB, uint64_t paramC,
+            ImsMediaEventPayload& payload)
+    {
+        (void)paramC;
+
+        if (mBlocked)
+        {
+            mBlocked = false;
+            mConditionBlocked.signal();
+            mConditionRelease.wait();
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            mEvents.push_back((static_cast<uint64_t>(event) << 32) | (paramA << 16) | paramB);
+            TrackedPayload* tracked = payload.Get<TrackedPayload>();
+
+            if (tracked != nullptr)
+            {
+                mPayloadValues.push_back(tracked->value);
+            }
+        }
+
+        mCount++;
+        mConditionReceived.signal();
+    }
+
+    std::atomic<bool> mBlocked;
+    std::atomic<int32_t> mCount;
+    std::mutex mMutex;
+    std::vector<uint64_t> mEvents;
+    std::vector<int32_t> mPayloadValues;
+    ImsMediaCondition mConditionRelease;
+};
+
+static bool waitCount(FakeEventHandler& handler, int32_t count)
+{
+    for (int32_t i = 0; i < 200 && handler.getCount() < count; i++)
+    {
+        handler.mConditionReceived.wait_timeout(10);
+    }
+
+    return handler.getCount() == count;
+}
+
+TEST(ImsMediaEventHandlerTest, TestHandlerId)
+{
+    // the name is not registered until a handler is initialized with it
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId("TEST_ID_EVENT"), IM_EVENT_HANDLER_ID_INVALID);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(""), IM_EVENT_HANDLER_ID_INVALID);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(nullptr), IM_EVENT_HANDLER_ID_INVALID);
+    EXPECT_FALSE(ImsMediaEventHandler::SendEvent("TEST_ID_EVENT", 1, 0));
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId("TEST_ID_EVENT"), IM_EVENT_HANDLER_ID_INVALID);
+
+    FakeEventHandler handler;
+    handler.Init("TEST_ID_EVENT");
+    int32_t id = ImsMediaEventHandler::GetHandlerId("TEST_ID_EVENT");
+    EXPECT_NE(id, IM_EVENT_HANDLER_ID_INVALID);
+    EXPECT_GE(id, kReservedHandlerMax);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId("TEST_ID_EVENT"), id);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId("TEST_ID_OTHER_EVENT"),
+            IM_EVENT_HANDLER_ID_INVALID);
+    handler.Deinit();
+
+    // the id is kept for the name after the handler is deinitialized
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId("TEST_ID_EVENT"), id);
+    EXPECT_FALSE(ImsMediaEventHandler::SendEvent(id, 1, 0));
+    EXPECT_FALSE(ImsMediaEventHandler::SendEvent(IM_EVENT_HANDLER_MAX, 1, 0));
+
+    // the names of the manager handlers have the reserved ids
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(AUDIO_REQUEST_EVENT), kAudioRequestHandler);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(AUDIO_RESPONSE_EVENT), kAudioResponseHandler);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(VIDEO_REQUEST_EVENT), kVideoRequestHandler);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(VIDEO_RESPONSE_EVENT), kVideoResponseHandler);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(TEXT_REQUEST_EVENT), kTextRequestHandler);
+    EXPECT_EQ(ImsMediaEventHandler::GetHandlerId(TEXT_RESPONSE_EVENT), kTextResponseHandler);
+
+    FakeEventHandler reserved;
+    reserved.Init(TEXT_RESPONSE_EVENT);
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(kTextResponseHandler, 1, 2, 3));
+    EXPECT_TRUE(waitCount(reserved, 1));
+    reserved.Deinit();
+}
+
+TEST(ImsMediaEventHandlerTest, TestSendEvent)
+{
+    FakeEventHandler handler;
+    handler.Init("TEST_SEND_EVENT");
+    int32_t id = ImsMediaEventHandler::GetHandlerId("TEST_SEND_EVENT");
+
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(id, 1, 2, 3));
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent("TEST_SEND_EVENT", 4, 5, 6));
+    ASSERT_TRUE(waitCount(handler, 2));
+
+    std::vector<uint64_t> events = handler.getEvents();
+    EXPECT_EQ(events[0], (1ULL << 32) | (2 << 16) | 3);
+    EXPECT_EQ(events[1], (4ULL << 32) | (5 << 16) | 6);
+
+    handler.Deinit();
+    EXPECT_FALSE(ImsMediaEventHandler::SendEvent(id, 1, 2, 3));
+}
+
+TEST(ImsMediaEventHandlerTest, TestMultipleProducers)
+{
+    const int32_t kProducers = 4;
+    const int32_t kEvents = 50;
+    FakeEventHandler handler;
+    handler.Init("TEST_PRODUCER_EVENT");
+    int32_t id = ImsMediaEventHandler::GetHandlerId("TEST_PRODUCER_EVENT");
+
+    std::vector<std::thread> producers;
+
+    for (int32_t producer = 0; producer < kProducers; producer++)
+    {
+        producers.emplace_back(
+                [id, producer]()
+                {
+                    for (int32_t i = 0; i < kEvents; i++)
+                    {
+                        ImsMediaEventHandler::SendEvent(id, producer, i);
+                    }
+                });
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_TRUE(waitCount(handler, kProducers * kEvents));
+
+    // the events of each producer are delivered in the order sent
+    int64_t last[kProducers] = {-1, -1, -1, -1};
+
+    for (uint64_t event : handler.getEvents())
+    {
+        uint32_t producer = event >> 32;
+        int64_t sequence = (event >> 16) & 0xFFFF;
+        ASSERT_LT(producer, kProducers);
+        EXPECT_EQ(sequence, last[producer] + 1);
+        last[producer] = sequence;
+    }
+
+    handler.Deinit();
+}
+
+TEST(ImsMediaEventHandlerTest, TestQueueFull)
+{
+    FakeEventHandler handler;
+    handler.Init("TEST_FULL_EVENT");
+    int32_t id = ImsMediaEventHandler::GetHandlerId("TEST_FULL_EVENT");
+    handler.setBlocked(true);
+
+    // the first event blocks the handler thread after it is taken from the queue
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(id, 0, 0));
+
+    ASSERT_FALSE(handler.mConditionBlocked.wait_timeout(1000));
+
+    int32_t sent = 0;
+
+    while (ImsMediaEventHandler::SendEvent(id, 0, 0))
+    {
+        sent++;
+        ASSERT_LE(sent, IM_EVENT_QUEUE_SIZE);
+    }
+
+    EXPECT_EQ(sent, IM_EVENT_QUEUE_SIZE);
+    handler.release();
+    ASSERT_TRUE(waitCount(handler, sent + 1));
+
+    // the queue accepts the events again once it is drained
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(id, 0, 0));
+    EXPECT_TRUE(waitCount(handler, sent + 2));
+    handler.Deinit();
+}
+
+TEST(ImsMediaEventHandlerTest, TestPayload)
+{
+    ImsMediaEventPayload payload = ImsMediaEventPayload::Create<TrackedPayload>(7);
+    ASSERT_NE(payload.Get<TrackedPayload>(), nullptr);
+    EXPECT_EQ(payload.Get<TrackedPayload>()->value, 7);
+    EXPECT_EQ(payload.Get<int32_t>(), nullptr);
+    EXPECT_EQ(TrackedPayload::sAlive, 1);
+
+    ImsMediaEventPayload moved = std::move(payload);
+    EXPECT_TRUE(payload.IsEmpty());
+    EXPECT_EQ(TrackedPayload::sAlive, 1);
+    moved.Reset();
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+
+    // the payloads over the pool size are allocated from the heap
+    std::vector<ImsMediaEventPayload> payloads;
+
+    for (int32_t i = 0; i < IM_EVENT_PAYLOAD_POOL_SIZE + 4; i++)
+    {
+        payloads.push_back(ImsMediaEventPayload::Create<TrackedPayload>(i));
+        EXPECT_EQ(payloads.back().Get<TrackedPayload>()->value, i);
+    }
+
+    EXPECT_EQ(TrackedPayload::sAlive, IM_EVENT_PAYLOAD_POOL_SIZE + 4);
+    payloads.clear();
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+
+    ImsMediaEventPayload adopted = ImsMediaEventPayload::Adopt(new TrackedPayload(3));
+    EXPECT_EQ(adopted.Get<TrackedPayload>()->value, 3);
+    adopted.Reset();
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+}
+
+TEST(ImsMediaEventHandlerTest, TestSendPayload)
+{
+    FakeEventHandler handler;
+
+    // the payload is released when the event is not queued
+    EXPECT_FALSE(ImsMediaEventHandler::SendEvent(
+            "TEST_PAYLOAD_EVENT", 1, ImsMediaEventPayload::Create<TrackedPayload>(1), 0));
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+
+    handler.Init("TEST_PAYLOAD_EVENT");
+    int32_t id = ImsMediaEventHandler::GetHandlerId("TEST_PAYLOAD_EVENT");
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(
+            id, 1, ImsMediaEventPayload::Create<TrackedPayload>(2), 0));
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(
+            "TEST_PAYLOAD_EVENT", 1, ImsMediaEventPayload::Adopt(new TrackedPayload(3)), 0));
+    ASSERT_TRUE(waitCount(handler, 2));
+
+    std::vector<int32_t> values = handler.getPayloadValues();
+    ASSERT_EQ(values.size(), 2);
+    EXPECT_EQ(values[0], 2);
+    EXPECT_EQ(values[1], 3);
+
+    handler.Deinit();
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+}
+
+TEST(ImsMediaEventHandlerTest, TestDeinitReleasesPayload)
+{
+    const int32_t kEvents = 5;
+    FakeEventHandler handler;
+    handler.Init("TEST_DEINIT_EVENT");
+    int32_t id = ImsMediaEventHandler::GetHandlerId("TEST_DEINIT_EVENT");
+    handler.setBlocked(true);
+
+    EXPECT_TRUE(ImsMediaEventHandler::SendEvent(id, 0, 0));
+    ASSERT_FALSE(handler.mConditionBlocked.wait_timeout(1000));
+
+    for (int32_t i = 0; i < kEvents; i++)
+    {
+        EXPECT_TRUE(ImsMediaEventHandler::SendEvent(
+                id, 0, ImsMediaEventPayload::Create<TrackedPayload>(i), 0));
+    }
+
+    EXPECT_EQ(TrackedPayload::sAlive, kEvents);
+
+    // the thread stops after the blocked event and the queued payloads are released by Deinit
+    std::thread deinit(
+            [&handler]()
+            {
+                handler.Deinit();
+            });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    handler.release();
+    deinit.join();
+
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+    EXPECT_FALSE(ImsMediaEventHandler::SendEvent(
+            id, 0, ImsMediaEventPayload::Create<TrackedPayload>(0), 0));
+    EXPECT_EQ(TrackedPayload::sAlive, 0);
+}
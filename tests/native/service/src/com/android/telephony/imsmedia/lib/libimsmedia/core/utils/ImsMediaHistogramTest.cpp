@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <ImsMediaHistogram.h>
+#include <thread>
+#include <vector>
+
+TEST(ImsMediaHistogramTest, TestBucketIndex)
+{
+    for (uint64_t value = 0; value < IM_HISTOGRAM_SUB_BUCKETS; value++)
+    {
+        EXPECT_EQ(ImsMediaHistogram::GetBucketIndex(value), value);
+    }
+
+    // each bucket starts at its lower bound and ends before the next lower bound
+    for (uint32_t index = 0; index < IM_HISTOGRAM_BUCKETS - 1; index++)
+    {
+        uint64_t lower = ImsMediaHistogram::GetBucketLowerBound(index);
+        uint64_t upper = ImsMediaHistogram::GetBucketLowerBound(index + 1);
+        ASSERT_LT(lower, upper);
+        EXPECT_EQ(ImsMediaHistogram::GetBucketIndex(lower), index);
+        EXPECT_EQ(ImsMediaHistogram::GetBucketIndex(upper - 1), index);
+    }
+
+    EXPECT_EQ(ImsMediaHistogram::GetBucketIndex(1ULL << IM_HISTOGRAM_MAX_ORDER),
+            IM_HISTOGRAM_BUCKETS - 1);
+    EXPECT_EQ(ImsMediaHistogram::GetBucketIndex(UINT64_MAX), IM_HISTOGRAM_BUCKETS - 1);
+}
+
+TEST(ImsMediaHistogramTest, TestSnapshot)
+{
+    ImsMediaHistogram histogram;
+    ImsMediaHistogramSnapshot snapshot;
+
+    histogram.GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.min, 0);
+    EXPECT_EQ(snapshot.GetMean(), 0);
+    EXPECT_EQ(snapshot.GetPercentile(50), 0);
+
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.Add(value);
+    }
+
+    histogram.GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.count, 1000);
+    EXPECT_EQ(snapshot.sum, 500500);
+    EXPECT_EQ(snapshot.min, 1);
+    EXPECT_EQ(snapshot.max, 1000);
+    EXPECT_EQ(snapshot.GetMean(), 500);
+    EXPECT_EQ(snapshot.GetPercentile(0), 1);
+    EXPECT_EQ(snapshot.GetPercentile(100), 1000);
+
+    // the error of the estimation is less than the half of the bucket width
+    EXPECT_NEAR(snapshot.GetPercentile(50), 500, 500 / 16);
+    EXPECT_NEAR(snapshot.GetPercentile(90), 900, 900 / 16);
+    EXPECT_NEAR(snapshot.GetPercentile(99), 990, 990 / 16);
+
+    histogram.Reset();
+    histogram.GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.max, 0);
+}
+
+TEST(ImsMediaHistogramTest, TestAddFromThreads)
+{
+    const uint32_t kThreads = 4;
+    const uint32_t kValues = 10000;
+    ImsMediaHistogram histogram;
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 0; i < kThreads; i++)
+    {
+        threads.emplace_back(
+                [&histogram, i]()
+                {
+                    for (uint32_t value = 0; value < kValues; value++)
+                    {
+                        histogram.Add(value + i);
+                    }
+                });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    ImsMediaHistogramSnapshot snapshot;
+    histogram.GetSnapshot(snapshot);
+    EXPECT_EQ(snapshot.count, kThreads * kValues);
+    EXPECT_EQ(snapshot.min, 0);
+    EXPECT_EQ(snapshot.max, kValues - 1 + kThreads - 1);
+
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < IM_HISTOGRAM_BUCKETS; i++)
+    {
+        total += snapshot.buckets[i];
+    }
+
+    EXPECT_EQ(total, snapshot.count);
+}
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 #include <ImsMediaImageRotate.h>
+#include <stdlib.h>
+#include <vector>
 
 class ImsMediaImageRotateTest : public ::testing::Test
 {
@@ -23,9 +25,129 @@ public:
 protected:
     virtual void SetUp() override {}
 
-    virtual void TearDown() override {}
+    virtual void TearDown() override { ImsMediaImageRotate::SetSimdEnabled(true); }
 };
 
+namespace
+{
+// The pixel by pixel rotations to verify the tiled rotations against
+void referenceRotate90(uint8_t* dst, uint16_t stride, const uint8_t* y, const uint8_t* uv,
+        uint16_t width, uint16_t height)
+{
+    for (uint32_t r = 0; r < height; r++)
+    {
+        for (uint32_t c = 0; c < width; c++)
+        {
+            dst[c * stride + height - 1 - r] = y[r * width + c];
+        }
+    }
+
+    uint8_t* dstUv = dst + stride * width;
+
+    for (uint32_t r = 0; r < height / 2u; r++)
+    {
+        for (uint32_t c = 0; c < width / 2u; c++)
+        {
+            dstUv[c * stride + height - 2 - r * 2] = uv[r * width + c * 2];
+            dstUv[c * stride + height - 1 - r * 2] = uv[r * width + c * 2 + 1];
+        }
+    }
+}
+
+void referenceRotate270(uint8_t* dst, uint16_t stride, const uint8_t* y, const uint8_t* uv,
+        uint16_t width, uint16_t height)
+{
+    for (uint32_t r = 0; r < height; r++)
+    {
+        for (uint32_t c = 0; c < width; c++)
+        {
+            dst[(width - 1 - c) * stride + r] = y[r * width + c];
+        }
+    }
+
+    uint8_t* dstUv = dst + stride * width;
+
+    for (uint32_t r = 0; r < height / 2u; r++)
+    {
+        for (uint32_t c = 0; c < width / 2u; c++)
+        {
+            dstUv[(width / 2u - 1 - c) * stride + r * 2] = uv[r * width + c * 2];
+            dstUv[(width / 2u - 1 - c) * stride + r * 2 + 1] = uv[r * width + c * 2 + 1];
+        }
+    }
+}
+
+void referenceRotate90Flip(uint8_t* dst, const uint8_t* y, const uint8_t* uv, uint16_t width,
+        uint16_t height)
+{
+    for (uint32_t r = 0; r < height; r++)
+    {
+        for (uint32_t c = 0; c < width; c++)
+        {
+            dst[(width - 1 - c) * height + height - 1 - r] = y[r * width + c];
+        }
+    }
+
+    uint8_t* dstUv = dst + width * height;
+
+    for (uint32_t r = 0; r < height / 2u; r++)
+    {
+        for (uint32_t c = 0; c < width / 2u; c++)
+        {
+            uint32_t index = (width / 2u - 1 - c) * height + height - 2 - r * 2;
+            dstUv[index] = uv[r * width + c * 2];
+            dstUv[index + 1] = uv[r * width + c * 2 + 1];
+        }
+    }
+}
+
+void referencePlanarRotate90Flip(uint8_t* dst, const uint8_t* src, uint16_t width, uint16_t height)
+{
+    const uint32_t size = width * height;
+    for (uint32_t r = 0; r < height; r++)
+    {
+        for (uint32_t c = 0; c < width; c++)
+        {
+            dst[(width - 1 - c) * height + height - 1 - r] = src[r * width + c];
+        }
+    }
+
+    const uint32_t chromaWidth = width / 2u;
+    const uint32_t chromaHeight = height / 2u;
+
+    for (uint32_t plane = 0; plane < 2; plane++)
+    {
+        const uint8_t* srcChroma = src + size + plane * size / 4;
+        uint8_t* dstChroma = dst + size + plane * size / 4;
+
+        for (uint32_t r = 0; r < chromaHeight; r++)
+        {
+            for (uint32_t c = 0; c < chromaWidth; c++)
+            {
+                dstChroma[(chromaWidth - 1 - c) * chromaHeight + chromaHeight - 1 - r] =
+                        srcChroma[r * chromaWidth + c];
+            }
+        }
+    }
+}
+
+std::vector<uint8_t> createImage(uint16_t width, uint16_t height)
+{
+    std::vector<uint8_t> image(width * height * 3 / 2);
+
+    for (auto& pixel : image)
+    {
+        pixel = rand() & 0xFF;
+    }
+
+    return image;
+}
+
+// The sizes cover the images of full tiles and the partial tiles on the right and bottom edges
+const uint16_t kTestSizes[][2] = {
+        {2, 2}, {8, 8}, {16, 16}, {22, 14}, {32, 18}, {64, 48}, {176, 144}, {102, 38}};
+}  // namespace
+
 TEST_F(ImsMediaImageRotateTest, Rotate90FlipTest)
 {
     const uint16_t img_width = 4, img_height = 4;
@@ -249,4 +371,53 @@ TEST_F(ImsMediaImageRotateTest, Rotate90PlanarTest_ZeroImageSize)
     ImsMediaImageRotate::YUV420_Planar_Rotate90_Flip(output_img, input_img, img_width, img_height);
 
     EXPECT_EQ(memcmp(output_img, exp_img, 0), 0);
-}
\ No newline at end of file
+}
+
+TEST_F(ImsMediaImageRotateTest, TiledRotationMatchesReference)
+{
+    srand(1234);
+
+    for (bool simd : {true, false})
+    {
+        ImsMediaImageRotate::SetSimdEnabled(simd);
+
+        for (const auto& size : kTestSizes)
+        {
+            const uint16_t width = size[0], height = size[1];
+            const uint16_t stride = height + 6;
+            const size_t outSize = stride * width * 3 / 2;
+            std::vector<uint8_t> image = createImage(width, height);
+            uint8_t* y = image.data();
+            uint8_t* uv = y + width * height;
+
+            std::vector<uint8_t> output(outSize, 0);
+            std::vector<uint8_t> expected(outSize, 0);
+            EXPECT_EQ(ImsMediaImageRotate::YUV420_SP_Rotate90(
+                              output.data(), outSize, stride, y, uv, width, height),
+                    0);
+            referenceRotate90(expected.data(), stride, y, uv, width, height);
+            EXPECT_EQ(output, expected) << "Rotate90 " << width << "x" << height << " " << simd;
+
+            std::fill(output.begin(), output.end(), 0);
+            std::fill(expected.begin(), expected.end(), 0);
+            EXPECT_EQ(ImsMediaImageRotate::YUV420_SP_Rotate270(
+                              output.data(), outSize, stride, y, uv, width, height),
+                    0);
+            referenceRotate270(expected.data(), stride, y, uv, width, height);
+            EXPECT_EQ(output, expected) << "Rotate270 " << width << "x" << height << " " << simd;
+
+            output.assign(image.size(), 0);
+            expected.assign(image.size(), 0);
+            ImsMediaImageRotate::YUV420_SP_Rotate90_Flip(output.data(), y, uv, width, height);
+            referenceRotate90Flip(expected.data(), y, uv, width, height);
+            EXPECT_EQ(output, expected) << "Rotate90Flip " << width << "x" << height << " "
+                                        << simd;
+
+            std::fill(output.begin(), output.end(), 0);
+            std::fill(expected.begin(), expected.end(), 0);
+            ImsMediaImageRotate::YUV420_Planar_Rotate90_Flip(output.data(), y, width, height);
+            referencePlanarRotate90Flip(expected.data(), y, width, height);
+            EXPECT_EQ(output, expected) << "Planar " << width << "x" << height << " " << simd;
+        }
+    }
+}
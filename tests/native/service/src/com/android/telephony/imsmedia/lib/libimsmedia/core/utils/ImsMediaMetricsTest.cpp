@@ -0,0 +1,143 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <ImsMediaMetrics.h>
+#include <thread>
+#include <vector>
+
+const int32_t kSessionId = 10;
+
+TEST(ImsMediaMetricsTest, TestAcquireAndSnapshot)
+{
+    ImsMediaMetricsSnapshot snapshot;
+    EXPECT_FALSE(ImsMediaMetricsRegistry::GetSnapshot(kSessionId, IMS_MEDIA_AUDIO, snapshot));
+
+    ImsMediaMetrics* metrics = ImsMediaMetricsRegistry::Acquire(kSessionId, IMS_MEDIA_AUDIO);
+    ASSERT_NE(metrics, nullptr);
+
+    metrics->AddCounter(kMetricRtpPacketsReceived);
+    metrics->AddCounter(kMetricRtpBytesReceived, 160);
+    metrics->AddCounter(kMetricRtpPacketsReceived);
+    metrics->AddCounter(kMetricRtpBytesReceived, 160);
+    metrics->SetGauge(kMetricJitterBufferSize, 4);
+    metrics->AddHistogram(kMetricRtpInterArrivalTime, 20000);
+
+    EXPECT_EQ(metrics->GetCounter(kMetricRtpPacketsReceived), 2);
+    EXPECT_EQ(metrics->GetGauge(kMetricJitterBufferSize), 4);
+
+    ASSERT_TRUE(ImsMediaMetricsRegistry::GetSnapshot(kSessionId, IMS_MEDIA_AUDIO, snapshot));
+    EXPECT_EQ(snapshot.sessionId, kSessionId);
+    EXPECT_EQ(snapshot.mediaType, IMS_MEDIA_AUDIO);
+    EXPECT_EQ(snapshot.counters[kMetricRtpPacketsReceived], 2);
+    EXPECT_EQ(snapshot.counters[kMetricRtpBytesReceived], 320);
+    EXPECT_EQ(snapshot.counters[kMetricRtpPacketsSent], 0);
+    EXPECT_EQ(snapshot.gauges[kMetricJitterBufferSize], 4);
+    EXPECT_EQ(snapshot.histograms[kMetricRtpInterArrivalTime].count, 1);
+    EXPECT_EQ(snapshot.histograms[kMetricRtpInterArrivalTime].max, 20000);
+
+    // the other stream of the same session is not registered
+    EXPECT_FALSE(ImsMediaMetricsRegistry::GetSnapshot(kSessionId, IMS_MEDIA_VIDEO, snapshot));
+
+    ImsMediaMetricsRegistry::Release(metrics);
+    EXPECT_FALSE(ImsMediaMetricsRegistry::GetSnapshot(kSessionId, IMS_MEDIA_AUDIO, snapshot));
+}
+
+TEST(ImsMediaMetricsTest, TestReuseSlot)
+{
+    ImsMediaMetrics* metrics = ImsMediaMetricsRegistry::Acquire(kSessionId, IMS_MEDIA_AUDIO);
+    ASSERT_NE(metrics, nullptr);
+    metrics->AddCounter(kMetricLostPackets, 3);
+    ImsMediaMetricsRegistry::Release(metrics);
+
+    // the metrics are cleared when the slot is registered again
+    metrics = ImsMediaMetricsRegistry::Acquire(kSessionId + 1, IMS_MEDIA_VIDEO);
+    ASSERT_NE(metrics, nullptr);
+    EXPECT_EQ(metrics->GetCounter(kMetricLostPackets), 0);
+    ImsMediaMetricsRegistry::Release(metrics);
+}
+
+TEST(ImsMediaMetricsTest, TestFullRegistry)
+{
+    std::vector<ImsMediaMetrics*> listMetrics;
+
+    for (int32_t i = 0; i < IM_METRICS_MAX_STREAMS; i++)
+    {
+        ImsMediaMetrics* metrics = ImsMediaMetricsRegistry::Acquire(i, IMS_MEDIA_TEXT);
+        ASSERT_NE(metrics, nullptr);
+        metrics->AddCounter(kMetricRtpPacketsSent, i);
+        listMetrics.push_back(metrics);
+    }
+
+    EXPECT_EQ(ImsMediaMetricsRegistry::Acquire(IM_METRICS_MAX_STREAMS, IMS_MEDIA_TEXT), nullptr);
+
+    ImsMediaMetricsSnapshot snapshots[IM_METRICS_MAX_STREAMS];
+    ASSERT_EQ(ImsMediaMetricsRegistry::GetSnapshots(snapshots, IM_METRICS_MAX_STREAMS),
+            IM_METRICS_MAX_STREAMS);
+
+    for (const auto& snapshot : snapshots)
+    {
+        EXPECT_EQ(snapshot.counters[kMetricRtpPacketsSent], snapshot.sessionId);
+    }
+
+    EXPECT_EQ(ImsMediaMetricsRegistry::GetSnapshots(snapshots, 2), 2);
+
+    for (auto metrics : listMetrics)
+    {
+        ImsMediaMetricsRegistry::Release(metrics);
+    }
+
+    EXPECT_EQ(ImsMediaMetricsRegistry::GetSnapshots(snapshots, IM_METRICS_MAX_STREAMS), 0);
+}
+
+TEST(ImsMediaMetricsTest, TestSnapshotWhileUpdating)
+{
+    const uint64_t kPackets = 100000;
+    ImsMediaMetrics* metrics = ImsMediaMetricsRegistry::Acquire(kSessionId, IMS_MEDIA_AUDIO);
+    ASSERT_NE(metrics, nullptr);
+
+    std::thread writer(
+            [metrics]()
+            {
+                for (uint64_t i = 0; i < kPackets; i++)
+                {
+                    metrics->AddCounter(kMetricRtpPacketsSent);
+                    metrics->AddCounter(kMetricRtpBytesSent, 100);
+                }
+            });
+
+    ImsMediaMetricsSnapshot snapshot;
+    uint64_t lastCount = 0;
+
+    while (lastCount < kPackets)
+    {
+        // break instead of returning so the writer thread is always joined
+        bool result = ImsMediaMetricsRegistry::GetSnapshot(kSessionId, IMS_MEDIA_AUDIO, snapshot);
+        EXPECT_TRUE(result);
+
+        if (!result)
+        {
+            break;
+        }
+
+        // the counters are monotonic while the monitor polls
+        EXPECT_GE(snapshot.counters[kMetricRtpPacketsSent], lastCount);
+        lastCount = snapshot.counters[kMetricRtpPacketsSent];
+    }
+
+    writer.join();
+    EXPECT_EQ(metrics->GetCounter(kMetricRtpBytesSent), kPackets * 100);
+    ImsMediaMetricsRegistry::Release(metrics);
+}
@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <ImsMediaNalUnitSplitter.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+// the reference splitter checking the start code at every byte
+std::vector<ImsMediaNalUnit> splitByByte(uint8_t* buffer, uint32_t size)
+{
+    std::vector<ImsMediaNalUnit> units;
+
+    for (uint32_t i = 0; i + 3 <= size; i++)
+    {
+        if (buffer[i] == 0 && buffer[i + 1] == 0 && buffer[i + 2] == 1)
+        {
+            uint32_t startCodeSize = 3;
+
+            if (!units.empty())
+            {
+                ImsMediaNalUnit& last = units.back();
+
+                // the zero byte before "00 00 01" belongs to the start code of the next unit
+                if (i > 0 && buffer[i - 1] == 0 && buffer + i - 1 >= last.data)
+                {
+                    startCodeSize = 4;
+                }
+
+                last.size = buffer + i + 3 - startCodeSize - last.data;
+            }
+            else if (i > 0 && buffer[i - 1] == 0)
+            {
+                startCodeSize = 4;
+            }
+
+            units.push_back({buffer + i + 3, 0, startCodeSize});
+            i += 2;
+        }
+    }
+
+    if (!units.empty())
+    {
+        units.back().size = buffer + size - units.back().data;
+    }
+
+    return units;
+}
+}  // namespace
+
+class ImsMediaNalUnitSplitterTest : public ::testing::Test
+{
+public:
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+};
+
+TEST_F(ImsMediaNalUnitSplitterTest, TestSplitAccessUnit)
+{
+    // leading garbage, sps with 4 bytes, pps with 3 bytes and idr slice with 4 bytes start code
+    uint8_t buffer[] = {0xFF, 0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0xC0, 0x0C, 0x00, 0x00, 0x01,
+            0x68, 0xCE, 0x3C, 0x80, 0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x00, 0x21};
+
+    ImsMediaNalUnitSplitter splitter(buffer, sizeof(buffer));
+    ImsMediaNalUnit unit;
+
+    ASSERT_TRUE(splitter.Next(&unit));
+    EXPECT_EQ(unit.data, buffer + 5);
+    EXPECT_EQ(unit.size, 4);
+    EXPECT_EQ(unit.startCodeSize, 4);
+    EXPECT_EQ(unit.data[0] & 0x1F, 7);
+
+    ASSERT_TRUE(splitter.Next(&unit));
+    EXPECT_EQ(unit.data, buffer + 12);
+    EXPECT_EQ(unit.size, 4);
+    EXPECT_EQ(unit.startCodeSize, 3);
+    EXPECT_EQ(unit.data[0] & 0x1F, 8);
+
+    ASSERT_TRUE(splitter.Next(&unit));
+    EXPECT_EQ(unit.data, buffer + 20);
+    EXPECT_EQ(unit.size, 5);
+    EXPECT_EQ(unit.startCodeSize, 4);
+    EXPECT_EQ(unit.data[0] & 0x1F, 5);
+
+    EXPECT_FALSE(splitter.Next(&unit));
+    EXPECT_FALSE(splitter.Next(&unit));
+}
+
+TEST_F(ImsMediaNalUnitSplitterTest, TestNoStartCode)
+{
+    uint8_t buffer[] = {0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x01, 0x00, 0x00};
+    ImsMediaNalUnit unit;
+
+    ImsMediaNalUnitSplitter splitter(buffer, sizeof(buffer));
+    EXPECT_FALSE(splitter.Next(&unit));
+
+    ImsMediaNalUnitSplitter empty(nullptr, 0);
+    EXPECT_FALSE(empty.Next(&unit));
+
+    uint32_t startCodeSize = 0;
+    EXPECT_EQ(ImsMediaNalUnitSplitter::FindStartCode(buffer, 2, &startCodeSize), nullptr);
+    EXPECT_EQ(ImsMediaNalUnitSplitter::FindStartCode(nullptr, 10, &startCodeSize), nullptr);
+}
+
+TEST_F(ImsMediaNalUnitSplitterTest, TestGetStartCodeSize)
+{
+    const uint8_t kStartCode4[] = {0x00, 0x00, 0x00, 0x01, 0x67};
+    const uint8_t kStartCode3[] = {0x00, 0x00, 0x01, 0x67};
+    const uint8_t kNoStartCode[] = {0x00, 0x01, 0x67, 0x00};
+
+    EXPECT_EQ(ImsMediaNalUnitSplitter::GetStartCodeSize(kStartCode4, sizeof(kStartCode4)), 4);
+    EXPECT_EQ(ImsMediaNalUnitSplitter::GetStartCodeSize(kStartCode3, sizeof(kStartCode3)), 3);
+    EXPECT_EQ(ImsMediaNalUnitSplitter::GetStartCodeSize(kNoStartCode, sizeof(kNoStartCode)), 0);
+    EXPECT_EQ(ImsMediaNalUnitSplitter::GetStartCodeSize(kStartCode4, 3), 0);
+    EXPECT_EQ(ImsMediaNalUnitSplitter::GetStartCodeSize(nullptr, 4), 0);
+}
+
+TEST_F(ImsMediaNalUnitSplitterTest, TestSplitCapacity)
+{
+    uint8_t buffer[] = {0x00, 0x00, 0x01, 0x09, 0x00, 0x00, 0x01, 0x41, 0x9A, 0x00, 0x00, 0x01,
+            0x01, 0x9E};
+    ImsMediaNalUnit units[3];
+
+    EXPECT_EQ(ImsMediaNalUnitSplitter::Split(buffer, sizeof(buffer), units, 3), 3);
+    EXPECT_EQ(units[0].size, 1);
+    EXPECT_EQ(units[1].size, 2);
+    EXPECT_EQ(units[2].size, 2);
+
+    EXPECT_EQ(ImsMediaNalUnitSplitter::Split(buffer, sizeof(buffer), units, 2), 2);
+    EXPECT_EQ(ImsMediaNalUnitSplitter::Split(buffer, sizeof(buffer), nullptr, 2), 0);
+}
+
+TEST_F(ImsMediaNalUnitSplitterTest, TestMatchesByteScan)
+{
+    // the buffers of many zero bytes to put the start codes at every offset of the word
+    std::mt19937 random(5);
+    std::uniform_int_distribution<int> byteValue(0, 3);
+    std::uniform_int_distribution<uint32_t> bufferSize(0, 67);
+
+    for (int32_t i = 0; i < 20000; i++)
+    {
+        std::vector<uint8_t> buffer(bufferSize(random));
+
+        for (auto& value : buffer)
+        {
+            int v = byteValue(random);
+            value = v == 3 ? 0xA5 : (v == 2 ? 0x00 : v);
+        }
+
+        std::vector<ImsMediaNalUnit> expected = splitByByte(buffer.data(), buffer.size());
+        ImsMediaNalUnitSplitter splitter(buffer.data(), buffer.size());
+        ImsMediaNalUnit unit;
+
+        for (auto& expectedUnit : expected)
+        {
+            ASSERT_TRUE(splitter.Next(&unit));
+            ASSERT_EQ(unit.data, expectedUnit.data);
+            ASSERT_EQ(unit.size, expectedUnit.size);
+            ASSERT_EQ(unit.startCodeSize, expectedUnit.startCodeSize);
+        }
+
+        ASSERT_FALSE(splitter.Next(&unit));
+    }
+}
@@ -0,0 +1,178 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ImsMediaPacketTracer.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FakeTraceCallback
+{
+public:
+    int32_t getSessionId() { return 7; }
+};
+
+class ImsMediaPacketTracerTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ImsMediaPacketTracer::Reset();
+        ImsMediaPacketTracer::SetEnabled(true);
+    }
+
+    virtual void TearDown() override
+    {
+        ImsMediaPacketTracer::SetEnabled(false);
+        ImsMediaPacketTracer::Reset();
+    }
+
+    std::vector<ImsMediaPacketTraceRecord> Collect()
+    {
+        std::vector<ImsMediaPacketTraceRecord> records(IM_PACKET_TRACE_RING_SIZE * 4);
+        records.resize(ImsMediaPacketTracer::Collect(records.data(), records.size()));
+        return records;
+    }
+};
+
+TEST_F(ImsMediaPacketTracerTest, TestWrite)
+{
+    FakeTraceCallback callback;
+    FakeTraceCallback* pCallback = &callback;
+    IMTRACE_PACKET(kPacketTraceJitterAdd, pCallback, 100, 160, 33);
+    IMTRACE_PACKET(kPacketTraceJitterGet, pCallback, 101, 320, 34);
+
+    std::vector<ImsMediaPacketTraceRecord> records = Collect();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].event, kPacketTraceJitterAdd);
+    EXPECT_EQ(records[0].sessionId, 7);
+    EXPECT_EQ(records[0].seq, 100);
+    EXPECT_EQ(records[0].timestamp, 160);
+    EXPECT_EQ(records[0].size, 33);
+    EXPECT_EQ(records[1].event, kPacketTraceJitterGet);
+    EXPECT_EQ(records[1].seq, 101);
+    EXPECT_LE(records[0].timeNs, records[1].timeNs);
+    EXPECT_EQ(records[0].threadId, records[1].threadId);
+}
+
+TEST_F(ImsMediaPacketTracerTest, TestDisabled)
+{
+    ImsMediaPacketTracer::SetEnabled(false);
+    FakeTraceCallback* callback = nullptr;
+    IMTRACE_PACKET(kPacketTraceRtpDecode, callback, 1, 2, 3);
+    EXPECT_EQ(Collect().size(), 0);
+
+    ImsMediaPacketTracer::SetEnabled(true);
+    IMTRACE_PACKET(kPacketTraceRtpDecode, callback, 1, 2, 3);
+    std::vector<ImsMediaPacketTraceRecord> records = Collect();
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].sessionId, -1);
+}
+
+TEST_F(ImsMediaPacketTracerTest, TestWriteRtp)
+{
+    const uint8_t kRtpPacket[] = {0x80, 0x60, 0x12, 0x34, 0x00, 0x01, 0x02, 0x03, 0xaa, 0xbb, 0xcc,
+            0xdd, 0x01, 0x02};
+    ImsMediaPacketTracer::WriteRtp(kPacketTraceSocketRead, 3, kRtpPacket, sizeof(kRtpPacket));
+    ImsMediaPacketTracer::WriteRtp(kPacketTraceSocketRead, 3, kRtpPacket, 4);
+
+    std::vector<ImsMediaPacketTraceRecord> records = Collect();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].seq, 0x1234);
+    EXPECT_EQ(records[0].timestamp, 0x00010203);
+    EXPECT_EQ(records[0].size, sizeof(kRtpPacket));
+    // too short to read the header
+    EXPECT_EQ(records[1].seq, 0);
+    EXPECT_EQ(records[1].timestamp, 0);
+}
+
+TEST_F(ImsMediaPacketTracerTest, TestRingOverwrite)
+{
+    const uint32_t kNumRecords = IM_PACKET_TRACE_RING_SIZE + 10;
+
+    for (uint32_t i = 0; i < kNumRecords; i++)
+    {
+        ImsMediaPacketTracer::Write(kPacketTraceRtpEncode, 1, i, i, 0);
+    }
+
+    std::vector<ImsMediaPacketTraceRecord> records = Collect();
+    // the latest records are kept except the slot the writer reuses next
+    ASSERT_EQ(records.size(), IM_PACKET_TRACE_RING_SIZE - 1);
+    EXPECT_EQ(records.front().timestamp, 11);
+    EXPECT_EQ(records.back().timestamp, kNumRecords - 1);
+
+    ImsMediaPacketTracer::Reset();
+    EXPECT_EQ(Collect().size(), 0);
+}
+
+TEST_F(ImsMediaPacketTracerTest, TestMultipleThreads)
+{
+    const uint32_t kNumRecords = 100;
+    auto writer = [&](int32_t sessionId)
+    {
+        for (uint32_t i = 0; i < kNumRecords; i++)
+        {
+            ImsMediaPacketTracer::Write(kPacketTraceSocketWrite, sessionId, i, i, 0);
+        }
+    };
+
+    std::thread thread1(writer, 1);
+    std::thread thread2(writer, 2);
+    thread1.join();
+    thread2.join();
+
+    // the records of the exited threads are kept until the ring is reused
+    std::vector<ImsMediaPacketTraceRecord> records = Collect();
+    ASSERT_EQ(records.size(), kNumRecords * 2);
+
+    uint32_t count[3] = {0};
+
+    for (auto& record : records)
+    {
+        ASSERT_TRUE(record.sessionId == 1 || record.sessionId == 2);
+        count[record.sessionId]++;
+    }
+
+    EXPECT_EQ(count[1], kNumRecords);
+    EXPECT_EQ(count[2], kNumRecords);
+}
+
+TEST_F(ImsMediaPacketTracerTest, TestDump)
+{
+    ImsMediaPacketTracer::Write(kPacketTraceAudioPlay, 5, 10, 20, 30);
+    std::string path = testing::TempDir() + "packet_trace_test.bin";
+    ASSERT_EQ(ImsMediaPacketTracer::Dump(path.c_str()), 1);
+
+    FILE* file = fopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+
+    ImsMediaPacketTraceFileHeader header;
+    ImsMediaPacketTraceRecord record;
+    EXPECT_EQ(fread(&header, sizeof(header), 1, file), 1);
+    EXPECT_EQ(fread(&record, sizeof(record), 1, file), 1);
+    fclose(file);
+    remove(path.c_str());
+
+    EXPECT_EQ(header.magic, IM_PACKET_TRACE_MAGIC);
+    EXPECT_EQ(header.version, IM_PACKET_TRACE_VERSION);
+    EXPECT_EQ(header.recordSize, sizeof(ImsMediaPacketTraceRecord));
+    EXPECT_EQ(header.numRecords, 1);
+    EXPECT_EQ(record.event, kPacketTraceAudioPlay);
+    EXPECT_EQ(record.sessionId, 5);
+    EXPECT_STREQ(ImsMediaPacketTracer::GetEventName(record.event), "audio_play");
+}
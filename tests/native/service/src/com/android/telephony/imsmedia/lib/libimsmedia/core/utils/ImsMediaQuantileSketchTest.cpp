@@ -0,0 +1,231 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ImsMediaQuantileSketch.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class ImsMediaQuantileSketchTest : public ::testing::Test
+{
+public:
+    ImsMediaQuantileSketch sketch;
+
+protected:
+    // the exact percentile with the same rank as the sketch
+    uint32_t getExactPercentile(std::vector<uint32_t> values, uint32_t percent)
+    {
+        std::sort(values.begin(), values.end());
+        uint64_t rank = (values.size() * percent + 99) / 100;
+        return values[rank == 0 ? 0 : rank - 1];
+    }
+};
+
+TEST_F(ImsMediaQuantileSketchTest, TestEmpty)
+{
+    EXPECT_EQ(sketch.GetCount(), 0);
+    EXPECT_EQ(sketch.GetMin(), 0);
+    EXPECT_EQ(sketch.GetMax(), 0);
+    EXPECT_EQ(sketch.GetPercentile(50), 0);
+}
+
+TEST_F(ImsMediaQuantileSketchTest, TestRelativeAccuracy)
+{
+    std::mt19937 generator(1);
+    std::lognormal_distribution<double> distribution(4.0, 0.8);
+    std::vector<uint32_t> values;
+
+    for (int32_t i = 0; i < 10000; i++)
+    {
+        uint32_t value = 1 + static_cast<uint32_t>(distribution(generator));
+        values.push_back(value);
+        sketch.Add(value);
+    }
+
+    EXPECT_EQ(sketch.GetCount(), values.size());
+    EXPECT_EQ(sketch.GetMin(), *std::min_element(values.begin(), values.end()));
+    EXPECT_EQ(sketch.GetMax(), *std::max_element(values.begin(), values.end()));
+
+    for (uint32_t percent : {1, 10, 25, 50, 75, 90, 95, 99})
+    {
+        double exact = getExactPercentile(values, percent);
+        // the error of the rounding to the integer is added to the relative error
+        EXPECT_NEAR(sketch.GetPercentile(percent), exact,
+                exact * IM_SKETCH_RELATIVE_ACCURACY + 1)
+                << "percent " << percent;
+    }
+}
+
+TEST_F(ImsMediaQuantileSketchTest, TestZeroAndLargeValues)
+{
+    for (int32_t i = 0; i < 60; i++)
+    {
+        sketch.Add(0);
+    }
+
+    for (int32_t i = 0; i < 40; i++)
+    {
+        sketch.Add(1000000);
+    }
+
+    EXPECT_EQ(sketch.GetPercentile(50), 0);
+    EXPECT_EQ(sketch.GetPercentile(60), 0);
+    // the values beyond the last bin are limited by the max
+    EXPECT_EQ(sketch.GetPercentile(61), 1000000);
+    EXPECT_EQ(sketch.GetPercentile(100), 1000000);
+    EXPECT_EQ(ImsMediaQuantileSketch::GetBinIndex(1), 0);
+    EXPECT_EQ(ImsMediaQuantileSketch::GetBinIndex(UINT32_MAX), IM_SKETCH_MAX_BINS - 1);
+}
+
+TEST_F(ImsMediaQuantileSketchTest, TestMerge)
+{
+    ImsMediaQuantileSketch sketch1;
+    ImsMediaQuantileSketch sketch2;
+
+    for (uint32_t value = 1; value <= 500; value++)
+    {
+        sketch.Add(value);
+        (value % 2 == 0 ? sketch1 : sketch2).Add(value);
+    }
+
+    sketch1.Merge(sketch2);
+    EXPECT_EQ(sketch1.GetCount(), sketch.GetCount());
+    EXPECT_EQ(sketch1.GetMin(), 1);
+    EXPECT_EQ(sketch1.GetMax(), 500);
+
+    for (uint32_t percent = 0; percent <= 100; percent += 5)
+    {
+        EXPECT_EQ(sketch1.GetPercentile(percent), sketch.GetPercentile(percent));
+    }
+
+    // merging the empty sketch keeps the values
+    ImsMediaQuantileSketch empty;
+    sketch1.Merge(empty);
+    EXPECT_EQ(sketch1.GetCount(), 500);
+    empty.Merge(sketch1);
+    EXPECT_EQ(empty.GetMin(), 1);
+}
+
+TEST_F(ImsMediaQuantileSketchTest, TestSerialize)
+{
+    for (uint32_t value = 0; value < 300; value += 3)
+    {
+        sketch.Add(value);
+        sketch.Add(value * 50);
+    }
+
+    uint8_t buffer[IM_SKETCH_MAX_SERIALIZED_SIZE];
+    uint32_t size = sketch.Serialize(buffer, sizeof(buffer));
+    ASSERT_GT(size, 0);
+    EXPECT_LT(size, sizeof(buffer));
+    EXPECT_EQ(sketch.Serialize(buffer, size - 1), 0);
+
+    ImsMediaQuantileSketch restored;
+    EXPECT_TRUE(restored.Deserialize(buffer, size));
+    EXPECT_EQ(restored.GetCount(), sketch.GetCount());
+    EXPECT_EQ(restored.GetMin(), sketch.GetMin());
+    EXPECT_EQ(restored.GetMax(), sketch.GetMax());
+
+    for (uint32_t percent = 0; percent <= 100; percent += 5)
+    {
+        EXPECT_EQ(restored.GetPercentile(percent), sketch.GetPercentile(percent));
+    }
+
+    // truncated and wrong version
+    EXPECT_FALSE(restored.Deserialize(buffer, size - 1));
+    EXPECT_EQ(restored.GetCount(), 0);
+    buffer[0] = IM_SKETCH_VERSION + 1;
+    EXPECT_FALSE(restored.Deserialize(buffer, size));
+    EXPECT_FALSE(restored.Deserialize(nullptr, size));
+}
+
+TEST_F(ImsMediaQuantileSketchTest, TestSerializeEmptyAndMerge)
+{
+    uint8_t buffer[IM_SKETCH_MAX_SERIALIZED_SIZE];
+    uint32_t size = sketch.Serialize(buffer, sizeof(buffer));
+    ASSERT_GT(size, 0);
+
+    ImsMediaQuantileSketch restored;
+    restored.Add(10);
+    EXPECT_TRUE(restored.Deserialize(buffer, size));
+    EXPECT_EQ(restored.GetCount(), 0);
+
+    // the restored sketches of two calls are merged as the sketches of the calls
+    ImsMediaQuantileSketch call1, call2, merged;
+
+    for (uint32_t value = 1; value <= 100; value++)
+    {
+        call1.Add(value);
+        call2.Add(value * 10);
+        merged.Add(value);
+        merged.Add(value * 10);
+    }
+
+    size = call1.Serialize(buffer, sizeof(buffer));
+    EXPECT_TRUE(restored.Deserialize(buffer, size));
+    size = call2.Serialize(buffer, sizeof(buffer));
+    ImsMediaQuantileSketch restored2;
+    EXPECT_TRUE(restored2.Deserialize(buffer, size));
+    restored.Merge(restored2);
+
+    EXPECT_EQ(restored.GetCount(), merged.GetCount());
+    EXPECT_EQ(restored.GetMin(), 1);
+    EXPECT_EQ(restored.GetMax(), 1000);
+
+    for (uint32_t percent = 0; percent <= 100; percent += 10)
+    {
+        EXPECT_EQ(restored.GetPercentile(percent), merged.GetPercentile(percent));
+    }
+}
+
+TEST_F(ImsMediaQuantileSketchTest, TestDeserializeCorrupted)
+{
+    // version, zero count 0, min 1, max 2 and the bins 5 and 6 with the count 1
+    uint8_t valid[] = {IM_SKETCH_VERSION, 0, 1, 2, 2, 5, 1, 1, 1};
+    EXPECT_TRUE(sketch.Deserialize(valid, sizeof(valid)));
+    EXPECT_EQ(sketch.GetCount(), 2);
+
+    // the distance of the second bin wraps the index to the first bin
+    uint8_t wrapped[] = {IM_SKETCH_VERSION, 0, 1, 2, 2, 5, 1, 0xFC, 0xFF, 0xFF, 0xFF, 0x0F, 1};
+    EXPECT_FALSE(sketch.Deserialize(wrapped, sizeof(wrapped)));
+    EXPECT_EQ(sketch.GetCount(), 0);
+
+    // the bin beyond the last bin
+    uint8_t outOfRange[] = {IM_SKETCH_VERSION, 0, 1, 2, 1, 0x80, 0x02, 1};
+    EXPECT_FALSE(sketch.Deserialize(outOfRange, sizeof(outOfRange)));
+
+    // too many bins, the same bin twice and the empty bin
+    uint8_t tooManyBins[] = {IM_SKETCH_VERSION, 0, 1, 2, 0x81, 0x02, 5, 1};
+    EXPECT_FALSE(sketch.Deserialize(tooManyBins, sizeof(tooManyBins)));
+    uint8_t sameBin[] = {IM_SKETCH_VERSION, 0, 1, 2, 2, 5, 1, 0, 1};
+    EXPECT_FALSE(sketch.Deserialize(sameBin, sizeof(sameBin)));
+    uint8_t emptyBin[] = {IM_SKETCH_VERSION, 0, 1, 2, 1, 5, 0};
+    EXPECT_FALSE(sketch.Deserialize(emptyBin, sizeof(emptyBin)));
+
+    // min larger than max, the value without the count and the trailing byte
+    uint8_t minOverMax[] = {IM_SKETCH_VERSION, 0, 3, 2, 1, 5, 1};
+    EXPECT_FALSE(sketch.Deserialize(minOverMax, sizeof(minOverMax)));
+    uint8_t noCount[] = {IM_SKETCH_VERSION, 0, 0, 7, 0};
+    EXPECT_FALSE(sketch.Deserialize(noCount, sizeof(noCount)));
+    uint8_t trailing[] = {IM_SKETCH_VERSION, 0, 1, 2, 2, 5, 1, 1, 1, 0};
+    EXPECT_FALSE(sketch.Deserialize(trailing, sizeof(trailing)));
+
+    // the varint longer than 32 bits
+    uint8_t longVarint[] = {IM_SKETCH_VERSION, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 1, 2, 0};
+    EXPECT_FALSE(sketch.Deserialize(longVarint, sizeof(longVarint)));
+    EXPECT_EQ(sketch.GetCount(), 0);
+}
@@ -0,0 +1,177 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <VideoFrameBufferPool.h>
+#include <vector>
+
+namespace
+{
+const uint32_t kWidth = 320;
+const uint32_t kHeight = 240;
+const uint32_t kPacketSize = 1000;
+
+class VideoFrameBufferPoolTest : public ::testing::Test
+{
+public:
+    VideoFrameBufferPoolTest() {}
+    virtual ~VideoFrameBufferPoolTest() {}
+
+protected:
+    VideoFrameBufferPool mPool;
+    ImsMediaDataQueue mQueue;
+    uint8_t mPacket[kPacketSize];
+
+    virtual void SetUp() override
+    {
+        for (uint32_t i = 0; i < kPacketSize; i++)
+        {
+            mPacket[i] = static_cast<uint8_t>(i);
+        }
+
+        mPool.SetResolution(kWidth, kHeight);
+    }
+
+    virtual void TearDown() override { mQueue.Clear(); }
+
+    // store the packet in the frame buffer and refer it from the queue as the jitter buffer does
+    uint8_t* AddPacket(uint32_t timestamp, uint32_t size = kPacketSize)
+    {
+        uint8_t* data = mPool.Write(timestamp, mPacket, size, &mQueue);
+
+        if (data != nullptr)
+        {
+            DataEntry entry;
+            entry.pbBuffer = data;
+            entry.nBufferSize = size;
+            entry.nTimestamp = timestamp;
+            entry.bExternalBuffer = true;
+            mQueue.Add(&entry);
+        }
+
+        return data;
+    }
+
+    void DeleteFrame(uint32_t timestamp)
+    {
+        DataEntry* entry = nullptr;
+
+        while (mQueue.Get(&entry) && entry->nTimestamp == timestamp)
+        {
+            mQueue.Delete();
+        }
+    }
+};
+
+TEST_F(VideoFrameBufferPoolTest, TestPacketsContiguous)
+{
+    EXPECT_EQ(mPool.GetCapacity(), kWidth * kHeight * 3 / 4);
+
+    uint8_t* first = AddPacket(1000);
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(mPool.Contains(first));
+
+    for (uint32_t i = 1; i < 10; i++)
+    {
+        EXPECT_EQ(AddPacket(1000), first + i * kPacketSize);
+    }
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(memcmp(first + i * kPacketSize, mPacket, kPacketSize), 0);
+    }
+
+    // the queue keeps the pointer to the frame buffer instead of a copy
+    DataEntry* entry = nullptr;
+    ASSERT_TRUE(mQueue.Get(&entry));
+    EXPECT_EQ(entry->pbBuffer, first);
+
+    // the next frame uses another frame buffer
+    uint8_t* second = AddPacket(4000);
+    ASSERT_NE(second, nullptr);
+    EXPECT_FALSE(second >= first && second < first + mPool.GetCapacity());
+}
+
+TEST_F(VideoFrameBufferPoolTest, TestNoRoom)
+{
+    EXPECT_EQ(mPool.Write(1000, mPacket, 0, &mQueue), nullptr);
+    EXPECT_EQ(mPool.Write(1000, nullptr, kPacketSize, &mQueue), nullptr);
+
+    uint32_t count = mPool.GetCapacity() / kPacketSize;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ASSERT_NE(AddPacket(1000), nullptr);
+    }
+
+    // the packet exceeding the frame buffer falls back to the copy of the queue
+    EXPECT_EQ(AddPacket(1000), nullptr);
+
+    VideoFrameBufferPool pool;
+    EXPECT_EQ(pool.Write(1000, mPacket, kPacketSize, &mQueue), nullptr);
+    EXPECT_FALSE(pool.Contains(mPacket));
+}
+
+TEST_F(VideoFrameBufferPoolTest, TestReuseReleasedFrame)
+{
+    std::vector<uint8_t*> frames;
+
+    for (uint32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        uint8_t* frame = AddPacket(i * 3000);
+        ASSERT_NE(frame, nullptr);
+        frames.push_back(frame);
+    }
+
+    // all the frame buffers are referred by the queue
+    EXPECT_EQ(AddPacket(VIDEO_FRAME_BUFFER_POOL_SIZE * 3000), nullptr);
+
+    DeleteFrame(0);
+    EXPECT_EQ(AddPacket(VIDEO_FRAME_BUFFER_POOL_SIZE * 3000), frames[0]);
+}
+
+TEST_F(VideoFrameBufferPoolTest, TestHoldFrame)
+{
+    std::vector<uint8_t*> frames;
+
+    for (uint32_t i = 0; i < VIDEO_FRAME_BUFFER_POOL_SIZE; i++)
+    {
+        frames.push_back(AddPacket(i * 3000));
+    }
+
+    // the frames are read after the entries are deleted
+    mPool.Hold(frames[0]);
+    mPool.Hold(frames[1]);
+    DeleteFrame(0);
+    DeleteFrame(3000);
+    EXPECT_EQ(AddPacket(VIDEO_FRAME_BUFFER_POOL_SIZE * 3000), nullptr);
+
+    // the oldest frame held is released when the third frame is held
+    mPool.Hold(frames[2]);
+    EXPECT_EQ(AddPacket(VIDEO_FRAME_BUFFER_POOL_SIZE * 3000), frames[0]);
+}
+
+TEST_F(VideoFrameBufferPoolTest, TestReset)
+{
+    uint8_t* first = AddPacket(1000);
+    ASSERT_NE(first, nullptr);
+    DeleteFrame(1000);
+    mPool.Reset();
+
+    // the frame buffer is reserved again from the beginning
+    EXPECT_EQ(AddPacket(1000), first);
+}
+}  // namespace
@@ -0,0 +1,275 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <VideoConfig.h>
+#include <VideoJitterBuffer.h>
+#include <VideoRtpPayloadDecoderNode.h>
+#include <vector>
+
+using namespace android::telephony::imsmedia;
+
+namespace
+{
+const uint32_t kFrameDuration = 3000;
+const uint32_t kFrameInterval = 66;
+
+struct PlayedUnit
+{
+    uint32_t seq;
+    uint32_t timestamp;
+    bool mark;
+    // the first byte of the nal unit after the start code
+    uint8_t header;
+};
+
+struct AddedUnit
+{
+    uint32_t seq;
+    bool mark;
+    ImsMediaSubType dataType;
+};
+
+// the rear node of the payload decoder adding the nal units to the jitter buffer
+class JitterInputNode : public BaseNode
+{
+public:
+    JitterInputNode(VideoJitterBuffer* jitter) :
+            mJitter(jitter)
+    {
+    }
+    virtual ~JitterInputNode() {}
+    void Stop() {}
+    bool IsRunTime() { return true; }
+    bool IsSourceNode() { return false; }
+    virtual kBaseNodeState GetState() { return kNodeStateRunning; }
+    void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+            uint32_t timestamp, bool mark, uint32_t seq, ImsMediaSubType dataType,
+            uint32_t arrivalTime)
+    {
+        mAdded.push_back({seq, mark, dataType});
+        mJitter->Add(subtype, data, size, timestamp, mark, seq, dataType, arrivalTime);
+    }
+
+    ImsMediaResult Start() { return RESULT_SUCCESS; }
+
+    std::vector<AddedUnit> mAdded;
+
+private:
+    VideoJitterBuffer* mJitter;
+};
+
+class VideoJitterBufferTest : public ::testing::Test
+{
+public:
+    VideoJitterBufferTest() :
+            mInputNode(&mJitter)
+    {
+    }
+    virtual ~VideoJitterBufferTest() {}
+
+protected:
+    VideoConfig mConfig;
+    VideoJitterBuffer mJitter;
+    VideoRtpPayloadDecoderNode mDecoder;
+    JitterInputNode mInputNode;
+    uint32_t mCurrentTime = 1000;
+
+    virtual void TearDown() override
+    {
+        mDecoder.Stop();
+        mDecoder.DisconnectNodes();
+    }
+
+    void StartDecoder(int32_t codecType)
+    {
+        mConfig.setCodecType(codecType);
+        mConfig.setPacketizationMode(VideoConfig::MODE_NON_INTERLEAVED);
+        mDecoder.SetMediaType(IMS_MEDIA_VIDEO);
+        mDecoder.SetConfig(&mConfig);
+        mDecoder.ConnectRearNode(&mInputNode);
+        ASSERT_EQ(mDecoder.Start(), RESULT_SUCCESS);
+    }
+
+    void SendPacket(std::vector<uint8_t> payload, uint32_t seq, uint32_t timestamp, bool mark)
+    {
+        mDecoder.OnDataFromFrontNode(MEDIASUBTYPE_RTPPAYLOAD, payload.data(), payload.size(),
+                timestamp, mark, seq, MEDIASUBTYPE_UNDEFINED, 0);
+    }
+
+    // build the payload of the aggregation packet with the 16 bit size before each nal unit
+    std::vector<uint8_t> MakeAggregationPacket(
+            std::vector<uint8_t> header, const std::vector<std::vector<uint8_t>>& units)
+    {
+        std::vector<uint8_t> packet = header;
+
+        for (auto& unit : units)
+        {
+            packet.push_back(unit.size() >> 8);
+            packet.push_back(unit.size() & 0xFF);
+            packet.insert(packet.end(), unit.begin(), unit.end());
+        }
+
+        return packet;
+    }
+
+    std::vector<PlayedUnit> PlayAll()
+    {
+        std::vector<PlayedUnit> played;
+        uint8_t* data = nullptr;
+        uint32_t size = 0;
+        uint32_t timestamp = 0;
+        bool mark = false;
+        uint32_t seq = 0;
+
+        while (mJitter.Get(nullptr, &data, &size, &timestamp, &mark, &seq, mCurrentTime))
+        {
+            played.push_back({seq, timestamp, mark, size > 4 ? data[4] : (uint8_t)0});
+            mJitter.Delete();
+            mCurrentTime += kFrameInterval;
+        }
+
+        return played;
+    }
+};
+
+TEST_F(VideoJitterBufferTest, TestAvcStapAFrame)
+{
+    StartDecoder(VideoConfig::CODEC_AVC);
+
+    // SPS, PPS and two IDR slices aggregated in one STAP-A packet
+    SendPacket(MakeAggregationPacket({0x78},
+                       {{0x67, 0x42, 0xC0, 0x0C}, {0x68, 0xCE, 0x3C, 0x80},
+                               {0x65, 0x88, 0x84, 0x00, 0x11}, {0x65, 0x88, 0x84, 0x00, 0x22}}),
+            100, kFrameDuration, true);
+    SendPacket({0x41, 0x9A, 0x02}, 101, 2 * kFrameDuration, true);
+    SendPacket({0x41, 0x9A, 0x03}, 102, 3 * kFrameDuration, true);
+
+    ASSERT_EQ(mInputNode.mAdded.size(), 6);
+    // the parameter sets and the last nal unit of the packet carry the marker
+    EXPECT_TRUE(mInputNode.mAdded[0].mark);
+    EXPECT_TRUE(mInputNode.mAdded[1].mark);
+    EXPECT_FALSE(mInputNode.mAdded[2].mark);
+    EXPECT_TRUE(mInputNode.mAdded[3].mark);
+    EXPECT_EQ(mInputNode.mAdded[2].dataType, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+
+    std::vector<PlayedUnit> played = PlayAll();
+    ASSERT_GE(played.size(), 5);
+
+    const std::vector<uint8_t> kHeaders = {0x67, 0x68, 0x65, 0x65, 0x41};
+    const std::vector<bool> kMarks = {true, true, false, true, true};
+
+    for (uint32_t i = 0; i < kHeaders.size(); i++)
+    {
+        EXPECT_EQ(played[i].header, kHeaders[i]);
+        EXPECT_EQ(played[i].mark, kMarks[i]);
+    }
+
+    EXPECT_EQ(played[3].seq, 100);
+    EXPECT_EQ(played[3].timestamp, kFrameDuration);
+    EXPECT_EQ(played[4].seq, 101);
+}
+
+TEST_F(VideoJitterBufferTest, TestAvcStapAFollowedBySingleNalUnit)
+{
+    StartDecoder(VideoConfig::CODEC_AVC);
+
+    // the first two slices are aggregated and the last slice of the frame is sent alone
+    SendPacket(MakeAggregationPacket({0x78}, {{0x41, 0x9A, 0x01}, {0x41, 0x9A, 0x02}}), 200,
+            kFrameDuration, false);
+    SendPacket({0x41, 0x9A, 0x03}, 201, kFrameDuration, true);
+    SendPacket({0x41, 0x9A, 0x04}, 202, 2 * kFrameDuration, true);
+    SendPacket({0x41, 0x9A, 0x05}, 203, 3 * kFrameDuration, true);
+
+    std::vector<PlayedUnit> played = PlayAll();
+    ASSERT_GE(played.size(), 4);
+
+    const std::vector<uint32_t> kSeqs = {200, 200, 201, 202};
+
+    for (uint32_t i = 0; i < kSeqs.size(); i++)
+    {
+        EXPECT_EQ(played[i].seq, kSeqs[i]);
+    }
+
+    EXPECT_FALSE(played[1].mark);
+    EXPECT_TRUE(played[2].mark);
+}
+
+TEST_F(VideoJitterBufferTest, TestHevcAggregationPacket)
+{
+    StartDecoder(VideoConfig::CODEC_HEVC);
+
+    // VPS, SPS and PPS aggregated in an AP without the marker ahead of the IDR slice
+    SendPacket(MakeAggregationPacket({0x60, 0x01},
+                       {{0x40, 0x01, 0x0C}, {0x42, 0x01, 0x01}, {0x44, 0x01, 0xC1}}),
+            300, kFrameDuration, false);
+    SendPacket({0x26, 0x01, 0xAF, 0x01}, 301, kFrameDuration, true);
+    // two TRAIL_R slices of the next frame aggregated in an AP
+    SendPacket(MakeAggregationPacket({0x60, 0x01}, {{0x02, 0x01, 0xD0}, {0x02, 0x01, 0xD1}}), 302,
+            2 * kFrameDuration, true);
+    SendPacket({0x02, 0x01, 0xD2}, 303, 3 * kFrameDuration, true);
+
+    ASSERT_EQ(mInputNode.mAdded.size(), 7);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(mInputNode.mAdded[i].dataType, MEDIASUBTYPE_VIDEO_CONFIGSTRING);
+        EXPECT_TRUE(mInputNode.mAdded[i].mark);
+    }
+
+    std::vector<PlayedUnit> played = PlayAll();
+    ASSERT_GE(played.size(), 6);
+
+    const std::vector<uint8_t> kHeaders = {0x40, 0x42, 0x44, 0x26, 0x02, 0x02};
+    const std::vector<bool> kMarks = {true, true, true, true, false, true};
+
+    for (uint32_t i = 0; i < kHeaders.size(); i++)
+    {
+        EXPECT_EQ(played[i].header, kHeaders[i]);
+        EXPECT_EQ(played[i].mark, kMarks[i]);
+    }
+
+    EXPECT_EQ(played[5].seq, 302);
+}
+
+TEST_F(VideoJitterBufferTest, TestDuplicatedAggregationPacket)
+{
+    StartDecoder(VideoConfig::CODEC_AVC);
+
+    std::vector<uint8_t> packet = MakeAggregationPacket({0x78},
+            {{0x67, 0x42, 0xC0, 0x0C}, {0x68, 0xCE, 0x3C, 0x80}, {0x65, 0x88, 0x84, 0x00, 0x11},
+                    {0x65, 0x88, 0x84, 0x00, 0x22}});
+
+    // the retransmitted packet right after the original and after the next packet
+    SendPacket(packet, 400, kFrameDuration, true);
+    SendPacket(packet, 400, kFrameDuration, true);
+    SendPacket({0x41, 0x9A, 0x02}, 401, 2 * kFrameDuration, true);
+    SendPacket(packet, 400, kFrameDuration, true);
+    SendPacket({0x41, 0x9A, 0x03}, 402, 3 * kFrameDuration, true);
+
+    std::vector<PlayedUnit> played = PlayAll();
+    ASSERT_GE(played.size(), 5);
+
+    const std::vector<uint8_t> kHeaders = {0x67, 0x68, 0x65, 0x65, 0x41};
+    const std::vector<uint32_t> kSeqs = {400, 400, 400, 400, 401};
+
+    for (uint32_t i = 0; i < kHeaders.size(); i++)
+    {
+        EXPECT_EQ(played[i].header, kHeaders[i]);
+        EXPECT_EQ(played[i].seq, kSeqs[i]);
+    }
+}
+}  // namespace
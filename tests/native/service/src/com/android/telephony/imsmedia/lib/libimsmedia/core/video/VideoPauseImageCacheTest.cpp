@@ -0,0 +1,316 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <VideoPauseImageCache.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+const VideoPauseImageKey kKey = {1, 1, 8, 480, 640, 384, 15, 1, 0x12345678};
+const uint8_t kConfig[] = {0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x00, 0x00, 0x01, 0x68};
+const uint8_t kIdrFrame[] = {0x00, 0x00, 0x00, 0x01, 0x65, 0x88, 0x84, 0x21, 0xA0};
+const uint8_t kSkipFrame[] = {0x00, 0x00, 0x00, 0x01, 0x41, 0x9A, 0x02};
+
+class VideoPauseImageCacheTest : public ::testing::Test
+{
+protected:
+    std::string mDirectory;
+
+    virtual void SetUp() override
+    {
+        std::string path = testing::TempDir() + "/pause_image_cache_XXXXXX";
+        ASSERT_NE(mkdtemp(&path[0]), nullptr);
+        mDirectory = path;
+        VideoPauseImageCache::SetDirectory(mDirectory);
+        VideoPauseImageCache::Clear();
+    }
+
+    virtual void TearDown() override
+    {
+        VideoPauseImageCache::Clear();
+        VideoPauseImageCache::SetDirectory(PAUSE_IMAGE_CACHE_DIR);
+
+        for (auto& name : getFileNames())
+        {
+            remove((mDirectory + "/" + name).c_str());
+        }
+
+        rmdir(mDirectory.c_str());
+    }
+
+    std::string getFilePath(const VideoPauseImageKey& key)
+    {
+        char name[128];
+        snprintf(name, sizeof(name), "/pause_image_%d_%u_%u_%ux%u_%u_%u_%u_%08x.bin",
+                key.codecType, key.profile, key.level, key.width, key.height, key.bitrate,
+                key.framerate, key.intraInterval, key.imageHash);
+        return mDirectory + name;
+    }
+
+    std::vector<std::string> getFileNames()
+    {
+        std::vector<std::string> names;
+        DIR* dir = opendir(mDirectory.c_str());
+
+        if (dir == nullptr)
+        {
+            return names;
+        }
+
+        struct dirent* file;
+
+        while ((file = readdir(dir)) != nullptr)
+        {
+            if (strcmp(file->d_name, ".") != 0 && strcmp(file->d_name, "..") != 0)
+            {
+                names.push_back(file->d_name);
+            }
+        }
+
+        closedir(dir);
+        return names;
+    }
+
+    std::shared_ptr<VideoPauseImageStream> createStream(uint32_t numSkipFrames)
+    {
+        auto stream = std::make_shared<VideoPauseImageStream>();
+        stream->AddFrame(kConfig, sizeof(kConfig), PAUSE_IMAGE_FLAG_CODEC_CONFIG);
+        stream->AddFrame(kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME);
+
+        for (uint32_t i = 0; i < numSkipFrames; i++)
+        {
+            stream->AddFrame(kSkipFrame, sizeof(kSkipFrame), 0);
+        }
+
+        stream->AddFrame(kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME);
+        return stream;
+    }
+
+    void expectFrame(const VideoPauseImageStream* stream, uint32_t index, const uint8_t* data,
+            uint32_t size, uint32_t flags)
+    {
+        const uint8_t* frame = nullptr;
+        uint32_t frameSize = 0;
+        uint32_t frameFlags = 0;
+        ASSERT_TRUE(stream->GetFrame(index, &frame, &frameSize, &frameFlags));
+        EXPECT_EQ(frameSize, size);
+        EXPECT_EQ(frameFlags, flags);
+        EXPECT_EQ(memcmp(frame, data, size), 0);
+    }
+};
+
+TEST_F(VideoPauseImageCacheTest, TestAddFrame)
+{
+    VideoPauseImageStream stream;
+
+    // the frames before the idr frame are dropped
+    EXPECT_FALSE(stream.AddFrame(kSkipFrame, sizeof(kSkipFrame), 0));
+    EXPECT_EQ(stream.GetNumFrames(), 0);
+
+    EXPECT_FALSE(stream.AddFrame(kConfig, sizeof(kConfig), PAUSE_IMAGE_FLAG_CODEC_CONFIG));
+    EXPECT_FALSE(stream.AddFrame(kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME));
+    EXPECT_FALSE(stream.AddFrame(kSkipFrame, sizeof(kSkipFrame), 0));
+    EXPECT_FALSE(stream.AddFrame(kSkipFrame, sizeof(kSkipFrame), 0));
+    EXPECT_FALSE(stream.IsComplete());
+
+    // the next gop completes the stream without being added
+    EXPECT_TRUE(stream.AddFrame(kConfig, sizeof(kConfig), PAUSE_IMAGE_FLAG_CODEC_CONFIG));
+    EXPECT_TRUE(stream.IsComplete());
+    EXPECT_TRUE(stream.AddFrame(kSkipFrame, sizeof(kSkipFrame), 0));
+    ASSERT_EQ(stream.GetNumFrames(), 4);
+    EXPECT_EQ(stream.GetSize(), sizeof(kConfig) + sizeof(kIdrFrame) + sizeof(kSkipFrame) * 2);
+
+    expectFrame(&stream, 0, kConfig, sizeof(kConfig), PAUSE_IMAGE_FLAG_CODEC_CONFIG);
+    expectFrame(&stream, 1, kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME);
+    expectFrame(&stream, 3, kSkipFrame, sizeof(kSkipFrame), 0);
+
+    const uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t flags = 0;
+    EXPECT_FALSE(stream.GetFrame(4, &data, &size, &flags));
+}
+
+TEST_F(VideoPauseImageCacheTest, TestAddFrameLimit)
+{
+    VideoPauseImageStream stream;
+    EXPECT_FALSE(stream.AddFrame(kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME));
+
+    for (uint32_t i = 1; i < PAUSE_IMAGE_CACHE_MAX_FRAMES; i++)
+    {
+        EXPECT_FALSE(stream.AddFrame(kSkipFrame, sizeof(kSkipFrame), 0));
+    }
+
+    EXPECT_TRUE(stream.AddFrame(kSkipFrame, sizeof(kSkipFrame), 0));
+    EXPECT_EQ(stream.GetNumFrames(), PAUSE_IMAGE_CACHE_MAX_FRAMES);
+}
+
+TEST_F(VideoPauseImageCacheTest, TestSaveLoad)
+{
+    auto stream = createStream(3);
+    ASSERT_TRUE(stream->IsComplete());
+
+    std::string path = getFilePath(kKey);
+    ASSERT_TRUE(stream->Save(path.c_str(), kKey));
+
+    VideoPauseImageStream loaded;
+    ASSERT_TRUE(loaded.Load(path.c_str(), kKey));
+    EXPECT_TRUE(loaded.IsComplete());
+    ASSERT_EQ(loaded.GetNumFrames(), 5);
+    EXPECT_EQ(loaded.GetSize(), stream->GetSize());
+    expectFrame(&loaded, 0, kConfig, sizeof(kConfig), PAUSE_IMAGE_FLAG_CODEC_CONFIG);
+    expectFrame(&loaded, 1, kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME);
+    expectFrame(&loaded, 4, kSkipFrame, sizeof(kSkipFrame), 0);
+
+    // another configuration
+    VideoPauseImageKey key = kKey;
+    key.width = 640;
+    VideoPauseImageStream other;
+    EXPECT_FALSE(other.Load(path.c_str(), key));
+
+    // another bitrate, frame rate or idr interval
+    key = kKey;
+    key.bitrate = 512;
+    EXPECT_FALSE(other.Load(path.c_str(), key));
+    key = kKey;
+    key.framerate = 30;
+    EXPECT_FALSE(other.Load(path.c_str(), key));
+    key = kKey;
+    key.intraInterval = 2;
+    EXPECT_FALSE(other.Load(path.c_str(), key));
+
+    // the stream of an old image
+    key = kKey;
+    key.imageHash = 0x87654321;
+    EXPECT_FALSE(other.Load(path.c_str(), key));
+
+    // truncated file
+    FILE* file = fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(ftruncate(fileno(file), 40), 0);
+    fclose(file);
+    EXPECT_FALSE(other.Load(path.c_str(), kKey));
+
+    // the incomplete stream is not saved
+    VideoPauseImageStream incomplete;
+    incomplete.AddFrame(kIdrFrame, sizeof(kIdrFrame), PAUSE_IMAGE_FLAG_KEY_FRAME);
+    EXPECT_FALSE(incomplete.Save(path.c_str(), kKey));
+}
+
+TEST_F(VideoPauseImageCacheTest, TestFindAndAdd)
+{
+    EXPECT_EQ(VideoPauseImageCache::Find(kKey), nullptr);
+
+    auto stream = createStream(2);
+    VideoPauseImageCache::Add(kKey, stream);
+    EXPECT_EQ(VideoPauseImageCache::Find(kKey), stream);
+
+    // read again from the file
+    VideoPauseImageCache::Clear();
+    auto loaded = VideoPauseImageCache::Find(kKey);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_NE(loaded, stream);
+    EXPECT_EQ(loaded->GetNumFrames(), 4);
+    EXPECT_EQ(VideoPauseImageCache::Find(kKey), loaded);
+
+    VideoPauseImageKey key = kKey;
+    key.codecType = 2;
+    EXPECT_EQ(VideoPauseImageCache::Find(key), nullptr);
+
+    // the incomplete stream is not cached
+    VideoPauseImageCache::Add(key, std::make_shared<VideoPauseImageStream>());
+    EXPECT_EQ(VideoPauseImageCache::Find(key), nullptr);
+
+    // the stream of the changed image is encoded again
+    key = kKey;
+    key.imageHash = 0x87654321;
+    VideoPauseImageCache::Clear();
+    EXPECT_EQ(VideoPauseImageCache::Find(key), nullptr);
+}
+
+TEST_F(VideoPauseImageCacheTest, TestLeastRecentlyUsed)
+{
+    VideoPauseImageCache::SetDirectory("");
+    auto stream = createStream(1);
+    VideoPauseImageKey key = kKey;
+
+    for (uint32_t i = 0; i <= PAUSE_IMAGE_CACHE_MAX_ENTRIES; i++)
+    {
+        key.level = i;
+        VideoPauseImageCache::Add(key, stream);
+
+        if (i == 0)
+        {
+            continue;
+        }
+
+        // keep the first one used
+        key.level = 0;
+        EXPECT_EQ(VideoPauseImageCache::Find(key), stream);
+    }
+
+    key.level = 0;
+    EXPECT_EQ(VideoPauseImageCache::Find(key), stream);
+    key.level = 1;
+    EXPECT_EQ(VideoPauseImageCache::Find(key), nullptr);
+    key.level = PAUSE_IMAGE_CACHE_MAX_ENTRIES;
+    EXPECT_EQ(VideoPauseImageCache::Find(key), stream);
+}
+
+TEST_F(VideoPauseImageCacheTest, TestRemoveUnusedFiles)
+{
+    auto stream = createStream(1);
+
+    // the file of an old image and a file not written by the cache
+    VideoPauseImageKey oldKey = kKey;
+    oldKey.imageHash = 0x87654321;
+    ASSERT_TRUE(stream->Save(getFilePath(oldKey).c_str(), oldKey));
+    std::string otherPath = mDirectory + "/other.bin";
+    FILE* file = fopen(otherPath.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    fclose(file);
+
+    VideoPauseImageKey key = kKey;
+
+    for (uint32_t i = 0; i <= PAUSE_IMAGE_CACHE_MAX_ENTRIES; i++)
+    {
+        key.level = i;
+        VideoPauseImageCache::Add(key, stream);
+        EXPECT_EQ(access(getFilePath(key).c_str(), F_OK), 0);
+        EXPECT_NE(access(getFilePath(oldKey).c_str(), F_OK), 0);
+    }
+
+    // the files are kept as many as the streams in the memory
+    EXPECT_EQ(getFileNames().size(), PAUSE_IMAGE_CACHE_MAX_ENTRIES + 1);
+    EXPECT_EQ(access(otherPath.c_str(), F_OK), 0);
+    key.level = 0;
+    EXPECT_NE(access(getFilePath(key).c_str(), F_OK), 0);
+
+    for (uint32_t i = 1; i <= PAUSE_IMAGE_CACHE_MAX_ENTRIES; i++)
+    {
+        key.level = i;
+        EXPECT_EQ(access(getFilePath(key).c_str(), F_OK), 0);
+    }
+
+    // the files are not removed without the cache directory
+    VideoPauseImageCache::SetDirectory("");
+    key.level = PAUSE_IMAGE_CACHE_MAX_ENTRIES + 1;
+    VideoPauseImageCache::Add(key, stream);
+    key.level = 1;
+    EXPECT_EQ(access(getFilePath(key).c_str(), F_OK), 0);
+}
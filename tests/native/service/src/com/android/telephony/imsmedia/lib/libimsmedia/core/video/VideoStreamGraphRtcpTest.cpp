@@ -182,29 +182,26 @@ TEST_F(VideoStreamGraphRtcpTest, TestRtcpStreamInternalEvent)
     EXPECT_EQ(graph->start(), RESULT_SUCCESS);
     EXPECT_EQ(graph->getState(), kStreamStateRunning);
 
-    InternalRequestEventParam* nackEvent =
-            new InternalRequestEventParam(kRequestVideoSendNack, NackParams(0, 0, 0, true));
+    InternalRequestEventParam nackEvent(kRequestVideoSendNack, NackParams(0, 0, 0, true));
     EXPECT_EQ(
-            graph->OnEvent(kRequestVideoSendNack, reinterpret_cast<uint64_t>(nackEvent), 0), true);
+            graph->OnEvent(kRequestVideoSendNack, reinterpret_cast<uint64_t>(&nackEvent), 0), true);
 
-    InternalRequestEventParam* pliEvent =
-            new InternalRequestEventParam(kRequestVideoSendPictureLost, kPsfbPli);
-    EXPECT_EQ(graph->OnEvent(kRequestVideoSendPictureLost, reinterpret_cast<uint64_t>(pliEvent), 0),
+    InternalRequestEventParam pliEvent(kRequestVideoSendPictureLost, kPsfbPli);
+    EXPECT_EQ(graph->OnEvent(
+                      kRequestVideoSendPictureLost, reinterpret_cast<uint64_t>(&pliEvent), 0),
             true);
 
-    InternalRequestEventParam* firEvent =
-            new InternalRequestEventParam(kRequestVideoSendPictureLost, kPsfbFir);
-    EXPECT_EQ(graph->OnEvent(kRequestVideoSendPictureLost, reinterpret_cast<uint64_t>(firEvent), 0),
+    InternalRequestEventParam firEvent(kRequestVideoSendPictureLost, kPsfbFir);
+    EXPECT_EQ(graph->OnEvent(
+                      kRequestVideoSendPictureLost, reinterpret_cast<uint64_t>(&firEvent), 0),
             true);
 
-    InternalRequestEventParam* tmmbrEvent =
-            new InternalRequestEventParam(kRtpFbTmmbr, TmmbrParams(100000, 0, 0, 0));
-    EXPECT_EQ(graph->OnEvent(kRequestVideoSendTmmbr, reinterpret_cast<uint64_t>(tmmbrEvent), 0),
+    InternalRequestEventParam tmmbrEvent(kRtpFbTmmbr, TmmbrParams(100000, 0, 0, 0));
+    EXPECT_EQ(graph->OnEvent(kRequestVideoSendTmmbr, reinterpret_cast<uint64_t>(&tmmbrEvent), 0),
             true);
 
-    InternalRequestEventParam* tmmbn =
-            new InternalRequestEventParam(kRtpFbTmmbn, TmmbrParams(100000, 0, 0, 0));
-    EXPECT_EQ(graph->OnEvent(kRequestVideoSendTmmbn, reinterpret_cast<uint64_t>(tmmbn), 0), true);
+    InternalRequestEventParam tmmbn(kRtpFbTmmbn, TmmbrParams(100000, 0, 0, 0));
+    EXPECT_EQ(graph->OnEvent(kRequestVideoSendTmmbn, reinterpret_cast<uint64_t>(&tmmbn), 0), true);
 
     EXPECT_EQ(graph->stop(), RESULT_SUCCESS);
     EXPECT_EQ(graph->getState(), kStreamStateCreated);
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2023 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FAKE_REAR_NODE_H
+#define FAKE_REAR_NODE_H
+
+#include <BaseNode.h>
+#include <mutex>
+#include <vector>
+
+struct FakeRearNodePacket
+{
+    ImsMediaSubType subtype;
+    std::vector<uint8_t> data;
+    uint32_t timestamp;
+    bool mark;
+    uint32_t seq;
+    ImsMediaSubType dataType;
+    uint32_t arrivalTime;
+};
+
+/**
+ * @brief The running rear node keeping a copy of the packets sent by the node under the test
+ */
+class FakeRearNode : public BaseNode
+{
+public:
+    virtual ~FakeRearNode() {}
+    virtual ImsMediaResult Start() { return RESULT_SUCCESS; }
+    virtual void Stop() {}
+    virtual bool IsRunTime() { return true; }
+    virtual bool IsSourceNode() { return false; }
+    virtual kBaseNodeState GetState() { return kNodeStateRunning; }
+    virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+            uint32_t timestamp, bool mark, uint32_t seq, ImsMediaSubType dataType,
+            uint32_t arrivalTime)
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mPackets.push_back({subtype, std::vector<uint8_t>(data, data + size), timestamp, mark,
+                seq, dataType, arrivalTime});
+    }
+
+    std::vector<FakeRearNodePacket> mPackets;
+
+private:
+    std::mutex mMutex;
+};
+
+#endif
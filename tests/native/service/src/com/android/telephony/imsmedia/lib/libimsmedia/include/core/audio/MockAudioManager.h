@@ -28,6 +28,7 @@ public:
     virtual ~MockAudioManager() { sManager = nullptr; }
     MOCK_METHOD(ImsMediaResult, deleteConfig, (int sessionId, AudioConfig* config), (override));
     MOCK_METHOD(void, sendDtmf, (int sessionId, char dtmfDigit, int duration), (override));
+    MOCK_METHOD(void, setPtime, (int sessionId, uint32_t ptime), (override));
     MOCK_METHOD(void, sendRtpHeaderExtension,
             (int sessionId, std::list<RtpHeaderExtension>* listExtension), (override));
     MOCK_METHOD(void, setMediaQualityThreshold, (int sessionId, MediaQualityThreshold* threshold),
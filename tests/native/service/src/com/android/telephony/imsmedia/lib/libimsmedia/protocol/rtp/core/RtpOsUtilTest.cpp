@@ -16,6 +16,7 @@
 
 #include <RtpOsUtil.h>
 #include <gtest/gtest.h>
+#include <time.h>
 
 TEST(RtpOsUtilTest, TestGetNtpTime)
 {
@@ -54,4 +55,68 @@ TEST(RtpOsUtilTest, TestRRand)
     RtpDt_Double ulRRand2 = RtpOsUtil::RRand();
 
     EXPECT_NE(ulRRand1, ulRRand2);
-}
\ No newline at end of file
+}
+
+TEST(RtpOsUtilTest, TestGetMonotonicTime)
+{
+    tRTP_NTP_TIME stTime1 = {RTP_ZERO, RTP_ZERO};
+    tRTP_NTP_TIME stTime2 = {RTP_ZERO, RTP_ZERO};
+    struct timespec stTs;
+
+    RtpOsUtil::GetMonotonicTime(stTime1);
+    clock_gettime(CLOCK_MONOTONIC, &stTs);
+    EXPECT_LE(stTs.tv_sec - stTime1.m_uiNtpHigh32Bits, 1);
+
+    usleep(RTP_MILLISEC_MICRO);
+    RtpOsUtil::GetMonotonicTime(stTime2);
+    EXPECT_TRUE(stTime2.m_uiNtpHigh32Bits > stTime1.m_uiNtpHigh32Bits ||
+            stTime2.m_uiNtpLow32Bits > stTime1.m_uiNtpLow32Bits);
+}
+
+TEST(RtpOsUtilTest, TestTimeBatch)
+{
+    tRTP_NTP_TIME stNtpTime1 = {RTP_ZERO, RTP_ZERO};
+    tRTP_NTP_TIME stNtpTime2 = {RTP_ZERO, RTP_ZERO};
+    tRTP_NTP_TIME stTime1 = {RTP_ZERO, RTP_ZERO};
+    tRTP_NTP_TIME stTime2 = {RTP_ZERO, RTP_ZERO};
+
+    {
+        RtpOsTimeBatch objTimeBatch;
+        RtpOsUtil::GetNtpTime(stNtpTime1);
+        RtpOsUtil::GetMonotonicTime(stTime1);
+        usleep(RTP_MILLISEC_MICRO);
+
+        {
+            RtpOsTimeBatch objNestedBatch;
+        }
+
+        RtpOsUtil::GetNtpTime(stNtpTime2);
+        RtpOsUtil::GetMonotonicTime(stTime2);
+    }
+
+    EXPECT_EQ(stNtpTime1.m_uiNtpHigh32Bits, stNtpTime2.m_uiNtpHigh32Bits);
+    EXPECT_EQ(stNtpTime1.m_uiNtpLow32Bits, stNtpTime2.m_uiNtpLow32Bits);
+    EXPECT_EQ(stTime1.m_uiNtpHigh32Bits, stTime2.m_uiNtpHigh32Bits);
+    EXPECT_EQ(stTime1.m_uiNtpLow32Bits, stTime2.m_uiNtpLow32Bits);
+
+    usleep(RTP_MILLISEC_MICRO);
+    RtpOsUtil::GetMonotonicTime(stTime2);
+    EXPECT_NE(stTime1.m_uiNtpLow32Bits, stTime2.m_uiNtpLow32Bits);
+}
+
+TEST(RtpOsUtilTest, TestRRandRange)
+{
+    RtpDt_Double dSum = 0;
+    const RtpDt_UInt32 kCount = 10000;
+
+    for (RtpDt_UInt32 i = 0; i < kCount; i++)
+    {
+        RtpDt_Double dRand = RtpOsUtil::RRand();
+        ASSERT_GE(dRand, 0.0);
+        ASSERT_LT(dRand, 1.0);
+        dSum += dRand;
+    }
+
+    // uniformly distributed, the mean is close to 0.5
+    EXPECT_NEAR(dSum / kCount, 0.5, 0.05);
+}
@@ -76,4 +76,26 @@ public class JNIImsMediaServiceTest {
         mJniService.sendData2Java(sessionId2, data2);
         verify(mAudioListener2, times(1)).onMessage(any());
     }
+
+    @Test
+    public void testSendDataWithReusedBuffer() {
+        final int sessionId = 0;
+        mJniService.setListener(sessionId, mAudioListener1);
+
+        Parcel parcel = Parcel.obtain();
+        parcel.writeInt(AudioSession.EVENT_OPEN_SESSION_SUCCESS);
+        parcel.writeInt(sessionId);
+        byte[] data = parcel.marshall();
+        parcel.recycle();
+
+        // the native side passes a pooled buffer larger than the parcel
+        byte[] buffer = new byte[data.length * 2];
+        System.arraycopy(data, 0, buffer, 0, data.length);
+
+        assertEquals(mJniService.sendData2Java(sessionId, buffer, data.length), 1);
+        verify(mAudioListener1, times(1)).onMessage(any());
+
+        assertEquals(mJniService.sendData2Java(sessionId, buffer, buffer.length + 1), -1);
+        verify(mAudioListener1, times(1)).onMessage(any());
+    }
 }